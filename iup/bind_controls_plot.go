@@ -78,6 +78,16 @@ func PlotLoadData(ih Ihandle, filename string, strXdata int) int {
 	return int(C.IupPlotLoadData(ih.ptr(), cFilename, C.int(strXdata)))
 }
 
+// PlotSaveData saves all datasets of the current plot to a file, in text or binary format.
+//
+// https://github.com/gen2brain/iup-go/blob/main/docs/ctrl/iup_plot.md
+func PlotSaveData(ih Ihandle, filename string, binary int) int {
+	cFilename := C.CString(filename)
+	defer C.free(unsafe.Pointer(cFilename))
+
+	return int(C.IupPlotSaveData(ih.ptr(), cFilename, C.int(binary)))
+}
+
 // PlotInsert inserts a sample at the given position in a dataset.
 //
 // https://github.com/gen2brain/iup-go/blob/main/docs/ctrl/iup_plot.md
@@ -145,6 +155,27 @@ func PlotAddSamples(ih Ihandle, dsIndex int, x, y []float64) {
 	C.IupPlotAddSamples(ih.ptr(), C.int(dsIndex), (*C.double)(&x[0]), (*C.double)(&y[0]), C.int(count))
 }
 
+// PlotSetSamplesBuffer replaces all the samples of a dataset with x and y.
+// The values are copied once into C arrays that the plot takes ownership of.
+// Returns 1 on success, or 0 if the dataset is invalid, uses strings in the X axis or the slices differ in length.
+//
+// https://github.com/gen2brain/iup-go/blob/main/docs/ctrl/iup_plot.md
+func PlotSetSamplesBuffer(ih Ihandle, dsIndex int, x, y []float64) int {
+	count := len(x)
+	if len(y) != count {
+		return 0
+	}
+	var cX, cY *C.double
+	if count > 0 {
+		size := C.size_t(count) * C.size_t(unsafe.Sizeof(C.double(0)))
+		cX = (*C.double)(C.malloc(size))
+		cY = (*C.double)(C.malloc(size))
+		copy(unsafe.Slice((*float64)(unsafe.Pointer(cX)), count), x)
+		copy(unsafe.Slice((*float64)(unsafe.Pointer(cY)), count), y)
+	}
+	return int(C.IupPlotSetSamplesBuffer(ih.ptr(), C.int(dsIndex), cX, cY, C.int(count), 1))
+}
+
 // PlotAddStrSamples adds multiple string X samples to a dataset.
 //
 // https://github.com/gen2brain/iup-go/blob/main/docs/ctrl/iup_plot.md
@@ -110,6 +110,18 @@ func DrawPolygon(ih Ihandle, points []int, count int) {
 	C.IupDrawPolygon(ih.ptr(), &cPoints[0], C.int(count))
 }
 
+// DrawPolyline draws a sequence of connected lines, as a single stroke.
+// Coordinates are stored in the array in the sequence: x1, y1, x2, y2, ...
+//
+// https://github.com/gen2brain/iup-go/blob/main/docs/func/iup_draw.md
+func DrawPolyline(ih Ihandle, points []int, count int) {
+	cPoints := make([]C.int, len(points))
+	for i, v := range points {
+		cPoints[i] = C.int(v)
+	}
+	C.IupDrawPolyline(ih.ptr(), &cPoints[0], C.int(count))
+}
+
 // DrawPixel draws a single pixel at the given position.
 //
 // https://github.com/gen2brain/iup-go/blob/main/docs/func/iup_draw.md
@@ -0,0 +1,8 @@
+//go:build !js
+
+package iup
+
+/*
+#include "external/src/iup_draw_rgba.c"
+*/
+import "C"
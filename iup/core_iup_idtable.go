@@ -0,0 +1,8 @@
+//go:build !js
+
+package iup
+
+/*
+#include "external/src/iup_idtable.c"
+*/
+import "C"
\ No newline at end of file
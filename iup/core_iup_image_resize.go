@@ -0,0 +1,8 @@
+//go:build !js
+
+package iup
+
+/*
+#include "external/src/iup_image_resize.c"
+*/
+import "C"
@@ -15,6 +15,7 @@ package iup
 #include "external/srcctrl/matrix/iupmat_mouse.c"
 #include "external/srcctrl/matrix/iupmat_numlc.c"
 #include "external/srcctrl/matrix/iupmat_scroll.c"
+#include "external/srcctrl/matrix/iupmat_sort.c"
 #include "external/srcctrl/matrix/iupmat_ex.c"
 #include "external/srcctrl/matrix/iupmatrix.c"
 
@@ -0,0 +1,235 @@
+//go:build ctrl && cgo && !js
+
+package iup
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+// newMatrixEx creates a mapped MatrixEx with one line per row of values.
+// cgo only: the libraries embedded for nocgo may predate the tested features.
+func newMatrixEx(t *testing.T, values [][]string) Ihandle {
+	t.Helper()
+	ControlsOpen()
+	mat := MatrixEx()
+	mat.SetAttribute("NUMLIN", len(values))
+	mat.SetAttribute("NUMCOL", len(values[0]))
+	dlg := Dialog(mat)
+	t.Cleanup(func() { dlg.Destroy() })
+	if Map(dlg) == ERROR {
+		t.Fatal("cannot map the matrix dialog")
+	}
+	for lin, row := range values {
+		for col, v := range row {
+			SetAttributeId2(mat, "", lin+1, col+1, v)
+		}
+	}
+	return mat
+}
+
+// sortedLines returns the original line shown at each display line.
+func sortedLines(mat Ihandle) []int {
+	lines := make([]int, mat.GetInt("NUMLIN"))
+	for i := range lines {
+		lines[i] = mat.GetInt("SORTLINEINDEX", i+1)
+	}
+	return lines
+}
+
+// waitFindAll runs the event loop until the FINDALL search is done.
+func waitFindAll(t *testing.T, mat Ihandle) {
+	t.Helper()
+	deadline := time.Now().Add(10 * time.Second)
+	for mat.GetAttribute("FINDALLRUNNING") == "Yes" {
+		if time.Now().After(deadline) {
+			t.Fatal("FINDALL did not finish")
+		}
+		LoopStep()
+		time.Sleep(time.Millisecond)
+	}
+}
+
+func equalInts(a, b []int) bool {
+	if len(a) != len(b) {
+		return false
+	}
+	for i := range a {
+		if a[i] != b[i] {
+			return false
+		}
+	}
+	return true
+}
+
+func TestMatrixExSortColumns(t *testing.T) {
+	mat := newMatrixEx(t, [][]string{
+		{"B", "1"},
+		{"A", "2"},
+		{"B", "3"},
+		{"A", "4"},
+		{"A", "5"},
+	})
+
+	// stable: equal keys keep their original order
+	mat.SetAttribute("SORTCOLUMNS", "1")
+	if got, want := sortedLines(mat), []int{2, 4, 5, 1, 3}; !equalInts(got, want) {
+		t.Fatalf("SORTCOLUMNS=1: lines %v, want %v", got, want)
+	}
+
+	mat.SetAttribute("SORTCOLUMNS", "1:ASC,2:DESC")
+	if got, want := sortedLines(mat), []int{5, 4, 2, 3, 1}; !equalInts(got, want) {
+		t.Fatalf("SORTCOLUMNS=1:ASC,2:DESC: lines %v, want %v", got, want)
+	}
+
+	// an invalid column is skipped, the other keys still sort
+	mat.SetAttribute("SORTCOLUMNS", "9:DESC,1:DESC,x")
+	if got, want := sortedLines(mat), []int{1, 3, 2, 4, 5}; !equalInts(got, want) {
+		t.Fatalf("SORTCOLUMNS=9:DESC,1:DESC,x: lines %v, want %v", got, want)
+	}
+}
+
+func TestMatrixStorageNumbers(t *testing.T) {
+	mat := newMatrixEx(t, [][]string{{"", ""}, {"", ""}, {"", ""}})
+	mat.SetAttribute("STORAGE1", "INT64")
+	mat.SetAttribute("STORAGE2", "DOUBLE")
+	if got := mat.GetAttribute("STORAGE", 1); got != "INT64" {
+		t.Fatalf("STORAGE1 = %q, want INT64", got)
+	}
+
+	for i, v := range []string{"42", "12abc", " 7 "} {
+		SetAttributeId2(mat, "", i+1, 1, v)
+		SetAttributeId2(mat, "", i+1, 2, v)
+	}
+	for col := 1; col <= 2; col++ {
+		for i, want := range []string{"42", "", "7"} {
+			if got := GetAttributeId2(mat, "", i+1, col); got != want {
+				t.Fatalf("cell %d:%d = %q, want %q", i+1, col, got, want)
+			}
+		}
+	}
+}
+
+func TestMatrixExFindAll(t *testing.T) {
+	mat := newMatrixEx(t, [][]string{
+		{"apple", "x", "apple"},
+		{"y", "apple", "z"},
+		{"z", "z", "z"},
+		{"apple", "y", "x"},
+		{"x", "x", "x"},
+	})
+	mat.SetAttribute("MARKMODE", "CELL")
+	mat.SetAttribute("MARKMULTIPLE", "YES")
+
+	// marked by the user, one of them is also a match
+	SetAttributeId2(mat, "MARK", 1, 1, "1")
+	SetAttributeId2(mat, "MARK", 5, 3, "1")
+
+	mat.SetAttribute("FINDALL", "apple")
+	waitFindAll(t, mat)
+	if n := mat.GetInt("MATCHCOUNT"); n != 4 {
+		t.Fatalf("MATCHCOUNT = %d, want 4", n)
+	}
+	for _, c := range [][2]int{{1, 1}, {1, 3}, {2, 2}, {4, 1}, {5, 3}} {
+		if GetIntId2(mat, "MARK", c[0], c[1]) != 1 {
+			t.Fatalf("cell %d:%d is not marked after FINDALL", c[0], c[1])
+		}
+	}
+
+	// clearing the result keeps the marks of the user
+	mat.SetAttribute("FINDALL", "")
+	for _, c := range [][2]int{{1, 3}, {2, 2}, {4, 1}} {
+		if GetIntId2(mat, "MARK", c[0], c[1]) != 0 {
+			t.Fatalf("cell %d:%d is still marked after clearing FINDALL", c[0], c[1])
+		}
+	}
+	for _, c := range [][2]int{{1, 1}, {5, 3}} {
+		if GetIntId2(mat, "MARK", c[0], c[1]) != 1 {
+			t.Fatalf("user mark of cell %d:%d was removed", c[0], c[1])
+		}
+	}
+
+	// FIND does not use a result older than the cells
+	mat.SetAttribute("FINDALL", "apple")
+	waitFindAll(t, mat)
+	SetAttributeId2(mat, "", 3, 2, "apple")
+	mat.SetAttribute("FOCUSCELL", "3:1")
+	mat.SetAttribute("FIND", "apple")
+	if got := mat.GetAttribute("FOCUSCELL"); got != "3:2" {
+		t.Fatalf("FIND after an edit: FOCUSCELL = %s, want 3:2", got)
+	}
+	if GetIntId2(mat, "MARK", 5, 3) != 1 {
+		t.Fatal("FIND removed the user mark of cell 5:3")
+	}
+}
+
+func TestMatrixExCopyFileCSV(t *testing.T) {
+	mat := newMatrixEx(t, [][]string{
+		{"a,b", `say "hi"`},
+		{"plain", ""},
+		{"two\nlines", "x"},
+	})
+	// titles, so the title line and column are exported too
+	for col, title := range []string{"", "Name", "Note"} {
+		SetAttributeId2(mat, "", 0, col, title)
+	}
+	for lin, title := range []string{"r1", "r2", "r3"} {
+		SetAttributeId2(mat, "", lin+1, 0, title)
+	}
+
+	name := filepath.Join(t.TempDir(), "matrix.csv")
+	mat.SetAttribute("FILEFORMAT", "CSV")
+	mat.SetAttribute("COPYFILE", name)
+	data, err := os.ReadFile(name)
+	if err != nil {
+		t.Fatalf("COPYFILE: %v", err)
+	}
+
+	want := ",Name,Note\r\n" +
+		"r1,\"a,b\",\"say \"\"hi\"\"\"\r\n" +
+		"r2,plain,\r\n" +
+		"r3,\"two\nlines\",x\r\n"
+	if string(data) != want {
+		t.Fatalf("CSV export:\n%q\nwant\n%q", data, want)
+	}
+}
+
+func TestMatrixExUndoMaxMemory(t *testing.T) {
+	mat := newMatrixEx(t, [][]string{{"v00"}})
+	mat.SetAttribute("UNDOREDO", "Yes")
+
+	// values of the same size, so every level uses the same memory
+	for i := 10; i < 30; i++ {
+		SetAttributeId2(mat, "", 1, 1, fmt.Sprintf("v%d", i))
+	}
+	if n := mat.GetInt("UNDOCOUNT"); n != 20 {
+		t.Fatalf("UNDOCOUNT = %d, want 20", n)
+	}
+	memory := mat.GetInt("UNDOMEMORY")
+	if memory <= 0 {
+		t.Fatalf("UNDOMEMORY = %d, want > 0", memory)
+	}
+
+	// room for a few levels, the oldest are removed
+	limit := memory/20*3 + memory/40
+	mat.SetAttribute("UNDOMAXMEMORY", limit)
+	if n := mat.GetInt("UNDOCOUNT"); n < 1 || n >= 20 {
+		t.Fatalf("UNDOMAXMEMORY=%d: UNDOCOUNT = %d, want between 1 and 19", limit, n)
+	}
+	if m := mat.GetInt("UNDOMEMORY"); m > limit {
+		t.Fatalf("UNDOMAXMEMORY=%d: UNDOMEMORY = %d", limit, m)
+	}
+
+	// the last level is always kept
+	mat.SetAttribute("UNDOMAXMEMORY", 1)
+	if n := mat.GetInt("UNDOCOUNT"); n != 1 {
+		t.Fatalf("UNDOMAXMEMORY=1: UNDOCOUNT = %d, want 1", n)
+	}
+	mat.SetAttribute("UNDO", "1")
+	if got := GetAttributeId2(mat, "", 1, 1); got != "v28" {
+		t.Fatalf("after UNDO the cell is %q, want v28", got)
+	}
+}
@@ -140,6 +140,18 @@ public final class IupCanvasHelper
         c.drawPath(path, p);
     }
 
+    @Keep
+    public static void drawPolyline(IupAndroidCanvas view, int[] points, int color, int style, int width)
+    {
+        Canvas c = view.getBackCanvas(); if (c == null) return;
+        if (points == null || points.length < 4) return;
+        Paint p = strokePaint(color, style, width);
+        Path path = new Path();
+        path.moveTo(points[0], points[1]);
+        for (int i = 2; i < points.length; i += 2) path.lineTo(points[i], points[i + 1]);
+        c.drawPath(path, p);
+    }
+
     @Keep
     public static void drawBezier(IupAndroidCanvas view, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, int color, int style, int width)
     {
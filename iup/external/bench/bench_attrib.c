@@ -0,0 +1,97 @@
+/* Attribute set/get throughput.
+ *
+ * Builds an unmapped dialog with a few hundred controls and compares the
+ * string API against the atom API for a registered attribute (handled by a
+ * class attribute function) and for an application attribute (stored in the
+ * element hash table).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "iup.h"
+
+#define BENCH_CONTROLS 400
+#define BENCH_LOOPS    500
+
+static Ihandle* controls[BENCH_CONTROLS];
+
+static double bench_seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void bench_report(const char* title, double secs)
+{
+  double ops = (double)BENCH_CONTROLS * BENCH_LOOPS;
+  printf("  %-28s %8.3f s  %10.2f Mops/s\n", title, secs, ops / (secs * 1e6));
+}
+
+static void bench_name(const char* name, const char* value)
+{
+  int atom = IupGetAtom(name);
+  clock_t start;
+  int i, l;
+
+  printf("%s:\n", name);
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS; l++)
+    for (i = 0; i < BENCH_CONTROLS; i++)
+      IupSetAttribute(controls[i], name, value);
+  bench_report("IupSetAttribute", bench_seconds(start));
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS; l++)
+    for (i = 0; i < BENCH_CONTROLS; i++)
+      IupSetAttributeAtom(controls[i], atom, value);
+  bench_report("IupSetAttributeAtom", bench_seconds(start));
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS; l++)
+    for (i = 0; i < BENCH_CONTROLS; i++)
+      IupGetAttribute(controls[i], name);
+  bench_report("IupGetAttribute", bench_seconds(start));
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS; l++)
+    for (i = 0; i < BENCH_CONTROLS; i++)
+      IupGetAttributeAtom(controls[i], atom);
+  bench_report("IupGetAttributeAtom", bench_seconds(start));
+}
+
+int main(int argc, char **argv)
+{
+  Ihandle *vbox, *dlg;
+  char name[50];
+  int i, j;
+
+  IupOpen(&argc, &argv);
+
+  vbox = IupVbox(NULL);
+  for (i = 0; i < BENCH_CONTROLS; i++)
+  {
+    if (i % 2)
+      controls[i] = IupLabel("Label");
+    else
+      controls[i] = IupButton("Button");
+
+    /* a realistic number of application attributes per element */
+    for (j = 0; j < 20; j++)
+    {
+      sprintf(name, "BENCH_USER%d", j);
+      IupSetStrAttribute(controls[i], name, "value");
+    }
+
+    IupAppend(vbox, controls[i]);
+  }
+  dlg = IupDialog(vbox);
+
+  printf("%d controls, %d loops\n", BENCH_CONTROLS, BENCH_LOOPS);
+  bench_name("TIP", "Tip text");
+  bench_name("BENCH_VALUE", "value");
+
+  IupDestroy(dlg);
+  IupClose();
+  return EXIT_SUCCESS;
+}
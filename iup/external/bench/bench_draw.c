@@ -0,0 +1,168 @@
+/* Canvas drawing time.
+ *
+ * Draws a plot-like scene with IupDraw: a background, a grid, tick labels,
+ * a few thousand line segments, markers and a legend. Each frame moves the
+ * data, so the whole scene is drawn again every time.
+ *
+ * By default the canvas is not mapped and DRAWHEADLESS is used, so the scene
+ * is rasterized in memory. This is the baseline for the native drivers.
+ *
+ * Usage: bench_draw [-map]
+ *   -map  shows the dialog and draws with the native driver.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "iup.h"
+#include "iupdraw.h"
+
+#define BENCH_WIDTH   800
+#define BENCH_HEIGHT  600
+#define BENCH_POINTS  2000
+#define BENCH_MARKERS 100
+#define BENCH_FRAMES  100
+
+static int frame = 0;
+
+static double bench_seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void bench_report(const char* title, double secs, int frames)
+{
+  printf("  %-36s %10.3f ms/frame\n", title, (secs * 1000.0) / frames);
+}
+
+static int bench_action(Ihandle* canvas)
+{
+  int w, h, i, x, y, last_x = 0, last_y = 0;
+  int left = 60, right, top = 20, bottom;
+  char label[50];
+
+  IupDrawBegin(canvas);
+  IupDrawGetSize(canvas, &w, &h);
+  right = w - 20;
+  bottom = h - 40;
+
+  IupSetAttribute(canvas, "DRAWCOLOR", "255 255 255");
+  IupSetAttribute(canvas, "DRAWSTYLE", "FILL");
+  IupDrawRectangle(canvas, 0, 0, w - 1, h - 1);
+
+  IupSetAttribute(canvas, "DRAWSTYLE", "STROKE_DOT");
+  IupSetAttribute(canvas, "DRAWCOLOR", "200 200 200");
+  for (i = 0; i <= 10; i++)
+  {
+    x = left + (i * (right - left)) / 10;
+    y = top + (i * (bottom - top)) / 10;
+    IupDrawLine(canvas, x, top, x, bottom);
+    IupDrawLine(canvas, left, y, right, y);
+  }
+
+  IupSetAttribute(canvas, "DRAWSTYLE", "STROKE");
+  IupSetAttribute(canvas, "DRAWCOLOR", "0 0 0");
+  IupDrawRectangle(canvas, left, top, right, bottom);
+
+  IupSetAttribute(canvas, "DRAWFONT", "Helvetica, 9");
+  for (i = 0; i <= 10; i++)
+  {
+    x = left + (i * (right - left)) / 10;
+    y = top + (i * (bottom - top)) / 10;
+    sprintf(label, "%d", i * 100 + frame);
+    IupDrawText(canvas, label, 0, x - 10, bottom + 5, -1, -1);
+    sprintf(label, "%.1f", 1.0 - i / 5.0);
+    IupDrawText(canvas, label, 0, 10, y - 6, -1, -1);
+  }
+
+  IupSetAttribute(canvas, "DRAWCOLOR", "0 90 200");
+  IupSetAttribute(canvas, "DRAWLINEWIDTH", "2");
+  IupDrawSetClipRect(canvas, left, top, right, bottom);
+  for (i = 0; i < BENCH_POINTS; i++)
+  {
+    double t = (double)i / (BENCH_POINTS - 1);
+    double v = sin(t * 20.0 + frame * 0.1) * cos(t * 3.0) + 0.1 * sin(t * 400.0);
+    x = left + (int)(t * (right - left));
+    y = (top + bottom) / 2 - (int)(v * (bottom - top) / 2.5);
+    if (i > 0)
+      IupDrawLine(canvas, last_x, last_y, x, y);
+    last_x = x;
+    last_y = y;
+  }
+  IupSetAttribute(canvas, "DRAWLINEWIDTH", "1");
+
+  IupSetAttribute(canvas, "DRAWCOLOR", "220 60 0 160");
+  IupSetAttribute(canvas, "DRAWSTYLE", "FILL");
+  for (i = 0; i < BENCH_MARKERS; i++)
+  {
+    double t = (double)i / (BENCH_MARKERS - 1);
+    double v = cos(t * 7.0 - frame * 0.05);
+    x = left + (int)(t * (right - left));
+    y = (top + bottom) / 2 - (int)(v * (bottom - top) / 3);
+    IupDrawEllipse(canvas, x - 3, y - 3, x + 3, y + 3);
+  }
+  IupDrawResetClip(canvas);
+
+  IupSetAttribute(canvas, "DRAWCOLOR", "255 255 255 220");
+  IupDrawRoundedRectangle(canvas, right - 150, top + 10, right - 10, top + 60, 6);
+  IupSetAttribute(canvas, "DRAWSTYLE", "STROKE");
+  IupSetAttribute(canvas, "DRAWCOLOR", "0 0 0");
+  IupDrawRoundedRectangle(canvas, right - 150, top + 10, right - 10, top + 60, 6);
+  IupSetAttribute(canvas, "DRAWCOLOR", "0 90 200");
+  IupDrawLine(canvas, right - 140, top + 25, right - 110, top + 25);
+  IupSetAttribute(canvas, "DRAWCOLOR", "220 60 0");
+  IupDrawArc(canvas, right - 128, top + 40, right - 122, top + 46, 0, 360);
+  IupSetAttribute(canvas, "DRAWCOLOR", "0 0 0");
+  IupDrawText(canvas, "signal", 0, right - 100, top + 18, -1, -1);
+  IupDrawText(canvas, "samples", 0, right - 100, top + 37, -1, -1);
+
+  IupDrawEnd(canvas);
+  return IUP_DEFAULT;
+}
+
+int main(int argc, char **argv)
+{
+  Ihandle *dlg, *canvas, *image;
+  clock_t start;
+  int map = (argc > 1 && strcmp(argv[1], "-map") == 0);
+
+  IupOpen(&argc, &argv);
+
+  canvas = IupCanvas();
+  IupSetStrf(canvas, "RASTERSIZE", "%dx%d", BENCH_WIDTH, BENCH_HEIGHT);
+  IupSetAttribute(canvas, "BORDER", "NO");
+  IupSetCallback(canvas, "ACTION", (Icallback)bench_action);
+  if (!map)
+    IupSetAttribute(canvas, "DRAWHEADLESS", "YES");
+
+  dlg = IupDialog(canvas);
+  if (map)
+    IupShow(dlg);
+
+  printf("%dx%d, %d segments, %d markers%s\n", BENCH_WIDTH, BENCH_HEIGHT, BENCH_POINTS - 1, BENCH_MARKERS, map ? ", native" : ", headless");
+
+  start = clock();
+  for (frame = 0; frame < BENCH_FRAMES; frame++)
+  {
+    if (map)
+      IupRedraw(canvas, 0);
+    else
+      bench_action(canvas);
+  }
+  bench_report("draw", bench_seconds(start), BENCH_FRAMES);
+
+  start = clock();
+  for (frame = 0; frame < BENCH_FRAMES / 10; frame++)
+  {
+    image = IupDrawGetImage(canvas);
+    if (image)
+      IupDestroy(image);
+  }
+  bench_report("IupDrawGetImage", bench_seconds(start), BENCH_FRAMES / 10);
+
+  IupDestroy(dlg);
+  IupClose();
+  return 0;
+}
@@ -0,0 +1,146 @@
+/* Layout refresh time.
+ *
+ * Builds a deep tree of IupVbox, IupHbox and IupGridBox containers with a few
+ * thousand labels, then measures IupRefresh after changing the title of a
+ * single label, and after changing many labels with and without
+ * IupRefreshBegin/IupRefreshEnd.
+ *
+ * Usage: bench_layout [-map]
+ *   -map  maps the dialog, so the native controls are also moved and resized.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "iup.h"
+
+#define BENCH_DEPTH    6
+#define BENCH_CHILDREN 4
+#define BENCH_LOOPS    200
+#define BENCH_BATCH    50
+
+static Ihandle** labels = NULL;
+static int label_count = 0, label_max = 0;
+
+static double bench_seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void bench_report(const char* title, double secs, int refreshes)
+{
+  printf("  %-36s %10.3f ms/refresh\n", title, (secs * 1000.0) / refreshes);
+}
+
+static Ihandle* bench_label(void)
+{
+  Ihandle* label = IupLabel("Label");
+
+  if (label_count == label_max)
+  {
+    label_max = label_max ? 2 * label_max : 1024;
+    labels = (Ihandle**)realloc(labels, label_max * sizeof(Ihandle*));
+  }
+  labels[label_count++] = label;
+  return label;
+}
+
+static Ihandle* bench_box(int depth)
+{
+  Ihandle* box;
+  int i;
+
+  if (depth % 3 == 0)
+    box = IupVbox(NULL);
+  else if (depth % 3 == 1)
+    box = IupHbox(NULL);
+  else
+  {
+    box = IupGridBox(NULL);
+    IupSetAttribute(box, "NUMDIV", "2");
+  }
+
+  IupSetAttribute(box, "GAP", "2");
+
+  for (i = 0; i < BENCH_CHILDREN; i++)
+  {
+    if (depth < BENCH_DEPTH)
+      IupAppend(box, bench_box(depth + 1));
+    else
+      IupAppend(box, bench_label());
+  }
+
+  return box;
+}
+
+static void bench_set_title(int i, int loop)
+{
+  char title[50];
+  sprintf(title, "Label %d", loop % 1000);
+  IupSetStrAttribute(labels[i], "TITLE", title);
+}
+
+int main(int argc, char **argv)
+{
+  Ihandle *dlg;
+  clock_t start;
+  int l, i, map = (argc > 1 && strcmp(argv[1], "-map") == 0);
+
+  IupOpen(&argc, &argv);
+
+  dlg = IupDialog(bench_box(0));
+  if (map)
+    IupMap(dlg);
+
+  printf("%d labels, depth %d%s\n", label_count, BENCH_DEPTH + 1, map ? ", mapped" : "");
+
+  start = clock();
+  IupRefresh(dlg);
+  bench_report("first refresh", bench_seconds(start), 1);
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS; l++)
+  {
+    i = (l * 7919) % label_count;
+    bench_set_title(i, l);
+    IupRefresh(labels[i]);
+  }
+  bench_report("one label changed", bench_seconds(start), BENCH_LOOPS);
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS / 10; l++)
+    IupRefresh(dlg);  /* the dialog computes the whole tree */
+  bench_report("whole tree", bench_seconds(start), BENCH_LOOPS / 10);
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS / 10; l++)
+  {
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+      int j = ((l * BENCH_BATCH + i) * 7919) % label_count;
+      bench_set_title(j, l);
+      IupRefresh(labels[j]);
+    }
+  }
+  bench_report("50 labels, refresh each", bench_seconds(start), BENCH_LOOPS / 10);
+
+  start = clock();
+  for (l = 0; l < BENCH_LOOPS / 10; l++)
+  {
+    IupRefreshBegin(dlg);
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+      int j = ((l * BENCH_BATCH + i) * 7919) % label_count;
+      bench_set_title(j, l + 1);
+      IupRefresh(labels[j]);
+    }
+    IupRefreshEnd(dlg);
+  }
+  bench_report("50 labels, IupRefreshBegin/End", bench_seconds(start), BENCH_LOOPS / 10);
+
+  IupDestroy(dlg);
+  free(labels);
+  IupClose();
+  return 0;
+}
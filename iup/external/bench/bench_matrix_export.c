@@ -0,0 +1,66 @@
+/* MatrixEx export time.
+ *
+ * Fills a mapped IupMatrixEx with text and numeric columns
+ * and exports it to a file with COPYFILE in each FILEFORMAT.
+ *
+ * Usage: bench_matrix_export [count] [filename]
+ *   count     number of lines, default is 1000000.
+ *   filename  exported file, default is "bench_matrix_export.out".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "iup.h"
+#include "iupcontrols.h"
+#include "bench_util.h"
+
+static double bench_export(Ihandle* mat, const char* format, const char* filename)
+{
+  double start;
+  IupSetStrAttribute(mat, "FILEFORMAT", format);
+  start = bench_now();
+  IupSetStrAttribute(mat, "COPYFILE", filename);
+  return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+  static const char* formats[] = { "TXT", "CSV", "HTML", "LaTeX" };
+  const char* filename = "bench_matrix_export.out";
+  Ihandle *mat, *dlg;
+  int count, lin, i;
+
+  count = bench_get_count(argc, argv, 1000000, 1);
+  if (argc > 2)
+    filename = argv[2];
+
+  IupOpen(&argc, &argv);
+  IupControlsOpen();
+
+  mat = IupMatrixEx();
+  IupSetInt(mat, "NUMLIN", count);
+  IupSetInt(mat, "NUMCOL", 4);
+  IupSetAttributeId(mat, "STORAGE", 3, "DOUBLE");
+  dlg = bench_map_dialog(mat);
+
+  IupSetAttribute(mat, "BULKLOAD", "Yes");
+  for (lin = 1; lin <= count; lin++)
+  {
+    IupSetStrfId2(mat, "", lin, 1, "item%d", lin);
+    IupSetStrfId2(mat, "", lin, 2, "text, with \"quotes\" %d", lin % 100);
+    IupSetStrfId2(mat, "", lin, 3, "%.3f", lin / 7.0);
+    IupSetStrfId2(mat, "", lin, 4, "%d", lin % 1000);
+  }
+  IupSetAttribute(mat, "BULKLOAD", "No");
+
+  printf("%d lines\n", count);
+
+  for (i = 0; i < 4; i++)
+    bench_report_ms(formats[i], bench_export(mat, formats[i], filename));
+
+  remove(filename);
+
+  IupDestroy(dlg);
+  IupClose();
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* MatrixEx find time.
+ *
+ * Fills a mapped IupMatrixEx with text and numeric columns, then
+ * compares FIND scanning the cells with FINDALL in the background
+ * followed by FIND over the FINDALL result.
+ *
+ * Usage: bench_matrix_find [count]
+ *   count  number of lines, default is 1000000.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "iup.h"
+#include "iupcontrols.h"
+#include "bench_util.h"
+
+static double bench_find_next(Ihandle* mat, const char* text, int times)
+{
+  double start;
+  int i;
+  IupSetAttribute(mat, "FOCUSCELL", "1:1");
+  start = bench_now();
+  for (i = 0; i < times; i++)
+    IupSetStrAttribute(mat, "FIND", text);
+  return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+  const char* text = "match";
+  Ihandle *mat, *dlg;
+  int count, lin;
+  double start;
+
+  count = bench_get_count(argc, argv, 1000000, 1);
+
+  IupOpen(&argc, &argv);
+  IupControlsOpen();
+
+  mat = IupMatrixEx();
+  IupSetInt(mat, "NUMLIN", count);
+  IupSetInt(mat, "NUMCOL", 4);
+  IupSetAttributeId(mat, "STORAGE", 3, "DOUBLE");
+  IupSetAttribute(mat, "MARKMODE", "CELL");
+  IupSetAttribute(mat, "MARKMULTIPLE", "Yes");
+  IupSetAttribute(mat, "FINDMATCHWHOLECELL", "No");
+  IupSetAttribute(mat, "FINDMATCHCASE", "No");
+  dlg = bench_map_dialog(mat);
+
+  /* a few matches, spread over the whole matrix */
+  IupSetAttribute(mat, "BULKLOAD", "Yes");
+  for (lin = 1; lin <= count; lin++)
+  {
+    if (lin % 10000 == 0)
+      IupSetStrfId2(mat, "", lin, 1, "Match%d", lin);
+    else
+      IupSetStrfId2(mat, "", lin, 1, "item%d", lin);
+    IupSetStrfId2(mat, "", lin, 2, "text %d", lin % 100);
+    IupSetStrfId2(mat, "", lin, 3, "%.3f", lin / 7.0);
+    IupSetStrfId2(mat, "", lin, 4, "%d", lin % 1000);
+  }
+  IupSetAttribute(mat, "BULKLOAD", "No");
+
+  printf("%d lines, %d matches\n", count, count / 10000);
+
+  bench_report_ms("FIND x10 (scan)", bench_find_next(mat, text, 10));
+
+  start = bench_now();
+  IupSetStrAttribute(mat, "FINDALL", text);
+  bench_report_ms("FINDALL (main thread)", bench_now() - start);
+  while (IupGetInt(mat, "FINDALLRUNNING"))
+    IupLoopStepWait();
+  bench_report_ms("FINDALL (finished)", bench_now() - start);
+  printf("  MATCHCOUNT=%s\n", IupGetAttribute(mat, "MATCHCOUNT"));
+
+  bench_report_ms("FIND x10 (FINDALL result)", bench_find_next(mat, text, 10));
+
+  IupDestroy(dlg);
+  IupClose();
+  return 0;
+}
@@ -0,0 +1,72 @@
+/* Matrix load time.
+ *
+ * Appends lines one at a time to a mapped IupMatrix with ADDLIN
+ * and sets the values of each new line, first without and then with BULKLOAD.
+ * Without BULKLOAD the matrix sizes are recalculated for every line.
+ *
+ * Usage: bench_matrix_load [count]
+ *   count  number of lines, default is 1000000.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "iup.h"
+#include "iupcontrols.h"
+#include "bench_util.h"
+
+static void bench_report(const char* title, int count, double secs)
+{
+  printf("  %-32s %8d lines %10.3f ms\n", title, count, secs * 1000.0);
+}
+
+static double bench_load(Ihandle* mat, int count, int bulk)
+{
+  double start = bench_now();
+  int lin;
+
+  IupSetAttribute(mat, "NUMLIN", "0");
+
+  if (bulk)
+    IupSetAttribute(mat, "BULKLOAD", "Yes");
+
+  for (lin = 1; lin <= count; lin++)
+  {
+    IupSetInt(mat, "ADDLIN", lin - 1);
+    IupSetStrfId2(mat, "", lin, 1, "item%d", lin);
+    IupSetStrfId2(mat, "", lin, 2, "%d", lin % 1000);
+    IupSetStrfId2(mat, "", lin, 3, "%.2f", lin / 100.0);
+  }
+
+  if (bulk)
+    IupSetAttribute(mat, "BULKLOAD", "No");
+
+  return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+  Ihandle *mat, *dlg;
+  int count, small;
+
+  count = bench_get_count(argc, argv, 1000000, 1);
+
+  /* without BULKLOAD the time is quadratic, use fewer lines */
+  small = count < 20000 ? count : 20000;
+
+  IupOpen(&argc, &argv);
+  IupControlsOpen();
+
+  mat = IupMatrix();
+  IupSetInt(mat, "NUMCOL", 3);
+  IupSetAttributeId(mat, "STORAGE", 2, "INT64");
+  IupSetAttributeId(mat, "STORAGE", 3, "DOUBLE");
+  dlg = bench_map_dialog(mat);
+
+  bench_report("ADDLIN", small, bench_load(mat, small, 0));
+  bench_report("ADDLIN with BULKLOAD", small, bench_load(mat, small, 1));
+  bench_report("ADDLIN with BULKLOAD", count, bench_load(mat, count, 1));
+
+  IupDestroy(dlg);
+  IupClose();
+  return 0;
+}
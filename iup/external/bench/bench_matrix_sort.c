@@ -0,0 +1,69 @@
+/* Matrix sort time.
+ *
+ * Fills a mapped IupMatrix with a text column, a numeric column
+ * and a column of names with numbers, then sorts the lines with SORTCOLUMN
+ * for each column and with SORTCOLUMNS by two and three columns.
+ * The keys of the sorted columns are extracted by several threads.
+ * The numeric column is stored as DOUBLE, see STORAGE.
+ *
+ * Usage: bench_matrix_sort [count]
+ *   count  number of lines, default is 500000.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "iup.h"
+#include "iupcontrols.h"
+#include "bench_util.h"
+
+static double bench_sort(Ihandle* mat, const char* name, int col, const char* value)
+{
+  double start;
+  IupSetAttributeId(mat, "SORTCOLUMN", 1, "RESET");
+  start = bench_now();
+  if (col)
+    IupSetAttributeId(mat, name, col, value);
+  else
+    IupSetAttribute(mat, name, value);
+  return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+  static const char* words[] = { "alpha", "Beta", "gamma", "Delta", "epsilon", "Zeta", "eta", "Theta" };
+  Ihandle *mat, *dlg;
+  int count, lin;
+
+  count = bench_get_count(argc, argv, 500000, 1);
+
+  IupOpen(&argc, &argv);
+  IupControlsOpen();
+
+  mat = IupMatrix();
+  IupSetInt(mat, "NUMLIN", count);
+  IupSetInt(mat, "NUMCOL", 3);
+  IupSetAttributeId(mat, "STORAGE", 2, "DOUBLE");
+  dlg = bench_map_dialog(mat);
+
+  IupSetAttributeId(mat, "NUMERICQUANTITYINDEX", 2, "0");
+
+  srand(1);
+  for (lin = 1; lin <= count; lin++)
+  {
+    IupSetStrAttributeId2(mat, "", lin, 1, words[rand() % 8]);
+    IupSetStrfId2(mat, "", lin, 2, "%.3f", (rand() % 100000) / 100.0);
+    IupSetStrfId2(mat, "", lin, 3, "item%d", rand() % 10000);
+  }
+
+  printf("%d lines\n", count);
+
+  bench_report_ms("SORTCOLUMN text", bench_sort(mat, "SORTCOLUMN", 1, "ALL"));
+  bench_report_ms("SORTCOLUMN numeric", bench_sort(mat, "SORTCOLUMN", 2, "ALL"));
+  bench_report_ms("SORTCOLUMN names with numbers", bench_sort(mat, "SORTCOLUMN", 3, "ALL"));
+  bench_report_ms("SORTCOLUMNS 1:DESC,2:ASC", bench_sort(mat, "SORTCOLUMNS", 0, "1:DESC,2:ASC"));
+  bench_report_ms("SORTCOLUMNS 1,3:DESC,2", bench_sort(mat, "SORTCOLUMNS", 0, "1,3:DESC,2"));
+
+  IupDestroy(dlg);
+  IupClose();
+  return 0;
+}
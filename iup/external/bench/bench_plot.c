@@ -0,0 +1,202 @@
+/* Plot sample loading time.
+ *
+ * Loads a large dataset into IupPlot one sample at a time,
+ * in chunks with IupPlotAddSamples, and without copying with
+ * IupPlotSetSamplesBuffer, both mapping and adopting the arrays.
+ * After each load the plot is drawn once with DRAWHEADLESS, which includes
+ * the data range used by the automatic axis limits.
+ *
+ * Then a streaming dataset limited by DS_MAXCOUNT receives new samples
+ * every frame, dropping the oldest ones, and is drawn again.
+ *
+ * The mouse is moved over the plot with a vertical crosshair, so only the
+ * crosshair is drawn over the recorded background and datasets layers.
+ *
+ * Finally IupPlotFindSample is called at random positions, as done when the
+ * mouse moves over the plot, for an ordered line and for a random scatter.
+ * The scatter is drawn with marks and as a density image.
+ *
+ * Usage: bench_plot [count]
+ *   count  number of samples, default is 10000000.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "iup.h"
+#include "iupcbs.h"
+#include "iupplot.h"
+#include "bench_util.h"
+
+#define BENCH_CHUNK 4096
+#define BENCH_STREAM_COUNT 100000
+#define BENCH_STREAM_FRAMES 200
+#define BENCH_STREAM_STEP 1000
+#define BENCH_FIND_COUNT 10000
+#define BENCH_MOTION_COUNT 100
+
+static void bench_report(const char* title, double load_secs, double draw_secs)
+{
+  printf("  %-32s %10.3f ms %10.3f ms\n", title, load_secs * 1000.0, draw_secs * 1000.0);
+}
+
+static void bench_fill(double* x, double* y, int count)
+{
+  int i;
+  for (i = 0; i < count; i++)
+  {
+    x[i] = i;
+    y[i] = sin(i * 0.001) + 0.1 * sin(i * 0.37);
+  }
+}
+
+static int bench_new_dataset(Ihandle* plot)
+{
+  IupSetAttribute(plot, "CLEAR", NULL);
+  IupPlotBegin(plot, 0);
+  return IupPlotEnd(plot);
+}
+
+static double bench_find(Ihandle* plot)
+{
+  double start = bench_now();
+  int i, ds, sample;
+  srand(1);
+  for (i = 0; i < BENCH_FIND_COUNT; i++)
+    IupPlotFindSample(plot, rand() % 800, rand() % 600, &ds, &sample);
+  return bench_now() - start;
+}
+
+static double bench_draw(Ihandle* plot)
+{
+  double start = bench_now();
+  IupSetAttribute(plot, "REDRAW", NULL);
+  return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+  Ihandle* plot;
+  double *x, *y, *ax, *ay, start, load_secs;
+  int count, ds, i;
+
+  count = bench_get_count(argc, argv, 10000000, BENCH_CHUNK);
+
+  IupOpen(&argc, &argv);
+  IupPlotOpen();
+
+  plot = IupPlot();
+  IupSetAttribute(plot, "RASTERSIZE", "800x600");
+  IupSetAttribute(plot, "DRAWHEADLESS", "YES");
+
+  x = (double*)malloc(count * sizeof(double));
+  y = (double*)malloc(count * sizeof(double));
+  bench_fill(x, y, count);
+
+  printf("%d samples%32s %13s\n", count, "load", "draw");
+
+  ds = bench_new_dataset(plot);
+  start = bench_now();
+  for (i = 0; i < count; i++)
+    IupPlotAddSamples(plot, ds, x + i, y + i, 1);
+  load_secs = bench_now() - start;
+  bench_report("one sample at a time", load_secs, bench_draw(plot));
+
+  ds = bench_new_dataset(plot);
+  start = bench_now();
+  for (i = 0; i < count; i += BENCH_CHUNK)
+    IupPlotAddSamples(plot, ds, x + i, y + i, (count - i < BENCH_CHUNK) ? count - i : BENCH_CHUNK);
+  load_secs = bench_now() - start;
+  bench_report("IupPlotAddSamples chunks", load_secs, bench_draw(plot));
+
+  ds = bench_new_dataset(plot);
+  start = bench_now();
+  IupPlotAddSamples(plot, ds, x, y, count);
+  load_secs = bench_now() - start;
+  bench_report("IupPlotAddSamples", load_secs, bench_draw(plot));
+
+  ds = bench_new_dataset(plot);
+  start = bench_now();
+  IupPlotSetSamplesBuffer(plot, ds, x, y, count, 0);
+  load_secs = bench_now() - start;
+  bench_report("IupPlotSetSamplesBuffer mapped", load_secs, bench_draw(plot));
+
+  /* the plot will free the adopted copies */
+  ax = (double*)malloc(count * sizeof(double));
+  ay = (double*)malloc(count * sizeof(double));
+  memcpy(ax, x, count * sizeof(double));
+  memcpy(ay, y, count * sizeof(double));
+  ds = bench_new_dataset(plot);
+  start = bench_now();
+  IupPlotSetSamplesBuffer(plot, ds, ax, ay, count, 1);
+  load_secs = bench_now() - start;
+  bench_report("IupPlotSetSamplesBuffer adopted", load_secs, bench_draw(plot));
+
+  /* 1 kHz telemetry drawn at 1 frame per second */
+  ds = bench_new_dataset(plot);
+  IupSetInt(plot, "DS_MAXCOUNT", BENCH_STREAM_COUNT);
+  load_secs = 0;
+  start = bench_now();
+  for (i = 0; i < BENCH_STREAM_FRAMES; i++)
+  {
+    double load_start = bench_now();
+    int j;
+    for (j = 0; j < BENCH_STREAM_STEP; j++)
+    {
+      double sx = (double)i * BENCH_STREAM_STEP + j;
+      double sy = sin(sx * 0.001) + 0.1 * sin(sx * 0.37);
+      IupPlotAddSamples(plot, ds, &sx, &sy, 1);
+    }
+    load_secs += bench_now() - load_start;
+    IupSetAttribute(plot, "REDRAW", NULL);
+  }
+  printf("DS_MAXCOUNT=%d, %d samples per frame\n", BENCH_STREAM_COUNT, BENCH_STREAM_STEP);
+  bench_report("streaming", load_secs / BENCH_STREAM_FRAMES, (bench_now() - start - load_secs) / BENCH_STREAM_FRAMES);
+
+  ds = bench_new_dataset(plot);
+  IupPlotAddSamples(plot, ds, x, y, count);
+  IupSetAttribute(plot, "SHOWCROSSHAIR", "VERTICAL");
+  bench_draw(plot);
+  {
+    IFniis motion_cb = (IFniis)IupGetCallback(plot, "MOTION_CB");
+    char status[] = "          ";
+    start = bench_now();
+    for (i = 0; i < BENCH_MOTION_COUNT; i++)
+      motion_cb(plot, 100 + i * 6, 300, status);
+    printf("%d x crosshair motion\n", BENCH_MOTION_COUNT);
+    bench_report("crosshair", 0, (bench_now() - start) / BENCH_MOTION_COUNT);
+  }
+  IupSetAttribute(plot, "SHOWCROSSHAIR", "NONE");
+
+  printf("%d x IupPlotFindSample\n", BENCH_FIND_COUNT);
+
+  ds = bench_new_dataset(plot);
+  IupPlotAddSamples(plot, ds, x, y, count);
+  bench_draw(plot);
+  bench_report("ordered line", bench_find(plot), 0);
+
+  for (i = 0; i < count; i++)
+  {
+    x[i] = rand() % 100000;
+    y[i] = rand() % 100000;
+  }
+  ds = bench_new_dataset(plot);
+  IupSetAttribute(plot, "DS_MODE", "MARK");
+  IupPlotAddSamples(plot, ds, x, y, count);
+  bench_draw(plot);
+  load_secs = bench_find(plot);  /* includes building the index */
+  bench_report("scatter, first time", load_secs, 0);
+  bench_report("scatter", bench_find(plot), 0);
+
+  printf("scatter drawing\n");
+  bench_report("MARK", 0, bench_draw(plot));
+  IupSetAttribute(plot, "DS_MODE", "DENSITY");
+  bench_report("DENSITY", 0, bench_draw(plot));
+
+  free(x);
+  free(y);
+  IupDestroy(plot);
+  IupClose();
+  return 0;
+}
@@ -0,0 +1,108 @@
+/* Plot data file loading throughput.
+ *
+ * Writes a text file with an X column and two Y columns, then loads it
+ * with IupPlotLoadData, which parses large files in blocks using several threads.
+ * The loaded datasets are saved with IupPlotSaveData in the binary format
+ * and in text format, and the binary file is loaded again.
+ * The throughput is reported in MB/s of the file size.
+ *
+ * Usage: bench_plot_load [count]
+ *   count  number of samples, default is 5000000.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "iup.h"
+#include "iupplot.h"
+#include "bench_util.h"
+
+#define BENCH_TEXT_FILE "bench_plot_load.txt"
+#define BENCH_TEXT_SAVE_FILE "bench_plot_load_save.txt"
+#define BENCH_BINARY_FILE "bench_plot_load.bin"
+
+static double bench_file_size(const char* filename)
+{
+  double size;
+  FILE* file = fopen(filename, "rb");
+  if (!file)
+    return 0;
+  fseek(file, 0, SEEK_END);
+  size = (double)ftell(file);
+  fclose(file);
+  return size;
+}
+
+static void bench_report(const char* title, const char* filename, double secs)
+{
+  double mb = bench_file_size(filename) / (1024.0 * 1024.0);
+  printf("  %-24s %10.1f MB %10.3f ms %10.1f MB/s\n", title, mb, secs * 1000.0, secs > 0 ? mb / secs : 0);
+}
+
+static int bench_write_text(int count)
+{
+  int i;
+  FILE* file = fopen(BENCH_TEXT_FILE, "w");
+  if (!file)
+    return 0;
+
+  fprintf(file, "# x y1 y2\n");
+  for (i = 0; i < count; i++)
+    fprintf(file, "%d %.6f %.6e\n", i, sin(i * 0.001), 1000.0 * cos(i * 0.37));
+
+  fclose(file);
+  return 1;
+}
+
+static double bench_load(Ihandle* plot, const char* filename)
+{
+  double start;
+  IupSetAttribute(plot, "CLEAR", NULL);
+  start = bench_now();
+  if (!IupPlotLoadData(plot, filename, 0))
+    printf("  failed to load %s\n", filename);
+  return bench_now() - start;
+}
+
+static double bench_save(Ihandle* plot, const char* filename, int binary)
+{
+  double start = bench_now();
+  if (!IupPlotSaveData(plot, filename, binary))
+    printf("  failed to save %s\n", filename);
+  return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+  Ihandle* plot;
+  int count;
+
+  count = bench_get_count(argc, argv, 5000000, 1);
+
+  IupOpen(&argc, &argv);
+  IupPlotOpen();
+
+  plot = IupPlot();
+
+  if (!bench_write_text(count))
+  {
+    printf("failed to write %s\n", BENCH_TEXT_FILE);
+    return 1;
+  }
+
+  printf("%d samples, 2 datasets\n", count);
+
+  bench_report("load text", BENCH_TEXT_FILE, bench_load(plot, BENCH_TEXT_FILE));
+  bench_report("save binary", BENCH_BINARY_FILE, bench_save(plot, BENCH_BINARY_FILE, 1));
+  bench_report("save text", BENCH_TEXT_SAVE_FILE, bench_save(plot, BENCH_TEXT_SAVE_FILE, 0));
+  bench_report("load binary", BENCH_BINARY_FILE, bench_load(plot, BENCH_BINARY_FILE));
+  bench_report("load saved text", BENCH_TEXT_SAVE_FILE, bench_load(plot, BENCH_TEXT_SAVE_FILE));
+
+  remove(BENCH_TEXT_FILE);
+  remove(BENCH_TEXT_SAVE_FILE);
+  remove(BENCH_BINARY_FILE);
+
+  IupDestroy(plot);
+  IupClose();
+  return 0;
+}
@@ -0,0 +1,60 @@
+/* Helpers shared by the benchmark programs.
+ *
+ * A wall clock timer, the line or sample count read from the command line
+ * and a mapped dialog for the controls that only work when mapped.
+ * The functions are inline, so each program only gets the ones it uses.
+ */
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+#include "iup.h"
+
+/* seconds, wall clock because the measured code may use several threads */
+static inline double bench_now(void)
+{
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+/* first command line argument, or def when not given, at least min */
+static inline int bench_get_count(int argc, char **argv, int def, int min)
+{
+  int count = def;
+  if (argc > 1)
+    count = atoi(argv[1]);
+  if (count < min)
+    count = min;
+  return count;
+}
+
+/* prints a single time in milliseconds */
+static inline void bench_report_ms(const char* title, double secs)
+{
+  printf("  %-32s %10.3f ms\n", title, secs * 1000.0);
+}
+
+/* creates and maps a dialog with the given element, returns the dialog */
+static inline Ihandle* bench_map_dialog(Ihandle* child)
+{
+  Ihandle* dlg = IupDialog(child);
+  IupMap(dlg);
+  return dlg;
+}
+
+#endif
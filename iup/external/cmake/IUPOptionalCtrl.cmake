@@ -34,6 +34,12 @@ target_include_directories(iupctrl
 target_compile_definitions(iupctrl PRIVATE IUPCONTROLS_BUILD_LIBRARY)
 target_link_libraries(iupctrl PUBLIC IUP::iup)
 
+# Worker threads that extract the sort keys of large matrices (iupmat_sort.c)
+if(NOT WIN32 AND NOT EMSCRIPTEN)
+  find_package(Threads REQUIRED)
+  target_link_libraries(iupctrl PRIVATE Threads::Threads)
+endif()
+
 set_target_properties(iupctrl PROPERTIES
   VERSION ${PROJECT_VERSION}
   SOVERSION ${PROJECT_VERSION_MAJOR}
@@ -24,6 +24,12 @@ target_include_directories(iupplot
 target_compile_definitions(iupplot PRIVATE IUPPLOT_BUILD_LIBRARY)
 target_link_libraries(iupplot PUBLIC IUP::iup)
 
+# Worker threads that transform large datasets (iupPlotAxis.cpp)
+if(NOT WIN32 AND NOT EMSCRIPTEN)
+  find_package(Threads REQUIRED)
+  target_link_libraries(iupplot PRIVATE Threads::Threads)
+endif()
+
 set_target_properties(iupplot PROPERTIES
   VERSION ${PROJECT_VERSION}
   SOVERSION ${PROJECT_VERSION_MAJOR}
@@ -53,6 +53,8 @@ IUP_API void      IupUpdateChildren(Ihandle* ih);
 IUP_API void      IupRedraw(Ihandle* ih, int children);
 IUP_API void      IupRefresh(Ihandle* ih);
 IUP_API void      IupRefreshChildren(Ihandle* ih);
+IUP_API void      IupRefreshBegin(Ihandle* ih);
+IUP_API void      IupRefreshEnd(Ihandle* ih);
 
 IUP_API int       IupExecute(const char* filename, const char* parameters);
 IUP_API int       IupExecuteWait(const char* filename, const char* parameters);
@@ -145,6 +147,11 @@ IUP_API float     IupGetFloatId2(Ihandle* ih, const char* name, int lin, int col
 IUP_API double    IupGetDoubleId2(Ihandle* ih, const char* name, int lin, int col);
 IUP_API void      IupGetRGBId2(Ihandle* ih, const char* name, int lin, int col, unsigned char* r, unsigned char* g, unsigned char* b);
 
+IUP_API int       IupGetAtom(const char* name);
+IUP_API void      IupSetAttributeAtom(Ihandle* ih, int atom, const char* value);
+IUP_API void      IupSetStrAttributeAtom(Ihandle* ih, int atom, const char* value);
+IUP_API char*     IupGetAttributeAtom(Ihandle* ih, int atom);
+
 IUP_API void      IupSetGlobal(const char* name, const char* value);
 IUP_API void      IupSetStrGlobal(const char* name, const char* value);
 IUP_API char*     IupGetGlobal(const char* name);
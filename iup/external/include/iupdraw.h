@@ -14,6 +14,7 @@ extern "C" {
 /* all functions can be used only in IUP canvas and inside the ACTION callback */
 
 IUP_API void IupDrawBegin(Ihandle* ih);
+IUP_API void IupDrawBeginRect(Ihandle* ih, int x1, int y1, int x2, int y2);
 IUP_API void IupDrawEnd(Ihandle* ih);
 
 /* all functions can be called only between calls to Begin and End */
@@ -33,6 +34,7 @@ IUP_API void IupDrawRoundedRectangle(Ihandle* ih, int x1, int y1, int x2, int y2
 IUP_API void IupDrawArc(Ihandle* ih, int x1, int y1, int x2, int y2, double a1, double a2);
 IUP_API void IupDrawEllipse(Ihandle* ih, int x1, int y1, int x2, int y2);
 IUP_API void IupDrawPolygon(Ihandle* ih, int* points, int count);
+IUP_API void IupDrawPolyline(Ihandle* ih, int* points, int count);
 IUP_API void IupDrawPixel(Ihandle* ih, int x, int y);
 IUP_API void IupDrawBezier(Ihandle* ih, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4);
 IUP_API void IupDrawQuadraticBezier(Ihandle* ih, int x1, int y1, int x2, int y2, int x3, int y3);
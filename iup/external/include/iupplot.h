@@ -41,6 +41,7 @@ IUPPLOT_API void IupPlotAddSegment(Ihandle *ih, double x, double y);
 IUPPLOT_API int  IupPlotEnd(Ihandle *ih);
 
 IUPPLOT_API int  IupPlotLoadData(Ihandle* ih, const char* filename, int strXdata);
+IUPPLOT_API int  IupPlotSaveData(Ihandle* ih, const char* filename, int binary);
 
 IUPPLOT_API void IupPlotInsert(Ihandle *ih, int ds_index, int sample_index, double x, double y);
 IUPPLOT_API void IupPlotInsertStr(Ihandle *ih, int ds_index, int sample_index, const char* x, double y);
@@ -51,6 +52,7 @@ IUPPLOT_API void IupPlotInsertSamples(Ihandle* ih, int ds_index, int sample_inde
 
 IUPPLOT_API void IupPlotAddSamples(Ihandle* ih, int ds_index, double *x, double *y, int count);
 IUPPLOT_API void IupPlotAddStrSamples(Ihandle* ih, int ds_index, const char** x, double* y, int count);
+IUPPLOT_API int  IupPlotSetSamplesBuffer(Ihandle* ih, int ds_index, double *x, double *y, int count, int own_buffer);
 
 IUPPLOT_API void IupPlotGetSample(Ihandle* ih, int ds_index, int sample_index, double *x, double *y);
 IUPPLOT_API void IupPlotGetSampleStr(Ihandle* ih, int ds_index, int sample_index, const char* *x, double *y);
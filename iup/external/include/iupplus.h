@@ -976,6 +976,7 @@ namespace Iup
     int End() { return IupPlotEnd(ih); }
 
     int LoadData(const char* filename, int strXdata) { return IupPlotLoadData(ih, filename, strXdata); }
+    int SaveData(const char* filename, int binary) { return IupPlotSaveData(ih, filename, binary); }
 
     void Insert(int ds_index, int sample_index, double x, double y) { IupPlotInsert(ih, ds_index, sample_index, x, y); }
     void InsertStr(int ds_index, int sample_index, const char* x, double y) { IupPlotInsertStr(ih, ds_index, sample_index, x, y); }
@@ -986,6 +987,7 @@ namespace Iup
 
     void AddSamples(int ds_index, double *x, double *y, int count) { IupPlotAddSamples(ih, ds_index, x, y, count); }
     void AddStrSamples(int ds_index, const char** x, double* y, int count) { IupPlotAddStrSamples(ih, ds_index, x, y, count); }
+    int SetSamplesBuffer(int ds_index, double *x, double *y, int count, int own_buffer) { return IupPlotSetSamplesBuffer(ih, ds_index, x, y, count, own_buffer); }
 
     void GetSample(int ds_index, int sample_index, double &x, double &y) { IupPlotGetSample(ih, ds_index, sample_index, &x, &y); }
     void GetSampleStr(int ds_index, int sample_index, const char* &x, double &y) { IupPlotGetSampleStr(ih, ds_index, sample_index, &x, &y); }
@@ -186,6 +186,21 @@ void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long color, int
   (*jni_env)->DeleteLocalRef(jni_env, java_class);
 }
 
+void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  if (!dc || !dc->ih->handle || count < 2) return;
+  JNIEnv* jni_env = iupAndroid_GetEnvThreadSafe();
+  jclass java_class = androidDrawFindHelper(jni_env);
+  jmethodID method_id = (*jni_env)->GetStaticMethodID(jni_env, java_class, "drawPolyline", "(Lio/github/gen2brain/iupgo/IupAndroidCanvas;[IIII)V");
+
+  jintArray arr = (*jni_env)->NewIntArray(jni_env, count * 2);
+  (*jni_env)->SetIntArrayRegion(jni_env, arr, 0, count * 2, (const jint*)points);
+  (*jni_env)->CallStaticVoidMethod(jni_env, java_class, method_id, dc->ih->handle, arr, (jint)androidPackColor(color), (jint)style, (jint)line_width);
+  iupAndroid_CheckException(jni_env, "IupCanvasHelper.drawPolyline");
+  (*jni_env)->DeleteLocalRef(jni_env, arr);
+  (*jni_env)->DeleteLocalRef(jni_env, java_class);
+}
+
 void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   if (!dc || !dc->ih->handle) return;
@@ -502,6 +502,27 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
     CGContextStrokePath(cg_context);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  CGContextRef cg_context = dc->cgContext;
+  CGColorRef the_color;
+
+  if (count < 2)
+    return;
+
+  the_color = iupCocoaDrawCreateColor(color);
+  CGContextSetStrokeColorWithColor(cg_context, the_color);
+  CGContextSetLineWidth(cg_context, (CGFloat)line_width);
+  iupCocoaSetLineStyle(cg_context, style);
+
+  CGContextBeginPath(cg_context);
+  CGContextMoveToPoint(cg_context, (CGFloat)points[0], (CGFloat)points[1]);
+  for (int i = 1; i < count; i++)
+    CGContextAddLineToPoint(cg_context, (CGFloat)points[2*i], (CGFloat)points[2*i+1]);
+
+  CGContextStrokePath(cg_context);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   CGContextRef cg_context = dc->cgContext;
@@ -482,6 +482,23 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
 		CGContextStrokePath(dc->cgContext);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+	if (!dc || count < 2) return;
+
+	cocoaTouchDrawSetStrokeColor(dc->cgContext, color);
+	CGContextSetLineWidth(dc->cgContext, (CGFloat)line_width);
+	cocoaTouchDrawSetLineStyle(dc->cgContext, style);
+
+	CGContextBeginPath(dc->cgContext);
+	CGContextMoveToPoint(dc->cgContext, (CGFloat)points[0], (CGFloat)points[1]);
+	for (int i = 1; i < count; i++)
+	{
+		CGContextAddLineToPoint(dc->cgContext, (CGFloat)points[2*i], (CGFloat)points[2*i + 1]);
+	}
+	CGContextStrokePath(dc->cgContext);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
 	if (!dc) return;
@@ -800,6 +800,31 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
   dc->shapes = eina_list_append(dc->shapes, shape);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  Efl_VG* shape;
+  int r, g, b, a;
+  int i;
+
+  if (count < 2)
+    return;
+
+  iDrawGetColor(color, &r, &g, &b, &a);
+
+  shape = efl_add(EFL_CANVAS_VG_SHAPE_CLASS, dc->root,
+    efl_gfx_path_append_move_to(efl_added, points[0], points[1]));
+
+  for (i = 1; i < count; i++)
+    efl_gfx_path_append_line_to(shape, points[i * 2], points[i * 2 + 1]);
+
+  efl_gfx_shape_stroke_color_set(shape, r, g, b, a);
+  efl_gfx_shape_stroke_width_set(shape, line_width > 0 ? line_width : 1);
+  efl_gfx_shape_stroke_cap_set(shape, EFL_GFX_CAP_BUTT);
+  iDrawSetDash(shape, style);
+
+  dc->shapes = eina_list_append(dc->shapes, shape);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   iupdrvDrawRectangle(dc, x, y, x, y, color, IUP_DRAW_FILL, 1);
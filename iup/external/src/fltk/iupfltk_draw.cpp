@@ -308,6 +308,19 @@ extern "C" IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int
   }
 }
 
+extern "C" IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  if (!dc || count < 2) return;
+
+  fltkDrawSetColor(color);
+  fltkDrawSetLineStyle(style, line_width);
+
+  fl_begin_line();
+  for (int i = 0; i < count; i++)
+    fl_vertex(points[2 * i], points[2 * i + 1]);
+  fl_end_line();
+}
+
 extern "C" IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   if (!dc) return;
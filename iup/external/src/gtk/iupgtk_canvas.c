@@ -11,6 +11,7 @@
 #endif
 
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 #include <memory.h>
 #include <stdarg.h>
@@ -26,6 +27,8 @@
 #include "iup_drv.h"
 #include "iup_drvinfo.h"
 #include "iup_canvas.h"
+#include "iup_drvdraw.h"
+#include "iup_draw.h"
 #include "iup_key.h"
 
 #include "iupgtk_drv.h"
@@ -372,14 +375,12 @@ static gboolean gtkCanvasExposeEvent(GtkWidget *widget, GdkEventExpose *evt, Iha
 
     if (buffer)
     {
-      GdkRectangle rect;
-      gdk_cairo_get_clip_rectangle(cr, &rect);
-
       int buf_w = cairo_image_surface_get_width(buffer);
       int buf_h = cairo_image_surface_get_height(buffer);
 
-      /* If buffer exists and matches size, use it instead of calling ACTION */
-      if (buf_w == rect.width && buf_h == rect.height)
+      /* If buffer exists and matches size, use it instead of calling ACTION,
+         partial exposes are also served from the buffer (cairo is already clipped to the exposed area) */
+      if (buf_w == gtk_widget_get_allocated_width(widget) && buf_h == gtk_widget_get_allocated_height(widget))
       {
         cairo_set_source_surface(cr, buffer, 0, 0);
         cairo_paint(cr);
@@ -863,6 +864,31 @@ static char* gtkCanvasGetDrawSizeAttrib(Ihandle *ih)
     return NULL;
 }
 
+static int gtkCanvasSetUpdateRectAttrib(Ihandle* ih, const char* value)
+{
+  int x1, y1, x2, y2;
+
+  if (!ih->handle)
+    return 0;
+
+  if (!value || sscanf(value, "%d %d %d %d", &x1, &y1, &x2, &y2) != 4)
+  {
+    iupdrvPostRedraw(ih);
+    return 0;
+  }
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+#if GTK_CHECK_VERSION(3, 0, 0)
+  /* the damaged area must be redrawn by ACTION, and not copied from the persistent buffer */
+  iupAttribSet(ih, "_IUPGTK3_BUFFER_DIRTY", NULL);
+#endif
+
+  gtk_widget_queue_draw_area(ih->handle, x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+  return 0;
+}
+
 static char* gtkCanvasGetDrawableAttrib(Ihandle* ih)
 {
   return (char*)iupgtkGetWindow(ih->handle);
@@ -1271,6 +1297,7 @@ IUP_SDK_API void iupdrvCanvasInitClass(Iclass* ic)
 
   /* IupCanvas only */
   iupClassRegisterAttribute(ic, "DRAWSIZE", gtkCanvasGetDrawSizeAttrib, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "UPDATERECT", NULL, gtkCanvasSetUpdateRectAttrib, NULL, NULL, IUPAF_WRITEONLY|IUPAF_NO_INHERIT);
 
   iupClassRegisterAttribute(ic, "DX", NULL, gtkCanvasSetDXAttrib, NULL, NULL, IUPAF_NO_INHERIT);  /* force new default value */
   iupClassRegisterAttribute(ic, "DY", NULL, gtkCanvasSetDYAttrib, NULL, NULL, IUPAF_NO_INHERIT);  /* force new default value */
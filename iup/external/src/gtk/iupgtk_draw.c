@@ -37,32 +37,84 @@ struct _IdrawCanvas
 #endif
 
   int clip_x1, clip_y1, clip_x2, clip_y2;
+
+  /* damaged region, only this area is cleared, drawn and flushed */
+  int damage_x, damage_y, damage_w, damage_h;
+
+  int retained;  /* the target still has the previous frame */
 };
 
-IUP_SDK_API IdrawCanvas* iupdrvDrawCreateCanvas(Ihandle* ih)
+static void iDrawInitDamage(IdrawCanvas* dc)
 {
-  IdrawCanvas* dc = calloc(1, sizeof(IdrawCanvas));
-  cairo_surface_t* surface;
-  cairo_surface_t* buffer;
+  int x1, y1, x2, y2;
+  char* value = iupAttribGet(dc->ih, "_IUP_DRAW_UPDATERECT");
 
-  dc->ih = ih;
+  dc->damage_x = 0;
+  dc->damage_y = 0;
+  dc->damage_w = dc->w;
+  dc->damage_h = dc->h;
 
-  dc->widget = (GtkWidget*)IupGetAttribute(ih, "WID");
+  if (!dc->retained)
+  {
+    /* the whole target must be drawn, so the update rectangle can not be used */
+    iupAttribSet(dc->ih, "_IUP_DRAW_UPDATERECT", NULL);
+    value = NULL;
+  }
 
-#if !GTK_CHECK_VERSION(3, 0, 0)
-  dc->wnd = (GdkWindow*)IupGetAttribute(ih, "DRAWABLE");
-  gdk_window_get_geometry(dc->wnd, NULL, NULL, &dc->w, &dc->h, NULL);
-#else
-  dc->w = gtk_widget_get_allocated_width(dc->widget);
-  dc->h = gtk_widget_get_allocated_height(dc->widget);
+  /* an empty rectangle (x2<x1 or y2<y1) means nothing changed */
+  if (value && sscanf(value, "%d %d %d %d", &x1, &y1, &x2, &y2) == 4)
+  {
+    dc->damage_x = x1;
+    dc->damage_y = y1;
+    dc->damage_w = x2 - x1 + 1;
+    dc->damage_h = y2 - y1 + 1;
+  }
+#if GTK_CHECK_VERSION(3, 0, 0)
+  else if (!dc->release_cr && dc->retained)
+  {
+    /* inside the ACTION callback only the exposed area needs to be redrawn */
+    GdkRectangle rect;
+    if (gdk_cairo_get_clip_rectangle(dc->cr, &rect))
+    {
+      dc->damage_x = rect.x;
+      dc->damage_y = rect.y;
+      dc->damage_w = rect.width;
+      dc->damage_h = rect.height;
+    }
+  }
 #endif
 
+  if (dc->damage_x < 0) { dc->damage_w += dc->damage_x; dc->damage_x = 0; }
+  if (dc->damage_y < 0) { dc->damage_h += dc->damage_y; dc->damage_y = 0; }
+  if (dc->damage_x + dc->damage_w > dc->w) dc->damage_w = dc->w - dc->damage_x;
+  if (dc->damage_y + dc->damage_h > dc->h) dc->damage_h = dc->h - dc->damage_y;
+  if (dc->damage_w < 0) dc->damage_w = 0;
+  if (dc->damage_h < 0) dc->damage_h = 0;
+}
+
+static int iDrawIsFullDamage(IdrawCanvas* dc)
+{
+  return dc->damage_x == 0 && dc->damage_y == 0 && dc->damage_w == dc->w && dc->damage_h == dc->h;
+}
+
+static void iDrawClipDamage(IdrawCanvas* dc, cairo_t* cr)
+{
+  if (iDrawIsFullDamage(dc))
+    return;
+
+  cairo_new_path(cr);
+  cairo_rectangle(cr, dc->damage_x, dc->damage_y, dc->damage_w, dc->damage_h);
+  cairo_clip(cr);
+}
+
 #if GTK_CHECK_VERSION(3, 0, 0)
-  /* Check if we have persistent offscreen buffer */
-  buffer = (cairo_surface_t*)iupAttribGet(ih, "_IUPGTK3_CANVAS_BUFFER");
+static cairo_surface_t* gtkDrawGetBuffer(IdrawCanvas* dc)
+{
+  /* The persistent offscreen buffer is also the back buffer of the draw canvas,
+     it is reused across frames and recreated only when the size changes */
+  cairo_surface_t* buffer = (cairo_surface_t*)iupAttribGet(dc->ih, "_IUPGTK3_CANVAS_BUFFER");
   if (buffer)
   {
-    /* Check if size changed - recreate buffer if needed */
     int buf_w = cairo_image_surface_get_width(buffer);
     int buf_h = cairo_image_surface_get_height(buffer);
     if (buf_w != dc->w || buf_h != dc->h)
@@ -72,33 +124,82 @@ IUP_SDK_API IdrawCanvas* iupdrvDrawCreateCanvas(Ihandle* ih)
     }
   }
 
-  /* Create new buffer if needed */
   if (!buffer)
   {
     buffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dc->w, dc->h);
-    iupAttribSet(ih, "_IUPGTK3_CANVAS_BUFFER", (char*)buffer);
+    iupAttribSet(dc->ih, "_IUPGTK3_CANVAS_BUFFER", (char*)buffer);
+    iupAttribSet(dc->ih, "_IUPGTK3_BUFFER_DIRTY", NULL);
   }
+  else
+    dc->retained = 1;
+
+  return buffer;
+}
+
+static void gtkDrawInitImage(IdrawCanvas* dc)
+{
+  cairo_surface_t* buffer = gtkDrawGetBuffer(dc);
+  dc->image_cr = cairo_create(buffer);
+
+  iDrawInitDamage(dc);
+  iDrawClipDamage(dc, dc->image_cr);
+
+  if (!dc->release_cr)
+  {
+    /* inside ACTION the damaged area will be fully redrawn, so clear only that area */
+    cairo_save(dc->image_cr);
+    cairo_set_operator(dc->image_cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(dc->image_cr);
+    cairo_restore(dc->image_cr);
+  }
+}
+#else
+static void gtkDrawInitImage(IdrawCanvas* dc)
+{
+  /* Create image surface for double-buffering the current operation */
+  cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dc->w, dc->h);
+  dc->image_cr = cairo_create(surface);
+  cairo_surface_destroy(surface);
+
+  /* outside ACTION the window keeps what was drawn before */
+  dc->retained = dc->release_cr;
+
+  iDrawInitDamage(dc);
+  iDrawClipDamage(dc, dc->image_cr);
+}
+#endif
+
+IUP_SDK_API IdrawCanvas* iupdrvDrawCreateCanvas(Ihandle* ih)
+{
+  IdrawCanvas* dc = calloc(1, sizeof(IdrawCanvas));
+
+  dc->ih = ih;
+
+  dc->widget = (GtkWidget*)IupGetAttribute(ih, "WID");
+
+#if !GTK_CHECK_VERSION(3, 0, 0)
+  dc->wnd = (GdkWindow*)IupGetAttribute(ih, "DRAWABLE");
+  gdk_window_get_geometry(dc->wnd, NULL, NULL, &dc->w, &dc->h, NULL);
+#else
+  dc->w = gtk_widget_get_allocated_width(dc->widget);
+  dc->h = gtk_widget_get_allocated_height(dc->widget);
 #endif
 
   /* valid only inside the ACTION callback of an IupCanvas */
   dc->cr = (cairo_t*)IupGetAttribute(ih, "CAIRO_CR");
   if (!dc->cr)
   {
-#if GTK_CHECK_VERSION(3, 0, 0)
-    /* Outside ACTION callback - draw to persistent buffer */
-    dc->cr = cairo_create(buffer);
-#else
+#if !GTK_CHECK_VERSION(3, 0, 0)
     dc->cr = gdk_cairo_create(dc->wnd);
 #endif
+    /* GTK 3: outside ACTION callback draw directly to the persistent buffer */
     dc->release_cr = 1;
   }
 
-  /* Create image surface for double-buffering the current operation */
-  surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dc->w, dc->h);
-  dc->image_cr = cairo_create(surface);
-  cairo_surface_destroy(surface);
+  gtkDrawInitImage(dc);
 
   iupAttribSet(ih, "DRAWDRIVER", "CAIRO");
+  iupAttribSet(ih, "_IUP_DRAW_RETAINED", dc->retained ? "1" : NULL);
 
   return dc;
 }
@@ -106,7 +207,7 @@ IUP_SDK_API IdrawCanvas* iupdrvDrawCreateCanvas(Ihandle* ih)
 IUP_SDK_API void iupdrvDrawKillCanvas(IdrawCanvas* dc)
 {
   cairo_destroy(dc->image_cr);
-  if (dc->release_cr)
+  if (dc->release_cr && dc->cr)
     cairo_destroy(dc->cr);
 
   free(dc);
@@ -124,16 +225,13 @@ IUP_SDK_API void iupdrvDrawUpdateSize(IdrawCanvas* dc)
 
   if (w != dc->w || h != dc->h)
   {
-    cairo_surface_t* surface;
-
     dc->w = w;
     dc->h = h;
 
     cairo_destroy(dc->image_cr);
-
-    surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dc->w, dc->h);
-    dc->image_cr = cairo_create(surface);
-    cairo_surface_destroy(surface);
+    dc->retained = 0;
+    gtkDrawInitImage(dc);
+    iupAttribSet(dc->ih, "_IUP_DRAW_RETAINED", dc->retained ? "1" : NULL);
   }
 }
 
@@ -156,60 +254,47 @@ IUP_SDK_API void iupdrvDrawFlush(IdrawCanvas* dc)
   /* Reset clip on image buffer to ensure clean state for next frame */
   iupdrvDrawResetClip(dc);
 
-  /* Copy the image buffer to the target surface */
-  cairo_set_source_surface(dc->cr, cairo_get_target(dc->image_cr), 0, 0);
-  cairo_set_operator(dc->cr, CAIRO_OPERATOR_OVER);
-  cairo_paint(dc->cr);  /* paints the entire source surface */
+#if GTK_CHECK_VERSION(3, 0, 0)
+  cairo_surface_flush(cairo_get_target(dc->image_cr));
 
-#if !GTK_CHECK_VERSION(3, 0, 0)
-  if (dc->draw_focus)
+  if (dc->release_cr)
   {
-    gdkDrawFocusRect(dc->ih, dc->focus_x1, dc->focus_y1, dc->focus_x2 - dc->focus_x1 + 1, dc->focus_y2 - dc->focus_y1 + 1);
-    dc->draw_focus = 0;
+    /* Outside ACTION: buffer was the draw target, just repaint the damaged area */
+    if (dc->damage_w <= 0 || dc->damage_h <= 0)
+      return;
+
+    iupAttribSet(dc->ih, "_IUPGTK3_BUFFER_DIRTY", "1");
+
+    if (iDrawIsFullDamage(dc))
+      gtk_widget_queue_draw(dc->widget);
+    else
+      gtk_widget_queue_draw_area(dc->widget, dc->damage_x, dc->damage_y, dc->damage_w, dc->damage_h);
+    return;
   }
 #endif
 
 #if GTK_CHECK_VERSION(3, 0, 0)
-  if (dc->release_cr)
-  {
-    /* Outside ACTION: buffer was the draw target, just flush and repaint */
-    cairo_surface_t* buffer = (cairo_surface_t*)iupAttribGet(dc->ih, "_IUPGTK3_CANVAS_BUFFER");
-    if (buffer)
-    {
-      cairo_surface_flush(buffer);
-      iupAttribSet(dc->ih, "_IUPGTK3_BUFFER_DIRTY", "1");
-    }
+  /* Inside ACTION the exposed area must be fully painted,
+     the buffer has the new damaged area and the previous frame elsewhere */
+  cairo_save(dc->cr);
+#else
+  if (dc->damage_w <= 0 || dc->damage_h <= 0)
+    return;
 
-    gtk_widget_queue_draw(dc->widget);
-  }
-  else
-  {
-    /* Inside ACTION: also copy rendered content to persistent buffer */
-    cairo_surface_t* buffer = (cairo_surface_t*)iupAttribGet(dc->ih, "_IUPGTK3_CANVAS_BUFFER");
-    if (buffer)
-    {
-      int buf_w = cairo_image_surface_get_width(buffer);
-      int buf_h = cairo_image_surface_get_height(buffer);
-      if (buf_w != dc->w || buf_h != dc->h)
-      {
-        cairo_surface_destroy(buffer);
-        buffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dc->w, dc->h);
-        iupAttribSet(dc->ih, "_IUPGTK3_CANVAS_BUFFER", (char*)buffer);
-      }
-    }
-    else
-    {
-      buffer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, dc->w, dc->h);
-      iupAttribSet(dc->ih, "_IUPGTK3_CANVAS_BUFFER", (char*)buffer);
-    }
+  /* Copy the damaged area of the image buffer to the target surface */
+  cairo_save(dc->cr);
+  iDrawClipDamage(dc, dc->cr);
+#endif
+  cairo_set_source_surface(dc->cr, cairo_get_target(dc->image_cr), 0, 0);
+  cairo_set_operator(dc->cr, CAIRO_OPERATOR_OVER);
+  cairo_paint(dc->cr);
+  cairo_restore(dc->cr);
 
-    {
-      cairo_t* buf_cr = cairo_create(buffer);
-      cairo_set_source_surface(buf_cr, cairo_get_target(dc->image_cr), 0, 0);
-      cairo_set_operator(buf_cr, CAIRO_OPERATOR_SOURCE);
-      cairo_paint(buf_cr);
-      cairo_destroy(buf_cr);
-    }
+#if !GTK_CHECK_VERSION(3, 0, 0)
+  if (dc->draw_focus)
+  {
+    gdkDrawFocusRect(dc->ih, dc->focus_x1, dc->focus_y1, dc->focus_x2 - dc->focus_x1 + 1, dc->focus_y2 - dc->focus_y1 + 1);
+    dc->draw_focus = 0;
   }
 #endif
 }
@@ -272,6 +357,26 @@ static void iDrawHorizontalLineW1(IdrawCanvas* dc, int x1, int x2, int y)
   cairo_line_to(dc->image_cr, x2 + 1, y + 0.5);
 }
 
+static void iDrawPolylineW1(IdrawCanvas* dc, int* points, int count)
+{
+  /* Used only when line_width=1 */
+  /* Use 0.5 to pass through the pixel centers, and extend both ends by half pixel to include the first and last pixels */
+  int i, last = 2 * (count - 1);
+  double dx = points[2] - points[0], dy = points[3] - points[1];
+  double len = sqrt(dx * dx + dy * dy);
+  if (len > 0) { dx /= len; dy /= len; }
+  cairo_move_to(dc->image_cr, points[0] + 0.5 - dx / 2, points[1] + 0.5 - dy / 2);
+
+  for (i = 1; i < count - 1; i++)
+    cairo_line_to(dc->image_cr, points[2 * i] + 0.5, points[2 * i + 1] + 0.5);
+
+  dx = points[last] - points[last - 2];
+  dy = points[last + 1] - points[last - 1];
+  len = sqrt(dx * dx + dy * dy);
+  if (len > 0) { dx /= len; dy /= len; }
+  cairo_line_to(dc->image_cr, points[last] + 0.5 + dx / 2, points[last + 1] + 0.5 + dy / 2);
+}
+
 IUP_SDK_API void iupdrvDrawRectangle(IdrawCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width)
 {
   cairo_set_source_rgba(dc->image_cr, iupgtkColorToDouble(iupDrawRed(color)), iupgtkColorToDouble(iupDrawGreen(color)), iupgtkColorToDouble(iupDrawBlue(color)), iupgtkColorToDouble(iupDrawAlpha(color)));
@@ -494,6 +599,33 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
     cairo_stroke(dc->image_cr);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  int i;
+
+  if (count < 2)
+    return;
+
+  cairo_set_source_rgba(dc->image_cr, iupgtkColorToDouble(iupDrawRed(color)), iupgtkColorToDouble(iupDrawGreen(color)), iupgtkColorToDouble(iupDrawBlue(color)), iupgtkColorToDouble(iupDrawAlpha(color)));
+
+  iDrawSetLineWidth(dc, line_width);
+  iDrawSetLineStyle(dc, style);
+
+  cairo_new_path(dc->image_cr);
+
+  /* a single path, so joins and dashes are continuous along the whole line */
+  if (line_width == 1)
+    iDrawPolylineW1(dc, points, count);
+  else
+  {
+    cairo_move_to(dc->image_cr, points[0], points[1]);
+    for (i=1; i<count; i++)
+      cairo_line_to(dc->image_cr, points[2*i], points[2*i+1]);
+  }
+
+  cairo_stroke(dc->image_cr);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   cairo_set_source_rgba(dc->image_cr,
@@ -672,6 +804,7 @@ IUP_SDK_API void iupdrvDrawSetClipRoundedRect(IdrawCanvas* dc, int x1, int y1, i
 IUP_SDK_API void iupdrvDrawResetClip(IdrawCanvas* dc)
 {
   cairo_reset_clip(dc->image_cr);
+  iDrawClipDamage(dc, dc->image_cr);  /* never draw outside the damaged area */
 
   dc->clip_x1 = 0;
   dc->clip_y1 = 0;
@@ -681,8 +814,8 @@ IUP_SDK_API void iupdrvDrawResetClip(IdrawCanvas* dc)
 
 IUP_SDK_API void iupdrvDrawText(IdrawCanvas* dc, const char* text, int len, int x, int y, int w, int h, long color, const char* font, int flags, double text_orientation)
 {
-  PangoLayout* fontlayout = (PangoLayout*)iupgtkGetPangoLayout(font);
-  PangoAlignment alignment = PANGO_ALIGN_LEFT;
+  PangoLayout* fontlayout;
+  cairo_matrix_t matrix;
   int layout_w = w, layout_h = h;
   int layout_center = flags & IUP_DRAW_LAYOUTCENTER;
 
@@ -690,34 +823,6 @@ IUP_SDK_API void iupdrvDrawText(IdrawCanvas* dc, const char* text, int len, int
     iupDrawGetTextSize(dc->ih, text, len, &layout_w, &layout_h, 0);
 
   text = iupgtkStrConvertToSystemLen(text, &len);
-  pango_layout_set_text(fontlayout, text, len);
-
-  if (flags & IUP_DRAW_RIGHT)
-    alignment = PANGO_ALIGN_RIGHT;
-  else if (flags & IUP_DRAW_CENTER)
-    alignment = PANGO_ALIGN_CENTER;
-
-  pango_layout_set_alignment(fontlayout, alignment);
-
-  if (flags & IUP_DRAW_WRAP)
-  {
-    pango_layout_set_width(fontlayout, iupGTK_PIXELS2PANGOUNITS(layout_w));
-#ifdef PANGO_VERSION_CHECK
-#if PANGO_VERSION_CHECK(1,2,0)
-    pango_layout_set_height(fontlayout, iupGTK_PIXELS2PANGOUNITS(layout_h));
-#endif
-#endif
-  }
-  else if (flags & IUP_DRAW_ELLIPSIS)
-  {
-    pango_layout_set_width(fontlayout, iupGTK_PIXELS2PANGOUNITS(layout_w));
-#ifdef PANGO_VERSION_CHECK
-#if PANGO_VERSION_CHECK(1,2,0)
-    pango_layout_set_height(fontlayout, iupGTK_PIXELS2PANGOUNITS(layout_h));
-#endif
-#endif
-    pango_layout_set_ellipsize(fontlayout, PANGO_ELLIPSIZE_END);
-  }
 
   cairo_set_source_rgba(dc->image_cr, iupgtkColorToDouble(iupDrawRed(color)), iupgtkColorToDouble(iupDrawGreen(color)), iupgtkColorToDouble(iupDrawBlue(color)), iupgtkColorToDouble(iupDrawAlpha(color)));
 
@@ -751,36 +856,93 @@ IUP_SDK_API void iupdrvDrawText(IdrawCanvas* dc, const char* text, int len, int
     }
   }
 
-  pango_cairo_update_layout(dc->image_cr, fontlayout);
-
-  cairo_move_to(dc->image_cr, x, y);
-  pango_cairo_show_layout(dc->image_cr, fontlayout);
-
-  /* restore settings */
-  if ((flags & IUP_DRAW_WRAP) || (flags & IUP_DRAW_ELLIPSIS))
+  /* the cached layouts share a context, a rotated or scaled matrix set in that context
+     would be reset by the next text and force all the cached layouts to be shaped again,
+     so that text uses its own context and layout */
+  cairo_get_matrix(dc->image_cr, &matrix);
+  if (matrix.xx != 1 || matrix.yy != 1 || matrix.xy != 0 || matrix.yx != 0)
   {
-    pango_layout_set_width(fontlayout, -1);
-#ifdef PANGO_VERSION_CHECK
-#if PANGO_VERSION_CHECK(1,2,0)
-    pango_layout_set_height(fontlayout, -1);
-#endif
-#endif
+    fontlayout = pango_cairo_create_layout(dc->image_cr);
+    if (iupgtkSetupTextLayout(fontlayout, font, text, len, flags, layout_w, layout_h))
+    {
+      cairo_move_to(dc->image_cr, x, y);
+      pango_cairo_show_layout(dc->image_cr, fontlayout);
+    }
+    g_object_unref(fontlayout);
+  }
+  else
+  {
+    /* alignment, wrap and ellipsis are part of the cached layout */
+    fontlayout = iupgtkGetTextLayout(font, text, len, flags, layout_w, layout_h);
+    if (fontlayout)
+    {
+      /* changes the shared context only when the surface font options change */
+      pango_cairo_update_layout(dc->image_cr, fontlayout);
+
+      cairo_move_to(dc->image_cr, x, y);
+      pango_cairo_show_layout(dc->image_cr, fontlayout);
+    }
   }
-  if (flags & IUP_DRAW_ELLIPSIS)
-    pango_layout_set_ellipsize(fontlayout, PANGO_ELLIPSIZE_NONE);
-  pango_layout_set_alignment(fontlayout, PANGO_ALIGN_LEFT);
 
   if ((flags & IUP_DRAW_CLIP) || text_orientation)
     cairo_restore(dc->image_cr);
 }
 
+static int gtk_draw_image_cache_hits = 0;
+static int gtk_draw_image_cache_misses = 0;
+
+IUP_DRV_API void iupgtkDrawGetImageCacheStats(int *hits, int *misses)
+{
+  if (hits) *hits = gtk_draw_image_cache_hits;
+  if (misses) *misses = gtk_draw_image_cache_misses;
+}
+
+static cairo_surface_t* gtkDrawGetImageSurface(GdkPixbuf* pixbuf)
+{
+  /* The pixbuf is already cached by the image for each inactive, bgcolor and tint combination,
+     so the converted surface is stored in the pixbuf and released together with it.
+     The scale is applied when painting, the same surface is used for all scales. */
+  cairo_surface_t* surface = (cairo_surface_t*)g_object_get_data(G_OBJECT(pixbuf), "_IUP_CAIRO_SURFACE");
+  cairo_t* cr;
+
+  if (surface)
+  {
+    gtk_draw_image_cache_hits++;
+    return surface;
+  }
+
+  gtk_draw_image_cache_misses++;
+
+  surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, gdk_pixbuf_get_width(pixbuf), gdk_pixbuf_get_height(pixbuf));
+  if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS)
+  {
+    cairo_surface_destroy(surface);
+    return NULL;
+  }
+
+  /* converts to premultiplied alpha only once */
+  cr = cairo_create(surface);
+  gdk_cairo_set_source_pixbuf(cr, pixbuf, 0, 0);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+
+  g_object_set_data_full(G_OBJECT(pixbuf), "_IUP_CAIRO_SURFACE", surface, (GDestroyNotify)cairo_surface_destroy);
+  return surface;
+}
+
 IUP_SDK_API void iupdrvDrawImage(IdrawCanvas* dc, const char* name, int make_inactive, const char* bgcolor, long tint, int opacity, int x, int y, int w, int h, int sx, int sy, int sw, int sh, int quality)
 {
   int bpp, img_w, img_h;
+  cairo_surface_t* surface;
   GdkPixbuf* pixbuf = iupImageGetImageTint(name, dc->ih, make_inactive, bgcolor, tint);
   if (!pixbuf)
     return;
 
+  surface = gtkDrawGetImageSurface(pixbuf);
+  if (!surface)
+    return;
+
   iupdrvImageGetInfo(pixbuf, &img_w, &img_h, &bpp);
 
   if (sw <= 0 || sh <= 0)
@@ -801,7 +963,7 @@ IUP_SDK_API void iupdrvDrawImage(IdrawCanvas* dc, const char* name, int make_ina
   cairo_translate(dc->image_cr, x, y);
   cairo_scale(dc->image_cr, (double)w / sw, (double)h / sh);
 
-  gdk_cairo_set_source_pixbuf(dc->image_cr, pixbuf, -sx, -sy);
+  cairo_set_source_surface(dc->image_cr, surface, -sx, -sy);
   cairo_pattern_set_filter(cairo_get_source(dc->image_cr), quality == IUP_DRAW_IMAGE_NEAREST ? CAIRO_FILTER_NEAREST : CAIRO_FILTER_GOOD);
   if (opacity < 255)
     cairo_paint_with_alpha(dc->image_cr, opacity / 255.0);
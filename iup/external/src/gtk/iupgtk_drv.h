@@ -72,6 +72,16 @@ IUP_DRV_API void iupgtkUpdateObjectFont(Ihandle* ih, gpointer object);
 IUP_DRV_API void iupgtkUpdateWidgetFont(Ihandle *ih, GtkWidget* widget);
 IUP_DRV_API PangoLayout* iupgtkGetPangoLayout(const char* value);
 
+/* Returns a cached layout with the text already shaped, it must not be changed.
+   text must be already converted to the system encoding.
+   flags are the IupDraw text flags, width and height are used only for wrap and ellipsis. */
+IUP_DRV_API PangoLayout* iupgtkGetTextLayout(const char* font, const char* text, int len, int flags, int width, int height);
+/* Same configuration of the cached layouts, for a layout that is not cached. Returns 0 if the font is invalid. */
+IUP_DRV_API int iupgtkSetupTextLayout(PangoLayout* layout, const char* font, const char* text, int len, int flags, int width, int height);
+IUP_DRV_API void iupgtkGetTextLayoutCacheStats(int *hits, int *misses, int *count);
+IUP_DRV_API void iupgtkSetTextLayoutCacheSize(int size);
+IUP_DRV_API int  iupgtkGetTextLayoutCacheSize(void);
+
 /* There are PANGO_SCALE Pango units in one device unit.
   For an output backend where a device unit is a pixel,
   a size value of 10 * PANGO_SCALE gives 10 pixels. */
@@ -96,6 +106,9 @@ IUP_DRV_API void iupgtkSetGlobalColors(void);
 /* table */
 IUP_DRV_API void iupgtkTableDetachVirtualModels(Ihandle* dialog);
 
+/* draw */
+IUP_DRV_API void iupgtkDrawGetImageCacheStats(int *hits, int *misses);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,8 @@
 #include "iup_array.h"
 #include "iup_object.h"
 #include "iup_drvfont.h"
+#include "iup_drvdraw.h"
+#include "iup_hashtable.h"
 #include "iup_assert.h"
 #include "iup_markup.h"
 
@@ -35,6 +37,7 @@ typedef struct _IgtkFont
 } IgtkFont;
 
 static Iarray* gtk_fonts = NULL;
+static Itable* gtk_fonts_table = NULL;  /* lower case font name -> index+1 in gtk_fonts */
 static PangoContext *gtk_fonts_context = NULL;
 
 static void gtkFontUpdateLayout(IgtkFont* gtkfont, PangoLayout* layout)
@@ -59,6 +62,14 @@ static void gtkFontUpdateLayout(IgtkFont* gtkfont, PangoLayout* layout)
   }
 }
 
+static void gtkFontGetKey(const char* font, char* key)
+{
+  int i;
+  for (i = 0; font[i] && i < 199; i++)
+    key[i] = iup_tolower(font[i]);
+  key[i] = 0;
+}
+
 static IgtkFont* gtkFindFont(const char *font)
 {
   PangoFontMetrics* metrics;
@@ -69,8 +80,18 @@ static IgtkFont* gtkFindFont(const char *font)
       count = iupArrayCount(gtk_fonts);
 
   IgtkFont* fonts = (IgtkFont*)iupArrayGetData(gtk_fonts);
+  char key[200];
+
+  if (!font)
+    return NULL;
 
   /* Check if the font already exists in cache */
+  gtkFontGetKey(font, key);
+  i = (int)(intptr_t)iupTableGet(gtk_fonts_table, key) - 1;
+  if (i >= 0 && iupStrEqualNoCase(font, fonts[i].font))
+    return &fonts[i];
+
+  /* very long names are truncated in the key */
   for (i = 0; i < count; i++)
   {
     if (iupStrEqualNoCase(font, fonts[i].font))
@@ -155,6 +176,12 @@ static IgtkFont* gtkFindFont(const char *font)
 
   gtkFontUpdateLayout(&(fonts[i]), fonts[i].layout);  /* for strikeout and underline */
 
+  {
+    char key[200];
+    gtkFontGetKey(font, key);
+    iupTableSet(gtk_fonts_table, key, (void*)(intptr_t)(i + 1), IUPTABLE_POINTER);
+  }
+
   return &fonts[i];
 }
 
@@ -372,6 +399,253 @@ IUP_SDK_API int iupdrvSetFontAttrib(Ihandle* ih, const char* value)
   return 1;
 }
 
+/* Cache of shaped text layouts, shared by drawing and measurement.
+   Each entry owns its PangoLayout, so repeated text is shaped only once.
+   The least recently used entries are released when the cache is full. */
+
+typedef struct _IgtkTextLayout
+{
+  struct _IgtkTextLayout *prev, *next;  /* usage order, most recent first */
+  struct _IgtkTextLayout *bucket_next;
+  unsigned int hash;
+  int font_index, flags, width, height;
+  int len;
+  char* text;
+  PangoLayout* layout;
+} IgtkTextLayout;
+
+static IgtkTextLayout** gtk_textlayout_buckets = NULL;
+static IgtkTextLayout *gtk_textlayout_first = NULL, *gtk_textlayout_last = NULL;
+static int gtk_textlayout_bucket_count = 0;
+static int gtk_textlayout_count = 0;
+static int gtk_textlayout_max = 2048;
+static int gtk_textlayout_hits = 0;
+static int gtk_textlayout_misses = 0;
+
+static unsigned int gtkTextLayoutHash(int font_index, const char* text, int len, int flags, int width, int height)
+{
+  /* FNV-1a */
+  unsigned int hash = 2166136261u;
+  int i;
+
+  for (i = 0; i < len; i++)
+  {
+    hash ^= (unsigned char)text[i];
+    hash *= 16777619u;
+  }
+
+  hash ^= (unsigned int)font_index * 2654435761u;
+  hash ^= ((unsigned int)flags << 24) ^ ((unsigned int)width * 40503u) ^ ((unsigned int)height * 9973u);
+  return hash;
+}
+
+static void gtkTextLayoutUnlink(IgtkTextLayout* entry)
+{
+  if (entry->prev)
+    entry->prev->next = entry->next;
+  else
+    gtk_textlayout_first = entry->next;
+
+  if (entry->next)
+    entry->next->prev = entry->prev;
+  else
+    gtk_textlayout_last = entry->prev;
+
+  entry->prev = NULL;
+  entry->next = NULL;
+}
+
+static void gtkTextLayoutPushFirst(IgtkTextLayout* entry)
+{
+  entry->prev = NULL;
+  entry->next = gtk_textlayout_first;
+  if (gtk_textlayout_first)
+    gtk_textlayout_first->prev = entry;
+  gtk_textlayout_first = entry;
+  if (!gtk_textlayout_last)
+    gtk_textlayout_last = entry;
+}
+
+static void gtkTextLayoutRemove(IgtkTextLayout* entry)
+{
+  IgtkTextLayout** bucket = &gtk_textlayout_buckets[entry->hash & (gtk_textlayout_bucket_count - 1)];
+
+  while (*bucket != entry)
+    bucket = &((*bucket)->bucket_next);
+  *bucket = entry->bucket_next;
+
+  gtkTextLayoutUnlink(entry);
+
+  g_object_unref(entry->layout);
+  free(entry->text);
+  free(entry);
+  gtk_textlayout_count--;
+}
+
+static void gtkTextLayoutClear(void)
+{
+  while (gtk_textlayout_last)
+    gtkTextLayoutRemove(gtk_textlayout_last);
+
+  free(gtk_textlayout_buckets);
+  gtk_textlayout_buckets = NULL;
+  gtk_textlayout_bucket_count = 0;
+}
+
+static int gtkTextLayoutFlags(int flags)
+{
+  /* only the flags that change the layout, wrap has precedence over ellipsis */
+  flags &= IUP_DRAW_CENTER | IUP_DRAW_RIGHT | IUP_DRAW_WRAP | IUP_DRAW_ELLIPSIS;
+  if (flags & IUP_DRAW_WRAP)
+    flags &= ~IUP_DRAW_ELLIPSIS;
+  return flags;
+}
+
+static void gtkTextLayoutSetup(IgtkFont* gtkfont, PangoLayout* layout, const char* text, int len, int flags, int width, int height)
+{
+  PangoAlignment alignment = PANGO_ALIGN_LEFT;
+
+  gtkFontUpdateLayout(gtkfont, layout);
+  pango_layout_set_text(layout, text, len);
+
+  if (flags & IUP_DRAW_RIGHT)
+    alignment = PANGO_ALIGN_RIGHT;
+  else if (flags & IUP_DRAW_CENTER)
+    alignment = PANGO_ALIGN_CENTER;
+  pango_layout_set_alignment(layout, alignment);
+
+  if (flags & (IUP_DRAW_WRAP | IUP_DRAW_ELLIPSIS))
+  {
+    pango_layout_set_width(layout, iupGTK_PIXELS2PANGOUNITS(width));
+#ifdef PANGO_VERSION_CHECK
+#if PANGO_VERSION_CHECK(1,2,0)
+    pango_layout_set_height(layout, iupGTK_PIXELS2PANGOUNITS(height));
+#endif
+#endif
+    if (!(flags & IUP_DRAW_WRAP))
+      pango_layout_set_ellipsize(layout, PANGO_ELLIPSIZE_END);
+  }
+}
+
+static PangoLayout* gtkTextLayoutGet(IgtkFont* gtkfont, const char* text, int len, int flags, int width, int height)
+{
+  IgtkTextLayout* entry;
+  int font_index = (int)(gtkfont - (IgtkFont*)iupArrayGetData(gtk_fonts));
+  unsigned int hash;
+
+  flags = gtkTextLayoutFlags(flags);
+  if (!(flags & (IUP_DRAW_WRAP | IUP_DRAW_ELLIPSIS)))
+  {
+    width = -1;
+    height = -1;
+  }
+
+  if (!gtk_textlayout_buckets)
+  {
+    gtk_textlayout_bucket_count = 64;
+    while (gtk_textlayout_bucket_count < gtk_textlayout_max)
+      gtk_textlayout_bucket_count *= 2;
+    gtk_textlayout_buckets = (IgtkTextLayout**)calloc(gtk_textlayout_bucket_count, sizeof(IgtkTextLayout*));
+    if (!gtk_textlayout_buckets)
+    {
+      gtk_textlayout_bucket_count = 0;
+      return NULL;
+    }
+  }
+
+  hash = gtkTextLayoutHash(font_index, text, len, flags, width, height);
+
+  for (entry = gtk_textlayout_buckets[hash & (gtk_textlayout_bucket_count - 1)]; entry; entry = entry->bucket_next)
+  {
+    if (entry->hash == hash && entry->font_index == font_index && entry->flags == flags &&
+        entry->width == width && entry->height == height &&
+        entry->len == len && memcmp(entry->text, text, len) == 0)
+    {
+      gtk_textlayout_hits++;
+      if (entry != gtk_textlayout_first)
+      {
+        gtkTextLayoutUnlink(entry);
+        gtkTextLayoutPushFirst(entry);
+      }
+      return entry->layout;
+    }
+  }
+
+  gtk_textlayout_misses++;
+
+  while (gtk_textlayout_count >= gtk_textlayout_max && gtk_textlayout_last)
+    gtkTextLayoutRemove(gtk_textlayout_last);
+
+  entry = (IgtkTextLayout*)calloc(1, sizeof(IgtkTextLayout));
+  if (!entry)
+    return NULL;
+
+  entry->text = (char*)malloc(len + 1);
+  if (!entry->text)
+  {
+    free(entry);
+    return NULL;
+  }
+  memcpy(entry->text, text, len);
+  entry->text[len] = 0;
+
+  entry->hash = hash;
+  entry->font_index = font_index;
+  entry->flags = flags;
+  entry->width = width;
+  entry->height = height;
+  entry->len = len;
+
+  entry->layout = pango_layout_new(gtk_fonts_context);
+  gtkTextLayoutSetup(gtkfont, entry->layout, text, len, flags, width, height);
+
+  entry->bucket_next = gtk_textlayout_buckets[hash & (gtk_textlayout_bucket_count - 1)];
+  gtk_textlayout_buckets[hash & (gtk_textlayout_bucket_count - 1)] = entry;
+  gtkTextLayoutPushFirst(entry);
+  gtk_textlayout_count++;
+
+  return entry->layout;
+}
+
+IUP_DRV_API PangoLayout* iupgtkGetTextLayout(const char* font, const char* text, int len, int flags, int width, int height)
+{
+  IgtkFont *gtkfont = gtkFindFont(font);
+  if (!gtkfont)
+    return NULL;
+  return gtkTextLayoutGet(gtkfont, text, len, flags, width, height);
+}
+
+IUP_DRV_API int iupgtkSetupTextLayout(PangoLayout* layout, const char* font, const char* text, int len, int flags, int width, int height)
+{
+  IgtkFont *gtkfont = gtkFindFont(font);
+  if (!gtkfont)
+    return 0;
+  gtkTextLayoutSetup(gtkfont, layout, text, len, gtkTextLayoutFlags(flags), width, height);
+  return 1;
+}
+
+IUP_DRV_API void iupgtkGetTextLayoutCacheStats(int *hits, int *misses, int *count)
+{
+  if (hits) *hits = gtk_textlayout_hits;
+  if (misses) *misses = gtk_textlayout_misses;
+  if (count) *count = gtk_textlayout_count;
+}
+
+IUP_DRV_API void iupgtkSetTextLayoutCacheSize(int size)
+{
+  if (size < 1)
+    size = 1;
+
+  /* buckets are sized for the maximum */
+  gtkTextLayoutClear();
+  gtk_textlayout_max = size;
+}
+
+IUP_DRV_API int iupgtkGetTextLayoutCacheSize(void)
+{
+  return gtk_textlayout_max;
+}
+
 static void gtkFontGetTextSize(Ihandle* ih, IgtkFont* gtkfont, const char* str, int len, int *w, int *h)
 {
   int max_w = 0, line_count = 1;
@@ -397,6 +671,7 @@ static void gtkFontGetTextSize(Ihandle* ih, IgtkFont* gtkfont, const char* str,
   {
     int dummy_h;
     char* text = iupgtkStrConvertToSystemLen(str, &len);
+    PangoLayout* layout = NULL;
 
     if (ih && iupAttribGetBoolean(ih, "MARKUP"))
     {
@@ -404,11 +679,18 @@ static void gtkFontGetTextSize(Ihandle* ih, IgtkFont* gtkfont, const char* str,
       pango_layout_set_attributes(gtkfont->layout, NULL);
       pango_layout_set_markup(gtkfont->layout, pango, (int)strlen(pango));
       free(pango);
+      layout = gtkfont->layout;
     }
     else
+      layout = gtkTextLayoutGet(gtkfont, text, len, 0, -1, -1);
+
+    if (!layout)
+    {
       pango_layout_set_text(gtkfont->layout, text, len);
+      layout = gtkfont->layout;
+    }
 
-    pango_layout_get_pixel_size(gtkfont->layout, &max_w, &dummy_h);
+    pango_layout_get_pixel_size(layout, &max_w, &dummy_h);
   }
 
   if (w) *w = max_w;
@@ -539,6 +821,7 @@ IUP_SDK_API int iupdrvFontGetFamilyList(char*** list)
 IUP_SDK_API void iupdrvFontInit(void)
 {
   gtk_fonts = iupArrayCreate(50, sizeof(IgtkFont));
+  gtk_fonts_table = iupTableCreate(IUPTABLE_STRINGINDEXED);
   gtk_fonts_context = gdk_pango_context_get();
   pango_context_set_language(gtk_fonts_context, gtk_get_default_language());
 }
@@ -547,6 +830,9 @@ IUP_SDK_API void iupdrvFontFinish(void)
 {
   int i, count = iupArrayCount(gtk_fonts);
   IgtkFont* fonts = (IgtkFont*)iupArrayGetData(gtk_fonts);
+
+  gtkTextLayoutClear();
+
   for (i = 0; i < count; i++)
   {
     pango_font_description_free(fonts[i].fontdesc);
@@ -555,5 +841,7 @@ IUP_SDK_API void iupdrvFontFinish(void)
     pango_attribute_destroy(fonts[i].underline);
   }
   iupArrayDestroy(gtk_fonts);
+  iupTableDestroy(gtk_fonts_table);
+  gtk_fonts_table = NULL;
   g_object_unref(gtk_fonts_context);
 }
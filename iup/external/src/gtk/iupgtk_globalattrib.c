@@ -129,6 +129,13 @@ IUP_SDK_API int iupdrvSetGlobal(const char *name, const char *value)
       gdk_event_handler_set((GdkEventFunc)gtk_main_do_event, NULL, NULL);
     return 1;
   }
+  if (iupStrEqual(name, "TEXTLAYOUTCACHESIZE"))
+  {
+    int size;
+    if (iupStrToInt(value, &size))
+      iupgtkSetTextLayoutCacheSize(size);
+    return 0;
+  }
   if (iupStrEqual(name, "UTF8MODE"))
   {
     iupgtkStrSetUTF8Mode(iupStrBoolean(value));
@@ -243,6 +250,38 @@ IUP_SDK_API char *iupdrvGetGlobal(const char *name)
     return iupStrReturnBoolean(gdk_visual_get_best_depth() > 8);
 #endif
   }
+  if (iupStrEqual(name, "TEXTLAYOUTCACHEHITS"))
+  {
+    int hits;
+    iupgtkGetTextLayoutCacheStats(&hits, NULL, NULL);
+    return iupStrReturnInt(hits);
+  }
+  if (iupStrEqual(name, "TEXTLAYOUTCACHEMISSES"))
+  {
+    int misses;
+    iupgtkGetTextLayoutCacheStats(NULL, &misses, NULL);
+    return iupStrReturnInt(misses);
+  }
+  if (iupStrEqual(name, "TEXTLAYOUTCACHECOUNT"))
+  {
+    int count;
+    iupgtkGetTextLayoutCacheStats(NULL, NULL, &count);
+    return iupStrReturnInt(count);
+  }
+  if (iupStrEqual(name, "TEXTLAYOUTCACHESIZE"))
+    return iupStrReturnInt(iupgtkGetTextLayoutCacheSize());
+  if (iupStrEqual(name, "DRAWIMAGECACHEHITS"))
+  {
+    int hits;
+    iupgtkDrawGetImageCacheStats(&hits, NULL);
+    return iupStrReturnInt(hits);
+  }
+  if (iupStrEqual(name, "DRAWIMAGECACHEMISSES"))
+  {
+    int misses;
+    iupgtkDrawGetImageCacheStats(NULL, &misses);
+    return iupStrReturnInt(misses);
+  }
   if (iupStrEqual(name, "UTF8MODE"))
   {
     return iupStrReturnBoolean(iupgtkStrGetUTF8Mode());
@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <math.h>
 
 #include "iup.h"
 
@@ -192,6 +193,26 @@ static void iDrawHorizontalLineW1(IdrawCanvas* dc, int x1, int x2, int y)
   cairo_line_to(dc->image_cr, x2 + 1, y + 0.5);
 }
 
+static void iDrawPolylineW1(IdrawCanvas* dc, int* points, int count)
+{
+  /* Used only when line_width=1 */
+  /* Use 0.5 to pass through the pixel centers, and extend both ends by half pixel to include the first and last pixels */
+  int i, last = 2 * (count - 1);
+  double dx = points[2] - points[0], dy = points[3] - points[1];
+  double len = sqrt(dx * dx + dy * dy);
+  if (len > 0) { dx /= len; dy /= len; }
+  cairo_move_to(dc->image_cr, points[0] + 0.5 - dx / 2, points[1] + 0.5 - dy / 2);
+
+  for (i = 1; i < count - 1; i++)
+    cairo_line_to(dc->image_cr, points[2 * i] + 0.5, points[2 * i + 1] + 0.5);
+
+  dx = points[last] - points[last - 2];
+  dy = points[last + 1] - points[last - 1];
+  len = sqrt(dx * dx + dy * dy);
+  if (len > 0) { dx /= len; dy /= len; }
+  cairo_line_to(dc->image_cr, points[last] + 0.5 + dx / 2, points[last + 1] + 0.5 + dy / 2);
+}
+
 IUP_SDK_API void iupdrvDrawRectangle(IdrawCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width)
 {
   cairo_set_source_rgba(dc->image_cr, iupgtk4ColorToDouble(iupDrawRed(color)), iupgtk4ColorToDouble(iupDrawGreen(color)), iupgtk4ColorToDouble(iupDrawBlue(color)), iupgtk4ColorToDouble(iupDrawAlpha(color)));
@@ -414,6 +435,33 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
     cairo_stroke(dc->image_cr);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  int i;
+
+  if (count < 2)
+    return;
+
+  cairo_set_source_rgba(dc->image_cr, iupgtk4ColorToDouble(iupDrawRed(color)), iupgtk4ColorToDouble(iupDrawGreen(color)), iupgtk4ColorToDouble(iupDrawBlue(color)), iupgtk4ColorToDouble(iupDrawAlpha(color)));
+
+  iDrawSetLineWidth(dc, line_width);
+  iDrawSetLineStyle(dc, style);
+
+  cairo_new_path(dc->image_cr);
+
+  /* a single path, so joins and dashes are continuous along the whole line */
+  if (line_width == 1)
+    iDrawPolylineW1(dc, points, count);
+  else
+  {
+    cairo_move_to(dc->image_cr, points[0], points[1]);
+    for (i=1; i<count; i++)
+      cairo_line_to(dc->image_cr, points[2*i], points[2*i+1]);
+  }
+
+  cairo_stroke(dc->image_cr);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   cairo_set_source_rgba(dc->image_cr,
@@ -254,6 +254,20 @@ extern "C" IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int
   free(pts);
 }
 
+extern "C" IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  if (!dc || !dc->bm || !points || count < 2) return;
+  BPoint* pts = (BPoint*)malloc(sizeof(BPoint) * count);
+  for (int i = 0; i < count; ++i)
+    pts[i] = BPoint((float)points[i*2], (float)points[i*2 + 1]);
+
+  dc->bm->Lock();
+  haikuApplyStroke(dc->view, color, line_width, style);
+  dc->view->StrokePolygon(pts, count, false);
+  dc->bm->Unlock();
+  free(pts);
+}
+
 extern "C" IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   if (!dc || !dc->bm) return;
@@ -0,0 +1,186 @@
+/** \file
+ * \brief Attribute name atoms.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <memory.h>
+
+#include "iup.h"
+
+#include "iup_str.h"
+#include "iup_hashtable.h"
+#include "iup_atom.h"
+#include "iup_assert.h"
+
+
+#define IATOM_CACHE_SIZE 4
+
+typedef struct _IatomCache
+{
+  const void* owner;
+  void* value;
+} IatomCache;
+
+typedef struct _Iatom
+{
+  char* name;
+  unsigned long hash;        /* key index of the name in string indexed tables */
+  unsigned int cache_gen;    /* cache is valid only if equal to iatom_cache_gen */
+  int cache_next;            /* next cache slot to be replaced */
+  IatomCache cache[IATOM_CACHE_SIZE];
+} Iatom;
+
+static Itable *iatom_strtable = NULL;   /* table indexed by name containing the atom number */
+static Iatom* iatom_array = NULL;       /* atom 0 is never used */
+static int iatom_count = 0;
+static int iatom_max = 0;
+static unsigned int iatom_cache_gen = 1;
+
+void iupAtomInit(void)
+{
+  iatom_strtable = iupTableCreateSized(IUPTABLE_STRINGINDEXED, 3);  /* 1601, all registered attributes will be here */
+  iatom_max = 1024;
+  iatom_array = (Iatom*)calloc(iatom_max, sizeof(Iatom));
+  iatom_count = 1;
+  iatom_cache_gen = 1;
+}
+
+void iupAtomFinish(void)
+{
+  int i;
+  for (i = 1; i < iatom_count; i++)
+    free(iatom_array[i].name);
+
+  free(iatom_array);
+  iatom_array = NULL;
+  iatom_count = 0;
+  iatom_max = 0;
+
+  iupTableDestroy(iatom_strtable);
+  iatom_strtable = NULL;
+}
+
+IUP_SDK_API int iupAtomFind(const char* name)
+{
+  if (!iatom_strtable || !name)
+    return 0;
+
+  return (int)(intptr_t)iupTableGet(iatom_strtable, name);
+}
+
+IUP_SDK_API int iupAtomGet(const char* name)
+{
+  int atom;
+  Iatom* iatom;
+
+  if (!iatom_strtable || !name)
+    return 0;
+
+  atom = (int)(intptr_t)iupTableGet(iatom_strtable, name);
+  if (atom)
+    return atom;
+
+  if (iatom_count == iatom_max)
+  {
+    Iatom* new_array = (Iatom*)realloc(iatom_array, 2 * iatom_max * sizeof(Iatom));
+    iupASSERT(new_array != NULL);
+    if (!new_array)
+      return 0;
+
+    memset(new_array + iatom_max, 0, iatom_max * sizeof(Iatom));
+    iatom_array = new_array;
+    iatom_max *= 2;
+  }
+
+  atom = iatom_count;
+  iatom_count++;
+
+  iatom = iatom_array + atom;
+  iatom->name = iupStrDup(name);
+  iatom->hash = iupTableHashKey(name);
+
+  iupTableSetHashed(iatom_strtable, name, iatom->hash, (void*)(intptr_t)atom, IUPTABLE_POINTER);
+  return atom;
+}
+
+IUP_SDK_API const char* iupAtomGetName(int atom)
+{
+  if (atom <= 0 || atom >= iatom_count)
+    return NULL;
+  return iatom_array[atom].name;
+}
+
+IUP_SDK_API unsigned long iupAtomGetHash(int atom)
+{
+  if (atom <= 0 || atom >= iatom_count)
+    return 0;
+  return iatom_array[atom].hash;
+}
+
+IUP_SDK_API int iupAtomGetCache(int atom, const void* owner, void* *value)
+{
+  Iatom* iatom;
+  int i;
+
+  if (atom <= 0 || atom >= iatom_count)
+    return 0;
+
+  iatom = iatom_array + atom;
+  if (iatom->cache_gen != iatom_cache_gen)
+    return 0;
+
+  for (i = 0; i < IATOM_CACHE_SIZE; i++)
+  {
+    if (iatom->cache[i].owner == owner)
+    {
+      *value = iatom->cache[i].value;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+IUP_SDK_API void iupAtomSetCache(int atom, const void* owner, void* value)
+{
+  Iatom* iatom;
+
+  if (atom <= 0 || atom >= iatom_count || !owner)
+    return;
+
+  iatom = iatom_array + atom;
+  if (iatom->cache_gen != iatom_cache_gen)
+  {
+    memset(iatom->cache, 0, sizeof(iatom->cache));
+    iatom->cache_next = 0;
+    iatom->cache_gen = iatom_cache_gen;
+  }
+
+  iatom->cache[iatom->cache_next].owner = owner;
+  iatom->cache[iatom->cache_next].value = value;
+  iatom->cache_next = (iatom->cache_next + 1) % IATOM_CACHE_SIZE;
+}
+
+IUP_SDK_API void iupAtomResetCache(void)
+{
+  iatom_cache_gen++;
+  if (iatom_cache_gen == 0)  /* 0 is the initial value of a new atom */
+  {
+    int i;
+    for (i = 1; i < iatom_count; i++)
+      iatom_array[i].cache_gen = 0;
+    iatom_cache_gen = 1;
+  }
+}
+
+IUP_API int IupGetAtom(const char* name)
+{
+  iupASSERT(name != NULL);
+  if (!name)
+    return 0;
+
+  return iupAtomGet(name);
+}
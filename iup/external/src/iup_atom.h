@@ -0,0 +1,72 @@
+/** \file
+ * \brief Attribute name atoms.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#ifndef __IUP_ATOM_H
+#define __IUP_ATOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup atom Attribute Atoms
+ * \par
+ * An atom is a positive integer that identifies an interned attribute name.
+ * The name is hashed only once, when the atom is created,
+ * then the atom carries the key index of the string indexed hash tables
+ * so attribute tables can be accessed without hashing the name again.
+ * \par
+ * All the names registered by \ref iupClassRegisterAttribute are interned.
+ * Atoms are valid from IupOpen until IupClose.
+ * \par
+ * See \ref iup_atom.h
+ * \ingroup util */
+
+
+/* called only in IupOpen and IupClose */
+void iupAtomInit(void);
+void iupAtomFinish(void);
+
+/** Returns the atom of the given name, creates a new one if not found.
+ * Returns 0 if IUP is not initialized.
+ * \ingroup atom */
+IUP_SDK_API int iupAtomGet(const char* name);
+
+/** Returns the atom of the given name, or 0 if the name was never interned.
+ * \ingroup atom */
+IUP_SDK_API int iupAtomFind(const char* name);
+
+/** Returns the name of the atom, or NULL if invalid.
+ * \ingroup atom */
+IUP_SDK_API const char* iupAtomGetName(int atom);
+
+/** Returns the key index of the atom name. See \ref iupTableHashKey.
+ * \ingroup atom */
+IUP_SDK_API unsigned long iupAtomGetHash(int atom);
+
+/** Retrieves a value cached in the atom for the given owner.
+ * Each atom keeps a small lookup cache, used for instance to store the attribute function of a class.
+ * Returns 1 if found, value can be NULL.
+ * \ingroup atom */
+IUP_SDK_API int iupAtomGetCache(int atom, const void* owner, void* *value);
+
+/** Stores a value in the atom cache for the given owner.
+ * \ingroup atom */
+IUP_SDK_API void iupAtomSetCache(int atom, const void* owner, void* value);
+
+/** Invalidates the cache of all atoms. Must be called when any cached value may become invalid.
+ * \ingroup atom */
+IUP_SDK_API void iupAtomResetCache(void);
+
+
+/* Other functions declared in <iup.h> and implemented here.
+IupGetAtom
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,6 +9,7 @@
 #include <string.h>
 #include <memory.h>
 #include <stdarg.h>
+#include <limits.h>
 
 #include "iup.h"
 
@@ -18,6 +19,7 @@
 #include "iup_attrib.h"
 #include "iup_assert.h"
 #include "iup_varg.h"
+#include "iup_atom.h"
 
 
 #define iupATTRIB_LANGUAGE_STRING(_v)  (_v && _v[0] == '_' && _v[1] == '@')
@@ -33,6 +35,297 @@
     }                                                                      \
   }
 
+/* Numbered attributes, like "BGCOLOR3:5", are stored in ih->attrib_id indexed by
+   the atom of the base name and the ids, so no string key is built for each one.
+   Names with ids set using the string API are split in the same key. */
+
+#define IATTRIB_NOID2 INT_MIN   /* id2 of attributes with a single id */
+#define IATTRIB_MAXNAME 100
+#define IATTRIB_MAXDIGITS 9     /* ids with more digits are kept in the name */
+#define IATTRIB_MAXID 999999999
+
+static void iAttribSetNameId2(char* nameid, int nameid_size, const char* name, int lin, int col)
+{
+  if (lin == IUP_INVALID_ID && col == IUP_INVALID_ID)
+    snprintf(nameid, nameid_size, "%s", name);
+  else if (lin == IUP_INVALID_ID)
+    snprintf(nameid, nameid_size, "%s*:%d", name, col);
+  else if (col == IUP_INVALID_ID)
+    snprintf(nameid, nameid_size, "%s%d:*", name, lin);
+  else
+    snprintf(nameid, nameid_size, "%s%d:%d", name, lin, col);
+}
+
+static void iAttribSetNameId(char* nameid, int nameid_size, const char* name, int id)
+{
+  if (id == IUP_INVALID_ID)
+    snprintf(nameid, nameid_size, "%s", name);
+  else
+    snprintf(nameid, nameid_size, "%s%d", name, id);
+}
+
+#define iAttribIsIdChar(_c) ((_c >= '0' && _c <= '9') || _c == '*')
+
+/* Parses an id that ends just before "end", returns its start.
+   Accepts only what iAttribSetNameId/iAttribSetNameId2 would write, so "X01" is not an id. */
+static int iAttribParseId(const char* name, int end, int *start, int *id)
+{
+  int i = end, value = 0;
+
+  if (end <= 0)
+    return 0;
+
+  if (name[end - 1] == '*')
+  {
+    *start = end - 1;
+    *id = IUP_INVALID_ID;
+    return 1;
+  }
+
+  while (i > 0 && name[i - 1] >= '0' && name[i - 1] <= '9')
+    i--;
+
+  if (i == end || end - i > IATTRIB_MAXDIGITS || (name[i] == '0' && end - i > 1))
+    return 0;
+
+  *start = i;
+  for (; i < end; i++)
+    value = value * 10 + (name[i] - '0');
+  *id = value;
+  return 1;
+}
+
+/* Splits "NAME12", "NAME1:2", "NAME*:2" and "NAME1:*" into "NAME" and the ids.
+   Returns 0 if the name has no ids. */
+static int iAttribSplitNameId(const char* name, char* base, int *id1, int *id2)
+{
+  int len, start, start1, id_a, id_b, base_len;
+
+  len = (int)strlen(name);
+  if (len == 0 || !iAttribIsIdChar(name[len - 1]))
+    return 0;
+
+  if (!iAttribParseId(name, len, &start, &id_b))
+    return 0;
+
+  if (start > 0 && name[start - 1] == ':' && iAttribParseId(name, start - 1, &start1, &id_a))
+  {
+    if (id_a == IUP_INVALID_ID && id_b == IUP_INVALID_ID)
+      return 0;
+
+    base_len = start1;
+    *id1 = id_a;
+    *id2 = id_b;
+  }
+  else
+  {
+    if (id_b == IUP_INVALID_ID)
+      return 0;
+
+    base_len = start;
+    *id1 = id_b;
+    *id2 = IATTRIB_NOID2;
+  }
+
+  if (base_len >= IATTRIB_MAXNAME)
+    return 0;
+
+  memcpy(base, name, base_len);
+  base[base_len] = 0;
+  return 1;
+}
+
+/* Checks if name and ids can be used directly as a key.
+   The result must be the same key that iAttribSplitNameId would return for the formatted name,
+   so names ending with an id character are excluded ("X1" with id 0 is "X10", the same as "X" with id 10),
+   negative ids are formatted with a minus sign that is kept in the name,
+   and ids above IATTRIB_MAXID are not parsed back. */
+#define iAttribIsDirectIdValue(_id) ((_id) >= 0 && (_id) <= IATTRIB_MAXID)
+
+static int iAttribIsDirectId(const char* name, int id1, int id2)
+{
+  int len = (int)strlen(name);
+  if (len >= IATTRIB_MAXNAME)
+    return 0;
+  if (len > 0 && (iAttribIsIdChar(name[len - 1]) || name[len - 1] == ':'))
+    return 0;
+
+  if (id2 == IATTRIB_NOID2)
+    return iAttribIsDirectIdValue(id1);
+
+  if (id1 == IUP_INVALID_ID && id2 == IUP_INVALID_ID)
+    return 0;
+  return (iAttribIsDirectIdValue(id1) || id1 == IUP_INVALID_ID) && (iAttribIsDirectIdValue(id2) || id2 == IUP_INVALID_ID);
+}
+
+static void iAttribSetIdItem(Ihandle* ih, const char* name, int id1, int id2, const char* value, Itable_Types itemType)
+{
+  if (!value)
+  {
+    int atom;
+    if (!ih->attrib_id)
+      return;
+
+    atom = iupAtomFind(name);
+    if (atom)
+      iupIdTableRemove(ih->attrib_id, atom, id1, id2);
+  }
+  else
+  {
+    if (!ih->attrib_id)
+      ih->attrib_id = iupIdTableCreate();
+
+    iupIdTableSet(ih->attrib_id, iupAtomGet(name), id1, id2, (void*)value, itemType);
+  }
+}
+
+static void iAttribSetStrIdItem(Ihandle* ih, const char* name, int id1, int id2, const char* value)
+{
+  int store = 1;
+
+  if (iupATTRIB_LANGUAGE_STRING(value))
+    iupATTRIB_GET_LANGUAGE_STRING(value, store);
+
+  iAttribSetIdItem(ih, name, id1, id2, value, store ? IUPTABLE_STRING : IUPTABLE_POINTER);
+}
+
+static char* iAttribGetIdItem(Ihandle* ih, const char* name, int id1, int id2)
+{
+  int atom;
+
+  if (!ih->attrib_id)
+    return NULL;
+
+  atom = iupAtomFind(name);
+  if (!atom)
+    return NULL;
+
+  return (char*)iupIdTableGet(ih->attrib_id, atom, id1, id2);
+}
+
+static void iAttribSetItem(Ihandle* ih, const char* name, const char* value, Itable_Types itemType)
+{
+  char base[IATTRIB_MAXNAME];
+  int id1, id2;
+
+  if (iAttribSplitNameId(name, base, &id1, &id2))
+    iAttribSetIdItem(ih, base, id1, id2, value, itemType);
+  else if (!value)
+    iupTableRemove(ih->attrib, name);
+  else
+    iupTableSet(ih->attrib, name, (void*)value, itemType);
+}
+
+static char* iAttribGetItem(Ihandle* ih, const char* name)
+{
+  char base[IATTRIB_MAXNAME];
+  int id1, id2;
+
+  if (iAttribSplitNameId(name, base, &id1, &id2))
+    return iAttribGetIdItem(ih, base, id1, id2);
+  else
+    return (char*)iupTableGet(ih->attrib, name);
+}
+
+/* Iteration over ih->attrib and then over ih->attrib_id.
+   Names of numbered attributes are built only when iterated. */
+
+static char* iAttribGetCurrIdName(Ihandle* ih, int atom, int id1, int id2)
+{
+  const char* name = iupIdTableGetCurrName(ih->attrib_id);
+  if (!name)
+  {
+    char nameid[IATTRIB_MAXNAME + 30];
+
+    if (id2 == IATTRIB_NOID2)
+      iAttribSetNameId(nameid, sizeof(nameid), iupAtomGetName(atom), id1);
+    else
+      iAttribSetNameId2(nameid, sizeof(nameid), iupAtomGetName(atom), id1, id2);
+
+    name = iupIdTableSetCurrName(ih->attrib_id, nameid);
+  }
+  return (char*)name;
+}
+
+static char* iAttribFirstId(Ihandle* ih)
+{
+  int atom, id1, id2;
+  if (ih->attrib_id && iupIdTableFirst(ih->attrib_id, &atom, &id1, &id2))
+    return iAttribGetCurrIdName(ih, atom, id1, id2);
+  return NULL;
+}
+
+IUP_SDK_API char* iupAttribFirst(Ihandle* ih)
+{
+  char* name = iupTableFirst(ih->attrib);
+  iupIdTableEndIteration(ih->attrib_id);
+  if (!name)
+    name = iAttribFirstId(ih);
+  return name;
+}
+
+IUP_SDK_API char* iupAttribNext(Ihandle* ih)
+{
+  char* name;
+
+  if (iupIdTableIsIterating(ih->attrib_id))
+  {
+    int atom, id1, id2;
+    if (iupIdTableNext(ih->attrib_id, &atom, &id1, &id2))
+      return iAttribGetCurrIdName(ih, atom, id1, id2);
+    return NULL;
+  }
+
+  name = iupTableNext(ih->attrib);
+  if (!name)
+    name = iAttribFirstId(ih);
+  return name;
+}
+
+IUP_SDK_API void* iupAttribGetCurr(Ihandle* ih)
+{
+  if (iupIdTableIsIterating(ih->attrib_id))
+    return iupIdTableGetCurr(ih->attrib_id);
+  return iupTableGetCurr(ih->attrib);
+}
+
+IUP_SDK_API int iupAttribGetCurrType(Ihandle* ih)
+{
+  if (iupIdTableIsIterating(ih->attrib_id))
+    return iupIdTableGetCurrType(ih->attrib_id);
+  return iupTableGetCurrType(ih->attrib);
+}
+
+IUP_SDK_API int iupAttribCount(Ihandle* ih)
+{
+  int count = iupTableCount(ih->attrib);
+  if (ih->attrib_id)
+    count += iupIdTableCount(ih->attrib_id);
+  return count;
+}
+
+IUP_SDK_API void iupAttribClear(Ihandle* ih)
+{
+  iupTableClear(ih->attrib);
+  if (ih->attrib_id)
+    iupIdTableClear(ih->attrib_id);
+}
+
+IUP_SDK_API int iupAttribGetMemory(Ihandle* ih, int *count, int *id_count)
+{
+  int size = iupTableGetMemory(ih->attrib);
+  if (count) *count = iupTableCount(ih->attrib);
+  if (id_count) *id_count = 0;
+
+  if (ih->attrib_id)
+  {
+    size += iupIdTableGetMemory(ih->attrib_id);
+    if (id_count) *id_count = iupIdTableCount(ih->attrib_id);
+  }
+
+  return size;
+}
+
 void iupAttribSetTheme(Ihandle* ih, Ihandle* theme)
 {
   /* theme is a IupUser, we assume all attributes are strings */
@@ -48,16 +341,16 @@ void iupAttribSetTheme(Ihandle* ih, Ihandle* theme)
   if (!iupObjectCheck(theme))
     return;
 
-  name = iupTableFirst(theme->attrib);
+  name = iupAttribFirst(theme);
   while (name)
   {
     if (iupClassObjectAttribCanCopy(ih, name))
     {
-      value = iupTableGetCurr(theme->attrib);
+      value = iupAttribGetCurr(theme);
       IupStoreAttribute(ih, name, value);
     }
 
-    name = iupTableNext(theme->attrib);
+    name = iupAttribNext(theme);
   }
 
   snprintf(class_name, sizeof(class_name), "IUP%s", ih->iclass->name);
@@ -83,16 +376,16 @@ IUP_API void IupCopyAttributes(Ihandle* src_ih, Ihandle* dst_ih)
   if (!iupObjectCheck(dst_ih))
     return;
 
-  name = iupTableFirst(src_ih->attrib);
+  name = iupAttribFirst(src_ih);
   while (name)
   {
     if (!iupATTRIB_ISINTERNAL(name) && !iupAttribIsNotString(src_ih, name))
     {
-      value = iupTableGetCurr(src_ih->attrib);
+      value = iupAttribGetCurr(src_ih);
       IupStoreAttribute(dst_ih, name, value);
     }
 
-    name = iupTableNext(src_ih->attrib);
+    name = iupAttribNext(src_ih);
   }
 }
 
@@ -106,9 +399,9 @@ IUP_API int IupGetAllAttributes(Ihandle* ih, char** names, int n)
     return 0;
 
   if (!names || n == 0 || n == -1)
-    return iupTableCount(ih->attrib);
+    return iupAttribCount(ih);
 
-  name = iupTableFirst(ih->attrib);
+  name = iupAttribFirst(ih);
   while (name)
   {
     if (!iupATTRIB_ISINTERNAL(name))
@@ -120,7 +413,7 @@ IUP_API int IupGetAllAttributes(Ihandle* ih, char** names, int n)
         break;
     }
 
-    name = iupTableNext(ih->attrib);
+    name = iupAttribNext(ih);
   }
 
   return i;
@@ -140,7 +433,7 @@ IUP_API char* IupGetAttributes(Ihandle *ih)
   buffer = iupStrGetLargeMem(&size);
   buffer[0] = 0;
 
-  name = iupTableFirst(ih->attrib);
+  name = iupAttribFirst(ih);
   {
     int pos = 0;
     while (name && pos < size - 1)
@@ -149,7 +442,7 @@ IUP_API char* IupGetAttributes(Ihandle *ih)
       {
         int written;
 
-        value = iupTableGetCurr(ih->attrib);
+        value = iupAttribGetCurr(ih);
         if (iupAttribIsNotString(ih, name))
         {
           snprintf(sb, sizeof(sb), "%p", (void*) value);
@@ -161,7 +454,7 @@ IUP_API char* IupGetAttributes(Ihandle *ih)
           pos += written;
       }
 
-      name = iupTableNext(ih->attrib);
+      name = iupAttribNext(ih);
     }
   }
 
@@ -174,14 +467,16 @@ void iupAttribUpdateFromParent(Ihandle* ih)
   char *name = iupTableFirst(ic->attrib_func);
   while (name)
   {
-    /* if inheritable and NOT defined at the element */
-    if (iupClassObjectCurAttribIsInherit(ic) && !iupAttribGet(ih, name))
+    /* if inheritable and NOT defined at the element,
+       use the atom of the registered name so the name is not hashed at each parent */
+    int atom = iupClassObjectCurAttribAtom(ic);
+    if (iupClassObjectCurAttribIsInherit(ic) && !iupAttribGetAtom(ih, atom))
     {
       /* check in the parent tree if the attribute is defined */
       Ihandle* parent = ih->parent;
       while (parent)
       {
-        char* value = iupTableGet(parent->attrib, name);
+        char* value = iupAttribGetAtom(parent, atom);
         if (value)
         {
           int inherit;
@@ -211,7 +506,7 @@ static void iAttribNotifyChildren(Ihandle *ih, const char* name, const char *val
   Ihandle* child = ih->firstchild;
   while (child)
   {
-    if (!iupTableGet(child->attrib, name))
+    if (!iupAttribGet(child, name))
     {
       /* set only if an inheritable attribute at the child */
       if (iAttribIsInherit(child, name))
@@ -229,17 +524,17 @@ static void iAttribNotifyChildren(Ihandle *ih, const char* name, const char *val
 
 void iupAttribUpdateChildren(Ihandle* ih)
 {
-  char *name = iupTableFirst(ih->attrib);
+  char *name = iupAttribFirst(ih);
   while (name)
   {
     if (!iupATTRIB_ISINTERNAL(name) && iAttribIsInherit(ih, name))
     {
       /* retrieve from the table */
-      char* value = iupTableGet(ih->attrib, name);
+      char* value = iupAttribGetCurr(ih);
       iAttribNotifyChildren(ih, name, value);
     }
 
-    name = iupTableNext(ih->attrib);
+    name = iupAttribNext(ih);
   }
 }
 
@@ -249,7 +544,7 @@ void iupAttribUpdate(Ihandle* ih)
   char *name, *value;
   int count, i = 0, inherit, store;
 
-  count = iupTableCount(ih->attrib);
+  count = iupAttribCount(ih);
   if (!count)
     return;
 
@@ -258,7 +553,7 @@ void iupAttribUpdate(Ihandle* ih)
     return;
 
   /* store the names before updating so we can add or remove attributes during the update */
-  name = iupTableFirst(ih->attrib);
+  name = iupAttribFirst(ih);
   while (name)
   {
     if (!iupATTRIB_ISINTERNAL(name))
@@ -267,7 +562,7 @@ void iupAttribUpdate(Ihandle* ih)
       i++;
     }
 
-    name = iupTableNext(ih->attrib);
+    name = iupAttribNext(ih);
   }
   count = i;
 
@@ -277,7 +572,7 @@ void iupAttribUpdate(Ihandle* ih)
     name = name_array[i];
 
     /* retrieve from the table */
-    value = iupTableGet(ih->attrib, name);
+    value = iupAttribGet(ih, name);
 
     /* set on the class */
     store = iupClassObjectSetAttribute(ih, name, value, &inherit);
@@ -286,7 +581,7 @@ void iupAttribUpdate(Ihandle* ih)
       iAttribNotifyChildren(ih, name, value);
 
     if (store == 0)
-      iupTableRemove(ih->attrib, name); /* remove from the table according to the class SetAttribute */
+      iupAttribSet(ih, name, NULL); /* remove from the table according to the class SetAttribute */
 
     free(name_array[i]);
   }
@@ -602,10 +897,137 @@ IUP_API void IupSetRGBId2(Ihandle *ih, const char* name, int lin, int col, unsig
   IupStoreAttributeId2(ih, name, lin, col, value);
 }
 
-IUP_API void IupSetAttribute(Ihandle *ih, const char* name, const char *value)
+static void iAttribSetAtom(Ihandle *ih, int atom, const char* name, const char *value)
 {
   int inherit;
 
+  if (iupClassObjectSetAttributeAtom(ih, atom, value, &inherit)!=0) /* store strings and pointers */
+    iupAttribSetAtom(ih, atom, value);
+
+  if (inherit)
+    iAttribNotifyChildren(ih, name, value);
+}
+
+static void iAttribStoreAtom(Ihandle *ih, int atom, const char* name, const char *value)
+{
+  int inherit, store = 1;
+
+  if (iupATTRIB_LANGUAGE_STRING(value))
+    iupATTRIB_GET_LANGUAGE_STRING(value, store);
+
+  if (iupClassObjectSetAttributeAtom(ih, atom, value, &inherit)==1) /* store only strings */
+  {
+    if (store)
+      iupAttribSetStrAtom(ih, atom, value);
+    else
+      iupAttribSetAtom(ih, atom, value);
+  }
+
+  if (inherit)
+    iAttribNotifyChildren(ih, name, value);
+}
+
+static char* iAttribGetAtom(Ihandle *ih, int atom)
+{
+  int inherit;
+  char *value, *def_value;
+
+  value = iupClassObjectGetAttributeAtom(ih, atom, &def_value, &inherit);
+
+  if (!value)
+    value = iupAttribGetAtom(ih, atom);
+
+  if (!value && inherit)
+  {
+    while (!value)
+    {
+      ih = ih->parent;
+      if (!ih)
+        break;
+
+      value = iupAttribGetAtom(ih, atom);
+    }
+  }
+
+  if (!value)
+    value = def_value;
+
+  return value;
+}
+
+IUP_API void IupSetAttributeAtom(Ihandle *ih, int atom, const char *value)
+{
+  const char* name = iupAtomGetName(atom);
+
+  iupASSERT(name!=NULL);
+  if (!name)
+    return;
+
+  if (!ih)
+  {
+    IupSetGlobal(name, value);
+    return;
+  }
+
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return;
+
+  if (iupATTRIB_ISINTERNAL(name))
+    iupAttribSetAtom(ih, atom, value);
+  else
+    iAttribSetAtom(ih, atom, name, value);
+}
+
+IUP_API void IupSetStrAttributeAtom(Ihandle *ih, int atom, const char *value)
+{
+  const char* name = iupAtomGetName(atom);
+
+  iupASSERT(name!=NULL);
+  if (!name)
+    return;
+
+  if (!ih)
+  {
+    IupStoreGlobal(name, value);
+    return;
+  }
+
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return;
+
+  if (iupATTRIB_ISINTERNAL(name))
+    iupAttribSetStrAtom(ih, atom, value);
+  else
+    iAttribStoreAtom(ih, atom, name, value);
+}
+
+IUP_API char* IupGetAttributeAtom(Ihandle *ih, int atom)
+{
+  const char* name = iupAtomGetName(atom);
+
+  iupASSERT(name!=NULL);
+  if (!name)
+    return NULL;
+
+  if (!ih)
+    return IupGetGlobal(name);
+
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return NULL;
+
+  if (iupATTRIB_ISINTERNAL(name))
+    return iupAttribGetAtom(ih, atom);
+  else
+    return iAttribGetAtom(ih, atom);
+}
+
+IUP_API void IupSetAttribute(Ihandle *ih, const char* name, const char *value)
+{
+  int inherit, atom;
+
   iupASSERT(name!=NULL);
   if (!name)
     return;
@@ -622,6 +1044,8 @@ IUP_API void IupSetAttribute(Ihandle *ih, const char* name, const char *value)
 
   if (iupATTRIB_ISINTERNAL(name))
     iupAttribSet(ih, name, value);
+  else if ((atom = iupAtomFind(name)) != 0)  /* registered names are always interned */
+    iAttribSetAtom(ih, atom, name, value);
   else
   {
     if (iupClassObjectSetAttribute(ih, name, value, &inherit)!=0) /* store strings and pointers */
@@ -639,7 +1063,7 @@ IUP_API void IupSetStrAttribute(Ihandle *ih, const char* name, const char *value
 
 IUP_API void IupStoreAttribute(Ihandle *ih, const char* name, const char *value)
 {
-  int inherit;
+  int inherit, atom;
 
   if (!name)
     return;
@@ -656,6 +1080,8 @@ IUP_API void IupStoreAttribute(Ihandle *ih, const char* name, const char *value)
 
   if (iupATTRIB_ISINTERNAL(name))
     iupAttribSetStr(ih, name, value);
+  else if ((atom = iupAtomFind(name)) != 0)  /* registered names are always interned */
+    iAttribStoreAtom(ih, atom, name, value);
   else
   {
     int store = 1;
@@ -726,9 +1152,13 @@ IUP_API char* IupGetAttribute(Ihandle *ih, const char* name)
     return iupAttribGet(ih, name);
   else
   {
-    int inherit;
+    int inherit, atom;
     char *value, *def_value;
 
+    atom = iupAtomFind(name);
+    if (atom)   /* registered names are always interned */
+      return iAttribGetAtom(ih, atom);
+
     value = iupClassObjectGetAttribute(ih, name, &def_value, &inherit);
 
     if (!value)
@@ -935,26 +1365,6 @@ IUP_API void IupSetAttributeHandle(Ihandle* ih, const char* name, Ihandle* ih_na
   IupStoreAttribute(ih, name, handle_name);
 }
 
-static void iAttribSetNameId2(char* nameid, int nameid_size, const char* name, int lin, int col)
-{
-  if (lin == IUP_INVALID_ID && col == IUP_INVALID_ID)
-    snprintf(nameid, nameid_size, "%s", name);
-  else if (lin == IUP_INVALID_ID)
-    snprintf(nameid, nameid_size, "%s*:%d", name, col);
-  else if (col == IUP_INVALID_ID)
-    snprintf(nameid, nameid_size, "%s%d:*", name, lin);
-  else
-    snprintf(nameid, nameid_size, "%s%d:%d", name, lin, col);
-}
-
-static void iAttribSetNameId(char* nameid, int nameid_size, const char* name, int id)
-{
-  if (id == IUP_INVALID_ID)
-    snprintf(nameid, nameid_size, "%s", name);
-  else
-    snprintf(nameid, nameid_size, "%s%d", name, id);
-}
-
 IUP_API void IupSetAttributeHandleId(Ihandle* ih, const char* name, int id, Ihandle* ih_named)
 {
   char nameid[100];
@@ -1053,17 +1463,63 @@ IUP_SDK_API char* iupAttribGetClassObjectId2(Ihandle* ih, const char* name, int
 }
 
 IUP_SDK_API void iupAttribSet(Ihandle* ih, const char* name, const char* value)
+{
+  iAttribSetItem(ih, name, value, IUPTABLE_POINTER);
+}
+
+IUP_SDK_API void iupAttribSetStr(Ihandle* ih, const char* name, const char* value)
 {
   if (!value)
-    iupTableRemove(ih->attrib, name);
+    iAttribSetItem(ih, name, NULL, IUPTABLE_POINTER);
   else
-    iupTableSet(ih->attrib, name, (void*)value, IUPTABLE_POINTER);
+  {
+    int store = 1;
+
+    if (iupATTRIB_LANGUAGE_STRING(value))
+      iupATTRIB_GET_LANGUAGE_STRING(value, store);
+
+    if (store)
+      iAttribSetItem(ih, name, value, IUPTABLE_STRING);
+    else
+      iAttribSetItem(ih, name, value, IUPTABLE_POINTER);
+  }
 }
 
-IUP_SDK_API void iupAttribSetStr(Ihandle* ih, const char* name, const char* value)
+/* an atom can also be created for a name with ids, for instance using IupGetAtom("TITLE1") */
+#define iAttribAtomHasId(_name) (_name[0] && iAttribIsIdChar(_name[strlen(_name) - 1]))
+
+IUP_SDK_API void iupAttribSetAtom(Ihandle* ih, int atom, const char* value)
 {
+  const char* name = iupAtomGetName(atom);
+  if (!name)
+    return;
+
+  if (iAttribAtomHasId(name))
+  {
+    iupAttribSet(ih, name, value);
+    return;
+  }
+
   if (!value)
-    iupTableRemove(ih->attrib, name);
+    iupTableRemoveHashed(ih->attrib, name, iupAtomGetHash(atom));
+  else
+    iupTableSetHashed(ih->attrib, name, iupAtomGetHash(atom), (void*)value, IUPTABLE_POINTER);
+}
+
+IUP_SDK_API void iupAttribSetStrAtom(Ihandle* ih, int atom, const char* value)
+{
+  const char* name = iupAtomGetName(atom);
+  if (!name)
+    return;
+
+  if (iAttribAtomHasId(name))
+  {
+    iupAttribSetStr(ih, name, value);
+    return;
+  }
+
+  if (!value)
+    iupTableRemoveHashed(ih->attrib, name, iupAtomGetHash(atom));
   else
   {
     int store = 1;
@@ -1072,9 +1528,9 @@ IUP_SDK_API void iupAttribSetStr(Ihandle* ih, const char* name, const char* valu
       iupATTRIB_GET_LANGUAGE_STRING(value, store);
 
     if (store)
-      iupTableSet(ih->attrib, name, (void*)value, IUPTABLE_STRING);
+      iupTableSetHashed(ih->attrib, name, iupAtomGetHash(atom), (void*)value, IUPTABLE_STRING);
     else
-      iupTableSet(ih->attrib, name, (void*)value, IUPTABLE_POINTER);
+      iupTableSetHashed(ih->attrib, name, iupAtomGetHash(atom), (void*)value, IUPTABLE_POINTER);
   }
 }
 
@@ -1111,168 +1567,233 @@ IUP_SDK_API void iupAttribSetDouble(Ihandle *ih, const char* name, double num)
 
 IUP_SDK_API void iupAttribSetId(Ihandle *ih, const char* name, int id, const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  iupAttribSet(ih, nameid, value);
+  if (iAttribIsDirectId(name, id, IATTRIB_NOID2))
+    iAttribSetIdItem(ih, name, id, IATTRIB_NOID2, value, IUPTABLE_POINTER);
+  else
+  {
+    char nameid[100];
+    iAttribSetNameId(nameid, sizeof(nameid), name, id);
+    iupAttribSet(ih, nameid, value);
+  }
 }
 
 IUP_SDK_API void iupAttribSetStrId(Ihandle *ih, const char* name, int id, const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  iupAttribSetStr(ih, nameid, value);
+  if (iAttribIsDirectId(name, id, IATTRIB_NOID2))
+    iAttribSetStrIdItem(ih, name, id, IATTRIB_NOID2, value);
+  else
+  {
+    char nameid[100];
+    iAttribSetNameId(nameid, sizeof(nameid), name, id);
+    iupAttribSetStr(ih, nameid, value);
+  }
 }
 
 IUP_SDK_API void iupAttribSetId2(Ihandle *ih, const char* name, int lin, int col, const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  iupAttribSet(ih, nameid, value);
+  if (iAttribIsDirectId(name, lin, col))
+    iAttribSetIdItem(ih, name, lin, col, value, IUPTABLE_POINTER);
+  else
+  {
+    char nameid[100];
+    iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
+    iupAttribSet(ih, nameid, value);
+  }
 }
 
 IUP_SDK_API void iupAttribSetStrId2(Ihandle *ih, const char* name, int lin, int col, const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  iupAttribSetStr(ih, nameid, value);
+  if (iAttribIsDirectId(name, lin, col))
+    iAttribSetStrIdItem(ih, name, lin, col, value);
+  else
+  {
+    char nameid[100];
+    iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
+    iupAttribSetStr(ih, nameid, value);
+  }
 }
 
 IUP_SDK_API void iupAttribSetIntId(Ihandle *ih, const char* name, int id, int num)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  iupAttribSetInt(ih, nameid, num);
+  char value[20];  /* +4,294,967,296 */
+  snprintf(value, sizeof(value), "%d", num);
+  iupAttribSetStrId(ih, name, id, value);
 }
 
 IUP_SDK_API void iupAttribSetIntId2(Ihandle *ih, const char* name, int lin, int col, int num)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  iupAttribSetInt(ih, nameid, num);
+  char value[20];  /* +4,294,967,296 */
+  snprintf(value, sizeof(value), "%d", num);
+  iupAttribSetStrId2(ih, name, lin, col, value);
 }
 
 IUP_SDK_API void iupAttribSetFloatId(Ihandle *ih, const char* name, int id, float num)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  iupAttribSetFloat(ih, nameid, num);
+  char value[80];
+  snprintf(value, sizeof(value), IUP_FLOAT2STR, num);
+  iupAttribSetStrId(ih, name, id, value);
 }
 
 IUP_SDK_API void iupAttribSetDoubleId(Ihandle *ih, const char* name, int id, double num)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  iupAttribSetDouble(ih, nameid, num);
+  char value[80];
+  snprintf(value, sizeof(value), IUP_DOUBLE2STR, num);
+  iupAttribSetStrId(ih, name, id, value);
 }
 
 IUP_SDK_API void iupAttribSetFloatId2(Ihandle *ih, const char* name, int lin, int col, float num)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  iupAttribSetFloat(ih, nameid, num);
+  char value[80];
+  snprintf(value, sizeof(value), IUP_FLOAT2STR, num);
+  iupAttribSetStrId2(ih, name, lin, col, value);
 }
 
 IUP_SDK_API void iupAttribSetDoubleId2(Ihandle *ih, const char* name, int lin, int col, double num)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  iupAttribSetDouble(ih, nameid, num);
+  char value[80];
+  snprintf(value, sizeof(value), IUP_DOUBLE2STR, num);
+  iupAttribSetStrId2(ih, name, lin, col, value);
 }
 
 IUP_SDK_API char* iupAttribGetId(Ihandle* ih, const char* name, int id)
 {
   char nameid[100];
+
+  if (!ih || !name)
+    return NULL;
+
+  if (iAttribIsDirectId(name, id, IATTRIB_NOID2))
+    return iAttribGetIdItem(ih, name, id, IATTRIB_NOID2);
+
   iAttribSetNameId(nameid, sizeof(nameid), name, id);
   return iupAttribGet(ih, nameid);
 }
 
-IUP_SDK_API int iupAttribGetIntId(Ihandle* ih, const char* name, int id)
+IUP_SDK_API char* iupAttribGetId2(Ihandle* ih, const char* name, int lin, int col)
 {
   char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  return iupAttribGetInt(ih, nameid);
+
+  if (!ih || !name)
+    return NULL;
+
+  if (iAttribIsDirectId(name, lin, col))
+    return iAttribGetIdItem(ih, name, lin, col);
+
+  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
+  return iupAttribGet(ih, nameid);
 }
 
-IUP_SDK_API int iupAttribGetBooleanId(Ihandle* ih, const char* name, int id)
+/* same as iupAttribGetStr using the name with ids,
+   but when the value is stored at the element there is no need to build the name */
+static char* iAttribGetStrId(Ihandle* ih, const char* name, int id1, int id2)
 {
   char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  return iupAttribGetBoolean(ih, nameid);
+
+  if (!ih || !name)
+    return NULL;
+
+  if (iAttribIsDirectId(name, id1, id2))
+  {
+    char* value = iAttribGetIdItem(ih, name, id1, id2);
+    if (value)
+      return value;
+  }
+
+  if (id2 == IATTRIB_NOID2)
+    iAttribSetNameId(nameid, sizeof(nameid), name, id1);
+  else
+    iAttribSetNameId2(nameid, sizeof(nameid), name, id1, id2);
+  return iupAttribGetStr(ih, nameid);
 }
 
-IUP_SDK_API float iupAttribGetFloatId(Ihandle* ih, const char* name, int id)
+static int iAttribStrToBoolean(const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  return iupAttribGetFloat(ih, nameid);
+  if (value)
+  {
+    if (iupStrBoolean(value))
+      return 1;
+  }
+  return 0;
 }
 
-IUP_SDK_API double iupAttribGetDoubleId(Ihandle* ih, const char* name, int id)
+static int iAttribStrToInt(const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId(nameid, sizeof(nameid), name, id);
-  return iupAttribGetDouble(ih, nameid);
+  int i = 0;
+  if (value)
+  {
+    if (!iupStrToInt(value, &i))
+    {
+      if (iupStrBoolean(value))
+        i = 1;
+    }
+  }
+  return i;
 }
 
-IUP_SDK_API char* iupAttribGetId2(Ihandle* ih, const char* name, int lin, int col)
+static float iAttribStrToFloat(const char* value)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  return iupAttribGet(ih, nameid);
+  float f = 0;
+  if (value)
+    iupStrToFloat(value, &f);
+  return f;
+}
+
+static double iAttribStrToDouble(const char* value)
+{
+  double f = 0;
+  if (value)
+    iupStrToDouble(value, &f);
+  return f;
+}
+
+IUP_SDK_API int iupAttribGetIntId(Ihandle* ih, const char* name, int id)
+{
+  return iAttribStrToInt(iAttribGetStrId(ih, name, id, IATTRIB_NOID2));
+}
+
+IUP_SDK_API int iupAttribGetBooleanId(Ihandle* ih, const char* name, int id)
+{
+  return iAttribStrToBoolean(iAttribGetStrId(ih, name, id, IATTRIB_NOID2));
+}
+
+IUP_SDK_API float iupAttribGetFloatId(Ihandle* ih, const char* name, int id)
+{
+  return iAttribStrToFloat(iAttribGetStrId(ih, name, id, IATTRIB_NOID2));
+}
+
+IUP_SDK_API double iupAttribGetDoubleId(Ihandle* ih, const char* name, int id)
+{
+  return iAttribStrToDouble(iAttribGetStrId(ih, name, id, IATTRIB_NOID2));
 }
 
 IUP_SDK_API int iupAttribGetIntId2(Ihandle* ih, const char* name, int lin, int col)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  return iupAttribGetInt(ih, nameid);
+  return iAttribStrToInt(iAttribGetStrId(ih, name, lin, col));
 }
 
 IUP_SDK_API int iupAttribGetBooleanId2(Ihandle* ih, const char* name, int lin, int col)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  return iupAttribGetBoolean(ih, nameid);
+  return iAttribStrToBoolean(iAttribGetStrId(ih, name, lin, col));
 }
 
 IUP_SDK_API float iupAttribGetFloatId2(Ihandle* ih, const char* name, int lin, int col)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  return iupAttribGetFloat(ih, nameid);
+  return iAttribStrToFloat(iAttribGetStrId(ih, name, lin, col));
 }
 
 IUP_SDK_API double iupAttribGetDoubleId2(Ihandle* ih, const char* name, int lin, int col)
 {
-  char nameid[100];
-  iAttribSetNameId2(nameid, sizeof(nameid), name, lin, col);
-  return iupAttribGetDouble(ih, nameid);
+  return iAttribStrToDouble(iAttribGetStrId(ih, name, lin, col));
 }
 
 IUP_SDK_API int iupAttribGetBoolean(Ihandle* ih, const char* name)
 {
-  char *value = iupAttribGetStr(ih, name);
-  if (value)
-  {
-    if (iupStrBoolean(value))
-      return 1;
-  }
-  return 0;
+  return iAttribStrToBoolean(iupAttribGetStr(ih, name));
 }
 
 IUP_SDK_API int iupAttribGetInt(Ihandle* ih, const char* name)
 {
-  int i = 0;
-  char *value = iupAttribGetStr(ih, name);
-  if (value)
-  {
-    if (!iupStrToInt(value, &i))
-    {
-      if (iupStrBoolean(value))
-        i = 1;
-    }
-  }
-  return i;
+  return iAttribStrToInt(iupAttribGetStr(ih, name));
 }
 
 IUP_SDK_API int iupAttribGetIntInt(Ihandle *ih, const char* name, int *i1, int *i2, char sep)
@@ -1291,27 +1812,29 @@ IUP_SDK_API int iupAttribGetIntInt(Ihandle *ih, const char* name, int *i1, int *
 
 IUP_SDK_API float iupAttribGetFloat(Ihandle* ih, const char* name)
 {
-  float f = 0;
-  char *value = iupAttribGetStr(ih, name);
-  if (value)
-    iupStrToFloat(value, &f);
-  return f;
+  return iAttribStrToFloat(iupAttribGetStr(ih, name));
 }
 
 IUP_SDK_API double iupAttribGetDouble(Ihandle* ih, const char* name)
 {
-  double f = 0;
-  char *value = iupAttribGetStr(ih, name);
-  if (value)
-    iupStrToDouble(value, &f);
-  return f;
+  return iAttribStrToDouble(iupAttribGetStr(ih, name));
 }
 
 IUP_SDK_API char* iupAttribGet(Ihandle* ih, const char* name)
 {
   if (!ih || !name)
     return NULL;
-  return iupTableGet(ih->attrib, name);
+  return iAttribGetItem(ih, name);
+}
+
+IUP_SDK_API char* iupAttribGetAtom(Ihandle* ih, int atom)
+{
+  const char* name = iupAtomGetName(atom);
+  if (!ih || !name)
+    return NULL;
+  if (iAttribAtomHasId(name))
+    return iAttribGetItem(ih, name);
+  return iupTableGetHashed(ih->attrib, name, iupAtomGetHash(atom));
 }
 
 IUP_SDK_API char* iupAttribGetStr(Ihandle* ih, const char* name)
@@ -1320,7 +1843,7 @@ IUP_SDK_API char* iupAttribGetStr(Ihandle* ih, const char* name)
   if (!ih || !name)
     return NULL;
 
-  value = iupTableGet(ih->attrib, name);
+  value = iAttribGetItem(ih, name);
 
   if (!value && !iupATTRIB_ISINTERNAL(name))
   {
@@ -1353,7 +1876,7 @@ IUP_SDK_API char* iupAttribGetLocal(Ihandle* ih, const char* name)
   if (!ih || !name)
     return NULL;
 
-  value = iupTableGet(ih->attrib, name);
+  value = iAttribGetItem(ih, name);
 
   if (!value && !iupATTRIB_ISINTERNAL(name))
   {
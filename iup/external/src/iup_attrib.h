@@ -66,7 +66,10 @@ IUP_SDK_API void iupAttribSetStrf(Ihandle *ih, const char* name, const char* for
  * \ingroup attrib */
 IUP_SDK_API void iupAttribSetInt(Ihandle *ih, const char* name, int num);
 
-/** Same as \ref iupAttribSet with an id.
+/** Same as \ref iupAttribSet with an id. \n
+ * Numbered attributes are stored in a separate table indexed by the name atom and the ids,
+ * so no string is built for the name. The same attribute can also be accessed using the name with the ids,
+ * for instance "BGCOLOR3:5" is the same as using "BGCOLOR", 3 and 5.
  * \ingroup attrib */
 IUP_SDK_API void iupAttribSetId(Ihandle *ih, const char* name, int id, const char* value);
 
@@ -119,12 +122,24 @@ IUP_SDK_API void iupAttribSetDoubleId(Ihandle *ih, const char* name, int id, dou
 * \ingroup attrib */
 IUP_SDK_API void iupAttribSetDoubleId2(Ihandle *ih, const char* name, int lin, int col, double num);
 
+/** Same as \ref iupAttribSet but uses an atom instead of the name. See \ref iup_atom.h.
+ * \ingroup attrib */
+IUP_SDK_API void iupAttribSetAtom(Ihandle* ih, int atom, const char* value);
+
+/** Same as \ref iupAttribSetStr but uses an atom instead of the name. See \ref iup_atom.h.
+ * \ingroup attrib */
+IUP_SDK_API void iupAttribSetStrAtom(Ihandle* ih, int atom, const char* value);
+
 
 /** Returns the attribute from the hash table only.  \n
  * NO inheritance, NO control implementation, NO default value here. \n
  * \ingroup attrib */
 IUP_SDK_API char* iupAttribGet(Ihandle* ih, const char* name);
 
+/** Same as \ref iupAttribGet but uses an atom instead of the name. See \ref iup_atom.h.
+ * \ingroup attrib */
+IUP_SDK_API char* iupAttribGetAtom(Ihandle* ih, int atom);
+
 /** Returns the attribute from the hash table as a string, 
  * but if not defined then checks in its parent tree if allowed by the control implementation, 
  * if still not defined then returns the registered default value if any.
@@ -241,6 +256,37 @@ IUP_SDK_API char* iupAttribGetClassObject(Ihandle* ih, const char* name);
 IUP_SDK_API char* iupAttribGetClassObjectId(Ihandle* ih, const char* name, int id);
 IUP_SDK_API char* iupAttribGetClassObjectId2(Ihandle* ih, const char* name, int lin, int col);
 
+/** Starts an iteration over all the attributes stored at the element,
+ * including the numbered attributes. Returns the attribute name or NULL. \n
+ * Attributes must not be set or removed at the element during the iteration.
+ * \ingroup attrib */
+IUP_SDK_API char* iupAttribFirst(Ihandle* ih);
+
+/** Continues the iteration started with \ref iupAttribFirst. Returns NULL at the end.
+ * \ingroup attrib */
+IUP_SDK_API char* iupAttribNext(Ihandle* ih);
+
+/** Returns the value of the current attribute in the iteration.
+ * \ingroup attrib */
+IUP_SDK_API void* iupAttribGetCurr(Ihandle* ih);
+
+/** Returns the type of the current attribute in the iteration, see \ref Itable_Types.
+ * \ingroup attrib */
+IUP_SDK_API int iupAttribGetCurrType(Ihandle* ih);
+
+/** Returns the number of attributes stored at the element, including internal and numbered attributes.
+ * \ingroup attrib */
+IUP_SDK_API int iupAttribCount(Ihandle* ih);
+
+/** Removes all the attributes stored at the element.
+ * \ingroup attrib */
+IUP_SDK_API void iupAttribClear(Ihandle* ih);
+
+/** Returns the approximate number of bytes used to store the element attributes.
+ * Optionally returns the number of named and numbered attributes.
+ * \ingroup attrib */
+IUP_SDK_API int iupAttribGetMemory(Ihandle* ih, int *count, int *id_count);
+
 /* For all attributes in the environment, call the class SetAttribute only.
  * Called only after the element is mapped, but before the children are mapped. */
 void iupAttribUpdate(Ihandle* ih);
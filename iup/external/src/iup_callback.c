@@ -10,6 +10,7 @@
 #include "iup.h"
 
 #include "iup_object.h"
+#include "iup_attrib.h"
 #include "iup_assert.h"
 #include "iup_varg.h"
 
@@ -19,6 +20,9 @@ char* iupGetCallbackName(Ihandle *ih, const char *name)
   void* value;
   Icallback func = (Icallback)iupTableGetFunc(ih->attrib, name, &value);
 
+  if (!func && !value)
+    value = iupAttribGet(ih, name);  /* names with numbers, like "K_F1", are stored as numbered attributes */
+
   if (!func && value)
   {
     /* if not a IUPTABLE_FUNCPOINTER then it is an old fashion name */
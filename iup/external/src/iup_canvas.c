@@ -13,9 +13,12 @@
 #include "iup_object.h"
 #include "iup_attrib.h"
 #include "iup_str.h"
+#include "iup_drv.h"
 #include "iup_drvfont.h"
 #include "iup_stdcontrols.h"
 #include "iup_canvas.h"
+#include "iup_drvdraw.h"
+#include "iup_draw.h"
 
 
 void iupCanvasCalcScrollIntPos(double min, double max, double page, double pos, int imin, int imax, int *ipage,  int *ipos)
@@ -48,6 +51,15 @@ void iupCanvasCalcScrollRealPos(double min, double max, double *pos, int imin, i
   *pos = min + ((double)(*ipos-imin))/ratio;
 }
 
+static int iCanvasSetUpdateRectAttrib(Ihandle* ih, const char* value)
+{
+  /* drivers that do not support partial invalidation redraw the whole canvas */
+  if (ih->handle)
+    iupdrvPostRedraw(ih);
+  (void)value;
+  return 0;
+}
+
 char* iupCanvasGetPosXAttrib(Ihandle* ih)
 {
   return iupStrReturnDouble(ih->data->posx);
@@ -85,6 +97,11 @@ static int iCanvasCreateMethod(Ihandle* ih, void** params)
   return IUP_NOERROR;
 }
 
+static void iCanvasDestroyMethod(Ihandle* ih)
+{
+  iupDrawReleaseList(ih);
+}
+
 static void iCanvasComputeNaturalSizeMethod(Ihandle* ih, int *w, int *h, int *children_expand)
 {
   int natural_w = 0, natural_h = 0;
@@ -145,6 +162,7 @@ Iclass* iupCanvasNewClass(void)
   ic->New = iupCanvasNewClass;
   ic->Create = iCanvasCreateMethod;
   ic->ComputeNaturalSize = iCanvasComputeNaturalSizeMethod;
+  ic->Destroy = iCanvasDestroyMethod;
 
   ic->LayoutUpdate = iupdrvBaseLayoutUpdateMethod;
   ic->UnMap = iupdrvBaseUnMapMethod;
@@ -194,7 +212,11 @@ Iclass* iupCanvasNewClass(void)
   iupClassRegisterAttribute(ic, "WHEELDROPFOCUS", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
 
   iupClassRegisterAttribute(ic, "BORDER", NULL, NULL, IUPAF_SAMEASSYSTEM, "YES", IUPAF_DEFAULT);
+  iupClassRegisterAttribute(ic, "UPDATERECT", NULL, iCanvasSetUpdateRectAttrib, NULL, NULL, IUPAF_WRITEONLY|IUPAF_NO_INHERIT);
 
+  iupClassRegisterAttribute(ic, "DRAWLIST", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "DRAWHEADLESS", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "DRAWLISTHASH", iupDrawGetListHashAttrib, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NO_DEFAULTVALUE|IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "DRAWFONT", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "DRAWCOLOR", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "DRAWSTYLE", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
@@ -15,6 +15,7 @@
 #include "iup_class.h"
 #include "iup_assert.h"
 #include "iup_drv.h"
+#include "iup_layout.h"
 
 
 IUP_API Ihandle* IupGetDialog(Ihandle* ih)
@@ -47,6 +48,8 @@ static void iChildTreeDetach(Ihandle* parent, Ihandle* child)
 {
   Ihandle *c, *c_prev = NULL;
 
+  iupLayoutMarkDirty(parent);
+
   /* Removes the child entry inside the parent's child list */
   for (c = parent->firstchild; c; c = c->brother)
   {
@@ -211,12 +214,16 @@ IUP_API Ihandle* IupInsert(Ihandle* parent, Ihandle* ref_child, Ihandle* child)
     iupClassObjectChildAdded(parent, child);
   }
 
+  if (child->parent == parent)
+    iupLayoutMarkDirty(child);
+
   return parent;
 }
 
 IUP_SDK_API void iupChildTreeAppend(Ihandle* parent, Ihandle* child)
 {
   child->parent = parent;
+  iupLayoutMarkDirty(child);
 
   if (parent->firstchild == NULL)
     parent->firstchild = child;
@@ -347,6 +354,9 @@ IUP_API int IupReparent(Ihandle* child, Ihandle* parent, Ihandle* ref_child)
     iupChildTreeAppend(parent, child);
   iupClassObjectChildAdded(parent, child);
 
+  /* inherited attributes may be different in the new parent */
+  iupLayoutMarkDirtyTree(child);
+
   /* no need to remap, just notify the native system */
   if (child->handle && parent->handle)
   {
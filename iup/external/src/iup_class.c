@@ -13,6 +13,7 @@
 #include "iup_object.h"
 #include "iup_str.h"
 #include "iup_assert.h"
+#include "iup_atom.h"
 
 
 /*****************************************************************
@@ -282,6 +283,9 @@ IUP_SDK_API void iupClassRelease(Iclass* ic)
   /* attributes functions table is released only once */
   iClassReleaseAttribFuncTable(ic);
 
+  /* atoms may have cached this class and its attribute functions */
+  iupAtomResetCache();
+
   free(ic);
 }
 
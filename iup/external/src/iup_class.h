@@ -413,6 +413,8 @@ int   iupClassObjectSetAttributeId(Ihandle* ih, const char* name, int id, const
 char* iupClassObjectGetAttributeId(Ihandle* ih, const char* name, int id);
 int   iupClassObjectSetAttributeId2(Ihandle* ih, const char* name, int id1, int id2, const char* value);
 char* iupClassObjectGetAttributeId2(Ihandle* ih, const char* name, int id1, int id2);
+int   iupClassObjectSetAttributeAtom(Ihandle* ih, int atom, const char* value, int *inherit);
+char* iupClassObjectGetAttributeAtom(Ihandle* ih, int atom, char* *def_value, int *inherit);
 
 /* Used only in iupAttribGetStr */
 void  iupClassObjectGetAttributeInfo(Ihandle* ih, const char* name, char* *def_value, int *inherit);
@@ -430,6 +432,7 @@ int   iupClassObjectAttribCanCopy(Ihandle* ih, const char* name);
 
 /* Used only in iupAttribUpdateFromParent */
 int   iupClassObjectCurAttribIsInherit(Iclass* ic);
+int   iupClassObjectCurAttribAtom(Iclass* ic);
 
 /* Used in iupObjectCreate and IupMap */
 void iupClassObjectEnsureDefaultAttributes(Ihandle* ih);
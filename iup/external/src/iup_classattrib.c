@@ -17,6 +17,7 @@
 #include "iup_assert.h"
 #include "iup_register.h"
 #include "iup_globalattrib.h"
+#include "iup_atom.h"
 
 
 typedef struct _IattribFunc
@@ -27,8 +28,12 @@ typedef struct _IattribFunc
   const char* system_default;
   int call_global_default;
   int flags;
+  int atom;
 } IattribFunc;
 
+/* cached for atoms with numeric ids, that must be parsed by the string functions */
+static IattribFunc iclass_afunc_nameid;
+
 
 int iupClassIsGlobalDefault(const char* name, int colors)
 {
@@ -170,6 +175,46 @@ int iupClassObjectSetAttributeId(Ihandle* ih, const char* name, int id, const ch
   return 1;  /* function not found, default to string */
 }
 
+static int iClassObjectSetAttribFunc(Ihandle* ih, IattribFunc* afunc, const char* name, const char * value, int *inherit);
+static char* iClassObjectGetAttribFunc(Ihandle* ih, IattribFunc* afunc, char* *def_value, int *inherit);
+
+static IattribFunc* iClassGetAtomFunc(Iclass* ic, int atom)
+{
+  void* afunc;
+
+  if (!iupAtomGetCache(atom, ic, &afunc))
+  {
+    const char* name = iupAtomGetName(atom);
+
+    if (ic->has_attrib_id!=0 && iClassFindId(name))
+      afunc = &iclass_afunc_nameid;
+    else
+      afunc = iupTableGetHashed(ic->attrib_func, name, iupAtomGetHash(atom));  /* can be NULL */
+
+    iupAtomSetCache(atom, ic, afunc);
+  }
+
+  return (IattribFunc*)afunc;
+}
+
+int iupClassObjectSetAttributeAtom(Ihandle* ih, int atom, const char* value, int *inherit)
+{
+  IattribFunc* afunc = iClassGetAtomFunc(ih->iclass, atom);
+  if (afunc == &iclass_afunc_nameid)
+    return iupClassObjectSetAttribute(ih, iupAtomGetName(atom), value, inherit);
+
+  return iClassObjectSetAttribFunc(ih, afunc, iupAtomGetName(atom), value, inherit);
+}
+
+char* iupClassObjectGetAttributeAtom(Ihandle* ih, int atom, char* *def_value, int *inherit)
+{
+  IattribFunc* afunc = iClassGetAtomFunc(ih->iclass, atom);
+  if (afunc == &iclass_afunc_nameid)
+    return iupClassObjectGetAttribute(ih, iupAtomGetName(atom), def_value, inherit);
+
+  return iClassObjectGetAttribFunc(ih, afunc, def_value, inherit);
+}
+
 int iupClassObjectSetAttribute(Ihandle* ih, const char* name, const char * value, int *inherit)
 {
   IattribFunc* afunc;
@@ -224,6 +269,11 @@ int iupClassObjectSetAttribute(Ihandle* ih, const char* name, const char * value
   /* if not has_attrib_id, or not found an ID, or not found the partial name, check using the full name */
 
   afunc = (IattribFunc*)iupTableGet(ih->iclass->attrib_func, name);
+  return iClassObjectSetAttribFunc(ih, afunc, name, value, inherit);
+}
+
+static int iClassObjectSetAttribFunc(Ihandle* ih, IattribFunc* afunc, const char* name, const char * value, int *inherit)
+{
   *inherit = 1; /* default is inheritable */
   if (afunc)
   {
@@ -384,6 +434,11 @@ char* iupClassObjectGetAttribute(Ihandle* ih, const char* name, char* *def_value
   /* if not has_attrib_id, or not found an ID, or not found the partial name, check using the full name */
 
   afunc = (IattribFunc*)iupTableGet(ih->iclass->attrib_func, name);
+  return iClassObjectGetAttribFunc(ih, afunc, def_value, inherit);
+}
+
+static char* iClassObjectGetAttribFunc(Ihandle* ih, IattribFunc* afunc, char* *def_value, int *inherit)
+{
   *def_value = NULL;
   *inherit = 1; /* default is inheritable */
   if (afunc)
@@ -470,6 +525,14 @@ int iupClassObjectCurAttribIsInherit(Iclass* ic)
   return 0;
 }
 
+int iupClassObjectCurAttribAtom(Iclass* ic)
+{
+  IattribFunc* afunc = (IattribFunc*)iupTableGetCurr(ic->attrib_func);
+  if (afunc)
+    return afunc->atom;
+  return 0;
+}
+
 int iupClassObjectAttribCanCopy(Ihandle* ih, const char* name)
 {
   Iclass* ic = ih->iclass;
@@ -553,7 +616,10 @@ IUP_SDK_API void iupClassRegisterAttribute(Iclass* ic, const char* name,
 {
   IattribFunc* afunc = (IattribFunc*)iupTableGet(ic->attrib_func, name);
   if (afunc)
+  {
     free(afunc);  /* overwrite a previous registration */
+    iupAtomResetCache();
+  }
 
 #ifdef IUP_ASSERT
   iClassCheckAttrib(ic, name, _get, _set, _flags);
@@ -574,6 +640,7 @@ IUP_SDK_API void iupClassRegisterAttribute(Iclass* ic, const char* name,
     afunc->call_global_default = 1;
   else
     afunc->call_global_default = 0;
+  afunc->atom = iupAtomGet(name);
 
   iupTableSet(ic->attrib_func, name, (void*)afunc, IUPTABLE_POINTER);
 }
@@ -584,7 +651,10 @@ IUP_SDK_API void iupClassRegisterAttributeId(Iclass* ic, const char* name,
 {
   IattribFunc* afunc = (IattribFunc*)iupTableGet(ic->attrib_func, name);
   if (afunc)
+  {
     free(afunc);  /* overwrite a previous registration */
+    iupAtomResetCache();
+  }
 
 #ifdef IUP_ASSERT
   iClassCheckAttrib(ic, name, (IattribGetFunc)_get, (IattribSetFunc)_set, _flags);
@@ -598,6 +668,7 @@ IUP_SDK_API void iupClassRegisterAttributeId(Iclass* ic, const char* name,
   afunc->system_default = NULL;
   afunc->flags = _flags|IUPAF_HAS_ID|IUPAF_NO_INHERIT|IUPAF_NO_DEFAULTVALUE;
   afunc->call_global_default = 0;
+  afunc->atom = iupAtomGet(name);
 
   iupTableSet(ic->attrib_func, name, (void*)afunc, IUPTABLE_POINTER);
 }
@@ -608,7 +679,10 @@ IUP_SDK_API void iupClassRegisterAttributeId2(Iclass* ic, const char* name,
 {
   IattribFunc* afunc = (IattribFunc*)iupTableGet(ic->attrib_func, name);
   if (afunc)
+  {
     free(afunc);  /* overwrite a previous registration */
+    iupAtomResetCache();
+  }
 
 #ifdef IUP_ASSERT
   iClassCheckAttrib(ic, name, (IattribGetFunc)_get, (IattribSetFunc)_set, _flags);
@@ -622,6 +696,7 @@ IUP_SDK_API void iupClassRegisterAttributeId2(Iclass* ic, const char* name,
   afunc->system_default = NULL;
   afunc->flags = _flags|IUPAF_HAS_ID2|IUPAF_HAS_ID|IUPAF_NO_INHERIT|IUPAF_NO_DEFAULTVALUE;
   afunc->call_global_default = 0;
+  afunc->atom = iupAtomGet(name);
 
   iupTableSet(ic->attrib_func, name, (void*)afunc, IUPTABLE_POINTER);
 }
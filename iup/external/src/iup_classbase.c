@@ -236,6 +236,13 @@ static int iBaseSetPositionAttrib(Ihandle* ih, const char* value)
   return 0;
 }
 
+static char* iBaseGetAttribMemoryAttrib(Ihandle *ih)
+{
+  int count, id_count;
+  int size = iupAttribGetMemory(ih, &count, &id_count);
+  return iupStrReturnStrf("%d:%d:%d", size, count, id_count);
+}
+
 static char* iBaseGetXAttrib(Ihandle *ih)
 {
   int x = 0, y = 0;
@@ -643,6 +650,7 @@ IUP_SDK_API void iupBaseRegisterCommonAttrib(Iclass* ic)
   iupClassRegisterAttribute(ic, "HANDLENAME", NULL, NULL, NULL, NULL, IUPAF_NO_SAVE | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "THEME", NULL, iBaseSetThemeAttrib, NULL, NULL, IUPAF_IHANDLENAME | IUPAF_NOT_MAPPED);
   iupClassRegisterAttribute(ic, "NTHEME", NULL, iBaseSetThemeAttrib, NULL, NULL, IUPAF_IHANDLENAME | IUPAF_NOT_MAPPED | IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "ATTRIBMEMORY", iBaseGetAttribMemoryAttrib, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NOT_MAPPED|IUPAF_NO_INHERIT);
 
   /* make sure everyone has the correct default value */
   iupClassRegisterAttribute(ic, "ACTIVE", NULL, NULL, IUPAF_SAMEASSYSTEM, "YES", IUPAF_DEFAULT);  /* inherited */
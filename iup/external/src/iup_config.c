@@ -344,13 +344,13 @@ IUP_API void IupConfigCopy(Ihandle* ih1, Ihandle* ih2, const char* exclude_prefi
   if (!iupObjectCheck(ih2))
     return;
 
-  name = iupTableFirst(ih1->attrib);
+  name = iupAttribFirst(ih1);
   while (name)
   {
     if (!iupATTRIB_ISINTERNAL(name) && !iupStrEqualPartial(name, exclude_prefix))
-      iupTableSet(ih2->attrib, name, iupTableGet(ih1->attrib, name), IUPTABLE_STRING);
+      iupAttribSetStr(ih2, name, (char*)iupAttribGetCurr(ih1));
 
-    name = iupTableNext(ih1->attrib);
+    name = iupAttribNext(ih1);
   }
 }
 
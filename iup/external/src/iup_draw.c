@@ -20,11 +20,14 @@
 #include "iup_drvdraw.h"
 #include "iup_draw.h"
 #include "iup_draw_svg.h"
+#include "iup_draw_list.h"
+#include "iup_draw_rgba.h"
 #include "iup_assert.h"
 #include "iup_image.h"
 
 
 #define IUP_SVG_GET(ih) ((iSvgCanvas*)iupAttribGet(ih, "_IUP_SVG_CANVAS"))
+#define IUP_DRAWLIST_GET(ih) ((IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LIST"))
 
 static void iSvgColorStr(long color, char* buf, int buf_size)
 {
@@ -38,6 +41,376 @@ static void iSvgColorStr(long color, char* buf, int buf_size)
     snprintf(buf, buf_size, "%d %d %d %d", r, g, b, a);
 }
 
+static void iDrawGetImageRGBA(const char* name, int make_inactive, const char* bgcolor, unsigned char** out_rgba, int* out_w, int* out_h)
+{
+  Ihandle* img_ih;
+
+  *out_rgba = NULL;
+  *out_w = 0;
+  *out_h = 0;
+
+  img_ih = iupImageGetImageFromName(name);
+  if (!img_ih)
+    return;
+
+  *out_rgba = iupImageGetRGBAData(img_ih, make_inactive, bgcolor, out_w, out_h);
+}
+
+static void iDrawSvgImage(iSvgCanvas* svg, const char* name, int make_inactive, const char* bgcolor, long tint, int opacity, int x, int y, int w, int h, int sx, int sy, int sw, int sh, int quality)
+{
+  unsigned char* rgba;
+  int img_w, img_h;
+  iDrawGetImageRGBA(name, make_inactive, bgcolor, &rgba, &img_w, &img_h);
+  if (rgba)
+  {
+    if (sw > 0 && sh > 0 && sw <= img_w && sh <= img_h)
+    {
+      int line;
+      for (line = 0; line < sh; line++)
+        memmove(rgba + (size_t)line * sw * 4, rgba + ((size_t)(sy + line) * img_w + sx) * 4, (size_t)sw * 4);
+      img_w = sw;
+      img_h = sh;
+    }
+
+    if (tint != IUP_DRAW_NO_TINT || opacity < 255)
+    {
+      int i, count = img_w * img_h;
+      int tint_on = (tint != IUP_DRAW_NO_TINT);
+      unsigned char tr = iupDrawRed(tint), tg = iupDrawGreen(tint), tb = iupDrawBlue(tint), ta = iupDrawAlpha(tint);
+      for (i = 0; i < count; i++)
+      {
+        if (tint_on)
+        {
+          rgba[i * 4 + 0] = tr;
+          rgba[i * 4 + 1] = tg;
+          rgba[i * 4 + 2] = tb;
+          rgba[i * 4 + 3] = (unsigned char)((rgba[i * 4 + 3] * ta) / 255);
+        }
+        rgba[i * 4 + 3] = (unsigned char)((rgba[i * 4 + 3] * opacity) / 255);
+      }
+    }
+
+    if (w == -1 || w == 0) w = img_w;
+    if (h == -1 || h == 0) h = img_h;
+    iupSvgDrawImageRGBA(svg, rgba, img_w, img_h, x, y, w, h, quality);
+    free(rgba);
+  }
+}
+
+static void iDrawListPlay(IdrawList* list, IdrawCanvas* dc, iSvgCanvas* svg, iRgbaCanvas* rgba)
+{
+  IdrawListItem item;
+  int pos = 0;
+  char c[32];
+
+  while (iupDrawListNext(list, &pos, &item))
+  {
+    if (svg)
+      iSvgColorStr(item.color, c, sizeof(c));
+
+    switch (item.type)
+    {
+    case IUP_DRAWLIST_LINE:
+      if (svg) iupSvgDrawLine(svg, item.x1, item.y1, item.x2, item.y2, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawLine(rgba, item.x1, item.y1, item.x2, item.y2, item.color, item.style, item.line_width);
+      else iupdrvDrawLine(dc, item.x1, item.y1, item.x2, item.y2, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_RECTANGLE:
+      if (svg) iupSvgDrawRectangle(svg, item.x1, item.y1, item.x2, item.y2, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawRectangle(rgba, item.x1, item.y1, item.x2, item.y2, item.color, item.style, item.line_width);
+      else iupdrvDrawRectangle(dc, item.x1, item.y1, item.x2, item.y2, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_ARC:
+      if (svg) iupSvgDrawArc(svg, item.x1, item.y1, item.x2, item.y2, item.a1, item.a2, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawArc(rgba, item.x1, item.y1, item.x2, item.y2, item.a1, item.a2, item.color, item.style, item.line_width);
+      else iupdrvDrawArc(dc, item.x1, item.y1, item.x2, item.y2, item.a1, item.a2, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_ELLIPSE:
+      if (svg) iupSvgDrawEllipse(svg, item.x1, item.y1, item.x2, item.y2, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawEllipse(rgba, item.x1, item.y1, item.x2, item.y2, item.color, item.style, item.line_width);
+      else iupdrvDrawEllipse(dc, item.x1, item.y1, item.x2, item.y2, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_POLYGON:
+      if (svg) iupSvgDrawPolygon(svg, (int*)item.points, item.count, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawPolygon(rgba, (int*)item.points, item.count, item.color, item.style, item.line_width);
+      else iupdrvDrawPolygon(dc, (int*)item.points, item.count, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_POLYLINE:
+      if (svg) iupSvgDrawPolyline(svg, (int*)item.points, item.count, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawPolyline(rgba, (int*)item.points, item.count, item.color, item.style, item.line_width);
+      else iupdrvDrawPolyline(dc, (int*)item.points, item.count, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_PIXEL:
+      if (svg) iupSvgDrawPixel(svg, item.x1, item.y1, c);
+      else if (rgba) iupRgbaDrawPixel(rgba, item.x1, item.y1, item.color);
+      else iupdrvDrawPixel(dc, item.x1, item.y1, item.color);
+      break;
+    case IUP_DRAWLIST_ROUNDEDRECTANGLE:
+      if (svg) iupSvgDrawRoundedRectangle(svg, item.x1, item.y1, item.x2, item.y2, item.corner_radius, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawRoundedRectangle(rgba, item.x1, item.y1, item.x2, item.y2, item.corner_radius, item.color, item.style, item.line_width);
+      else iupdrvDrawRoundedRectangle(dc, item.x1, item.y1, item.x2, item.y2, item.corner_radius, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_BEZIER:
+      if (svg) iupSvgDrawBezier(svg, item.x1, item.y1, item.x2, item.y2, item.x3, item.y3, item.x4, item.y4, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawBezier(rgba, item.x1, item.y1, item.x2, item.y2, item.x3, item.y3, item.x4, item.y4, item.color, item.style, item.line_width);
+      else iupdrvDrawBezier(dc, item.x1, item.y1, item.x2, item.y2, item.x3, item.y3, item.x4, item.y4, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_QUADRATICBEZIER:
+      if (svg) iupSvgDrawQuadraticBezier(svg, item.x1, item.y1, item.x2, item.y2, item.x3, item.y3, c, item.style, item.line_width);
+      else if (rgba) iupRgbaDrawQuadraticBezier(rgba, item.x1, item.y1, item.x2, item.y2, item.x3, item.y3, item.color, item.style, item.line_width);
+      else iupdrvDrawQuadraticBezier(dc, item.x1, item.y1, item.x2, item.y2, item.x3, item.y3, item.color, item.style, item.line_width);
+      break;
+    case IUP_DRAWLIST_LINEARGRADIENT:
+      if (svg) iupSvgDrawLinearGradient(svg, item.x1, item.y1, item.x2, item.y2, (float)item.a1, item.colors, item.offsets, item.count);
+      else if (rgba) iupRgbaDrawLinearGradient(rgba, item.x1, item.y1, item.x2, item.y2, (float)item.a1, item.colors, item.offsets, item.count);
+      else iupdrvDrawLinearGradient(dc, item.x1, item.y1, item.x2, item.y2, (float)item.a1, item.colors, item.offsets, item.count);
+      break;
+    case IUP_DRAWLIST_RADIALGRADIENT:
+      if (svg) iupSvgDrawRadialGradient(svg, item.x1, item.y1, item.x3, item.colors, item.offsets, item.count);
+      else if (rgba) iupRgbaDrawRadialGradient(rgba, item.x1, item.y1, item.x3, item.colors, item.offsets, item.count);
+      else iupdrvDrawRadialGradient(dc, item.x1, item.y1, item.x3, item.colors, item.offsets, item.count);
+      break;
+    case IUP_DRAWLIST_TEXT:
+      if (svg) iupSvgDrawText(svg, item.text, item.len, item.x1, item.y1, item.x2, item.y2, c, item.font, item.flags, item.a1);
+      else if (rgba) iupRgbaDrawText(rgba, item.text, item.len, item.x1, item.y1, item.x2, item.y2, item.color, item.font, item.flags, item.a1);
+      else iupdrvDrawText(dc, item.text, item.len, item.x1, item.y1, item.x2, item.y2, item.color, item.font, item.flags, item.a1);
+      break;
+    case IUP_DRAWLIST_IMAGE:
+      if (svg) iDrawSvgImage(svg, item.text, item.make_inactive, item.font, item.tint, item.opacity, item.x1, item.y1, item.x2, item.y2, item.sx, item.sy, item.sw, item.sh, item.quality);
+      else if (rgba) iupRgbaDrawImage(rgba, item.text, item.make_inactive, item.font, item.tint, item.opacity, item.x1, item.y1, item.x2, item.y2, item.sx, item.sy, item.sw, item.sh, item.quality);
+      else iupdrvDrawImage(dc, item.text, item.make_inactive, item.font, item.tint, item.opacity, item.x1, item.y1, item.x2, item.y2, item.sx, item.sy, item.sw, item.sh, item.quality);
+      break;
+    case IUP_DRAWLIST_SETCLIPRECT:
+      if (svg) iupSvgDrawSetClipRect(svg, item.x1, item.y1, item.x2, item.y2);
+      else if (rgba) iupRgbaDrawSetClipRect(rgba, item.x1, item.y1, item.x2, item.y2);
+      else iupdrvDrawSetClipRect(dc, item.x1, item.y1, item.x2, item.y2);
+      break;
+    case IUP_DRAWLIST_SETCLIPROUNDEDRECT:
+      if (svg) iupSvgDrawSetClipRoundedRect(svg, item.x1, item.y1, item.x2, item.y2, item.corner_radius);
+      else if (rgba) iupRgbaDrawSetClipRoundedRect(rgba, item.x1, item.y1, item.x2, item.y2, item.corner_radius);
+      else iupdrvDrawSetClipRoundedRect(dc, item.x1, item.y1, item.x2, item.y2, item.corner_radius);
+      break;
+    case IUP_DRAWLIST_RESETCLIP:
+      if (svg) iupSvgDrawResetClip(svg);
+      else if (rgba) iupRgbaDrawResetClip(rgba);
+      else iupdrvDrawResetClip(dc);
+      break;
+    case IUP_DRAWLIST_SELECTRECT:
+      if (svg) iupSvgDrawSelectRect(svg, item.x1, item.y1, item.x2, item.y2);
+      else if (rgba) iupRgbaDrawSelectRect(rgba, item.x1, item.y1, item.x2, item.y2);
+      else iupdrvDrawSelectRect(dc, item.x1, item.y1, item.x2, item.y2);
+      break;
+    case IUP_DRAWLIST_FOCUSRECT:
+      if (svg) iupSvgDrawFocusRect(svg, item.x1, item.y1, item.x2, item.y2);
+      else if (rgba) iupRgbaDrawFocusRect(rgba, item.x1, item.y1, item.x2, item.y2);
+      else iupdrvDrawFocusRect(dc, item.x1, item.y1, item.x2, item.y2);
+      break;
+    }
+  }
+}
+
+static int iDrawIsHeadless(Ihandle* ih)
+{
+  char* value = iupAttribGet(ih, "DRAWHEADLESS");
+  if (!value)
+    value = IupGetGlobal("DRAWHEADLESS");
+  return iupStrBoolean(value);
+}
+
+static void iDrawGetCanvasSize(Ihandle* ih, int *w, int *h)
+{
+  *w = 0;
+  *h = 0;
+
+  IupGetIntInt(ih, "DRAWSIZE", w, h);
+  if (*w > 0 && *h > 0)
+    return;
+
+  /* not mapped, possible only when headless */
+  *w = ih->currentwidth;
+  *h = ih->currentheight;
+  if (*w > 0 && *h > 0)
+    return;
+
+  *w = ih->userwidth;
+  *h = ih->userheight;
+}
+
+static void iDrawListBegin(Ihandle* ih)
+{
+  /* the previous frame is kept in _IUP_DRAW_LISTCACHE, the list is reused from _IUP_DRAW_LISTFREE */
+  IdrawList* list = (IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LISTFREE");
+  int w, h;
+
+  iDrawGetCanvasSize(ih, &w, &h);
+
+  if (list)
+  {
+    iupAttribSet(ih, "_IUP_DRAW_LISTFREE", NULL);
+    iupDrawListClear(list, w, h);
+  }
+  else
+    list = iupDrawListCreate(w, h);
+
+  iupAttribSet(ih, "_IUP_DRAW_LIST", (char*)list);
+  iupAttribSet(ih, "_IUP_DRAW_UPDATERECT", NULL);  /* the changed area will be computed from the list */
+  iupAttribSet(ih, "_IUP_DRAW_DC", (char*)1);
+}
+
+static void iDrawListEnd(Ihandle* ih, IdrawList* list)
+{
+  IdrawList* prev = (IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LISTCACHE");
+  IdrawCanvas* dc;
+  int x1 = 0, y1 = 0, x2 = -1, y2 = -1;
+  int changed = iupDrawListDiff(prev, list, &x1, &y1, &x2, &y2);
+
+  iupAttribSet(ih, "_IUP_DRAW_LIST", NULL);
+  iupAttribSet(ih, "_IUP_DRAW_DC", NULL);
+
+  if (iDrawIsHeadless(ih))
+  {
+    /* the software canvas always keeps the previous frame */
+    iRgbaCanvas* rgba = (iRgbaCanvas*)iupAttribGet(ih, "_IUP_DRAW_RGBA");
+    int w, h, rgba_w = 0, rgba_h = 0;
+
+    iupDrawListGetSize(list, &w, &h);
+    if (rgba)
+      iupRgbaDrawGetSize(rgba, &rgba_w, &rgba_h);
+
+    if (!rgba || rgba_w != w || rgba_h != h)
+    {
+      iupRgbaDrawKillCanvas(rgba);
+      rgba = iupRgbaDrawCreateCanvas(w, h);
+      iupAttribSet(ih, "_IUP_DRAW_RGBA", (char*)rgba);
+      changed = 1;
+    }
+
+    if (rgba && changed)
+    {
+      /* clip items in the list would escape a partial update, so the whole frame is drawn again */
+      iupRgbaDrawResetClip(rgba);
+      iupRgbaDrawClear(rgba);
+      iDrawListPlay(list, NULL, NULL, rgba);
+      iupRgbaDrawResetClip(rgba);
+    }
+
+    iupAttribSet(ih, "DRAWDRIVER", "RGBA");
+    iupAttribSet(ih, "_IUP_DRAW_LISTCACHE", (char*)list);
+    iupAttribSet(ih, "_IUP_DRAW_LISTFREE", (char*)prev);
+    return;
+  }
+
+  /* drivers that keep the previous frame redraw only the changed area, an empty area simply presents it again.
+     The driver ignores the area when its buffer is new, and returns if the buffer was retained. */
+  iupAttribSetStrf(ih, "_IUP_DRAW_UPDATERECT", "%d %d %d %d", x1, y1, x2, y2);
+  dc = iupdrvDrawCreateCanvas(ih);
+  iupAttribSet(ih, "_IUP_DRAW_UPDATERECT", NULL);
+
+  if (!iupAttribGet(ih, "_IUP_DRAW_RETAINED"))
+    iDrawListPlay(list, dc, NULL, NULL);
+  else if (changed)
+  {
+    iupdrvDrawSetClipRect(dc, x1, y1, x2, y2);
+    iDrawListPlay(list, dc, NULL, NULL);
+  }
+
+  iupdrvDrawFlush(dc);
+  iupdrvDrawKillCanvas(dc);
+
+  iupAttribSet(ih, "_IUP_DRAW_LISTCACHE", (char*)list);
+  iupAttribSet(ih, "_IUP_DRAW_LISTFREE", (char*)prev);
+}
+
+IUP_SDK_API void iupDrawReleaseList(Ihandle* ih)
+{
+  IdrawList* list = (IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LISTCACHE");
+  if (list)
+  {
+    iupDrawListKill(list);
+    iupAttribSet(ih, "_IUP_DRAW_LISTCACHE", NULL);
+  }
+
+  list = (IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LISTFREE");
+  if (list)
+  {
+    iupDrawListKill(list);
+    iupAttribSet(ih, "_IUP_DRAW_LISTFREE", NULL);
+  }
+
+  {
+    iRgbaCanvas* rgba = (iRgbaCanvas*)iupAttribGet(ih, "_IUP_DRAW_RGBA");
+    if (rgba)
+    {
+      iupRgbaDrawKillCanvas(rgba);
+      iupAttribSet(ih, "_IUP_DRAW_RGBA", NULL);
+    }
+  }
+}
+
+IUP_SDK_API char* iupDrawGetListHashAttrib(Ihandle* ih)
+{
+  IdrawList* list = (IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LISTCACHE");
+  if (!list)
+    return NULL;
+
+  return iupStrReturnStrf("%08X", iupDrawListGetHash(list));
+}
+
+IUP_SDK_API IdrawList* iupDrawLayerBegin(Ihandle* ih, IdrawList* layer)
+{
+  int w, h;
+
+  if (!iupAttribGet(ih, "_IUP_DRAW_DC") || IUP_SVG_GET(ih))
+    return NULL;
+
+  iDrawGetCanvasSize(ih, &w, &h);
+
+  if (layer)
+    iupDrawListClear(layer, w, h);
+  else
+    layer = iupDrawListCreate(w, h);
+
+  /* the following items are recorded only in the layer, until iupDrawLayerEnd */
+  iupAttribSet(ih, "_IUP_DRAW_LAYERTARGET", iupAttribGet(ih, "_IUP_DRAW_LIST"));
+  iupAttribSet(ih, "_IUP_DRAW_LIST", (char*)layer);
+  return layer;
+}
+
+IUP_SDK_API void iupDrawLayerEnd(Ihandle* ih, IdrawList* layer)
+{
+  iupAttribSet(ih, "_IUP_DRAW_LIST", iupAttribGet(ih, "_IUP_DRAW_LAYERTARGET"));
+  iupAttribSet(ih, "_IUP_DRAW_LAYERTARGET", NULL);
+
+  iupDrawLayerPlay(ih, layer);
+}
+
+IUP_SDK_API int iupDrawLayerPlay(Ihandle* ih, IdrawList* layer)
+{
+  IdrawList* list;
+  int w, h, layer_w, layer_h;
+
+  if (!layer || !iupAttribGet(ih, "_IUP_DRAW_DC") || IUP_SVG_GET(ih))
+    return 0;
+
+  iDrawGetCanvasSize(ih, &w, &h);
+  iupDrawListGetSize(layer, &layer_w, &layer_h);
+  if (layer_w != w || layer_h != h)
+    return 0;
+
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+    iupDrawListAppend(list, layer);
+  else
+    iDrawListPlay(layer, (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), NULL, NULL);
+
+  return 1;
+}
+
+IUP_SDK_API void iupDrawLayerKill(IdrawList* layer)
+{
+  iupDrawListKill(layer);
+}
+
 IUP_API void IupDrawBegin(Ihandle* ih)
 {
   iupASSERT(iupObjectCheck(ih));
@@ -50,26 +423,103 @@ IUP_API void IupDrawBegin(Ihandle* ih)
     return;
   }
 
+  /* the headless canvas is always drawn from the display list */
+  if (iupAttribGetBoolean(ih, "DRAWLIST") || iDrawIsHeadless(ih))
+  {
+    iDrawListBegin(ih);
+    return;
+  }
+
+  /* the cached frame is no longer valid when drawing directly */
+  iupDrawReleaseList(ih);
+
   {
     IdrawCanvas* dc = iupdrvDrawCreateCanvas(ih);
     iupAttribSet(ih, "_IUP_DRAW_DC", (char*)dc);
   }
 }
 
+IUP_API void IupDrawBeginRect(Ihandle* ih, int x1, int y1, int x2, int y2)
+{
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return;
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  /* used by the driver to limit clear, draw and flush to the damaged area */
+  iupAttribSetStrf(ih, "_IUP_DRAW_UPDATERECT", "%d %d %d %d", x1, y1, x2, y2);
+
+  IupDrawBegin(ih);
+
+  /* the driver removes the rectangle when the whole canvas must be drawn */
+  if (!IUP_SVG_GET(ih) && !IUP_DRAWLIST_GET(ih) && iupAttribGet(ih, "_IUP_DRAW_UPDATERECT"))
+    iupdrvDrawSetClipRect((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2);
+}
+
+static void iDrawSetUpdateClipRect(Ihandle* ih, IdrawCanvas* dc, int x1, int y1, int x2, int y2)
+{
+  int ux1, uy1, ux2, uy2;
+  char* value = iupAttribGet(ih, "_IUP_DRAW_UPDATERECT");
+  if (!value || sscanf(value, "%d %d %d %d", &ux1, &uy1, &ux2, &uy2) != 4)
+  {
+    if (x1 == 0 && y1 == 0 && x2 == 0 && y2 == 0)
+      iupdrvDrawResetClip(dc);
+    else
+      iupdrvDrawSetClipRect(dc, x1, y1, x2, y2);
+    return;
+  }
+
+  if (x1 == 0 && y1 == 0 && x2 == 0 && y2 == 0)
+  {
+    /* reset to the damaged area */
+    iupdrvDrawSetClipRect(dc, ux1, uy1, ux2, uy2);
+    return;
+  }
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  if (x1 < ux1) x1 = ux1;
+  if (y1 < uy1) y1 = uy1;
+  if (x2 > ux2) x2 = ux2;
+  if (y2 > uy2) y2 = uy2;
+
+  if (x1 > x2 || y1 > y2)
+  {
+    /* empty intersection, a single pixel outside the canvas */
+    x1 = x2 = -1;
+    y1 = y2 = -1;
+  }
+
+  iupdrvDrawSetClipRect(dc, x1, y1, x2, y2);
+}
+
 IUP_API void IupDrawEnd(Ihandle* ih)
 {
   IdrawCanvas* dc;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
     return;
 
+  iupAttribSet(ih, "_IUP_DRAW_UPDATERECT", NULL);  /* already used by the driver */
+
   if (IUP_SVG_GET(ih))
   {
     iupAttribSet(ih, "_IUP_DRAW_DC", NULL);
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iDrawListEnd(ih, list);
+    return;
+  }
+
   dc = (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC");
   if (!dc)
     return;
@@ -82,6 +532,7 @@ IUP_API void IupDrawEnd(Ihandle* ih)
 IUP_API void IupDrawGetSize(Ihandle* ih, int *w, int *h)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -94,6 +545,13 @@ IUP_API void IupDrawGetSize(Ihandle* ih, int *w, int *h)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListGetSize(list, w, h);
+    return;
+  }
+
   {
     IdrawCanvas* dc = (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC");
     if (!dc)
@@ -105,6 +563,7 @@ IUP_API void IupDrawGetSize(Ihandle* ih, int *w, int *h)
 IUP_API void IupDrawParentBackground(Ihandle* ih)
 {
   IdrawCanvas* dc;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -113,6 +572,16 @@ IUP_API void IupDrawParentBackground(Ihandle* ih)
   if (IUP_SVG_GET(ih))
     return;
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    int w, h;
+    long color = iupDrawStrToColor(iupBaseNativeParentGetBgColorAttrib(ih), 0);
+    iupDrawListGetSize(list, &w, &h);
+    iupDrawListRectangle(list, 0, 0, w - 1, h - 1, color, IUP_DRAW_FILL, 1);
+    return;
+  }
+
   dc = (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC");
   if (!dc)
     return;
@@ -156,6 +625,7 @@ IUP_API void IupDrawLine(Ihandle* ih, int x1, int y1, int x2, int y2)
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -176,6 +646,13 @@ IUP_API void IupDrawLine(Ihandle* ih, int x1, int y1, int x2, int y2)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListLine(list, x1, y1, x2, y2, color, style, line_width);
+    return;
+  }
+
   dc = (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC");
   iupdrvDrawLine(dc, x1, y1, x2, y2, color, style, line_width);
 }
@@ -186,6 +663,7 @@ IUP_API void IupDrawRectangle(Ihandle* ih, int x1, int y1, int x2, int y2)
   long color;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -206,6 +684,13 @@ IUP_API void IupDrawRectangle(Ihandle* ih, int x1, int y1, int x2, int y2)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListRectangle(list, x1, y1, x2, y2, color, style, line_width);
+    return;
+  }
+
   dc = (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC");
   iupdrvDrawRectangle(dc, x1, y1, x2, y2, color, style, line_width);
 }
@@ -215,6 +700,7 @@ IUP_API void IupDrawArc(Ihandle* ih, int x1, int y1, int x2, int y2, double a1,
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -235,6 +721,13 @@ IUP_API void IupDrawArc(Ihandle* ih, int x1, int y1, int x2, int y2, double a1,
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListArc(list, x1, y1, x2, y2, a1, a2, color, style, line_width);
+    return;
+  }
+
   iupdrvDrawArc((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, a1, a2, color, style, line_width);
 }
 
@@ -243,6 +736,7 @@ IUP_API void IupDrawEllipse(Ihandle* ih, int x1, int y1, int x2, int y2)
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -263,6 +757,13 @@ IUP_API void IupDrawEllipse(Ihandle* ih, int x1, int y1, int x2, int y2)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListEllipse(list, x1, y1, x2, y2, color, style, line_width);
+    return;
+  }
+
   iupdrvDrawEllipse((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, color, style, line_width);
 }
 
@@ -271,6 +772,7 @@ IUP_API void IupDrawPolygon(Ihandle* ih, int* points, int count)
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -291,13 +793,57 @@ IUP_API void IupDrawPolygon(Ihandle* ih, int* points, int count)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListPolygon(list, points, count, color, style, line_width);
+    return;
+  }
+
   iupdrvDrawPolygon((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), points, count, color, style, line_width);
 }
 
+IUP_API void IupDrawPolyline(Ihandle* ih, int* points, int count)
+{
+  long color = 0;
+  int style, line_width;
+  iSvgCanvas* svg;
+  IdrawList* list;
+
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return;
+
+  if (!iupAttribGet(ih, "_IUP_DRAW_DC"))
+    return;
+
+  color = iupDrawStrToColor(iupAttribGetStr(ih, "DRAWCOLOR"), 0);
+  line_width = iDrawGetLineWidth(ih);
+  style = iDrawGetStyle(ih);
+
+  svg = IUP_SVG_GET(ih);
+  if (svg)
+  {
+    char c[32]; iSvgColorStr(color, c, sizeof(c));
+    iupSvgDrawPolyline(svg, points, count, c, style, line_width);
+    return;
+  }
+
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListPolyline(list, points, count, color, style, line_width);
+    return;
+  }
+
+  iupdrvDrawPolyline((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), points, count, color, style, line_width);
+}
+
 IUP_API void IupDrawPixel(Ihandle* ih, int x, int y)
 {
   long color = 0;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -316,6 +862,13 @@ IUP_API void IupDrawPixel(Ihandle* ih, int x, int y)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListPixel(list, x, y, color);
+    return;
+  }
+
   iupdrvDrawPixel((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x, y, color);
 }
 
@@ -324,6 +877,7 @@ IUP_API void IupDrawRoundedRectangle(Ihandle* ih, int x1, int y1, int x2, int y2
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -344,6 +898,13 @@ IUP_API void IupDrawRoundedRectangle(Ihandle* ih, int x1, int y1, int x2, int y2
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListRoundedRectangle(list, x1, y1, x2, y2, corner_radius, color, style, line_width);
+    return;
+  }
+
   iupdrvDrawRoundedRectangle((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, corner_radius, color, style, line_width);
 }
 
@@ -352,6 +913,7 @@ IUP_API void IupDrawBezier(Ihandle* ih, int x1, int y1, int x2, int y2, int x3,
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -372,6 +934,13 @@ IUP_API void IupDrawBezier(Ihandle* ih, int x1, int y1, int x2, int y2, int x3,
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListBezier(list, x1, y1, x2, y2, x3, y3, x4, y4, color, style, line_width);
+    return;
+  }
+
   iupdrvDrawBezier((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, x3, y3, x4, y4, color, style, line_width);
 }
 
@@ -380,6 +949,7 @@ IUP_API void IupDrawQuadraticBezier(Ihandle* ih, int x1, int y1, int x2, int y2,
   long color = 0;
   int style, line_width;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -400,6 +970,13 @@ IUP_API void IupDrawQuadraticBezier(Ihandle* ih, int x1, int y1, int x2, int y2,
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListQuadraticBezier(list, x1, y1, x2, y2, x3, y3, color, style, line_width);
+    return;
+  }
+
   iupdrvDrawQuadraticBezier((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, x3, y3, color, style, line_width);
 }
 
@@ -435,6 +1012,7 @@ IUP_API void IupDrawLinearGradient(Ihandle* ih, int x1, int y1, int x2, int y2,
 IUP_API void IupDrawLinearGradientStops(Ihandle* ih, int x1, int y1, int x2, int y2, float angle, const char** colors, const float* offsets, int count)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
   long c[IUP_GRADIENT_MAX_STOPS];
   float o[IUP_GRADIENT_MAX_STOPS];
 
@@ -456,6 +1034,13 @@ IUP_API void IupDrawLinearGradientStops(Ihandle* ih, int x1, int y1, int x2, int
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListLinearGradient(list, x1, y1, x2, y2, angle, c, o, count);
+    return;
+  }
+
   iupdrvDrawLinearGradient((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, angle, c, o, count);
 }
 
@@ -470,6 +1055,7 @@ IUP_API void IupDrawRadialGradient(Ihandle* ih, int cx, int cy, int radius, cons
 IUP_API void IupDrawRadialGradientStops(Ihandle* ih, int cx, int cy, int radius, const char** colors, const float* offsets, int count)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
   long c[IUP_GRADIENT_MAX_STOPS];
   float o[IUP_GRADIENT_MAX_STOPS];
 
@@ -491,6 +1077,13 @@ IUP_API void IupDrawRadialGradientStops(Ihandle* ih, int cx, int cy, int radius,
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListRadialGradient(list, cx, cy, radius, c, o, count);
+    return;
+  }
+
   iupdrvDrawRadialGradient((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), cx, cy, radius, c, o, count);
 }
 
@@ -531,6 +1124,14 @@ static void iDrawGetTextBounds(int w, int h, double text_orientation, int *o_w,
   if (o_h) *o_h = ymax - ymin + 1;
 }
 
+static void iDrawFontGetTextSize(Ihandle* ih, const char* font, const char* text, int len, int *w, int *h)
+{
+  if (iDrawIsHeadless(ih))
+    iupRgbaDrawGetTextSize(font, text, len, w, h);
+  else
+    iupdrvFontGetTextSize(font, text, len, w, h);
+}
+
 IUP_SDK_API char* iupDrawGetTextSize(Ihandle* ih, const char* text, int len, int *w, int *h, double text_orientation)
 {
   char*font = iupAttribGetStr(ih, "DRAWFONT");
@@ -557,16 +1158,16 @@ IUP_SDK_API char* iupDrawGetTextSize(Ihandle* ih, const char* text, int len, int
   if (text_orientation)
   {
     if (text_orientation == 90)
-      iupdrvFontGetTextSize(font, text, len, h, w);
+      iDrawFontGetTextSize(ih, font, text, len, h, w);
     else
     {
       int txt_w, txt_h;
-      iupdrvFontGetTextSize(font, text, len, &txt_w, &txt_h);
+      iDrawFontGetTextSize(ih, font, text, len, &txt_w, &txt_h);
       iDrawGetTextBounds(txt_w, txt_h, text_orientation, w, h);
     }
   }
   else
-    iupdrvFontGetTextSize(font, text, len, w, h);
+    iDrawFontGetTextSize(ih, font, text, len, w, h);
 
   return font;
 }
@@ -589,6 +1190,7 @@ IUP_API void IupDrawText(Ihandle* ih, const char* text, int len, int x, int y, i
   int text_flags;
   double text_orientation;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -627,6 +1229,13 @@ IUP_API void IupDrawText(Ihandle* ih, const char* text, int len, int x, int y, i
       return;
     }
 
+    list = IUP_DRAWLIST_GET(ih);
+    if (list)
+    {
+      iupDrawListText(list, text, len, x, y, w, h, color, font, text_flags, text_orientation, txt_w, txt_h);
+      return;
+    }
+
     iupdrvDrawText((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), text, len, x, y, w, h, color, font, text_flags, text_orientation);
   }
 }
@@ -661,7 +1270,10 @@ IUP_API void IupDrawGetTextMetrics(Ihandle* ih, int *ascent, int *descent, int *
   if (!font)
     font = IupGetAttribute(ih, "FONT");
 
-  iupdrvFontGetFontDim(font, &max_width, &lh, &asc, &desc);
+  if (iDrawIsHeadless(ih))
+    iupRgbaDrawGetFontDim(font, &max_width, &lh, &asc, &desc);
+  else
+    iupdrvFontGetFontDim(font, &max_width, &lh, &asc, &desc);
 
   if (ascent) *ascent = asc;
   if (descent) *descent = desc;
@@ -673,6 +1285,53 @@ IUP_API void IupDrawGetImageInfo(const char* name, int *w, int *h, int *bpp)
   iupImageGetInfo(name, w, h, bpp);
 }
 
+static Ihandle* iDrawGetHeadlessImage(Ihandle* ih)
+{
+  IdrawList* list = IUP_DRAWLIST_GET(ih);
+  iRgbaCanvas* rgba;
+  Ihandle* image;
+  int w, h, rgba_w, rgba_h;
+
+  if (list)
+  {
+    /* inside IupDrawBegin/IupDrawEnd, returns what was drawn so far */
+    iupDrawListGetSize(list, &w, &h);
+    rgba = iupRgbaDrawCreateCanvas(w, h);
+    if (!rgba)
+      return NULL;
+
+    iDrawListPlay(list, NULL, NULL, rgba);
+    image = IupImageRGBA(w, h, iupRgbaDrawGetData(rgba));
+    iupRgbaDrawKillCanvas(rgba);
+    return image;
+  }
+
+  iDrawGetCanvasSize(ih, &w, &h);
+
+  rgba = (iRgbaCanvas*)iupAttribGet(ih, "_IUP_DRAW_RGBA");
+  if (rgba)
+  {
+    iupRgbaDrawGetSize(rgba, &rgba_w, &rgba_h);
+    if (rgba_w != w || rgba_h != h)
+      rgba = NULL;
+  }
+
+  if (!rgba)
+  {
+    /* there is no valid frame yet, draw one */
+    Icallback action_cb = IupGetCallback(ih, "ACTION");
+    if (action_cb)
+      action_cb(ih);
+
+    rgba = (iRgbaCanvas*)iupAttribGet(ih, "_IUP_DRAW_RGBA");
+    if (!rgba)
+      return NULL;
+  }
+
+  iupRgbaDrawGetSize(rgba, &rgba_w, &rgba_h);
+  return IupImageRGBA(rgba_w, rgba_h, iupRgbaDrawGetData(rgba));
+}
+
 IUP_API Ihandle* IupDrawGetImage(Ihandle* ih)
 {
   IdrawCanvas* dc;
@@ -684,7 +1343,13 @@ IUP_API Ihandle* IupDrawGetImage(Ihandle* ih)
   if (!iupObjectCheck(ih))
     return NULL;
 
+  if (iDrawIsHeadless(ih))
+    return iDrawGetHeadlessImage(ih);
+
   dc = (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC");
+  if (IUP_SVG_GET(ih) || IUP_DRAWLIST_GET(ih))
+    dc = NULL;  /* not a native canvas */
+
   if (dc)
   {
     iupdrvDrawGetSize(dc, &w, &h);
@@ -730,12 +1395,13 @@ IUP_API char* IupDrawGetSvg(Ihandle* ih)
   const char* str;
   char* result;
   Icallback action_cb;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
     return NULL;
 
-  IupGetIntInt(ih, "DRAWSIZE", &w, &h);
+  iDrawGetCanvasSize(ih, &w, &h);
   if (w <= 0 || h <= 0)
     return NULL;
 
@@ -743,11 +1409,25 @@ IUP_API char* IupDrawGetSvg(Ihandle* ih)
   if (!svg)
     return NULL;
 
-  iupAttribSet(ih, "_IUP_SVG_CANVAS", (char*)svg);
+  list = (IdrawList*)iupAttribGet(ih, "_IUP_DRAW_LISTCACHE");
+  if (list)
+  {
+    int list_w, list_h;
+    iupDrawListGetSize(list, &list_w, &list_h);
+    if (list_w != w || list_h != h)
+      list = NULL;
+  }
 
-  action_cb = IupGetCallback(ih, "ACTION");
-  if (action_cb)
-    action_cb(ih);
+  if (list)
+    iDrawListPlay(list, NULL, svg, NULL);  /* the last frame is still valid */
+  else
+  {
+    iupAttribSet(ih, "_IUP_SVG_CANVAS", (char*)svg);
+
+    action_cb = IupGetCallback(ih, "ACTION");
+    if (action_cb)
+      action_cb(ih);
+  }
 
   str = iupSvgDrawGetString(svg);
   if (str)
@@ -766,21 +1446,6 @@ IUP_API char* IupDrawGetSvg(Ihandle* ih)
   return result;
 }
 
-static void iDrawGetImageRGBA(const char* name, int make_inactive, const char* bgcolor, unsigned char** out_rgba, int* out_w, int* out_h)
-{
-  Ihandle* img_ih;
-
-  *out_rgba = NULL;
-  *out_w = 0;
-  *out_h = 0;
-
-  img_ih = iupImageGetImageFromName(name);
-  if (!img_ih)
-    return;
-
-  *out_rgba = iupImageGetRGBAData(img_ih, make_inactive, bgcolor, out_w, out_h);
-}
-
 IUP_API void IupDrawImage(Ihandle* ih, const char* name, int x, int y, int w, int h)
 {
   char* bgcolor;
@@ -789,6 +1454,7 @@ IUP_API void IupDrawImage(Ihandle* ih, const char* name, int x, int y, int w, in
   int sx = 0, sy = 0, sw = -1, sh = -1;
   long tint;
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -835,43 +1501,29 @@ IUP_API void IupDrawImage(Ihandle* ih, const char* name, int x, int y, int w, in
   svg = IUP_SVG_GET(ih);
   if (svg)
   {
-    unsigned char* rgba;
-    int img_w, img_h;
-    iDrawGetImageRGBA(name, make_inactive, bgcolor, &rgba, &img_w, &img_h);
-    if (rgba)
+    iDrawSvgImage(svg, name, make_inactive, bgcolor, tint, opacity, x, y, w, h, sx, sy, sw, sh, quality);
+    return;
+  }
+
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    if (w == -1 || w == 0 || h == -1 || h == 0)
     {
-      if (sw > 0 && sh > 0 && sw <= img_w && sh <= img_h)
+      int img_w = 0, img_h = 0;
+      if (sw > 0 && sh > 0)
       {
-        int line;
-        for (line = 0; line < sh; line++)
-          memmove(rgba + (size_t)line * sw * 4, rgba + ((size_t)(sy + line) * img_w + sx) * 4, (size_t)sw * 4);
         img_w = sw;
         img_h = sh;
       }
-
-      if (tint != IUP_DRAW_NO_TINT || opacity < 255)
-      {
-        int i, count = img_w * img_h;
-        int tint_on = (tint != IUP_DRAW_NO_TINT);
-        unsigned char tr = iupDrawRed(tint), tg = iupDrawGreen(tint), tb = iupDrawBlue(tint), ta = iupDrawAlpha(tint);
-        for (i = 0; i < count; i++)
-        {
-          if (tint_on)
-          {
-            rgba[i * 4 + 0] = tr;
-            rgba[i * 4 + 1] = tg;
-            rgba[i * 4 + 2] = tb;
-            rgba[i * 4 + 3] = (unsigned char)((rgba[i * 4 + 3] * ta) / 255);
-          }
-          rgba[i * 4 + 3] = (unsigned char)((rgba[i * 4 + 3] * opacity) / 255);
-        }
-      }
+      else
+        iupImageGetInfo(name, &img_w, &img_h, NULL);
 
       if (w == -1 || w == 0) w = img_w;
       if (h == -1 || h == 0) h = img_h;
-      iupSvgDrawImageRGBA(svg, rgba, img_w, img_h, x, y, w, h, quality);
-      free(rgba);
     }
+
+    iupDrawListImage(list, name, iupImageGetStamp(name), make_inactive, bgcolor, tint, opacity, x, y, w, h, sx, sy, sw, sh, quality);
     return;
   }
 
@@ -881,6 +1533,7 @@ IUP_API void IupDrawImage(Ihandle* ih, const char* name, int x, int y, int w, in
 IUP_API void IupDrawSetClipRect(Ihandle* ih, int x1, int y1, int x2, int y2)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -896,12 +1549,20 @@ IUP_API void IupDrawSetClipRect(Ihandle* ih, int x1, int y1, int x2, int y2)
     return;
   }
 
-  iupdrvDrawSetClipRect((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2);
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListSetClipRect(list, x1, y1, x2, y2);
+    return;
+  }
+
+  iDrawSetUpdateClipRect(ih, (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2);
 }
 
 IUP_API void IupDrawSetClipRoundedRect(Ihandle* ih, int x1, int y1, int x2, int y2, int corner_radius)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -917,12 +1578,20 @@ IUP_API void IupDrawSetClipRoundedRect(Ihandle* ih, int x1, int y1, int x2, int
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListSetClipRoundedRect(list, x1, y1, x2, y2, corner_radius);
+    return;
+  }
+
   iupdrvDrawSetClipRoundedRect((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2, corner_radius);
 }
 
 IUP_API void IupDrawGetClipRect(Ihandle* ih, int *x1, int *y1, int *x2, int *y2)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -938,12 +1607,20 @@ IUP_API void IupDrawGetClipRect(Ihandle* ih, int *x1, int *y1, int *x2, int *y2)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListGetClipRect(list, x1, y1, x2, y2);
+    return;
+  }
+
   iupdrvDrawGetClipRect((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2);
 }
 
 IUP_API void IupDrawResetClip(Ihandle* ih)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -959,12 +1636,20 @@ IUP_API void IupDrawResetClip(Ihandle* ih)
     return;
   }
 
-  iupdrvDrawResetClip((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"));
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListResetClip(list);
+    return;
+  }
+
+  iDrawSetUpdateClipRect(ih, (IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), 0, 0, 0, 0);
 }
 
 IUP_API void IupDrawSelectRect(Ihandle* ih, int x1, int y1, int x2, int y2)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -980,12 +1665,20 @@ IUP_API void IupDrawSelectRect(Ihandle* ih, int x1, int y1, int x2, int y2)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListSelectRect(list, x1, y1, x2, y2);
+    return;
+  }
+
   iupdrvDrawSelectRect((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2);
 }
 
 IUP_API void IupDrawFocusRect(Ihandle* ih, int x1, int y1, int x2, int y2)
 {
   iSvgCanvas* svg;
+  IdrawList* list;
 
   iupASSERT(iupObjectCheck(ih));
   if (!iupObjectCheck(ih))
@@ -1001,6 +1694,13 @@ IUP_API void IupDrawFocusRect(Ihandle* ih, int x1, int y1, int x2, int y2)
     return;
   }
 
+  list = IUP_DRAWLIST_GET(ih);
+  if (list)
+  {
+    iupDrawListFocusRect(list, x1, y1, x2, y2);
+    return;
+  }
+
   iupdrvDrawFocusRect((IdrawCanvas*)iupAttribGet(ih, "_IUP_DRAW_DC"), x1, y1, x2, y2);
 }
 
@@ -1701,7 +2401,7 @@ IUP_SDK_API void iupFlatDrawCheckMark(IdrawCanvas* dc, int xmin, int xmax, int y
   points[4] = xmax;
   points[5] = ymin;
 
-  iupdrvDrawPolygon(dc, points, 3, color, IUP_DRAW_STROKE, 2);
+  iupdrvDrawPolyline(dc, points, 3, color, IUP_DRAW_STROKE, 2);
 }
 
 IUP_SDK_API void iupFlatDrawDrawCircle(IdrawCanvas* dc, int xc, int yc, int radius, int fill, int line_width, char *fgcolor, char *bgcolor, int active)
@@ -49,6 +49,21 @@ IUP_SDK_API void iupDrawParentBackground(IdrawCanvas* dc, Ihandle* ih);
 IUP_SDK_API char* iupDrawGetTextSize(Ihandle* ih, const char* str, int len, int *w, int *h, double text_orientation);
 IUP_SDK_API int iupDrawGetTextFlags(Ihandle* ih, const char* align_name, const char* wrap_name, const char* ellipsis_name);
 
+/* Display list used when DRAWLIST=Yes. Frees the last recorded frame. */
+IUP_SDK_API void iupDrawReleaseList(Ihandle* ih);
+IUP_SDK_API char* iupDrawGetListHashAttrib(Ihandle* ih);
+
+/* Layers record the draw functions called between iupDrawLayerBegin and iupDrawLayerEnd,
+   so they can be drawn again later with iupDrawLayerPlay without calling them.
+   iupDrawLayerEnd also draws the layer. Must be called between IupDrawBegin and IupDrawEnd.
+   iupDrawLayerBegin returns NULL when drawing to SVG, and iupDrawLayerPlay returns 0
+   when the layer can not be used, for instance when the canvas size changed. */
+struct _IdrawList;
+IUP_SDK_API struct _IdrawList* iupDrawLayerBegin(Ihandle* ih, struct _IdrawList* layer);
+IUP_SDK_API void iupDrawLayerEnd(Ihandle* ih, struct _IdrawList* layer);
+IUP_SDK_API int  iupDrawLayerPlay(Ihandle* ih, struct _IdrawList* layer);
+IUP_SDK_API void iupDrawLayerKill(struct _IdrawList* layer);
+
 /**********************************************************************************************************/
 
 enum{ IUP_IMGPOS_LEFT, IUP_IMGPOS_RIGHT, IUP_IMGPOS_TOP, IUP_IMGPOS_BOTTOM };
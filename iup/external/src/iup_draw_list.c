@@ -0,0 +1,675 @@
+/** \file
+ * \brief Draw Display List
+ *
+ * Binary display list of the IUP draw primitives.
+ * Each item is a fixed size header and parameters block followed by
+ * its variable data (points, gradient stops and strings),
+ * all aligned to 8 bytes so the decoded arrays can point directly to the list data.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "iup.h"
+
+#include "iup_drvdraw.h"
+#include "iup_draw.h"
+#include "iup_draw_list.h"
+
+
+#define IDRAWLIST_ALIGN(_s) (((_s) + 7) & ~7)
+
+typedef struct _IdrawListHeader
+{
+  int type;
+  int size;     /* total size of the item, including this header */
+  int full;     /* item can affect the whole canvas */
+  int reserved;
+  int bx1, by1, bx2, by2;   /* area affected by the item */
+} IdrawListHeader;
+
+/* no padding, so items can be compared with memcmp */
+typedef struct _IdrawListParams
+{
+  double a1, a2;
+  int x1, y1, x2, y2, x3, y3, x4, y4;
+  int corner_radius, style, line_width, count, len, flags;
+  int make_inactive, opacity, quality, sx, sy, sw, sh;
+  unsigned int color, tint;
+  int font_len;   /* -1 when there is no font */
+  unsigned int stamp;   /* image change stamp */
+  int reserved;
+} IdrawListParams;
+
+struct _IdrawList
+{
+  int w, h;
+  int count;
+  unsigned char* data;
+  int size, max_size;
+  unsigned int hash;
+  int hash_valid;
+  int clip_x1, clip_y1, clip_x2, clip_y2;
+  int clip_changed;   /* the list changes the clipping */
+};
+
+
+IdrawList* iupDrawListCreate(int w, int h)
+{
+  IdrawList* list = (IdrawList*)calloc(1, sizeof(IdrawList));
+  if (!list)
+    return NULL;
+
+  list->w = w;
+  list->h = h;
+  return list;
+}
+
+void iupDrawListKill(IdrawList* list)
+{
+  if (!list)
+    return;
+
+  free(list->data);
+  free(list);
+}
+
+void iupDrawListClear(IdrawList* list, int w, int h)
+{
+  list->w = w;
+  list->h = h;
+  list->count = 0;
+  list->size = 0;   /* keep the allocated memory for the next frame */
+  list->hash_valid = 0;
+  list->clip_x1 = 0;
+  list->clip_y1 = 0;
+  list->clip_x2 = 0;
+  list->clip_y2 = 0;
+  list->clip_changed = 0;
+}
+
+void iupDrawListGetSize(IdrawList* list, int *w, int *h)
+{
+  if (w) *w = list->w;
+  if (h) *h = list->h;
+}
+
+int iupDrawListGetCount(IdrawList* list)
+{
+  return list->count;
+}
+
+const unsigned char* iupDrawListGetData(IdrawList* list, int *size)
+{
+  if (size) *size = list->size;
+  return list->data;
+}
+
+unsigned int iupDrawListGetHash(IdrawList* list)
+{
+  if (!list->hash_valid)
+  {
+    /* FNV-1a */
+    unsigned int h = 2166136261u;
+    int i;
+    for (i = 0; i < list->size; i++)
+    {
+      h ^= list->data[i];
+      h *= 16777619u;
+    }
+    h ^= (unsigned int)list->w * 0x9E3779B1u;
+    h ^= (unsigned int)list->h * 0x85EBCA77u;
+
+    list->hash = h;
+    list->hash_valid = 1;
+  }
+
+  return list->hash;
+}
+
+/**************************************************************************************/
+
+static unsigned char* iDrawListReserve(IdrawList* list, int size)
+{
+  unsigned char* ptr;
+
+  if (list->size + size > list->max_size)
+  {
+    int new_max = list->max_size ? list->max_size * 2 : 1024;
+    unsigned char* new_data;
+
+    while (new_max < list->size + size)
+      new_max *= 2;
+
+    new_data = (unsigned char*)realloc(list->data, new_max);
+    if (!new_data)
+      return NULL;
+
+    list->data = new_data;
+    list->max_size = new_max;
+  }
+
+  ptr = list->data + list->size;
+  memset(ptr, 0, size);  /* includes the alignment padding */
+  list->size += size;
+  return ptr;
+}
+
+static void iDrawListAdd(IdrawList* list, int type, int full, int bx1, int by1, int bx2, int by2, const IdrawListParams* params,
+                         const void* data1, int size1, const void* data2, int size2, const void* data3, int size3)
+{
+  int size = (int)(sizeof(IdrawListHeader) + sizeof(IdrawListParams)) + IDRAWLIST_ALIGN(size1) + IDRAWLIST_ALIGN(size2) + IDRAWLIST_ALIGN(size3);
+  IdrawListHeader header;
+  unsigned char* ptr = iDrawListReserve(list, size);
+  if (!ptr)
+    return;
+
+  iupDrawCheckSwapCoord(bx1, bx2);
+  iupDrawCheckSwapCoord(by1, by2);
+
+  memset(&header, 0, sizeof(IdrawListHeader));
+  header.type = type;
+  header.size = size;
+  header.full = full;
+  header.bx1 = bx1;
+  header.by1 = by1;
+  header.bx2 = bx2;
+  header.by2 = by2;
+
+  memcpy(ptr, &header, sizeof(IdrawListHeader));
+  ptr += sizeof(IdrawListHeader);
+  memcpy(ptr, params, sizeof(IdrawListParams));
+  ptr += sizeof(IdrawListParams);
+
+  if (size1) { memcpy(ptr, data1, size1); ptr += IDRAWLIST_ALIGN(size1); }
+  if (size2) { memcpy(ptr, data2, size2); ptr += IDRAWLIST_ALIGN(size2); }
+  if (size3) { memcpy(ptr, data3, size3); }
+
+  list->count++;
+  list->hash_valid = 0;
+}
+
+static void iDrawListInitParams(IdrawListParams* params, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  memset(params, 0, sizeof(IdrawListParams));
+  params->x1 = x1;
+  params->y1 = y1;
+  params->x2 = x2;
+  params->y2 = y2;
+  params->color = (unsigned int)color;
+  params->style = style;
+  params->line_width = line_width;
+  params->font_len = -1;
+}
+
+static void iDrawListAddShape(IdrawList* list, int type, const IdrawListParams* params, int bx1, int by1, int bx2, int by2)
+{
+  /* include the line width and anti-aliasing */
+  int d = params->line_width / 2 + 1;
+  iupDrawCheckSwapCoord(bx1, bx2);
+  iupDrawCheckSwapCoord(by1, by2);
+  iDrawListAdd(list, type, 0, bx1 - d, by1 - d, bx2 + d, by2 + d, params, NULL, 0, NULL, 0, NULL, 0);
+}
+
+void iupDrawListLine(IdrawList* list, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  iDrawListAddShape(list, IUP_DRAWLIST_LINE, &params, x1, y1, x2, y2);
+}
+
+void iupDrawListRectangle(IdrawList* list, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  iDrawListAddShape(list, IUP_DRAWLIST_RECTANGLE, &params, x1, y1, x2, y2);
+}
+
+void iupDrawListArc(IdrawList* list, int x1, int y1, int x2, int y2, double a1, double a2, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  params.a1 = a1;
+  params.a2 = a2;
+  iDrawListAddShape(list, IUP_DRAWLIST_ARC, &params, x1, y1, x2, y2);
+}
+
+void iupDrawListEllipse(IdrawList* list, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  iDrawListAddShape(list, IUP_DRAWLIST_ELLIPSE, &params, x1, y1, x2, y2);
+}
+
+static void iDrawListAddPoints(IdrawList* list, int type, int* points, int count, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  int i, bx1 = INT_MAX, by1 = INT_MAX, bx2 = INT_MIN, by2 = INT_MIN, d;
+
+  if (count <= 0)
+    return;
+
+  for (i = 0; i < count; i++)
+  {
+    int x = points[2 * i], y = points[2 * i + 1];
+    if (x < bx1) bx1 = x;
+    if (x > bx2) bx2 = x;
+    if (y < by1) by1 = y;
+    if (y > by2) by2 = y;
+  }
+
+  iDrawListInitParams(&params, 0, 0, 0, 0, color, style, line_width);
+  params.count = count;
+
+  d = line_width / 2 + 1;
+  iDrawListAdd(list, type, 0, bx1 - d, by1 - d, bx2 + d, by2 + d, &params, points, count * 2 * (int)sizeof(int), NULL, 0, NULL, 0);
+}
+
+void iupDrawListPolygon(IdrawList* list, int* points, int count, long color, int style, int line_width)
+{
+  iDrawListAddPoints(list, IUP_DRAWLIST_POLYGON, points, count, color, style, line_width);
+}
+
+void iupDrawListPolyline(IdrawList* list, int* points, int count, long color, int style, int line_width)
+{
+  iDrawListAddPoints(list, IUP_DRAWLIST_POLYLINE, points, count, color, style, line_width);
+}
+
+void iupDrawListPixel(IdrawList* list, int x, int y, long color)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x, y, 0, 0, color, 0, 1);
+  iDrawListAdd(list, IUP_DRAWLIST_PIXEL, 0, x, y, x, y, &params, NULL, 0, NULL, 0, NULL, 0);
+}
+
+void iupDrawListRoundedRectangle(IdrawList* list, int x1, int y1, int x2, int y2, int corner_radius, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  params.corner_radius = corner_radius;
+  iDrawListAddShape(list, IUP_DRAWLIST_ROUNDEDRECTANGLE, &params, x1, y1, x2, y2);
+}
+
+static void iDrawListBoundsAdd(int x, int y, int *bx1, int *by1, int *bx2, int *by2)
+{
+  if (x < *bx1) *bx1 = x;
+  if (x > *bx2) *bx2 = x;
+  if (y < *by1) *by1 = y;
+  if (y > *by2) *by2 = y;
+}
+
+void iupDrawListBezier(IdrawList* list, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  int bx1 = x1, by1 = y1, bx2 = x1, by2 = y1;
+
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  params.x3 = x3;
+  params.y3 = y3;
+  params.x4 = x4;
+  params.y4 = y4;
+
+  /* the curve is inside the convex hull of the control points */
+  iDrawListBoundsAdd(x2, y2, &bx1, &by1, &bx2, &by2);
+  iDrawListBoundsAdd(x3, y3, &bx1, &by1, &bx2, &by2);
+  iDrawListBoundsAdd(x4, y4, &bx1, &by1, &bx2, &by2);
+  iDrawListAddShape(list, IUP_DRAWLIST_BEZIER, &params, bx1, by1, bx2, by2);
+}
+
+void iupDrawListQuadraticBezier(IdrawList* list, int x1, int y1, int x2, int y2, int x3, int y3, long color, int style, int line_width)
+{
+  IdrawListParams params;
+  int bx1 = x1, by1 = y1, bx2 = x1, by2 = y1;
+
+  iDrawListInitParams(&params, x1, y1, x2, y2, color, style, line_width);
+  params.x3 = x3;
+  params.y3 = y3;
+
+  iDrawListBoundsAdd(x2, y2, &bx1, &by1, &bx2, &by2);
+  iDrawListBoundsAdd(x3, y3, &bx1, &by1, &bx2, &by2);
+  iDrawListAddShape(list, IUP_DRAWLIST_QUADRATICBEZIER, &params, bx1, by1, bx2, by2);
+}
+
+void iupDrawListLinearGradient(IdrawList* list, int x1, int y1, int x2, int y2, float angle, const long* colors, const float* offsets, int count)
+{
+  IdrawListParams params;
+
+  if (count <= 0)
+    return;
+
+  iDrawListInitParams(&params, x1, y1, x2, y2, 0, 0, 1);
+  params.a1 = angle;
+  params.count = count;
+  iDrawListAdd(list, IUP_DRAWLIST_LINEARGRADIENT, 0, x1, y1, x2, y2, &params, colors, count * (int)sizeof(long), offsets, count * (int)sizeof(float), NULL, 0);
+}
+
+void iupDrawListRadialGradient(IdrawList* list, int cx, int cy, int radius, const long* colors, const float* offsets, int count)
+{
+  IdrawListParams params;
+
+  if (count <= 0)
+    return;
+
+  iDrawListInitParams(&params, cx, cy, 0, 0, 0, 0, 1);
+  params.x3 = radius;
+  params.count = count;
+  iDrawListAdd(list, IUP_DRAWLIST_RADIALGRADIENT, 0, cx - radius, cy - radius, cx + radius, cy + radius, &params, colors, count * (int)sizeof(long), offsets, count * (int)sizeof(float), NULL, 0);
+}
+
+void iupDrawListText(IdrawList* list, const char* text, int len, int x, int y, int w, int h, long color, const char* font, int flags, double text_orientation, int box_w, int box_h)
+{
+  IdrawListParams params;
+  int font_size = font ? (int)strlen(font) + 1 : 0;
+
+  if (box_w < w) box_w = w;
+  if (box_h < h) box_h = h;
+
+  iDrawListInitParams(&params, x, y, w, h, color, 0, 1);
+  params.a1 = text_orientation;
+  params.len = len;
+  params.flags = flags;
+  params.font_len = font ? font_size - 1 : -1;
+
+  /* the text string is stored with a terminator, so it can be used directly */
+  {
+    char* str = (char*)malloc(len + 1);
+    if (!str)
+      return;
+    memcpy(str, text, len);
+    str[len] = 0;
+
+    /* rotated text can be anywhere */
+    iDrawListAdd(list, IUP_DRAWLIST_TEXT, text_orientation != 0, x - 1, y - 1, x + box_w, y + box_h, &params, str, len + 1, font, font_size, NULL, 0);
+    free(str);
+  }
+}
+
+void iupDrawListImage(IdrawList* list, const char* name, unsigned int stamp, int make_inactive, const char* bgcolor, long tint, int opacity, int x, int y, int w, int h, int sx, int sy, int sw, int sh, int quality)
+{
+  IdrawListParams params;
+  int bgcolor_size = bgcolor ? (int)strlen(bgcolor) + 1 : 0;
+
+  if (!name)
+    return;
+
+  iDrawListInitParams(&params, x, y, w, h, 0, 0, 1);
+  params.make_inactive = make_inactive;
+  params.tint = (unsigned int)tint;
+  params.opacity = opacity;
+  params.sx = sx;
+  params.sy = sy;
+  params.sw = sw;
+  params.sh = sh;
+  params.quality = quality;
+  params.len = (int)strlen(name);
+  params.font_len = bgcolor ? bgcolor_size - 1 : -1;
+  params.stamp = stamp;
+
+  iDrawListAdd(list, IUP_DRAWLIST_IMAGE, (w <= 0 || h <= 0), x, y, x + w - 1, y + h - 1, &params, name, params.len + 1, bgcolor, bgcolor_size, NULL, 0);
+}
+
+void iupDrawListSetClipRect(IdrawList* list, int x1, int y1, int x2, int y2)
+{
+  IdrawListParams params;
+
+  if (x1 == 0 && y1 == 0 && x2 == 0 && y2 == 0)
+  {
+    iupDrawListResetClip(list);
+    return;
+  }
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  /* a different clipping changes how all the following items are drawn */
+  iDrawListInitParams(&params, x1, y1, x2, y2, 0, 0, 1);
+  iDrawListAdd(list, IUP_DRAWLIST_SETCLIPRECT, 1, 0, 0, 0, 0, &params, NULL, 0, NULL, 0, NULL, 0);
+
+  list->clip_x1 = x1;
+  list->clip_y1 = y1;
+  list->clip_x2 = x2;
+  list->clip_y2 = y2;
+  list->clip_changed = 1;
+}
+
+void iupDrawListSetClipRoundedRect(IdrawList* list, int x1, int y1, int x2, int y2, int corner_radius)
+{
+  IdrawListParams params;
+
+  if (x1 == 0 && y1 == 0 && x2 == 0 && y2 == 0)
+  {
+    iupDrawListResetClip(list);
+    return;
+  }
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  iDrawListInitParams(&params, x1, y1, x2, y2, 0, 0, 1);
+  params.corner_radius = corner_radius;
+  iDrawListAdd(list, IUP_DRAWLIST_SETCLIPROUNDEDRECT, 1, 0, 0, 0, 0, &params, NULL, 0, NULL, 0, NULL, 0);
+
+  list->clip_x1 = x1;
+  list->clip_y1 = y1;
+  list->clip_x2 = x2;
+  list->clip_y2 = y2;
+  list->clip_changed = 1;
+}
+
+void iupDrawListResetClip(IdrawList* list)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, 0, 0, 0, 0, 0, 0, 1);
+  iDrawListAdd(list, IUP_DRAWLIST_RESETCLIP, 1, 0, 0, 0, 0, &params, NULL, 0, NULL, 0, NULL, 0);
+
+  list->clip_x1 = 0;
+  list->clip_y1 = 0;
+  list->clip_x2 = 0;
+  list->clip_y2 = 0;
+  list->clip_changed = 1;
+}
+
+void iupDrawListGetClipRect(IdrawList* list, int *x1, int *y1, int *x2, int *y2)
+{
+  if (x1) *x1 = list->clip_x1;
+  if (y1) *y1 = list->clip_y1;
+  if (x2) *x2 = list->clip_x2;
+  if (y2) *y2 = list->clip_y2;
+}
+
+void iupDrawListSelectRect(IdrawList* list, int x1, int y1, int x2, int y2)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, 0, 0, 1);
+  iDrawListAddShape(list, IUP_DRAWLIST_SELECTRECT, &params, x1, y1, x2, y2);
+}
+
+void iupDrawListFocusRect(IdrawList* list, int x1, int y1, int x2, int y2)
+{
+  IdrawListParams params;
+  iDrawListInitParams(&params, x1, y1, x2, y2, 0, 0, 1);
+  iDrawListAddShape(list, IUP_DRAWLIST_FOCUSRECT, &params, x1, y1, x2, y2);
+}
+
+void iupDrawListAppend(IdrawList* list, IdrawList* src)
+{
+  unsigned char* ptr;
+
+  if (src->size == 0)
+    return;
+
+  /* items are position independent, so they are simply copied */
+  ptr = iDrawListReserve(list, src->size);
+  if (!ptr)
+    return;
+
+  memcpy(ptr, src->data, src->size);
+  list->count += src->count;
+  list->hash_valid = 0;
+
+  if (src->clip_changed)
+  {
+    list->clip_x1 = src->clip_x1;
+    list->clip_y1 = src->clip_y1;
+    list->clip_x2 = src->clip_x2;
+    list->clip_y2 = src->clip_y2;
+    list->clip_changed = 1;
+  }
+}
+
+/**************************************************************************************/
+
+int iupDrawListNext(IdrawList* list, int *pos, IdrawListItem* item)
+{
+  IdrawListHeader header;
+  IdrawListParams params;
+  const unsigned char* ptr;
+  int size1;
+
+  if (*pos >= list->size)
+    return 0;
+
+  ptr = list->data + *pos;
+  memcpy(&header, ptr, sizeof(IdrawListHeader));
+  memcpy(&params, ptr + sizeof(IdrawListHeader), sizeof(IdrawListParams));
+  ptr += sizeof(IdrawListHeader) + sizeof(IdrawListParams);
+
+  memset(item, 0, sizeof(IdrawListItem));
+  item->type = header.type;
+  item->x1 = params.x1;
+  item->y1 = params.y1;
+  item->x2 = params.x2;
+  item->y2 = params.y2;
+  item->x3 = params.x3;
+  item->y3 = params.y3;
+  item->x4 = params.x4;
+  item->y4 = params.y4;
+  item->corner_radius = params.corner_radius;
+  item->color = (long)params.color;
+  item->style = params.style;
+  item->line_width = params.line_width;
+  item->a1 = params.a1;
+  item->a2 = params.a2;
+  item->count = params.count;
+  item->len = params.len;
+  item->flags = params.flags;
+  item->tint = (long)params.tint;
+  item->make_inactive = params.make_inactive;
+  item->opacity = params.opacity;
+  item->quality = params.quality;
+  item->sx = params.sx;
+  item->sy = params.sy;
+  item->sw = params.sw;
+  item->sh = params.sh;
+  item->stamp = params.stamp;
+
+  switch (header.type)
+  {
+  case IUP_DRAWLIST_POLYGON:
+  case IUP_DRAWLIST_POLYLINE:
+    item->points = (const int*)ptr;
+    break;
+  case IUP_DRAWLIST_LINEARGRADIENT:
+  case IUP_DRAWLIST_RADIALGRADIENT:
+    size1 = params.count * (int)sizeof(long);
+    item->colors = (const long*)ptr;
+    item->offsets = (const float*)(ptr + IDRAWLIST_ALIGN(size1));
+    break;
+  case IUP_DRAWLIST_TEXT:
+  case IUP_DRAWLIST_IMAGE:
+    size1 = params.len + 1;
+    item->text = (const char*)ptr;
+    if (params.font_len >= 0)
+      item->font = (const char*)(ptr + IDRAWLIST_ALIGN(size1));
+    break;
+  }
+
+  *pos += header.size;
+  return 1;
+}
+
+static void iDrawListDiffAddItem(const IdrawListHeader* header, int *full, int *x1, int *y1, int *x2, int *y2)
+{
+  if (header->full)
+  {
+    *full = 1;
+    return;
+  }
+
+  if (header->bx1 < *x1) *x1 = header->bx1;
+  if (header->by1 < *y1) *y1 = header->by1;
+  if (header->bx2 > *x2) *x2 = header->bx2;
+  if (header->by2 > *y2) *y2 = header->by2;
+}
+
+int iupDrawListDiff(IdrawList* prev, IdrawList* list, int *x1, int *y1, int *x2, int *y2)
+{
+  int pos1 = 0, pos2 = 0, full = 0;
+  int dx1 = INT_MAX, dy1 = INT_MAX, dx2 = INT_MIN, dy2 = INT_MIN;
+
+  if (!prev || prev->w != list->w || prev->h != list->h)
+    full = 1;
+  else if (prev->size == list->size && (prev->size == 0 || memcmp(prev->data, list->data, list->size) == 0))
+    return 0;
+
+  /* items are compared at the same position,
+     any item drawn over a changed item will be redrawn when the changed area is redrawn */
+  while (!full && (pos1 < prev->size || pos2 < list->size))
+  {
+    IdrawListHeader h1, h2;
+
+    if (pos1 < prev->size && pos2 < list->size)
+    {
+      memcpy(&h1, prev->data + pos1, sizeof(IdrawListHeader));
+      memcpy(&h2, list->data + pos2, sizeof(IdrawListHeader));
+
+      if (h1.size != h2.size || memcmp(prev->data + pos1, list->data + pos2, h1.size) != 0)
+      {
+        iDrawListDiffAddItem(&h1, &full, &dx1, &dy1, &dx2, &dy2);
+        iDrawListDiffAddItem(&h2, &full, &dx1, &dy1, &dx2, &dy2);
+      }
+
+      pos1 += h1.size;
+      pos2 += h2.size;
+    }
+    else if (pos1 < prev->size)
+    {
+      memcpy(&h1, prev->data + pos1, sizeof(IdrawListHeader));
+      iDrawListDiffAddItem(&h1, &full, &dx1, &dy1, &dx2, &dy2);
+      pos1 += h1.size;
+    }
+    else
+    {
+      memcpy(&h2, list->data + pos2, sizeof(IdrawListHeader));
+      iDrawListDiffAddItem(&h2, &full, &dx1, &dy1, &dx2, &dy2);
+      pos2 += h2.size;
+    }
+  }
+
+  if (full)
+  {
+    dx1 = 0;
+    dy1 = 0;
+    dx2 = list->w - 1;
+    dy2 = list->h - 1;
+  }
+  else
+  {
+    if (dx1 < 0) dx1 = 0;
+    if (dy1 < 0) dy1 = 0;
+    if (dx2 > list->w - 1) dx2 = list->w - 1;
+    if (dy2 > list->h - 1) dy2 = list->h - 1;
+
+    if (dx1 > dx2 || dy1 > dy2)
+      return 0;  /* changes are all outside the canvas */
+  }
+
+  if (x1) *x1 = dx1;
+  if (y1) *y1 = dy1;
+  if (x2) *x2 = dx2;
+  if (y2) *y2 = dy2;
+  return 1;
+}
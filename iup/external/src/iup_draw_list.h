@@ -0,0 +1,108 @@
+/** \file
+ * \brief Draw Display List.
+ *
+ * Records the IUP draw primitives into a compact binary list
+ * that can be replayed later to any draw canvas,
+ * and compared to a previous list to find the changed area.
+ *
+ * See Copyright Notice in "iup.h"
+ *
+ */
+
+#ifndef __IUP_DRAW_LIST_H
+#define __IUP_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct _IdrawList IdrawList;
+
+/* item types */
+enum {
+  IUP_DRAWLIST_LINE = 1, IUP_DRAWLIST_RECTANGLE, IUP_DRAWLIST_ARC, IUP_DRAWLIST_ELLIPSE,
+  IUP_DRAWLIST_POLYGON, IUP_DRAWLIST_PIXEL, IUP_DRAWLIST_ROUNDEDRECTANGLE,
+  IUP_DRAWLIST_BEZIER, IUP_DRAWLIST_QUADRATICBEZIER,
+  IUP_DRAWLIST_LINEARGRADIENT, IUP_DRAWLIST_RADIALGRADIENT,
+  IUP_DRAWLIST_TEXT, IUP_DRAWLIST_IMAGE,
+  IUP_DRAWLIST_SETCLIPRECT, IUP_DRAWLIST_SETCLIPROUNDEDRECT, IUP_DRAWLIST_RESETCLIP,
+  IUP_DRAWLIST_SELECTRECT, IUP_DRAWLIST_FOCUSRECT, IUP_DRAWLIST_POLYLINE
+};
+
+/* A decoded item. Pointers are valid while the list is not changed. */
+typedef struct _IdrawListItem
+{
+  int type;
+  int x1, y1, x2, y2, x3, y3, x4, y4;   /* x3,y3 is also cx,cy and radius for radial gradients */
+  int corner_radius;
+  long color;
+  int style, line_width;
+  double a1, a2;                  /* arc angles, text orientation at a1, gradient angle at a1 */
+  int count;                      /* polygon/polyline points or gradient stops */
+  const int* points;
+  const long* colors;
+  const float* offsets;
+  const char* text;               /* text or image name */
+  int len, flags;
+  const char* font;               /* font or image bgcolor, can be NULL */
+  long tint;
+  int make_inactive, opacity, quality;
+  int sx, sy, sw, sh;
+  unsigned int stamp;             /* image change stamp */
+} IdrawListItem;
+
+IdrawList* iupDrawListCreate(int w, int h);
+void       iupDrawListKill(IdrawList* list);
+void       iupDrawListClear(IdrawList* list, int w, int h);
+
+void iupDrawListGetSize(IdrawList* list, int *w, int *h);
+int  iupDrawListGetCount(IdrawList* list);
+const unsigned char* iupDrawListGetData(IdrawList* list, int *size);
+unsigned int iupDrawListGetHash(IdrawList* list);
+
+/* Adds a copy of all the items of src at the end of list. */
+void iupDrawListAppend(IdrawList* list, IdrawList* src);
+
+/* Iterates the list items. pos must start at 0. Returns 0 at the end of the list. */
+int  iupDrawListNext(IdrawList* list, int *pos, IdrawListItem* item);
+
+/* Returns 0 if both lists will produce the same output,
+   or 1 and the rectangle that includes all the differences. */
+int  iupDrawListDiff(IdrawList* prev, IdrawList* list, int *x1, int *y1, int *x2, int *y2);
+
+/* color is encoded as in iupDrawColor */
+
+void iupDrawListLine(IdrawList* list, int x1, int y1, int x2, int y2, long color, int style, int line_width);
+void iupDrawListRectangle(IdrawList* list, int x1, int y1, int x2, int y2, long color, int style, int line_width);
+void iupDrawListArc(IdrawList* list, int x1, int y1, int x2, int y2, double a1, double a2, long color, int style, int line_width);
+void iupDrawListEllipse(IdrawList* list, int x1, int y1, int x2, int y2, long color, int style, int line_width);
+void iupDrawListPolygon(IdrawList* list, int* points, int count, long color, int style, int line_width);
+void iupDrawListPolyline(IdrawList* list, int* points, int count, long color, int style, int line_width);
+void iupDrawListPixel(IdrawList* list, int x, int y, long color);
+void iupDrawListRoundedRectangle(IdrawList* list, int x1, int y1, int x2, int y2, int corner_radius, long color, int style, int line_width);
+void iupDrawListBezier(IdrawList* list, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, long color, int style, int line_width);
+void iupDrawListQuadraticBezier(IdrawList* list, int x1, int y1, int x2, int y2, int x3, int y3, long color, int style, int line_width);
+void iupDrawListLinearGradient(IdrawList* list, int x1, int y1, int x2, int y2, float angle, const long* colors, const float* offsets, int count);
+void iupDrawListRadialGradient(IdrawList* list, int cx, int cy, int radius, const long* colors, const float* offsets, int count);
+
+/* box_w and box_h is the area actually covered by the text, used only to compare lists */
+void iupDrawListText(IdrawList* list, const char* text, int len, int x, int y, int w, int h, long color, const char* font, int flags, double text_orientation, int box_w, int box_h);
+
+/* w and h must be already resolved to the image size when -1,
+   stamp must change when the image pixels change (see iupImageGetStamp) */
+void iupDrawListImage(IdrawList* list, const char* name, unsigned int stamp, int make_inactive, const char* bgcolor, long tint, int opacity, int x, int y, int w, int h, int sx, int sy, int sw, int sh, int quality);
+
+void iupDrawListSetClipRect(IdrawList* list, int x1, int y1, int x2, int y2);
+void iupDrawListSetClipRoundedRect(IdrawList* list, int x1, int y1, int x2, int y2, int corner_radius);
+void iupDrawListResetClip(IdrawList* list);
+void iupDrawListGetClipRect(IdrawList* list, int *x1, int *y1, int *x2, int *y2);
+
+void iupDrawListSelectRect(IdrawList* list, int x1, int y1, int x2, int y2);
+void iupDrawListFocusRect(IdrawList* list, int x1, int y1, int x2, int y2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1895 @@
+/** \file
+ * \brief RGBA Draw Driver
+ *
+ * Software drawing canvas that mirrors the IUP draw API.
+ * All drawing operations are rasterized into an RGBA buffer in memory.
+ * Shapes are not anti-aliased, so the result is the same in all systems.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "iup.h"
+
+#include "iup_drvdraw.h"
+#include "iup_draw.h"
+#include "iup_draw_rgba.h"
+#include "iup_drvfont.h"
+#include "iup_image.h"
+
+
+#define IRGBA_PI 3.14159265358979323846
+
+struct _iRgbaCanvas
+{
+  int w, h;
+  unsigned char* data;
+
+  /* effective clipping, always inside the canvas */
+  int clip_x1, clip_y1, clip_x2, clip_y2;
+  double clip_radius;
+  int round_x1, round_y1, round_x2, round_y2;
+
+  /* last values set by the application */
+  int user_clip_x1, user_clip_y1, user_clip_x2, user_clip_y2;
+};
+
+
+/* ---- Pixels ---- */
+
+static void iRgbaBlend(unsigned char* p, unsigned char r, unsigned char g, unsigned char b, int a)
+{
+  int da, oa;
+
+  if (a <= 0)
+    return;
+
+  if (a >= 255)
+  {
+    p[0] = r; p[1] = g; p[2] = b; p[3] = 255;
+    return;
+  }
+
+  da = p[3];
+  if (da == 255)
+  {
+    p[0] = (unsigned char)(p[0] + ((r - p[0]) * a) / 255);
+    p[1] = (unsigned char)(p[1] + ((g - p[1]) * a) / 255);
+    p[2] = (unsigned char)(p[2] + ((b - p[2]) * a) / 255);
+    return;
+  }
+
+  /* source over a transparent destination, colors are not premultiplied */
+  da = (da * (255 - a)) / 255;
+  oa = a + da;
+  p[0] = (unsigned char)((r * a + p[0] * da) / oa);
+  p[1] = (unsigned char)((g * a + p[1] * da) / oa);
+  p[2] = (unsigned char)((b * a + p[2] * da) / oa);
+  p[3] = (unsigned char)oa;
+}
+
+static int iRgbaInRoundClip(iRgbaCanvas* dc, int x, int y)
+{
+  double r = dc->clip_radius, cx, cy, dx, dy;
+
+  if (x < dc->round_x1 + r)
+    cx = dc->round_x1 + r;
+  else if (x + 1 > dc->round_x2 + 1 - r)
+    cx = dc->round_x2 + 1 - r;
+  else
+    return 1;
+
+  if (y < dc->round_y1 + r)
+    cy = dc->round_y1 + r;
+  else if (y + 1 > dc->round_y2 + 1 - r)
+    cy = dc->round_y2 + 1 - r;
+  else
+    return 1;
+
+  dx = x + 0.5 - cx;
+  dy = y + 0.5 - cy;
+  return dx * dx + dy * dy <= r * r;
+}
+
+static void iRgbaPixel(iRgbaCanvas* dc, int x, int y, long color, int alpha)
+{
+  if (x < dc->clip_x1 || x > dc->clip_x2 || y < dc->clip_y1 || y > dc->clip_y2)
+    return;
+
+  if (dc->clip_radius > 0 && !iRgbaInRoundClip(dc, x, y))
+    return;
+
+  iRgbaBlend(dc->data + ((size_t)y * dc->w + x) * 4, iupDrawRed(color), iupDrawGreen(color), iupDrawBlue(color), alpha);
+}
+
+static void iRgbaSpan(iRgbaCanvas* dc, int y, int x1, int x2, long color)
+{
+  unsigned char r = iupDrawRed(color), g = iupDrawGreen(color), b = iupDrawBlue(color);
+  int a = iupDrawAlpha(color);
+  unsigned char* p;
+  int x;
+
+  if (y < dc->clip_y1 || y > dc->clip_y2)
+    return;
+
+  if (x1 < dc->clip_x1) x1 = dc->clip_x1;
+  if (x2 > dc->clip_x2) x2 = dc->clip_x2;
+  if (x1 > x2)
+    return;
+
+  p = dc->data + ((size_t)y * dc->w + x1) * 4;
+
+  if (dc->clip_radius > 0)
+  {
+    for (x = x1; x <= x2; x++, p += 4)
+    {
+      if (iRgbaInRoundClip(dc, x, y))
+        iRgbaBlend(p, r, g, b, a);
+    }
+    return;
+  }
+
+  if (a >= 255)
+  {
+    for (x = x1; x <= x2; x++, p += 4)
+    {
+      p[0] = r; p[1] = g; p[2] = b; p[3] = 255;
+    }
+  }
+  else
+  {
+    for (x = x1; x <= x2; x++, p += 4)
+      iRgbaBlend(p, r, g, b, a);
+  }
+}
+
+
+/* ---- Dashes ---- */
+
+typedef struct _iRgbaDash
+{
+  const double* pattern;
+  int count, index;
+  double remain, period;
+} iRgbaDash;
+
+static void iRgbaDashInit(iRgbaDash* dash, int style)
+{
+  /* same patterns of the Cairo driver */
+  static const double dash_pattern[2] = { 9.0, 3.0 };
+  static const double dot_pattern[2] = { 1.0, 2.0 };
+  static const double dash_dot_pattern[4] = { 7.0, 3.0, 1.0, 3.0 };
+  static const double dash_dot_dot_pattern[6] = { 7.0, 3.0, 1.0, 3.0, 1.0, 3.0 };
+
+  dash->pattern = NULL;
+  dash->count = 0;
+
+  if (style == IUP_DRAW_STROKE_DASH)
+  {
+    dash->pattern = dash_pattern;
+    dash->count = 2;
+  }
+  else if (style == IUP_DRAW_STROKE_DOT)
+  {
+    dash->pattern = dot_pattern;
+    dash->count = 2;
+  }
+  else if (style == IUP_DRAW_STROKE_DASH_DOT)
+  {
+    dash->pattern = dash_dot_pattern;
+    dash->count = 4;
+  }
+  else if (style == IUP_DRAW_STROKE_DASH_DOT_DOT)
+  {
+    dash->pattern = dash_dot_dot_pattern;
+    dash->count = 6;
+  }
+
+  dash->index = 0;
+  dash->remain = dash->pattern ? dash->pattern[0] : 0;
+  dash->period = 0;
+  if (dash->pattern)
+  {
+    int i;
+    for (i = 0; i < dash->count; i++)
+      dash->period += dash->pattern[i];
+  }
+}
+
+static int iRgbaDashIsOn(iRgbaDash* dash)
+{
+  return !dash->pattern || (dash->index % 2) == 0;
+}
+
+static void iRgbaDashAdvance(iRgbaDash* dash, double length)
+{
+  if (!dash->pattern)
+    return;
+
+  /* whole periods do not change the pattern position, long clipped out pieces are skipped at once */
+  if (length > dash->period)
+    length = fmod(length, dash->period);
+
+  dash->remain -= length;
+  while (dash->remain <= 0)
+  {
+    dash->index = (dash->index + 1) % dash->count;
+    dash->remain += dash->pattern[dash->index];
+  }
+}
+
+
+/* ---- Segment Clipping ---- */
+
+/* Strokes are clipped to the clipping area expanded by the line width and this margin.
+   A clipped stroke starts at a different position, so its pixels and dashes can differ by rounding,
+   with a large margin this happens only for strokes that go far outside the canvas. */
+#define IRGBA_CLIP_MARGIN 256
+
+typedef struct _iRgbaBounds
+{
+  double x1, y1, x2, y2;
+} iRgbaBounds;
+
+/* clipping area expanded by margin, strokes outside it do not change any pixel */
+static void iRgbaGetStrokeBounds(iRgbaCanvas* dc, double margin, iRgbaBounds* bounds)
+{
+  bounds->x1 = dc->clip_x1 - margin;
+  bounds->y1 = dc->clip_y1 - margin;
+  bounds->x2 = dc->clip_x2 + 1 + margin;
+  bounds->y2 = dc->clip_y2 + 1 + margin;
+}
+
+static int iRgbaBoundsContains(const iRgbaBounds* bounds, double x, double y)
+{
+  return x >= bounds->x1 && x <= bounds->x2 && y >= bounds->y1 && y <= bounds->y2;
+}
+
+/* Liang-Barsky. Returns 0 if the segment is outside the bounds,
+   or 1 and the visible part of the segment from t0 to t1 (0 to 1 when all visible). */
+static int iRgbaClipSegment(const iRgbaBounds* bounds, double x1, double y1, double x2, double y2, double *t0, double *t1)
+{
+  double p[4], q[4];
+  int i;
+
+  p[0] = x1 - x2; q[0] = x1 - bounds->x1;
+  p[1] = x2 - x1; q[1] = bounds->x2 - x1;
+  p[2] = y1 - y2; q[2] = y1 - bounds->y1;
+  p[3] = y2 - y1; q[3] = bounds->y2 - y1;
+
+  *t0 = 0;
+  *t1 = 1;
+
+  for (i = 0; i < 4; i++)
+  {
+    if (p[i] == 0)
+    {
+      if (q[i] < 0)
+        return 0;  /* parallel and outside */
+    }
+    else
+    {
+      double r = q[i] / p[i];
+      if (p[i] < 0)
+      {
+        if (r > *t1)
+          return 0;
+        if (r > *t0)
+          *t0 = r;
+      }
+      else
+      {
+        if (r < *t0)
+          return 0;
+        if (r < *t1)
+          *t1 = r;
+      }
+    }
+  }
+
+  return 1;
+}
+
+
+/* ---- Edges ---- */
+
+typedef struct _iRgbaEdge
+{
+  double x0, y0, y1, dxdy;
+  int dir;
+} iRgbaEdge;
+
+typedef struct _iRgbaPath
+{
+  iRgbaEdge* edges;
+  int count, max;
+} iRgbaPath;
+
+static void iRgbaPathInit(iRgbaPath* path)
+{
+  path->edges = NULL;
+  path->count = 0;
+  path->max = 0;
+}
+
+static void iRgbaPathFree(iRgbaPath* path)
+{
+  free(path->edges);
+  iRgbaPathInit(path);
+}
+
+static void iRgbaPathAddEdge(iRgbaPath* path, double x0, double y0, double x1, double y1)
+{
+  iRgbaEdge* edge;
+  int dir = 1;
+
+  if (y0 == y1)
+    return;  /* horizontal edges do not cross the scan lines */
+
+  if (y0 > y1)
+  {
+    double t;
+    t = x0; x0 = x1; x1 = t;
+    t = y0; y0 = y1; y1 = t;
+    dir = -1;
+  }
+
+  if (path->count == path->max)
+  {
+    int new_max = path->max ? 2 * path->max : 64;
+    iRgbaEdge* new_edges = (iRgbaEdge*)realloc(path->edges, new_max * sizeof(iRgbaEdge));
+    if (!new_edges)
+      return;
+    path->edges = new_edges;
+    path->max = new_max;
+  }
+
+  edge = path->edges + path->count;
+  edge->x0 = x0;
+  edge->y0 = y0;
+  edge->y1 = y1;
+  edge->dxdy = (x1 - x0) / (y1 - y0);
+  edge->dir = dir;
+  path->count++;
+}
+
+/* pts are xyxyxy..., the polygon is always closed */
+static void iRgbaPathAddPolygon(iRgbaPath* path, const double* pts, int count)
+{
+  int i;
+  for (i = 0; i < count; i++)
+  {
+    int j = (i + 1) % count;
+    iRgbaPathAddEdge(path, pts[2 * i], pts[2 * i + 1], pts[2 * j], pts[2 * j + 1]);
+  }
+}
+
+static int iRgbaEdgeCompare(const void* a, const void* b)
+{
+  double y0a = ((const iRgbaEdge*)a)->y0;
+  double y0b = ((const iRgbaEdge*)b)->y0;
+  return (y0a > y0b) - (y0a < y0b);
+}
+
+typedef struct _iRgbaCross
+{
+  double x;
+  int dir;
+} iRgbaCross;
+
+/* Fills the path with the non-zero winding rule, sampling at the pixel centers. */
+static void iRgbaPathFill(iRgbaCanvas* dc, iRgbaPath* path, long color)
+{
+  iRgbaCross* cross;
+  int* active;
+  int active_count = 0, next = 0, i, y, y1, y2;
+  double ymin, ymax;
+
+  if (path->count == 0)
+    return;
+
+  qsort(path->edges, path->count, sizeof(iRgbaEdge), iRgbaEdgeCompare);
+
+  ymin = path->edges[0].y0;
+  ymax = path->edges[0].y1;
+  for (i = 1; i < path->count; i++)
+  {
+    if (path->edges[i].y1 > ymax)
+      ymax = path->edges[i].y1;
+  }
+
+  /* rows with the center inside [ymin, ymax) */
+  y1 = (int)ceil(ymin - 0.5);
+  y2 = (int)ceil(ymax - 0.5) - 1;
+  if (y1 < dc->clip_y1) y1 = dc->clip_y1;
+  if (y2 > dc->clip_y2) y2 = dc->clip_y2;
+  if (y1 > y2)
+    return;
+
+  cross = (iRgbaCross*)malloc(path->count * sizeof(iRgbaCross));
+  active = (int*)malloc(path->count * sizeof(int));
+  if (!cross || !active)
+  {
+    free(cross);
+    free(active);
+    return;
+  }
+
+  for (y = y1; y <= y2; y++)
+  {
+    double sy = y + 0.5;
+    int count = 0, winding = 0;
+
+    while (next < path->count && path->edges[next].y0 <= sy)
+      active[active_count++] = next++;
+
+    for (i = 0; i < active_count; )
+    {
+      iRgbaEdge* edge = path->edges + active[i];
+      if (edge->y1 <= sy)
+      {
+        active[i] = active[--active_count];
+        continue;
+      }
+
+      if (edge->y0 <= sy)
+      {
+        int j = count++;
+        double x = edge->x0 + (sy - edge->y0) * edge->dxdy;
+
+        /* insertion sort, there are usually only a few crossings */
+        while (j > 0 && cross[j - 1].x > x)
+        {
+          cross[j] = cross[j - 1];
+          j--;
+        }
+        cross[j].x = x;
+        cross[j].dir = edge->dir;
+      }
+      i++;
+    }
+
+    for (i = 0; i < count - 1; i++)
+    {
+      winding += cross[i].dir;
+      if (winding != 0)
+      {
+        /* pixels with the center inside [x, next x) */
+        int x1 = (int)ceil(cross[i].x - 0.5);
+        int x2 = (int)ceil(cross[i + 1].x - 0.5) - 1;
+        if (x1 <= x2)
+          iRgbaSpan(dc, y, x1, x2, color);
+      }
+    }
+  }
+
+  free(cross);
+  free(active);
+}
+
+static void iRgbaPathAddEllipse(iRgbaPath* path, double xc, double yc, double rx, double ry, double a1, double span, int pie, int reverse)
+{
+  double* pts;
+  int n, i, count = 0;
+
+  /* a segment about every 2 pixels */
+  n = (int)(((rx > ry) ? rx : ry) * span / 90.0);
+  if (n < 8) n = 8;
+  if (n > 2048) n = 2048;
+
+  pts = (double*)malloc((n + 2) * 2 * sizeof(double));
+  if (!pts)
+    return;
+
+  if (pie)
+  {
+    pts[0] = xc;
+    pts[1] = yc;
+    count = 1;
+  }
+
+  for (i = 0; i <= n; i++)
+  {
+    double a = (a1 + (span * (reverse ? n - i : i)) / n) * IRGBA_PI / 180.0;
+    pts[2 * count] = xc + rx * cos(a);
+    pts[2 * count + 1] = yc - ry * sin(a);  /* counterclockwise, y axis is down */
+    count++;
+  }
+
+  iRgbaPathAddPolygon(path, pts, count);
+  free(pts);
+}
+
+
+/* ---- Strokes ---- */
+
+/* width 1 lines, all pixels of the line except the first if skip_first */
+static void iRgbaLineW1(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, iRgbaDash* dash, int skip_first, int skip_last)
+{
+  int dx = abs(x2 - x1), dy = abs(y2 - y1);
+  int sx = x1 < x2 ? 1 : -1, sy = y1 < y2 ? 1 : -1;
+  int err = dx - dy, i, steps = dx > dy ? dx : dy;
+  double step_length = steps ? sqrt((double)dx * dx + (double)dy * dy) / steps : 1;
+  int alpha = iupDrawAlpha(color);
+
+  for (i = 0; i <= steps; i++)
+  {
+    int e2;
+
+    if (!(i == 0 && skip_first) && !(i == steps && skip_last) && iRgbaDashIsOn(dash))
+      iRgbaPixel(dc, x1, y1, color, alpha);
+
+    if (i != steps)
+      iRgbaDashAdvance(dash, step_length);
+
+    e2 = 2 * err;
+    if (e2 > -dy)
+    {
+      err -= dy;
+      x1 += sx;
+    }
+    if (e2 < dx)
+    {
+      err += dx;
+      y1 += sy;
+    }
+  }
+}
+
+/* same as iRgbaLineW1 but the coordinates can be anywhere,
+   the line is clipped before it is rasterized and the dash pattern continues from the clipped part */
+static void iRgbaLineW1Clip(iRgbaCanvas* dc, double x1, double y1, double x2, double y2, long color, iRgbaDash* dash, int skip_first, int skip_last)
+{
+  iRgbaBounds bounds;
+  double t0, t1, dx = x2 - x1, dy = y2 - y1;
+  double len = sqrt(dx * dx + dy * dy);
+
+  iRgbaGetStrokeBounds(dc, IRGBA_CLIP_MARGIN, &bounds);
+
+  if (iRgbaBoundsContains(&bounds, x1, y1) && iRgbaBoundsContains(&bounds, x2, y2))
+  {
+    iRgbaLineW1(dc, (int)x1, (int)y1, (int)x2, (int)y2, color, dash, skip_first, skip_last);
+    return;
+  }
+
+  if (!iRgbaClipSegment(&bounds, x1, y1, x2, y2, &t0, &t1))
+  {
+    iRgbaDashAdvance(dash, len);
+    return;
+  }
+
+  {
+    /* the dash advances the same length for each pixel step as in the whole line */
+    double cx1 = floor(x1 + dx * t0 + 0.5), cy1 = floor(y1 + dy * t0 + 0.5);
+    double cx2 = floor(x1 + dx * t1 + 0.5), cy2 = floor(y1 + dy * t1 + 0.5);
+    int x_major = fabs(dx) > fabs(dy);
+    double step_length = len / (x_major ? fabs(dx) : fabs(dy));
+
+    iRgbaDashAdvance(dash, step_length * (x_major ? fabs(cx1 - x1) : fabs(cy1 - y1)));
+    iRgbaLineW1(dc, (int)cx1, (int)cy1, (int)cx2, (int)cy2, color, dash, skip_first && t0 == 0, skip_last && t1 == 1);
+    iRgbaDashAdvance(dash, step_length * (x_major ? fabs(x2 - cx2) : fabs(y2 - cy2)));
+  }
+}
+
+static void iRgbaPathAddQuad(iRgbaPath* path, double x1, double y1, double x2, double y2, double half_width)
+{
+  double pts[8];
+  double dx = x2 - x1, dy = y2 - y1;
+  double len = sqrt(dx * dx + dy * dy);
+  double nx, ny;
+
+  if (len == 0)
+    return;
+
+  nx = -dy * half_width / len;
+  ny = dx * half_width / len;
+
+  pts[0] = x1 + nx; pts[1] = y1 + ny;
+  pts[2] = x2 + nx; pts[3] = y2 + ny;
+  pts[4] = x2 - nx; pts[5] = y2 - ny;
+  pts[6] = x1 - nx; pts[7] = y1 - ny;
+  iRgbaPathAddPolygon(path, pts, 4);
+}
+
+static void iRgbaPathAddThickSegment(iRgbaPath* path, const iRgbaBounds* bounds, double x1, double y1, double x2, double y2, double half_width, iRgbaDash* dash)
+{
+  double dx = x2 - x1, dy = y2 - y1;
+  double len = sqrt(dx * dx + dy * dy), pos, end, t0, t1;
+
+  /* only the visible part is dashed and filled, bounds already include the line width */
+  if (!iRgbaClipSegment(bounds, x1, y1, x2, y2, &t0, &t1))
+  {
+    iRgbaDashAdvance(dash, len);
+    return;
+  }
+
+  if (!dash->pattern)
+  {
+    iRgbaPathAddQuad(path, x1 + dx * t0, y1 + dy * t0, x1 + dx * t1, y1 + dy * t1, half_width);
+    return;
+  }
+
+  pos = len * t0;
+  end = len * t1;
+  iRgbaDashAdvance(dash, pos);
+
+  while (pos < end)
+  {
+    double piece = dash->remain;
+    if (pos + piece > end)
+      piece = end - pos;
+
+    if (iRgbaDashIsOn(dash))
+      iRgbaPathAddQuad(path, x1 + dx * pos / len, y1 + dy * pos / len, x1 + dx * (pos + piece) / len, y1 + dy * (pos + piece) / len, half_width);
+
+    iRgbaDashAdvance(dash, piece);
+    pos += piece;
+  }
+
+  iRgbaDashAdvance(dash, len - end);
+}
+
+/* Strokes a polyline given in pixel coordinates, integer values are at the pixel centers. */
+static void iRgbaStrokePolyline(iRgbaCanvas* dc, const double* pts, int count, int closed, long color, int style, int line_width)
+{
+  iRgbaDash dash;
+  int i, seg_count = closed ? count : count - 1;
+
+  if (count < 2)
+  {
+    if (count == 1)
+      iRgbaPixel(dc, (int)floor(pts[0] + 0.5), (int)floor(pts[1] + 0.5), color, iupDrawAlpha(color));
+    return;
+  }
+
+  iRgbaDashInit(&dash, style);
+
+  if (line_width <= 1)
+  {
+    for (i = 0; i < seg_count; i++)
+    {
+      int j = (i + 1) % count;
+      double x1 = floor(pts[2 * i] + 0.5), y1 = floor(pts[2 * i + 1] + 0.5);
+      double x2 = floor(pts[2 * j] + 0.5), y2 = floor(pts[2 * j + 1] + 0.5);
+
+      /* the joints are drawn only once, so translucent lines do not get darker */
+      iRgbaLineW1Clip(dc, x1, y1, x2, y2, color, &dash, i > 0, closed && i == seg_count - 1);
+    }
+  }
+  else
+  {
+    /* all the pieces are filled at once, each pixel is painted only once */
+    iRgbaPath path;
+    iRgbaBounds bounds;
+    double half_width = line_width / 2.0;
+
+    iRgbaPathInit(&path);
+    iRgbaGetStrokeBounds(dc, half_width + IRGBA_CLIP_MARGIN, &bounds);
+
+    for (i = 0; i < seg_count; i++)
+    {
+      int j = (i + 1) % count;
+      iRgbaPathAddThickSegment(&path, &bounds, pts[2 * i] + 0.5, pts[2 * i + 1] + 0.5, pts[2 * j] + 0.5, pts[2 * j + 1] + 0.5, half_width, &dash);
+
+      /* round joins, with the same orientation of the segments */
+      if (!dash.pattern && line_width > 2 && (closed || j != 0) && (closed || i < seg_count - 1) && iRgbaBoundsContains(&bounds, pts[2 * j] + 0.5, pts[2 * j + 1] + 0.5))
+        iRgbaPathAddEllipse(&path, pts[2 * j] + 0.5, pts[2 * j + 1] + 0.5, half_width, half_width, 0, 360, 0, 1);
+    }
+
+    iRgbaPathFill(dc, &path, color);
+    iRgbaPathFree(&path);
+  }
+}
+
+static double* iRgbaEllipsePoints(double xc, double yc, double rx, double ry, double a1, double span, int *count)
+{
+  double* pts;
+  int n, i;
+
+  n = (int)(((rx > ry) ? rx : ry) * span / 90.0);
+  if (n < 8) n = 8;
+  if (n > 2048) n = 2048;
+
+  pts = (double*)malloc((n + 1) * 2 * sizeof(double));
+  if (!pts)
+  {
+    *count = 0;
+    return NULL;
+  }
+
+  for (i = 0; i <= n; i++)
+  {
+    double a = (a1 + (span * i) / n) * IRGBA_PI / 180.0;
+    pts[2 * i] = xc + rx * cos(a);
+    pts[2 * i + 1] = yc - ry * sin(a);
+  }
+
+  *count = n + 1;
+  return pts;
+}
+
+static int iRgbaRoundedRectPoints(double x1, double y1, double x2, double y2, double radius, double* pts)
+{
+  /* 4 corners with 9 points each, clockwise starting at the top right corner */
+  static const double corner_start[4] = { 90, 0, 270, 180 };
+  double cx[4], cy[4];
+  int c, i, count = 0;
+
+  cx[0] = x2 - radius; cy[0] = y1 + radius;
+  cx[1] = x2 - radius; cy[1] = y2 - radius;
+  cx[2] = x1 + radius; cy[2] = y2 - radius;
+  cx[3] = x1 + radius; cy[3] = y1 + radius;
+
+  for (c = 0; c < 4; c++)
+  {
+    for (i = 0; i <= 8; i++)
+    {
+      double a = (corner_start[c] - (90.0 * i) / 8) * IRGBA_PI / 180.0;
+      pts[2 * count] = cx[c] + radius * cos(a);
+      pts[2 * count + 1] = cy[c] - radius * sin(a);
+      count++;
+    }
+  }
+
+  return count;
+}
+
+static double iRgbaClampRadius(int x1, int y1, int x2, int y2, int corner_radius)
+{
+  double max_radius = ((x2 - x1) < (y2 - y1)) ? (x2 - x1) / 2.0 : (y2 - y1) / 2.0;
+  double radius = corner_radius;
+  if (radius > max_radius)
+    radius = max_radius;
+  if (radius < 0)
+    radius = 0;
+  return radius;
+}
+
+
+/* ---- Canvas ---- */
+
+iRgbaCanvas* iupRgbaDrawCreateCanvas(int w, int h)
+{
+  iRgbaCanvas* dc;
+
+  if (w <= 0 || h <= 0 || w > 32767 || h > 32767)
+    return NULL;
+
+  dc = (iRgbaCanvas*)calloc(1, sizeof(iRgbaCanvas));
+  if (!dc)
+    return NULL;
+
+  dc->data = (unsigned char*)calloc((size_t)w * h, 4);
+  if (!dc->data)
+  {
+    free(dc);
+    return NULL;
+  }
+
+  dc->w = w;
+  dc->h = h;
+  iupRgbaDrawResetClip(dc);
+
+  return dc;
+}
+
+void iupRgbaDrawKillCanvas(iRgbaCanvas* dc)
+{
+  if (!dc)
+    return;
+
+  free(dc->data);
+  free(dc);
+}
+
+void iupRgbaDrawGetSize(iRgbaCanvas* dc, int* w, int* h)
+{
+  if (w) *w = dc->w;
+  if (h) *h = dc->h;
+}
+
+unsigned char* iupRgbaDrawGetData(iRgbaCanvas* dc)
+{
+  return dc->data;
+}
+
+void iupRgbaDrawClear(iRgbaCanvas* dc)
+{
+  int y;
+
+  if (dc->clip_x1 > dc->clip_x2)
+    return;
+
+  for (y = dc->clip_y1; y <= dc->clip_y2; y++)
+    memset(dc->data + ((size_t)y * dc->w + dc->clip_x1) * 4, 0, (size_t)(dc->clip_x2 - dc->clip_x1 + 1) * 4);
+}
+
+
+/* ---- Clipping ---- */
+
+static void iRgbaSetClip(iRgbaCanvas* dc, int x1, int y1, int x2, int y2)
+{
+  dc->user_clip_x1 = x1;
+  dc->user_clip_y1 = y1;
+  dc->user_clip_x2 = x2;
+  dc->user_clip_y2 = y2;
+
+  if (x1 < 0) x1 = 0;
+  if (y1 < 0) y1 = 0;
+  if (x2 > dc->w - 1) x2 = dc->w - 1;
+  if (y2 > dc->h - 1) y2 = dc->h - 1;
+
+  if (x1 > x2 || y1 > y2)
+  {
+    /* empty, nothing will be drawn */
+    x1 = y1 = 0;
+    x2 = y2 = -1;
+  }
+
+  dc->clip_x1 = x1;
+  dc->clip_y1 = y1;
+  dc->clip_x2 = x2;
+  dc->clip_y2 = y2;
+  dc->clip_radius = 0;
+}
+
+void iupRgbaDrawSetClipRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2)
+{
+  if (x1 == 0 && y1 == 0 && x2 == 0 && y2 == 0)
+  {
+    iupRgbaDrawResetClip(dc);
+    return;
+  }
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  iRgbaSetClip(dc, x1, y1, x2, y2);
+}
+
+void iupRgbaDrawSetClipRoundedRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int corner_radius)
+{
+  if (x1 == 0 && y1 == 0 && x2 == 0 && y2 == 0)
+  {
+    iupRgbaDrawResetClip(dc);
+    return;
+  }
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  iRgbaSetClip(dc, x1, y1, x2, y2);
+
+  dc->clip_radius = iRgbaClampRadius(x1, y1, x2, y2, corner_radius);
+  dc->round_x1 = x1;
+  dc->round_y1 = y1;
+  dc->round_x2 = x2;
+  dc->round_y2 = y2;
+}
+
+void iupRgbaDrawResetClip(iRgbaCanvas* dc)
+{
+  dc->clip_x1 = 0;
+  dc->clip_y1 = 0;
+  dc->clip_x2 = dc->w - 1;
+  dc->clip_y2 = dc->h - 1;
+  dc->clip_radius = 0;
+
+  dc->user_clip_x1 = 0;
+  dc->user_clip_y1 = 0;
+  dc->user_clip_x2 = 0;
+  dc->user_clip_y2 = 0;
+}
+
+void iupRgbaDrawGetClipRect(iRgbaCanvas* dc, int* x1, int* y1, int* x2, int* y2)
+{
+  if (x1) *x1 = dc->user_clip_x1;
+  if (y1) *y1 = dc->user_clip_y1;
+  if (x2) *x2 = dc->user_clip_x2;
+  if (y2) *y2 = dc->user_clip_y2;
+}
+
+
+/* ---- Primitives ---- */
+
+void iupRgbaDrawPixel(iRgbaCanvas* dc, int x, int y, long color)
+{
+  iRgbaPixel(dc, x, y, color, iupDrawAlpha(color));
+}
+
+void iupRgbaDrawLine(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  double pts[4];
+
+  if (line_width <= 1 && style != IUP_DRAW_FILL && style != IUP_DRAW_STROKE)
+  {
+    iRgbaDash dash;
+    iRgbaDashInit(&dash, style);
+    iRgbaLineW1Clip(dc, x1, y1, x2, y2, color, &dash, 0, 0);
+    return;
+  }
+
+  if (line_width <= 1)
+  {
+    iRgbaDash dash;
+    iRgbaDashInit(&dash, IUP_DRAW_STROKE);
+
+    if (y1 == y2)
+    {
+      /* fast path for grids and axis */
+      iupDrawCheckSwapCoord(x1, x2);
+      iRgbaSpan(dc, y1, x1, x2, color);
+    }
+    else
+      iRgbaLineW1Clip(dc, x1, y1, x2, y2, color, &dash, 0, 0);
+    return;
+  }
+
+  pts[0] = x1; pts[1] = y1;
+  pts[2] = x2; pts[3] = y2;
+  iRgbaStrokePolyline(dc, pts, 2, 0, color, style, line_width);
+}
+
+void iupRgbaDrawRectangle(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  if (style == IUP_DRAW_FILL)
+  {
+    int y;
+    if (y1 < dc->clip_y1) y1 = dc->clip_y1;
+    if (y2 > dc->clip_y2) y2 = dc->clip_y2;
+    for (y = y1; y <= y2; y++)
+      iRgbaSpan(dc, y, x1, x2, color);
+  }
+  else if (style == IUP_DRAW_STROKE && line_width > 1)
+  {
+    /* outer border minus the inner area, with opposite orientations */
+    double hw = line_width / 2.0;
+    double ox1 = x1 + 0.5 - hw, oy1 = y1 + 0.5 - hw, ox2 = x2 + 0.5 + hw, oy2 = y2 + 0.5 + hw;
+    double ix1 = x1 + 0.5 + hw, iy1 = y1 + 0.5 + hw, ix2 = x2 + 0.5 - hw, iy2 = y2 + 0.5 - hw;
+    double outer[8], inner[8];
+    iRgbaPath path;
+
+    outer[0] = ox1; outer[1] = oy1; outer[2] = ox2; outer[3] = oy1;
+    outer[4] = ox2; outer[5] = oy2; outer[6] = ox1; outer[7] = oy2;
+
+    iRgbaPathInit(&path);
+    iRgbaPathAddPolygon(&path, outer, 4);
+
+    if (ix1 < ix2 && iy1 < iy2)
+    {
+      inner[0] = ix1; inner[1] = iy1; inner[2] = ix1; inner[3] = iy2;
+      inner[4] = ix2; inner[5] = iy2; inner[6] = ix2; inner[7] = iy1;
+      iRgbaPathAddPolygon(&path, inner, 4);
+    }
+
+    iRgbaPathFill(dc, &path, color);
+    iRgbaPathFree(&path);
+  }
+  else
+  {
+    double pts[8];
+    pts[0] = x1; pts[1] = y1; pts[2] = x2; pts[3] = y1;
+    pts[4] = x2; pts[5] = y2; pts[6] = x1; pts[7] = y2;
+    iRgbaStrokePolyline(dc, pts, 4, 1, color, style, line_width);
+  }
+}
+
+void iupRgbaDrawRoundedRectangle(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int corner_radius, long color, int style, int line_width)
+{
+  double pts[2 * 36];
+  double radius;
+  int count;
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  if (style == IUP_DRAW_FILL)
+  {
+    iRgbaPath path;
+
+    radius = iRgbaClampRadius(x1, y1, x2 + 1, y2 + 1, corner_radius);
+    count = iRgbaRoundedRectPoints(x1, y1, x2 + 1, y2 + 1, radius, pts);
+
+    iRgbaPathInit(&path);
+    iRgbaPathAddPolygon(&path, pts, count);
+    iRgbaPathFill(dc, &path, color);
+    iRgbaPathFree(&path);
+  }
+  else
+  {
+    radius = iRgbaClampRadius(x1, y1, x2, y2, corner_radius);
+    count = iRgbaRoundedRectPoints(x1, y1, x2, y2, radius, pts);
+    iRgbaStrokePolyline(dc, pts, count, 1, color, style, line_width);
+  }
+}
+
+static void iRgbaDrawEllipseArc(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, double a1, double span, int pie, long color, int style, int line_width)
+{
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  if (style == IUP_DRAW_FILL)
+  {
+    /* covers the pixels from x1 to x2 */
+    iRgbaPath path;
+    iRgbaPathInit(&path);
+    iRgbaPathAddEllipse(&path, (x1 + x2 + 1) / 2.0, (y1 + y2 + 1) / 2.0, (x2 - x1 + 1) / 2.0, (y2 - y1 + 1) / 2.0, a1, span, pie, 0);
+    iRgbaPathFill(dc, &path, color);
+    iRgbaPathFree(&path);
+  }
+  else
+  {
+    /* passes through the pixels at x1 and x2 */
+    int count;
+    double* pts = iRgbaEllipsePoints((x1 + x2) / 2.0, (y1 + y2) / 2.0, (x2 - x1) / 2.0, (y2 - y1) / 2.0, a1, span, &count);
+    if (pts)
+    {
+      iRgbaStrokePolyline(dc, pts, count, span >= 360, color, style, line_width);
+      free(pts);
+    }
+  }
+}
+
+void iupRgbaDrawArc(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, double a1, double a2, long color, int style, int line_width)
+{
+  /* counterclockwise from a1 to a2, in degrees */
+  double span = a2 - a1;
+  while (span < 0)
+    span += 360;
+  if (span > 360)
+    span = 360;
+
+  iRgbaDrawEllipseArc(dc, x1, y1, x2, y2, a1, span, span < 360, color, style, line_width);
+}
+
+void iupRgbaDrawEllipse(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width)
+{
+  iRgbaDrawEllipseArc(dc, x1, y1, x2, y2, 0, 360, 0, color, style, line_width);
+}
+
+void iupRgbaDrawPolygon(iRgbaCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  double* pts;
+  int i;
+
+  if (count < 2)
+    return;
+
+  pts = (double*)malloc(count * 2 * sizeof(double));
+  if (!pts)
+    return;
+
+  for (i = 0; i < 2 * count; i++)
+    pts[i] = points[i];
+
+  if (style == IUP_DRAW_FILL)
+  {
+    iRgbaPath path;
+    iRgbaPathInit(&path);
+    iRgbaPathAddPolygon(&path, pts, count);
+    iRgbaPathFill(dc, &path, color);
+    iRgbaPathFree(&path);
+  }
+  else
+    iRgbaStrokePolyline(dc, pts, count, 1, color, style, line_width);
+
+  free(pts);
+}
+
+void iupRgbaDrawPolyline(iRgbaCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  double* pts;
+  int i;
+
+  if (count < 2)
+    return;
+
+  pts = (double*)malloc(count * 2 * sizeof(double));
+  if (!pts)
+    return;
+
+  for (i = 0; i < 2 * count; i++)
+    pts[i] = points[i];
+
+  iRgbaStrokePolyline(dc, pts, count, 0, color, style, line_width);
+
+  free(pts);
+}
+
+static int iRgbaCurveSteps(double length)
+{
+  int n = (int)(length / 3);
+  if (n < 8) n = 8;
+  if (n > 1024) n = 1024;
+  return n;
+}
+
+void iupRgbaDrawBezier(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, long color, int style, int line_width)
+{
+  double length = hypot(x2 - x1, y2 - y1) + hypot(x3 - x2, y3 - y2) + hypot(x4 - x3, y4 - y3);
+  int n = iRgbaCurveSteps(length), i;
+  double* pts = (double*)malloc((n + 1) * 2 * sizeof(double));
+  if (!pts)
+    return;
+
+  for (i = 0; i <= n; i++)
+  {
+    double t = (double)i / n, s = 1 - t;
+    double b0 = s * s * s, b1 = 3 * s * s * t, b2 = 3 * s * t * t, b3 = t * t * t;
+    pts[2 * i] = b0 * x1 + b1 * x2 + b2 * x3 + b3 * x4;
+    pts[2 * i + 1] = b0 * y1 + b1 * y2 + b2 * y3 + b3 * y4;
+  }
+
+  if (style == IUP_DRAW_FILL)
+    style = IUP_DRAW_STROKE;  /* curves are always stroked */
+
+  iRgbaStrokePolyline(dc, pts, n + 1, 0, color, style, line_width);
+  free(pts);
+}
+
+void iupRgbaDrawQuadraticBezier(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int x3, int y3, long color, int style, int line_width)
+{
+  double length = hypot(x2 - x1, y2 - y1) + hypot(x3 - x2, y3 - y2);
+  int n = iRgbaCurveSteps(length), i;
+  double* pts = (double*)malloc((n + 1) * 2 * sizeof(double));
+  if (!pts)
+    return;
+
+  for (i = 0; i <= n; i++)
+  {
+    double t = (double)i / n, s = 1 - t;
+    double b0 = s * s, b1 = 2 * s * t, b2 = t * t;
+    pts[2 * i] = b0 * x1 + b1 * x2 + b2 * x3;
+    pts[2 * i + 1] = b0 * y1 + b1 * y2 + b2 * y3;
+  }
+
+  if (style == IUP_DRAW_FILL)
+    style = IUP_DRAW_STROKE;
+
+  iRgbaStrokePolyline(dc, pts, n + 1, 0, color, style, line_width);
+  free(pts);
+}
+
+void iupRgbaDrawSelectRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2)
+{
+  iupRgbaDrawRectangle(dc, x1, y1, x2, y2, iupDrawColor(0, 0, 255, 153), IUP_DRAW_FILL, 1);
+}
+
+void iupRgbaDrawFocusRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2)
+{
+  iupRgbaDrawRectangle(dc, x1, y1, x2, y2, iupDrawColor(0, 0, 0, 224), IUP_DRAW_STROKE_DOT, 1);
+}
+
+
+/* ---- Gradients ---- */
+
+static void iRgbaGradientTable(const long* colors, const float* offsets, int count, long* table)
+{
+  int i, s = 0;
+
+  for (i = 0; i < 256; i++)
+  {
+    float t = i / 255.0f;
+
+    while (s < count - 1 && t > offsets[s + 1])
+      s++;
+
+    if (t <= offsets[0] || count == 1)
+      table[i] = colors[0];
+    else if (s >= count - 1)
+      table[i] = colors[count - 1];
+    else
+    {
+      long c0 = colors[s], c1 = colors[s + 1];
+      float range = offsets[s + 1] - offsets[s];
+      float f = range > 0 ? (t - offsets[s]) / range : 1.0f;
+      table[i] = iupDrawColor((unsigned char)(iupDrawRed(c0) + f * (iupDrawRed(c1) - iupDrawRed(c0)) + 0.5f),
+                              (unsigned char)(iupDrawGreen(c0) + f * (iupDrawGreen(c1) - iupDrawGreen(c0)) + 0.5f),
+                              (unsigned char)(iupDrawBlue(c0) + f * (iupDrawBlue(c1) - iupDrawBlue(c0)) + 0.5f),
+                              (unsigned char)(iupDrawAlpha(c0) + f * (iupDrawAlpha(c1) - iupDrawAlpha(c0)) + 0.5f));
+    }
+  }
+}
+
+static int iRgbaGradientIndex(double t)
+{
+  if (t <= 0) return 0;
+  if (t >= 1) return 255;
+  return (int)(t * 255 + 0.5);
+}
+
+void iupRgbaDrawLinearGradient(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, float angle, const long* colors, const float* offsets, int count)
+{
+  long table[256];
+  double rad, w, h, x0, y0, dx, dy, len2;
+  int x, y;
+
+  if (count < 1)
+    return;
+
+  iupDrawCheckSwapCoord(x1, x2);
+  iupDrawCheckSwapCoord(y1, y2);
+
+  iRgbaGradientTable(colors, offsets, count, table);
+
+  /* same end points of the Cairo driver */
+  w = x2 - x1;
+  h = y2 - y1;
+  rad = angle * IRGBA_PI / 180.0;
+  x0 = x1 + w / 2.0 - (w * cos(rad)) / 2.0;
+  y0 = y1 + h / 2.0 - (h * sin(rad)) / 2.0;
+  dx = w * cos(rad);
+  dy = h * sin(rad);
+  len2 = dx * dx + dy * dy;
+  if (len2 == 0)
+    len2 = 1;
+
+  for (y = y1; y <= y2; y++)
+  {
+    if (y < dc->clip_y1 || y > dc->clip_y2)
+      continue;
+
+    for (x = x1; x <= x2; x++)
+    {
+      double t = ((x + 0.5 - x0) * dx + (y + 0.5 - y0) * dy) / len2;
+      long c = table[iRgbaGradientIndex(t)];
+      iRgbaPixel(dc, x, y, c, iupDrawAlpha(c));
+    }
+  }
+}
+
+void iupRgbaDrawRadialGradient(iRgbaCanvas* dc, int cx, int cy, int radius, const long* colors, const float* offsets, int count)
+{
+  long table[256];
+  int x, y;
+
+  if (count < 1 || radius <= 0)
+    return;
+
+  iRgbaGradientTable(colors, offsets, count, table);
+
+  for (y = cy - radius; y <= cy + radius; y++)
+  {
+    double dy = y + 0.5 - cy;
+
+    if (y < dc->clip_y1 || y > dc->clip_y2)
+      continue;
+
+    for (x = cx - radius; x <= cx + radius; x++)
+    {
+      double dx = x + 0.5 - cx;
+      double dist = sqrt(dx * dx + dy * dy);
+      if (dist <= radius)
+      {
+        long c = table[iRgbaGradientIndex(dist / radius)];
+        iRgbaPixel(dc, x, y, c, iupDrawAlpha(c));
+      }
+    }
+  }
+}
+
+
+/* ---- Images ---- */
+
+static void iRgbaSampleLinear(const unsigned char* rgba, int img_w, int img_h, double fx, double fy, unsigned char* out)
+{
+  int x0, y0, x1, y1, c;
+  double ax, ay;
+
+  if (fx < 0) fx = 0;
+  if (fy < 0) fy = 0;
+  if (fx > img_w - 1) fx = img_w - 1;
+  if (fy > img_h - 1) fy = img_h - 1;
+
+  x0 = (int)fx;
+  y0 = (int)fy;
+  x1 = x0 + 1 < img_w ? x0 + 1 : x0;
+  y1 = y0 + 1 < img_h ? y0 + 1 : y0;
+  ax = fx - x0;
+  ay = fy - y0;
+
+  for (c = 0; c < 4; c++)
+  {
+    double top = rgba[(y0 * img_w + x0) * 4 + c] * (1 - ax) + rgba[(y0 * img_w + x1) * 4 + c] * ax;
+    double bottom = rgba[(y1 * img_w + x0) * 4 + c] * (1 - ax) + rgba[(y1 * img_w + x1) * 4 + c] * ax;
+    out[c] = (unsigned char)(top * (1 - ay) + bottom * ay + 0.5);
+  }
+}
+
+void iupRgbaDrawImage(iRgbaCanvas* dc, const char* name, int make_inactive, const char* bgcolor, long tint, int opacity, int x, int y, int w, int h, int sx, int sy, int sw, int sh, int quality)
+{
+  Ihandle* image = iupImageGetImageFromName(name);
+  unsigned char* rgba;
+  int img_w, img_h, dx, dy;
+  int tint_on = (tint != IUP_DRAW_NO_TINT);
+
+  if (!image)
+    return;
+
+  rgba = iupImageGetRGBAData(image, make_inactive, bgcolor, &img_w, &img_h);
+  if (!rgba)
+    return;
+
+  if (sw <= 0 || sh <= 0)
+  {
+    sx = 0;
+    sy = 0;
+    sw = img_w;
+    sh = img_h;
+  }
+
+  if (w <= 0) w = sw;
+  if (h <= 0) h = sh;
+
+  for (dy = 0; dy < h; dy++)
+  {
+    if (y + dy < dc->clip_y1 || y + dy > dc->clip_y2)
+      continue;
+
+    for (dx = 0; dx < w; dx++)
+    {
+      unsigned char p[4];
+      int a;
+
+      if (x + dx < dc->clip_x1 || x + dx > dc->clip_x2)
+        continue;
+
+      if (quality == IUP_DRAW_IMAGE_NEAREST || (w == sw && h == sh))
+      {
+        int ix = sx + (dx * sw) / w, iy = sy + (dy * sh) / h;
+        memcpy(p, rgba + ((size_t)iy * img_w + ix) * 4, 4);
+      }
+      else
+        iRgbaSampleLinear(rgba, img_w, img_h, sx + ((dx + 0.5) * sw) / w - 0.5, sy + ((dy + 0.5) * sh) / h - 0.5, p);
+
+      a = p[3];
+      if (tint_on)
+      {
+        p[0] = iupDrawRed(tint);
+        p[1] = iupDrawGreen(tint);
+        p[2] = iupDrawBlue(tint);
+        a = (a * iupDrawAlpha(tint)) / 255;
+      }
+      a = (a * opacity) / 255;
+
+      iRgbaPixel(dc, x + dx, y + dy, iupDrawColor(p[0], p[1], p[2], 255), a);
+    }
+  }
+
+  free(rgba);
+}
+
+
+/* ---- Text ---- */
+
+/* 5x9 glyphs for ASCII 32 to 126, rows 0 to 6 are above the baseline.
+   Each row has one bit per column, bit 4 is the leftmost.
+   The last glyph is used for all other characters. */
+static const unsigned char iRgbaFont[96][9] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  /* space */
+  {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00},  /* ! */
+  {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  /* " */
+  {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A, 0x00, 0x00},  /* # */
+  {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04, 0x00, 0x00},  /* $ */
+  {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03, 0x00, 0x00},  /* % */
+  {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D, 0x00, 0x00},  /* & */
+  {0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  /* ' */
+  {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02, 0x00, 0x00},  /* ( */
+  {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08, 0x00, 0x00},  /* ) */
+  {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00, 0x00, 0x00},  /* * */
+  {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00, 0x00},  /* + */
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08, 0x00},  /* , */
+  {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00},  /* - */
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00, 0x00},  /* . */
+  {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00, 0x00},  /* / */
+  {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E, 0x00, 0x00},  /* 0 */
+  {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00, 0x00},  /* 1 */
+  {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F, 0x00, 0x00},  /* 2 */
+  {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E, 0x00, 0x00},  /* 3 */
+  {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02, 0x00, 0x00},  /* 4 */
+  {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E, 0x00, 0x00},  /* 5 */
+  {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E, 0x00, 0x00},  /* 6 */
+  {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08, 0x00, 0x00},  /* 7 */
+  {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x00, 0x00},  /* 8 */
+  {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C, 0x00, 0x00},  /* 9 */
+  {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x00},  /* : */
+  {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08, 0x00, 0x00},  /* ; */
+  {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00},  /* < */
+  {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00},  /* = */
+  {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00, 0x00},  /* > */
+  {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04, 0x00, 0x00},  /* ? */
+  {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E, 0x00, 0x00},  /* @ */
+  {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, 0x00},  /* A */
+  {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E, 0x00, 0x00},  /* B */
+  {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E, 0x00, 0x00},  /* C */
+  {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C, 0x00, 0x00},  /* D */
+  {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00, 0x00},  /* E */
+  {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10, 0x00, 0x00},  /* F */
+  {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F, 0x00, 0x00},  /* G */
+  {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, 0x00},  /* H */
+  {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00, 0x00},  /* I */
+  {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C, 0x00, 0x00},  /* J */
+  {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11, 0x00, 0x00},  /* K */
+  {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F, 0x00, 0x00},  /* L */
+  {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11, 0x00, 0x00},  /* M */
+  {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x00, 0x00},  /* N */
+  {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00},  /* O */
+  {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10, 0x00, 0x00},  /* P */
+  {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D, 0x00, 0x00},  /* Q */
+  {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11, 0x00, 0x00},  /* R */
+  {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E, 0x00, 0x00},  /* S */
+  {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00},  /* T */
+  {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00},  /* U */
+  {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, 0x00},  /* V */
+  {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A, 0x00, 0x00},  /* W */
+  {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11, 0x00, 0x00},  /* X */
+  {0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00},  /* Y */
+  {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F, 0x00, 0x00},  /* Z */
+  {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E, 0x00, 0x00},  /* [ */
+  {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00},  /* backslash */
+  {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E, 0x00, 0x00},  /* ] */
+  {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  /* ^ */
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00},  /* _ */
+  {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  /* ` */
+  {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00, 0x00},  /* a */
+  {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E, 0x00, 0x00},  /* b */
+  {0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x00, 0x00},  /* c */
+  {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F, 0x00, 0x00},  /* d */
+  {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, 0x00},  /* e */
+  {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08, 0x00, 0x00},  /* f */
+  {0x00, 0x00, 0x0F, 0x11, 0x11, 0x13, 0x0D, 0x01, 0x0E},  /* g */
+  {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11, 0x00, 0x00},  /* h */
+  {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E, 0x00, 0x00},  /* i */
+  {0x02, 0x00, 0x06, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  /* j */
+  {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12, 0x00, 0x00},  /* k */
+  {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00, 0x00},  /* l */
+  {0x00, 0x00, 0x1A, 0x15, 0x15, 0x15, 0x15, 0x00, 0x00},  /* m */
+  {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11, 0x00, 0x00},  /* n */
+  {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00},  /* o */
+  {0x00, 0x00, 0x1E, 0x11, 0x11, 0x19, 0x16, 0x10, 0x10},  /* p */
+  {0x00, 0x00, 0x0F, 0x11, 0x11, 0x13, 0x0D, 0x01, 0x01},  /* q */
+  {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10, 0x00, 0x00},  /* r */
+  {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E, 0x00, 0x00},  /* s */
+  {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06, 0x00, 0x00},  /* t */
+  {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x00, 0x00},  /* u */
+  {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, 0x00},  /* v */
+  {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A, 0x00, 0x00},  /* w */
+  {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00, 0x00},  /* x */
+  {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x01, 0x0E},  /* y */
+  {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F, 0x00, 0x00},  /* z */
+  {0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02, 0x00, 0x00},  /* { */
+  {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00},  /* | */
+  {0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08, 0x00, 0x00},  /* } */
+  {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00, 0x00},  /* ~ */
+  {0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F, 0x00, 0x00},  /* DEL (unknown) */
+};
+
+#define IRGBA_GLYPH_W 6    /* including spacing */
+#define IRGBA_GLYPH_H 10   /* including spacing */
+#define IRGBA_ASCENT  8
+
+typedef struct _iRgbaFontStyle
+{
+  int scale, bold, underline, strikeout;
+} iRgbaFontStyle;
+
+static void iRgbaGetFontStyle(const char* font, iRgbaFontStyle* style)
+{
+  char typeface[1024];
+  int size = 0, italic = 0, pixels;
+
+  style->bold = 0;
+  style->underline = 0;
+  style->strikeout = 0;
+
+  if (!font || !iupGetFontInfo(font, typeface, &size, &style->bold, &italic, &style->underline, &style->strikeout) || size == 0)
+    size = 10;
+
+  /* negative sizes are in pixels, positive in points at 96 DPI */
+  if (size < 0)
+    pixels = -size;
+  else
+    pixels = (size * 96 + 36) / 72;
+
+  style->scale = (pixels + 5) / IRGBA_GLYPH_H;
+  if (style->scale < 1)
+    style->scale = 1;
+}
+
+static int iRgbaCharAdvance(iRgbaFontStyle* style)
+{
+  return (IRGBA_GLYPH_W + (style->bold ? 1 : 0)) * style->scale;
+}
+
+/* number of characters in UTF-8, continuation bytes are not counted */
+static int iRgbaStrCharCount(const char* str, int len)
+{
+  int i, count = 0;
+  for (i = 0; i < len; i++)
+  {
+    if (((unsigned char)str[i] & 0xC0) != 0x80)
+      count++;
+  }
+  return count;
+}
+
+/* byte length of the first count characters */
+static int iRgbaStrCharLen(const char* str, int len, int count)
+{
+  int i;
+  for (i = 0; i < len; i++)
+  {
+    if (((unsigned char)str[i] & 0xC0) != 0x80)
+    {
+      if (count == 0)
+        return i;
+      count--;
+    }
+  }
+  return len;
+}
+
+typedef struct _iRgbaTextLine
+{
+  const char* str;
+  int len, ellipsis;
+} iRgbaTextLine;
+
+typedef struct _iRgbaTextLayout
+{
+  iRgbaTextLine* lines;
+  int count, max;
+  int width, height;
+} iRgbaTextLayout;
+
+static void iRgbaLayoutAddLine(iRgbaTextLayout* layout, const char* str, int len, int ellipsis)
+{
+  if (layout->count == layout->max)
+  {
+    int new_max = layout->max ? 2 * layout->max : 16;
+    iRgbaTextLine* new_lines = (iRgbaTextLine*)realloc(layout->lines, new_max * sizeof(iRgbaTextLine));
+    if (!new_lines)
+      return;
+    layout->lines = new_lines;
+    layout->max = new_max;
+  }
+
+  layout->lines[layout->count].str = str;
+  layout->lines[layout->count].len = len;
+  layout->lines[layout->count].ellipsis = ellipsis;
+  layout->count++;
+}
+
+static void iRgbaLayoutWrapLine(iRgbaTextLayout* layout, const char* str, int len, int max_chars)
+{
+  while (iRgbaStrCharCount(str, len) > max_chars)
+  {
+    int cut = iRgbaStrCharLen(str, len, max_chars), i;
+
+    /* break at the last space that fits */
+    for (i = cut; i > 0; i--)
+    {
+      if (str[i] == ' ')
+        break;
+    }
+
+    if (i > 0)
+    {
+      iRgbaLayoutAddLine(layout, str, i, 0);
+      str += i + 1;
+      len -= i + 1;
+    }
+    else
+    {
+      iRgbaLayoutAddLine(layout, str, cut, 0);
+      str += cut;
+      len -= cut;
+    }
+  }
+
+  iRgbaLayoutAddLine(layout, str, len, 0);
+}
+
+static void iRgbaLayoutText(iRgbaTextLayout* layout, iRgbaFontStyle* style, const char* text, int len, int w, int flags)
+{
+  int advance = iRgbaCharAdvance(style);
+  int max_chars = w / advance;
+  int i, start = 0;
+
+  memset(layout, 0, sizeof(iRgbaTextLayout));
+
+  for (i = 0; i <= len; i++)
+  {
+    if (i == len || text[i] == '\n')
+    {
+      int line_len = i - start;
+      if (line_len > 0 && text[start + line_len - 1] == '\r')
+        line_len--;
+
+      if ((flags & IUP_DRAW_WRAP) && w > 0)
+        iRgbaLayoutWrapLine(layout, text + start, line_len, max_chars > 1 ? max_chars : 1);
+      else if ((flags & IUP_DRAW_ELLIPSIS) && w > 0 && iRgbaStrCharCount(text + start, line_len) > max_chars)
+      {
+        int keep = max_chars - 3;
+        if (keep < 0) keep = 0;
+        iRgbaLayoutAddLine(layout, text + start, iRgbaStrCharLen(text + start, line_len, keep), 1);
+      }
+      else
+        iRgbaLayoutAddLine(layout, text + start, line_len, 0);
+
+      start = i + 1;
+    }
+  }
+
+  for (i = 0; i < layout->count; i++)
+  {
+    int line_w = (iRgbaStrCharCount(layout->lines[i].str, layout->lines[i].len) + (layout->lines[i].ellipsis ? 3 : 0)) * advance;
+    if (line_w > layout->width)
+      layout->width = line_w;
+  }
+
+  layout->height = layout->count * IRGBA_GLYPH_H * style->scale;
+}
+
+static void iRgbaMaskGlyph(unsigned char* mask, int mask_w, int mask_h, int x, int y, int code, iRgbaFontStyle* style)
+{
+  const unsigned char* glyph = iRgbaFont[(code >= 32 && code < 127) ? code - 32 : 95];
+  int row, col, i, j, bold;
+  int scale = style->scale;
+
+  for (row = 0; row < 9; row++)
+  {
+    for (col = 0; col < 5; col++)
+    {
+      if (!(glyph[row] & (0x10 >> col)))
+        continue;
+
+      for (bold = 0; bold <= style->bold; bold++)
+      {
+        for (j = 0; j < scale; j++)
+        {
+          int py = y + (row + 1) * scale + j;
+          if (py < 0 || py >= mask_h)
+            continue;
+
+          for (i = 0; i < scale; i++)
+          {
+            int px = x + (col + bold) * scale + i;
+            if (px >= 0 && px < mask_w)
+              mask[py * mask_w + px] = 255;
+          }
+        }
+      }
+    }
+  }
+}
+
+static void iRgbaMaskHorizLine(unsigned char* mask, int mask_w, int mask_h, int x, int y, int w, int scale)
+{
+  int i, j;
+  for (j = 0; j < scale; j++)
+  {
+    if (y + j < 0 || y + j >= mask_h)
+      continue;
+    for (i = x; i < x + w; i++)
+    {
+      if (i >= 0 && i < mask_w)
+        mask[(y + j) * mask_w + i] = 255;
+    }
+  }
+}
+
+static void iRgbaMaskLine(unsigned char* mask, int mask_w, int mask_h, int x, int y, const char* str, int len, int ellipsis, iRgbaFontStyle* style)
+{
+  int advance = iRgbaCharAdvance(style);
+  int i, start_x = x;
+
+  for (i = 0; i < len; i++)
+  {
+    unsigned char c = (unsigned char)str[i];
+    if ((c & 0xC0) == 0x80)
+      continue;  /* UTF-8 continuation */
+
+    iRgbaMaskGlyph(mask, mask_w, mask_h, x, y, c < 128 ? c : 127, style);
+    x += advance;
+  }
+
+  if (ellipsis)
+  {
+    for (i = 0; i < 3; i++)
+    {
+      iRgbaMaskGlyph(mask, mask_w, mask_h, x, y, '.', style);
+      x += advance;
+    }
+  }
+
+  if (style->underline)
+    iRgbaMaskHorizLine(mask, mask_w, mask_h, start_x, y + (IRGBA_ASCENT + 1) * style->scale, x - start_x, style->scale);
+  if (style->strikeout)
+    iRgbaMaskHorizLine(mask, mask_w, mask_h, start_x, y + 5 * style->scale, x - start_x, style->scale);
+}
+
+void iupRgbaDrawText(iRgbaCanvas* dc, const char* text, int len, int x, int y, int w, int h, long color, const char* font, int flags, double text_orientation)
+{
+  iRgbaFontStyle style;
+  iRgbaTextLayout layout;
+  unsigned char* mask;
+  int layout_w, layout_h, i, line_h;
+  int clip_x1 = dc->clip_x1, clip_y1 = dc->clip_y1, clip_x2 = dc->clip_x2, clip_y2 = dc->clip_y2;
+  int user_x1 = dc->user_clip_x1, user_y1 = dc->user_clip_y1, user_x2 = dc->user_clip_x2, user_y2 = dc->user_clip_y2;
+
+  if (!text || len <= 0)
+    return;
+
+  iRgbaGetFontStyle(font, &style);
+  iRgbaLayoutText(&layout, &style, text, len, w, flags);
+
+  /* lines are aligned inside the given width only when it is used to break the text */
+  layout_w = ((flags & IUP_DRAW_WRAP) || (flags & IUP_DRAW_ELLIPSIS)) && w > 0 ? w : layout.width;
+  layout_h = layout.height;
+  line_h = IRGBA_GLYPH_H * style.scale;
+
+  if (layout_w <= 0 || layout_h <= 0 || layout.count == 0)
+  {
+    free(layout.lines);
+    return;
+  }
+
+  mask = (unsigned char*)calloc((size_t)layout_w * layout_h, 1);
+  if (!mask)
+  {
+    free(layout.lines);
+    return;
+  }
+
+  for (i = 0; i < layout.count; i++)
+  {
+    iRgbaTextLine* line = layout.lines + i;
+    int line_w = (iRgbaStrCharCount(line->str, line->len) + (line->ellipsis ? 3 : 0)) * iRgbaCharAdvance(&style);
+    int line_x = 0;
+
+    if (flags & IUP_DRAW_RIGHT)
+      line_x = layout_w - line_w;
+    else if (flags & IUP_DRAW_CENTER)
+      line_x = (layout_w - line_w) / 2;
+
+    iRgbaMaskLine(mask, layout_w, layout_h, line_x, i * line_h, line->str, line->len, line->ellipsis, &style);
+  }
+
+  free(layout.lines);
+
+  if (flags & IUP_DRAW_CLIP)
+  {
+    /* intersect with the current clipping */
+    if (x > dc->clip_x1) dc->clip_x1 = x;
+    if (y > dc->clip_y1) dc->clip_y1 = y;
+    if (x + w - 1 < dc->clip_x2) dc->clip_x2 = x + w - 1;
+    if (y + h - 1 < dc->clip_y2) dc->clip_y2 = y + h - 1;
+  }
+
+  if (text_orientation == 0)
+  {
+    int mx, my, alpha = iupDrawAlpha(color);
+    for (my = 0; my < layout_h; my++)
+    {
+      for (mx = 0; mx < layout_w; mx++)
+      {
+        if (mask[my * layout_w + mx])
+          iRgbaPixel(dc, x + mx, y + my, color, alpha);
+      }
+    }
+  }
+  else
+  {
+    /* rotated counterclockwise around the origin or around the layout center */
+    double rad = text_orientation * IRGBA_PI / 180.0;
+    double cos_a = cos(rad), sin_a = sin(rad);
+    double ox = x, oy = y;
+    double corners[4][2];
+    int c, bx1, by1, bx2, by2, dx, dy, alpha = iupDrawAlpha(color);
+
+    if (flags & IUP_DRAW_LAYOUTCENTER)
+    {
+      ox = x + (w - layout_w) / 2 + layout_w / 2;
+      oy = y + (h - layout_h) / 2 + layout_h / 2;
+    }
+
+    corners[0][0] = x - ox;            corners[0][1] = y - oy;
+    corners[1][0] = x + layout_w - ox; corners[1][1] = y - oy;
+    corners[2][0] = x + layout_w - ox; corners[2][1] = y + layout_h - oy;
+    corners[3][0] = x - ox;            corners[3][1] = y + layout_h - oy;
+
+    if (flags & IUP_DRAW_LAYOUTCENTER)
+    {
+      for (c = 0; c < 4; c++)
+      {
+        corners[c][0] += (w - layout_w) / 2;
+        corners[c][1] += (h - layout_h) / 2;
+      }
+    }
+
+    bx1 = by1 = 32767;
+    bx2 = by2 = -32767;
+    for (c = 0; c < 4; c++)
+    {
+      double rx = ox + corners[c][0] * cos_a + corners[c][1] * sin_a;
+      double ry = oy - corners[c][0] * sin_a + corners[c][1] * cos_a;
+      if (floor(rx) < bx1) bx1 = (int)floor(rx);
+      if (floor(ry) < by1) by1 = (int)floor(ry);
+      if (ceil(rx) > bx2) bx2 = (int)ceil(rx);
+      if (ceil(ry) > by2) by2 = (int)ceil(ry);
+    }
+
+    for (dy = by1; dy <= by2; dy++)
+    {
+      for (dx = bx1; dx <= bx2; dx++)
+      {
+        /* inverse rotation of the pixel center */
+        double px = dx + 0.5 - ox, py = dy + 0.5 - oy;
+        double u = px * cos_a - py * sin_a;
+        double v = px * sin_a + py * cos_a;
+        int mx, my;
+
+        if (flags & IUP_DRAW_LAYOUTCENTER)
+        {
+          u -= (w - layout_w) / 2;
+          v -= (h - layout_h) / 2;
+        }
+
+        mx = (int)floor(u + ox - x);
+        my = (int)floor(v + oy - y);
+        if (mx >= 0 && mx < layout_w && my >= 0 && my < layout_h && mask[my * layout_w + mx])
+          iRgbaPixel(dc, dx, dy, color, alpha);
+      }
+    }
+  }
+
+  dc->clip_x1 = clip_x1;
+  dc->clip_y1 = clip_y1;
+  dc->clip_x2 = clip_x2;
+  dc->clip_y2 = clip_y2;
+  dc->user_clip_x1 = user_x1;
+  dc->user_clip_y1 = user_y1;
+  dc->user_clip_x2 = user_x2;
+  dc->user_clip_y2 = user_y2;
+
+  free(mask);
+}
+
+void iupRgbaDrawGetTextSize(const char* font, const char* text, int len, int* w, int* h)
+{
+  iRgbaFontStyle style;
+  iRgbaTextLayout layout;
+
+  iRgbaGetFontStyle(font, &style);
+
+  if (!text || len <= 0)
+  {
+    if (w) *w = 0;
+    if (h) *h = IRGBA_GLYPH_H * style.scale;
+    return;
+  }
+
+  iRgbaLayoutText(&layout, &style, text, len, 0, 0);
+  if (w) *w = layout.width;
+  if (h) *h = layout.height;
+  free(layout.lines);
+}
+
+void iupRgbaDrawGetFontDim(const char* font, int* max_width, int* line_height, int* ascent, int* descent)
+{
+  iRgbaFontStyle style;
+  iRgbaGetFontStyle(font, &style);
+
+  if (max_width) *max_width = iRgbaCharAdvance(&style);
+  if (line_height) *line_height = IRGBA_GLYPH_H * style.scale;
+  if (ascent) *ascent = IRGBA_ASCENT * style.scale;
+  if (descent) *descent = (IRGBA_GLYPH_H - IRGBA_ASCENT) * style.scale;
+}
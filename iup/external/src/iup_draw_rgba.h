@@ -0,0 +1,70 @@
+/** \file
+ * \brief RGBA Draw API.
+ *
+ * Provides a software drawing canvas that mirrors the IUP draw API.
+ * Instead of rendering to a native widget, all drawing operations
+ * are rasterized in memory into an RGBA buffer,
+ * so it does not depend on the native system or on a display.
+ * Text uses a built-in bitmap font.
+ *
+ * See Copyright Notice in "iup.h"
+ *
+ */
+
+#ifndef __IUP_DRAW_RGBA_H
+#define __IUP_DRAW_RGBA_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct _iRgbaCanvas iRgbaCanvas;
+
+iRgbaCanvas* iupRgbaDrawCreateCanvas(int w, int h);
+void         iupRgbaDrawKillCanvas(iRgbaCanvas* dc);
+
+void iupRgbaDrawGetSize(iRgbaCanvas* dc, int* w, int* h);
+
+/* top-down, non-premultiplied, w*h*4 bytes */
+unsigned char* iupRgbaDrawGetData(iRgbaCanvas* dc);
+
+/* clears the clipping area to transparent */
+void iupRgbaDrawClear(iRgbaCanvas* dc);
+
+/* style: IUP_DRAW_FILL, IUP_DRAW_STROKE, IUP_DRAW_STROKE_DASH, etc. */
+/* color is encoded as in iupDrawColor */
+
+void iupRgbaDrawLine(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width);
+void iupRgbaDrawRectangle(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width);
+void iupRgbaDrawRoundedRectangle(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int corner_radius, long color, int style, int line_width);
+void iupRgbaDrawArc(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, double a1, double a2, long color, int style, int line_width);
+void iupRgbaDrawEllipse(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, long color, int style, int line_width);
+void iupRgbaDrawPolygon(iRgbaCanvas* dc, int* points, int count, long color, int style, int line_width);
+void iupRgbaDrawPolyline(iRgbaCanvas* dc, int* points, int count, long color, int style, int line_width);
+void iupRgbaDrawPixel(iRgbaCanvas* dc, int x, int y, long color);
+void iupRgbaDrawBezier(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, long color, int style, int line_width);
+void iupRgbaDrawQuadraticBezier(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int x3, int y3, long color, int style, int line_width);
+void iupRgbaDrawText(iRgbaCanvas* dc, const char* text, int len, int x, int y, int w, int h, long color, const char* font, int flags, double text_orientation);
+void iupRgbaDrawImage(iRgbaCanvas* dc, const char* name, int make_inactive, const char* bgcolor, long tint, int opacity, int x, int y, int w, int h, int sx, int sy, int sw, int sh, int quality);
+
+void iupRgbaDrawLinearGradient(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, float angle, const long* colors, const float* offsets, int count);
+void iupRgbaDrawRadialGradient(iRgbaCanvas* dc, int cx, int cy, int radius, const long* colors, const float* offsets, int count);
+
+void iupRgbaDrawSetClipRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2);
+void iupRgbaDrawSetClipRoundedRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2, int corner_radius);
+void iupRgbaDrawResetClip(iRgbaCanvas* dc);
+void iupRgbaDrawGetClipRect(iRgbaCanvas* dc, int* x1, int* y1, int* x2, int* y2);
+
+void iupRgbaDrawSelectRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2);
+void iupRgbaDrawFocusRect(iRgbaCanvas* dc, int x1, int y1, int x2, int y2);
+
+/* Metrics of the built-in font, only the size and the style of the font are used. */
+void iupRgbaDrawGetTextSize(const char* font, const char* text, int len, int* w, int* h);
+void iupRgbaDrawGetFontDim(const char* font, int* max_width, int* line_height, int* ascent, int* descent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
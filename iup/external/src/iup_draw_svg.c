@@ -399,6 +399,30 @@ void iupSvgDrawPolygon(iSvgCanvas* dc, int* points, int count, const char* color
   iSvgBufAppend(&dc->buf, "/>\n");
 }
 
+/* ---- Polyline ---- */
+
+void iupSvgDrawPolyline(iSvgCanvas* dc, int* points, int count, const char* color, int style, int line_width)
+{
+  int i, r, g, b, a;
+
+  if (count < 2)
+    return;
+
+  iSvgParseColor(color, &r, &g, &b, &a);
+
+  iSvgBufAppend(&dc->buf, "<polyline points=\"");
+  for (i = 0; i < count; i++)
+  {
+    if (i > 0)
+      iSvgBufAppend(&dc->buf, " ");
+    iSvgBufPrintf(&dc->buf, "%d,%d", points[2 * i], points[2 * i + 1]);
+  }
+  iSvgBufAppend(&dc->buf, "\"");
+  iSvgStrokeAttrs(&dc->buf, r, g, b, a, style, line_width);
+  iSvgClipRef(dc, &dc->buf);
+  iSvgBufAppend(&dc->buf, "/>\n");
+}
+
 /* ---- Pixel ---- */
 
 void iupSvgDrawPixel(iSvgCanvas* dc, int x, int y, const char* color)
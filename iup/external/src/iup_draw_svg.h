@@ -35,6 +35,7 @@ void iupSvgDrawRoundedRectangle(iSvgCanvas* dc, int x1, int y1, int x2, int y2,
 void iupSvgDrawArc(iSvgCanvas* dc, int x1, int y1, int x2, int y2, double a1, double a2, const char* color, int style, int line_width);
 void iupSvgDrawEllipse(iSvgCanvas* dc, int x1, int y1, int x2, int y2, const char* color, int style, int line_width);
 void iupSvgDrawPolygon(iSvgCanvas* dc, int* points, int count, const char* color, int style, int line_width);
+void iupSvgDrawPolyline(iSvgCanvas* dc, int* points, int count, const char* color, int style, int line_width);
 void iupSvgDrawPixel(iSvgCanvas* dc, int x, int y, const char* color);
 void iupSvgDrawBezier(iSvgCanvas* dc, int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, const char* color, int style, int line_width);
 void iupSvgDrawQuadraticBezier(iSvgCanvas* dc, int x1, int y1, int x2, int y2, int x3, int y3, const char* color, int style, int line_width);
@@ -71,6 +71,11 @@ IUP_SDK_API void iupdrvDrawEllipse(IdrawCanvas* dc, int x1, int y1, int x2, int
  * \ingroup drvdraw */
 IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width);
 
+/** Draws connected lines as a single stroke, the last point is not connected to the first.
+ * points are arranged xyxyxy...
+ * \ingroup drvdraw */
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width);
+
 /** Draws a single pixel.
  * \ingroup drvdraw */
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color);
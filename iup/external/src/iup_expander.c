@@ -540,6 +540,8 @@ static int iExpanderGetBarSize(Ihandle* ih)
   {
     Ihandle* box = ih->firstchild->firstchild;
 
+    /* also called outside the layout pass */
+    iupLayoutResetCache(box);
     iupBaseComputeNaturalSize(box);
 
     if (ih->data->position == IEXPANDER_LEFT || ih->data->position == IEXPANDER_RIGHT)
@@ -1498,6 +1500,7 @@ static void iExpanderSetChildrenCurrentSizeMethod(Ihandle* ih, int shrink)
   /* force the box size to be the same size of the bar */
   box->naturalwidth = bar->currentwidth;
   box->naturalheight = bar->currentheight;
+  iupLayoutResetCache(box);
   iupBaseSetCurrentSize(box, bar->currentwidth, bar->currentheight, shrink);
 
   if (child)
@@ -63,6 +63,8 @@ static const iGlobalRegEntry registry[] = {
   { "DLGBGCOLOR",             0,    ALL },
   { "DLGFGCOLOR",             0,    ALL },
   { "DLL_HINSTANCE",          R|P,  W },
+  { "DRAWIMAGECACHEHITS",     R,    G },
+  { "DRAWIMAGECACHEMISSES",   R,    G },
   { "DRIVER",                 R,    ALL },
   { "DWM_COMPOSITION",        R,    W|E },
   { "EFLACCEL",               0,    E },
@@ -91,6 +93,7 @@ static const iGlobalRegEntry registry[] = {
   { "ICON",                   0,    ALL },
   { "IMAGEAUTOSCALE",         0,    ALL },
   { "IMAGEEXPORT_STATIC",     0,    ALL },
+  { "IMAGERESIZEFILTER",      0,    ALL },
   { "IMAGESDPI",              0,    ALL },
   { "IMAGESTOCKAUTOSCALE",    0,    ALL },
   { "IMAGESTOCKSIZE",         0,    ALL },
@@ -130,6 +133,10 @@ static const iGlobalRegEntry registry[] = {
   { "SYSTEMLANGUAGE",         R,    ALL },
   { "SYSTEMLOCALE",           R,    ALL },
   { "SYSTEMVERSION",          R,    ALL },
+  { "TEXTLAYOUTCACHECOUNT",   R,    G },
+  { "TEXTLAYOUTCACHEHITS",    R,    G },
+  { "TEXTLAYOUTCACHEMISSES",  R,    G },
+  { "TEXTLAYOUTCACHESIZE",    0,    G },
   { "TMPDIR",                 R,    ALL },
   { "TREEIMAGE24",            0,    ALL },
   { "TRUECOLORCANVAS",        R,    ALL },
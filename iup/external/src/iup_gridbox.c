@@ -15,6 +15,7 @@
 #include "iup_drvfont.h"
 #include "iup_stdcontrols.h"
 #include "iup_normalizer.h"
+#include "iup_layout.h"
 #include "iup_varg.h"
 
 
@@ -385,7 +386,10 @@ static char* iGridBoxGetNumDivAttrib(Ihandle* ih)
 static char* iGridBoxGetNumColAttrib(Ihandle* ih)
 {
   if (!ih->handle)
+  {
+    iupLayoutMarkDirtyTree(ih);
     iupBaseComputeNaturalSize(ih);
+  }
 
   return iupStrReturnInt(ih->data->num_col);
 }
@@ -393,7 +397,10 @@ static char* iGridBoxGetNumColAttrib(Ihandle* ih)
 static char* iGridBoxGetNumLinAttrib(Ihandle* ih)
 {
   if (!ih->handle)
+  {
+    iupLayoutMarkDirtyTree(ih);
     iupBaseComputeNaturalSize(ih);
+  }
 
   return iupStrReturnInt(ih->data->num_lin);
 }
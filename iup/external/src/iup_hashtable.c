@@ -99,6 +99,8 @@ struct _Itable
 static void iTableFreeItemArray(Itable_IndexTypes indexType, unsigned int nextFreeIndex, ItableItem *items);
 static unsigned int iTableGetEntryIndex(Itable *it, const char *key, unsigned long *keyIndex);
 static unsigned int iTableFindItem(Itable *it, const char *key, ItableEntry **entry, unsigned int *itemIndex, unsigned long *keyIndex);
+static unsigned int iTableFindItemHashed(Itable *it, const char *key, unsigned long keyIndex, ItableEntry **entry, unsigned int *itemIndex);
+static void iTableSetItem(Itable *it, const char *key, unsigned long keyIndex, void *value, Itable_Types itemType);
 static unsigned int iTableResize(Itable *it);
 static void iTableAdd(Itable *it, ItableKey *key, void *value, Itable_Types itemType);
 static void iTableUpdateArraySize(ItableEntry *entry);
@@ -198,6 +200,38 @@ IUP_SDK_API int iupTableCount(Itable *it)
   return it->numberOfEntries;
 }
 
+IUP_SDK_API int iupTableGetMemory(Itable *it)
+{
+  unsigned int i, j;
+  int size;
+
+  iupASSERT(it!=NULL);
+  if (!it)
+    return 0;
+
+  size = (int)(sizeof(Itable) + it->entriesSize * sizeof(ItableEntry));
+
+  for (i = 0; i < it->entriesSize; i++)
+  {
+    ItableEntry *entry = &(it->entries[i]);
+
+    size += (int)(entry->itemsSize * sizeof(ItableItem));
+
+    for (j = 0; j < entry->nextItemIndex; j++)
+    {
+      ItableItem *item = &(entry->items[j]);
+
+      if (it->indexType == IUPTABLE_STRINGINDEXED)
+        size += (int)strlen(item->key.keyStr) + 1;
+
+      if (item->itemType == IUPTABLE_STRING)
+        size += (int)strlen((char*)item->value) + 1;
+    }
+  }
+
+  return size;
+}
+
 IUP_SDK_API void iupTableSetFunc(Itable *it, const char *key, Ifunc func)
 {
   iupTableSet(it, key, (void*)func, IUPTABLE_FUNCPOINTER); /* type cast from function pointer to void* */
@@ -205,19 +239,36 @@ IUP_SDK_API void iupTableSetFunc(Itable *it, const char *key, Ifunc func)
 
 IUP_SDK_API void iupTableSet(Itable *it, const char *key, void *value, Itable_Types itemType)
 {
-  unsigned int  itemIndex,
-                itemFound;
   unsigned long keyIndex;
-  ItableEntry  *entry;
-  ItableItem   *item;
-  void         *v;
 
   iupASSERT(it!=NULL);
   iupASSERT(key!=NULL);
   if (!it || !key || !value)
     return;
 
-  itemFound = iTableFindItem(it, key, &entry, &itemIndex, &keyIndex);
+  iTableGetEntryIndex(it, key, &keyIndex);
+  iTableSetItem(it, key, keyIndex, value, itemType);
+}
+
+IUP_SDK_API void iupTableSetHashed(Itable *it, const char *key, unsigned long keyIndex, void *value, Itable_Types itemType)
+{
+  iupASSERT(it!=NULL);
+  iupASSERT(key!=NULL);
+  if (!it || !key || !value)
+    return;
+
+  iTableSetItem(it, key, keyIndex, value, itemType);
+}
+
+static void iTableSetItem(Itable *it, const char *key, unsigned long keyIndex, void *value, Itable_Types itemType)
+{
+  unsigned int  itemIndex,
+                itemFound;
+  ItableEntry  *entry;
+  ItableItem   *item;
+  void         *v;
+
+  itemFound = iTableFindItemHashed(it, key, keyIndex, &entry, &itemIndex);
 
 #ifdef DEBUGTABLE
   if (it->indexType == IUPTABLE_STRINGINDEXED)
@@ -233,7 +284,7 @@ IUP_SDK_API void iupTableSet(Itable *it, const char *key, void *value, Itable_Ty
     {
       /* We have to search for the entry again, since it may
        * have been moved by iTableResize. */
-      iTableFindItem(it, key, &entry, &itemIndex, &keyIndex);
+      iTableFindItemHashed(it, key, keyIndex, &entry, &itemIndex);
     }
 
     iTableUpdateArraySize(entry);
@@ -326,6 +377,19 @@ IUP_SDK_API void iupTableRemove(Itable *it, const char *key)
     iTableRemoveItem(it, entry, itemIndex);
 }
 
+IUP_SDK_API void iupTableRemoveHashed(Itable *it, const char *key, unsigned long keyIndex)
+{
+  unsigned int itemIndex;
+  ItableEntry  *entry;
+
+  iupASSERT(it!=NULL);
+  if (!it)
+    return;
+
+  if (iTableFindItemHashed(it, key, keyIndex, &entry, &itemIndex))
+    iTableRemoveItem(it, entry, itemIndex);
+}
+
 IUP_SDK_API void* iupTableGet(Itable *it, const char *key)
 {
   unsigned int  itemFound,
@@ -349,6 +413,45 @@ IUP_SDK_API void* iupTableGet(Itable *it, const char *key)
   return value;
 }
 
+IUP_SDK_API void* iupTableGetHashed(Itable *it, const char *key, unsigned long keyIndex)
+{
+  unsigned int  itemIndex;
+  ItableEntry  *entry;
+
+  iupASSERT(it!=NULL);
+  if (!it)
+    return 0;
+
+  if (iTableFindItemHashed(it, key, keyIndex, &entry, &itemIndex))
+    return entry->items[itemIndex].value;
+
+  return 0;
+}
+
+IUP_SDK_API unsigned long iupTableHashKey(const char *key)
+{
+  unsigned int checksum = 0;
+
+  iupASSERT(key!=NULL);
+  if (!key)
+    return 0;
+
+/*     Original version
+  unsigned int i;
+  for (i = 0; key[i]; i++)
+    checksum = checksum*31 + key[i];
+*/
+
+  while (*key)
+  {
+    checksum *= 31;
+    checksum += *key;
+    key++;
+  }
+
+  return checksum;
+}
+
 IUP_SDK_API Ifunc iupTableGetFunc(Itable *it, const char *key, void **value)
 {
   Itable_Types itemType = IUPTABLE_POINTER;
@@ -582,24 +685,7 @@ static void iTableFreeItemArray(Itable_IndexTypes indexType, unsigned int nextFr
 static unsigned int iTableGetEntryIndex(Itable *it, const char *key, unsigned long *keyIndex)
 {
   if (it->indexType == IUPTABLE_STRINGINDEXED)
-  {
-    unsigned int checksum = 0;
-
-/*     Original version
-    unsigned int i;
-    for (i = 0; key[i]; i++)
-      checksum = checksum*31 + key[i];
-*/
-
-    while (*key)
-    {
-      checksum *= 31;
-      checksum += *key;
-      key++;
-    }
-
-    *keyIndex = checksum;            /* this could NOT be dependent from table size */
-  }
+    *keyIndex = iupTableHashKey(key);   /* this could NOT be dependent from table size */
   else
   {
     /* Pointer indexed */
@@ -626,20 +712,23 @@ static void iTableCheckDuplicated(ItableItem *item, unsigned int nextItemIndex,
 
 static unsigned int iTableFindItem(Itable *it, const char *key, ItableEntry **entry, unsigned int *itemIndex, unsigned long *keyIndex)
 {
-  unsigned int entryIndex,
-               itemFound,
+  iTableGetEntryIndex(it, key, keyIndex);
+  return iTableFindItemHashed(it, key, *keyIndex, entry, itemIndex);
+}
+
+static unsigned int iTableFindItemHashed(Itable *it, const char *key, unsigned long keyIndex, ItableEntry **entry, unsigned int *itemIndex)
+{
+  unsigned int itemFound,
                i;
   ItableItem  *item;
 
-  entryIndex = iTableGetEntryIndex(it, key, keyIndex);
-
-  *entry = &(it->entries[entryIndex]);
+  *entry = &(it->entries[keyIndex % it->entriesSize]);
 
   item = &((*entry)->items[0]);
   for (i = 0; i < (*entry)->nextItemIndex; i++, item++)
   {
     if (it->indexType == IUPTABLE_STRINGINDEXED)
-      itemFound = item->key.keyIndex == *keyIndex;
+      itemFound = item->key.keyIndex == keyIndex;
 /*    itemFound = iupStrEqual(item->key.keyStr, key);  This is the original safe version */
     else
       itemFound = item->key.keyStr == key;
@@ -651,7 +740,7 @@ static unsigned int iTableFindItem(Itable *it, const char *key, ItableEntry **en
     }
   }
 
-  /* if not found "entry", "itemIndex" and "keyIndex" will have the new insert position. */
+  /* if not found "entry" and "itemIndex" will have the new insert position. */
 
   *itemIndex = i;
   return 0;
@@ -682,14 +771,11 @@ static void iTableUpdateArraySize(ItableEntry *entry)
 
 static void iTableAdd(Itable *it, ItableKey *key, void *value, Itable_Types itemType)
 {
-  unsigned int entryIndex;
-  unsigned long keyIndex;
+  unsigned long keyIndex = key->keyIndex;  /* does not depend on the table size, no need to hash the key again */
   ItableEntry *entry;
   ItableItem* item;
 
-  entryIndex = iTableGetEntryIndex(it, key->keyStr, &keyIndex);
-
-  entry = &(it->entries[entryIndex]);
+  entry = &(it->entries[keyIndex % it->entriesSize]);
   iTableUpdateArraySize(entry);
 
   /* add a new item at the end of the item array without duplicating memory. */
@@ -74,6 +74,10 @@ IUP_SDK_API void iupTableClear(Itable *it);
  * \ingroup table */
 IUP_SDK_API int iupTableCount(Itable *it);
 
+/** Returns the approximate number of bytes used by the table, including keys and stored strings.
+ * \ingroup table */
+IUP_SDK_API int iupTableGetMemory(Itable *it);
+
 /** Store an element in the table.
  * \ingroup table */
 IUP_SDK_API void iupTableSet(Itable *it, const char *key, void *value, Itable_Types itemType);
@@ -104,6 +108,25 @@ IUP_SDK_API void *iupTableGetTyped(Itable *it, const char *key, Itable_Types *it
  * \ingroup table */
 IUP_SDK_API void iupTableRemove(Itable *it, const char *key);
 
+/** Returns the key index used internally by string indexed tables. \n
+ * It does not depend on the table, so it can be computed once for a key
+ * and used with \ref iupTableGetHashed, \ref iupTableSetHashed and \ref iupTableRemoveHashed
+ * in any string indexed table.
+ * \ingroup table */
+IUP_SDK_API unsigned long iupTableHashKey(const char *key);
+
+/** Same as \ref iupTableSet but uses a pre-computed key index.
+ * \ingroup table */
+IUP_SDK_API void iupTableSetHashed(Itable *it, const char *key, unsigned long keyIndex, void *value, Itable_Types itemType);
+
+/** Same as \ref iupTableGet but uses a pre-computed key index.
+ * \ingroup table */
+IUP_SDK_API void *iupTableGetHashed(Itable *it, const char *key, unsigned long keyIndex);
+
+/** Same as \ref iupTableRemove but uses a pre-computed key index.
+ * \ingroup table */
+IUP_SDK_API void iupTableRemoveHashed(Itable *it, const char *key, unsigned long keyIndex);
+
 /** Key iteration function. Returns a key.
  * To iterate over all keys call iupTableFirst at the first
  * and call iupTableNext in a loop
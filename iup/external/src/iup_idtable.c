@@ -0,0 +1,425 @@
+/** \file
+ * \brief iupIdTable functions.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <memory.h>
+
+#include "iup_export.h"
+#include "iup_hashtable.h"
+#include "iup_idtable.h"
+#include "iup_str.h"
+#include "iup_assert.h"
+
+
+#define IIDTABLE_MINSIZE 16    /* must be a power of 2 */
+
+/* An item of the table. key==0 marks an empty slot.
+   Uses linear probing and backward shift deletion, so there are no tombstones. */
+typedef struct _IidtableItem
+{
+  int key;
+  int id1, id2;
+  int itemType;
+  void* value;
+  char* name;   /* optional, used only when iterating over attribute names */
+} IidtableItem;
+
+struct _Iidtable
+{
+  unsigned int size;    /* always a power of 2 */
+  unsigned int count;
+  int cur;              /* iteration index, -1 when not iterating */
+  IidtableItem* items;
+};
+
+
+static unsigned int iIdTableHash(int key, int id1, int id2)
+{
+  unsigned int h = (unsigned int)key * 0x9E3779B1u;
+  h ^= (unsigned int)id1 * 0x85EBCA77u;
+  h ^= (unsigned int)id2 * 0xC2B2AE3Du;
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  return h;
+}
+
+static void iIdTableFreeItem(IidtableItem* item)
+{
+  if (item->itemType == IUPTABLE_STRING)
+    free(item->value);
+  if (item->name)
+    free(item->name);
+}
+
+static int iIdTableFind(Iidtable* it, int key, int id1, int id2)
+{
+  unsigned int mask = it->size - 1;
+  unsigned int i = iIdTableHash(key, id1, id2) & mask;
+
+  for (;;)
+  {
+    IidtableItem* item = it->items + i;
+    if (item->key == 0)
+      return -1;
+    if (item->key == key && item->id1 == id1 && item->id2 == id2)
+      return (int)i;
+    i = (i + 1) & mask;
+  }
+}
+
+static int iIdTableResize(Iidtable* it, unsigned int new_size)
+{
+  IidtableItem* old_items = it->items;
+  unsigned int old_size = it->size, i;
+  unsigned int mask = new_size - 1;
+
+  IidtableItem* new_items = (IidtableItem*)calloc(new_size, sizeof(IidtableItem));
+  iupASSERT(new_items != NULL);
+  if (!new_items)
+    return 0;
+
+  for (i = 0; i < old_size; i++)
+  {
+    IidtableItem* item = old_items + i;
+    if (item->key != 0)
+    {
+      unsigned int j = iIdTableHash(item->key, item->id1, item->id2) & mask;
+      while (new_items[j].key != 0)
+        j = (j + 1) & mask;
+      new_items[j] = *item;
+    }
+  }
+
+  free(old_items);
+  it->items = new_items;
+  it->size = new_size;
+  return 1;
+}
+
+static void iIdTableRemoveIndex(Iidtable* it, unsigned int i)
+{
+  unsigned int mask = it->size - 1;
+  unsigned int j = i;
+
+  iIdTableFreeItem(it->items + i);
+  it->count--;
+
+  /* backward shift the items of the same probe sequence */
+  for (;;)
+  {
+    unsigned int home;
+
+    j = (j + 1) & mask;
+    if (it->items[j].key == 0)
+      break;
+
+    home = iIdTableHash(it->items[j].key, it->items[j].id1, it->items[j].id2) & mask;
+
+    /* move it only if its home slot is not between i (exclusive) and j (inclusive) */
+    if ((j > i && (home <= i || home > j)) ||
+        (j < i && (home <= i && home > j)))
+    {
+      it->items[i] = it->items[j];
+      i = j;
+    }
+  }
+
+  memset(it->items + i, 0, sizeof(IidtableItem));
+}
+
+IUP_SDK_API Iidtable* iupIdTableCreate(void)
+{
+  Iidtable* it = (Iidtable*)malloc(sizeof(Iidtable));
+  iupASSERT(it != NULL);
+  if (!it)
+    return NULL;
+
+  it->size = IIDTABLE_MINSIZE;
+  it->count = 0;
+  it->cur = -1;
+  it->items = (IidtableItem*)calloc(it->size, sizeof(IidtableItem));
+  iupASSERT(it->items != NULL);
+  if (!it->items)
+  {
+    free(it);
+    return NULL;
+  }
+
+  return it;
+}
+
+IUP_SDK_API void iupIdTableClear(Iidtable* it)
+{
+  unsigned int i;
+
+  iupASSERT(it != NULL);
+  if (!it)
+    return;
+
+  for (i = 0; i < it->size; i++)
+  {
+    if (it->items[i].key != 0)
+      iIdTableFreeItem(it->items + i);
+  }
+
+  if (it->size > IIDTABLE_MINSIZE)
+  {
+    IidtableItem* new_items = (IidtableItem*)realloc(it->items, IIDTABLE_MINSIZE * sizeof(IidtableItem));
+    if (new_items)
+    {
+      it->items = new_items;
+      it->size = IIDTABLE_MINSIZE;
+    }
+  }
+
+  memset(it->items, 0, it->size * sizeof(IidtableItem));
+  it->count = 0;
+  it->cur = -1;
+}
+
+IUP_SDK_API void iupIdTableDestroy(Iidtable* it)
+{
+  iupASSERT(it != NULL);
+  if (!it)
+    return;
+
+  iupIdTableClear(it);
+
+  free(it->items);
+  free(it);
+}
+
+IUP_SDK_API int iupIdTableCount(Iidtable* it)
+{
+  iupASSERT(it != NULL);
+  if (!it)
+    return 0;
+
+  return (int)it->count;
+}
+
+IUP_SDK_API int iupIdTableGetMemory(Iidtable* it)
+{
+  unsigned int i;
+  int size;
+
+  iupASSERT(it != NULL);
+  if (!it)
+    return 0;
+
+  size = (int)(sizeof(Iidtable) + it->size * sizeof(IidtableItem));
+
+  for (i = 0; i < it->size; i++)
+  {
+    IidtableItem* item = it->items + i;
+    if (item->key == 0)
+      continue;
+
+    if (item->itemType == IUPTABLE_STRING)
+      size += (int)strlen((char*)item->value) + 1;
+    if (item->name)
+      size += (int)strlen(item->name) + 1;
+  }
+
+  return size;
+}
+
+IUP_SDK_API void iupIdTableSet(Iidtable* it, int key, int id1, int id2, void* value, Itable_Types itemType)
+{
+  IidtableItem* item;
+  unsigned int mask, i;
+  int index;
+
+  iupASSERT(it != NULL);
+  iupASSERT(key != 0);
+  if (!it || key == 0)
+    return;
+
+  if (!value)
+  {
+    iupIdTableRemove(it, key, id1, id2);
+    return;
+  }
+
+  if (itemType == IUPTABLE_STRING)
+    value = iupStrDup((const char*)value);
+
+  index = iIdTableFind(it, key, id1, id2);
+  if (index >= 0)
+  {
+    item = it->items + index;
+
+    if (item->itemType == IUPTABLE_STRING)
+      free(item->value);
+
+    item->itemType = itemType;
+    item->value = value;
+    return;
+  }
+
+  /* keep the load factor under 3/4 */
+  if ((it->count + 1) * 4 > it->size * 3)
+  {
+    if (!iIdTableResize(it, it->size * 2))
+    {
+      if (itemType == IUPTABLE_STRING)
+        free(value);
+      return;
+    }
+  }
+
+  mask = it->size - 1;
+  i = iIdTableHash(key, id1, id2) & mask;
+  while (it->items[i].key != 0)
+    i = (i + 1) & mask;
+
+  item = it->items + i;
+  item->key = key;
+  item->id1 = id1;
+  item->id2 = id2;
+  item->itemType = itemType;
+  item->value = value;
+  item->name = NULL;
+  it->count++;
+}
+
+IUP_SDK_API void* iupIdTableGet(Iidtable* it, int key, int id1, int id2)
+{
+  int index;
+
+  if (!it || it->count == 0)
+    return NULL;
+
+  index = iIdTableFind(it, key, id1, id2);
+  if (index < 0)
+    return NULL;
+
+  return it->items[index].value;
+}
+
+IUP_SDK_API void iupIdTableRemove(Iidtable* it, int key, int id1, int id2)
+{
+  int index;
+
+  if (!it || it->count == 0)
+    return;
+
+  index = iIdTableFind(it, key, id1, id2);
+  if (index >= 0)
+    iIdTableRemoveIndex(it, (unsigned int)index);
+}
+
+static int iIdTableIterate(Iidtable* it, unsigned int i, int *key, int *id1, int *id2)
+{
+  for (; i < it->size; i++)
+  {
+    IidtableItem* item = it->items + i;
+    if (item->key != 0)
+    {
+      it->cur = (int)i;
+      if (key) *key = item->key;
+      if (id1) *id1 = item->id1;
+      if (id2) *id2 = item->id2;
+      return 1;
+    }
+  }
+
+  it->cur = -1;
+  return 0;
+}
+
+IUP_SDK_API int iupIdTableFirst(Iidtable* it, int *key, int *id1, int *id2)
+{
+  iupASSERT(it != NULL);
+  if (!it)
+    return 0;
+
+  return iIdTableIterate(it, 0, key, id1, id2);
+}
+
+IUP_SDK_API int iupIdTableNext(Iidtable* it, int *key, int *id1, int *id2)
+{
+  iupASSERT(it != NULL);
+  if (!it || it->cur < 0)
+    return 0;
+
+  return iIdTableIterate(it, (unsigned int)it->cur + 1, key, id1, id2);
+}
+
+IUP_SDK_API int iupIdTableIsIterating(Iidtable* it)
+{
+  return it && it->cur >= 0;
+}
+
+IUP_SDK_API void iupIdTableEndIteration(Iidtable* it)
+{
+  if (it)
+    it->cur = -1;
+}
+
+IUP_SDK_API void* iupIdTableGetCurr(Iidtable* it)
+{
+  iupASSERT(it != NULL);
+  if (!it || it->cur < 0)
+    return NULL;
+
+  return it->items[it->cur].value;
+}
+
+IUP_SDK_API int iupIdTableGetCurrType(Iidtable* it)
+{
+  iupASSERT(it != NULL);
+  if (!it || it->cur < 0)
+    return -1;
+
+  return it->items[it->cur].itemType;
+}
+
+IUP_SDK_API void iupIdTableSetCurr(Iidtable* it, void* value, Itable_Types itemType)
+{
+  IidtableItem* item;
+
+  iupASSERT(it != NULL);
+  if (!it || it->cur < 0 || !value)
+    return;
+
+  item = it->items + it->cur;
+
+  if (itemType == IUPTABLE_STRING)
+    value = iupStrDup((const char*)value);
+
+  if (item->itemType == IUPTABLE_STRING)
+    free(item->value);
+
+  item->itemType = itemType;
+  item->value = value;
+}
+
+IUP_SDK_API const char* iupIdTableGetCurrName(Iidtable* it)
+{
+  iupASSERT(it != NULL);
+  if (!it || it->cur < 0)
+    return NULL;
+
+  return it->items[it->cur].name;
+}
+
+IUP_SDK_API const char* iupIdTableSetCurrName(Iidtable* it, const char* name)
+{
+  IidtableItem* item;
+
+  iupASSERT(it != NULL);
+  if (!it || it->cur < 0)
+    return NULL;
+
+  item = it->items + it->cur;
+  if (item->name)
+    free(item->name);
+  item->name = iupStrDup(name);
+  return item->name;
+}
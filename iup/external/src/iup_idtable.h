@@ -0,0 +1,107 @@
+/** \file
+ * \brief Sparse table indexed by integer keys and ids.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#ifndef __IUP_IDTABLE_H
+#define __IUP_IDTABLE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** \defgroup idtable Id Table
+ * \par
+ * Open addressing hash table indexed by a triple of integers (key, id1, id2).
+ * Used to store numbered attributes, like "BGCOLOR3:5", without building a string key for each one.
+ * The key must be non zero, usually an attribute name atom, see \ref iup_atom.h.
+ * \par
+ * Values can be strings duplicated internally or regular pointers, same as \ref table.
+ * \par
+ * See \ref iup_idtable.h
+ * \ingroup util */
+
+struct _Iidtable;
+typedef struct _Iidtable Iidtable;
+
+
+/** Creates an empty id table.
+ * \ingroup idtable */
+IUP_SDK_API Iidtable* iupIdTableCreate(void);
+
+/** Destroys the table and all the strings stored internally.
+ * \ingroup idtable */
+IUP_SDK_API void iupIdTableDestroy(Iidtable* it);
+
+/** Removes all items from the table.
+ * \ingroup idtable */
+IUP_SDK_API void iupIdTableClear(Iidtable* it);
+
+/** Returns the number of items in the table.
+ * \ingroup idtable */
+IUP_SDK_API int iupIdTableCount(Iidtable* it);
+
+/** Returns the approximate number of bytes used by the table, including stored strings.
+ * \ingroup idtable */
+IUP_SDK_API int iupIdTableGetMemory(Iidtable* it);
+
+/** Stores a value. If itemType is IUPTABLE_STRING the value is duplicated.
+ * A NULL value removes the item.
+ * \ingroup idtable */
+IUP_SDK_API void iupIdTableSet(Iidtable* it, int key, int id1, int id2, void* value, Itable_Types itemType);
+
+/** Retrieves a value. Returns NULL if not found.
+ * \ingroup idtable */
+IUP_SDK_API void* iupIdTableGet(Iidtable* it, int key, int id1, int id2);
+
+/** Removes a value.
+ * \ingroup idtable */
+IUP_SDK_API void iupIdTableRemove(Iidtable* it, int key, int id1, int id2);
+
+/** Starts the iteration. Returns 0 if the table is empty.
+ * Items must not be added or removed during the iteration.
+ * \ingroup idtable */
+IUP_SDK_API int iupIdTableFirst(Iidtable* it, int *key, int *id1, int *id2);
+
+/** Continues the iteration. Returns 0 at the end.
+ * \ingroup idtable */
+IUP_SDK_API int iupIdTableNext(Iidtable* it, int *key, int *id1, int *id2);
+
+/** Returns 1 if an iteration is active.
+ * \ingroup idtable */
+IUP_SDK_API int iupIdTableIsIterating(Iidtable* it);
+
+/** Ends the iteration, so \ref iupIdTableIsIterating returns 0.
+ * \ingroup idtable */
+IUP_SDK_API void iupIdTableEndIteration(Iidtable* it);
+
+/** Returns the value of the current item in the iteration.
+ * \ingroup idtable */
+IUP_SDK_API void* iupIdTableGetCurr(Iidtable* it);
+
+/** Returns the type of the current item in the iteration.
+ * \ingroup idtable */
+IUP_SDK_API int iupIdTableGetCurrType(Iidtable* it);
+
+/** Changes the value of the current item in the iteration.
+ * \ingroup idtable */
+IUP_SDK_API void iupIdTableSetCurr(Iidtable* it, void* value, Itable_Types itemType);
+
+/** Returns the name associated with the current item, or NULL.
+ * Names are optional and are only stored when the iteration needs them.
+ * \ingroup idtable */
+IUP_SDK_API const char* iupIdTableGetCurrName(Iidtable* it);
+
+/** Associates a name with the current item. The name is duplicated
+ * and freed when the item is removed.
+ * \ingroup idtable */
+IUP_SDK_API const char* iupIdTableSetCurrName(Iidtable* it, const char* name);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
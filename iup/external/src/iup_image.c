@@ -23,70 +23,11 @@
 #include "iup_draw.h"
 
 
-void iupImageResizeRGBA(int src_width, int src_height, unsigned char *src_map, int dst_width, int dst_height, unsigned char *dst_map, int depth)
-{
-  /* Do bilinear interpolation */
-
-  unsigned char *line_mapl, *line_maph;
-  double t, u, src_x, src_y, factor;
-  int xl, yl, xh, yh, x, y;
-  unsigned char *fhh, *fll, *fhl, *flh;
-
-  int *XL = (int*)malloc(dst_width * sizeof(int));
-  double *T = (double*)malloc(dst_width * sizeof(double));
-  if (!XL || !T) { free(XL); free(T); return; }
-
-  factor = (double)src_width / (double)dst_width;
-  for (x = 0; x < dst_width; x++)
-  {
-    src_x = x * factor;
-    xl = (int)(src_x);
-    T[x] = src_x - xl;
-    XL[x] = xl;
-  }
-
-  factor = (double)src_height / (double)dst_height;
-
-  for (y = 0; y < dst_height; y++)
-  {
-    src_y = y * factor;
-    yl = (int)(src_y);
-    yh = (yl == src_height - 1) ? yl : yl + 1;
-    u = src_y - yl;
-
-    line_mapl = src_map + yl * src_width * depth;
-    line_maph = src_map + yh * src_width * depth;
-
-    for (x = 0; x < dst_width; x++)
-    {
-      xl = XL[x];
-      xh = (xl == src_width - 1) ? xl : xl + 1;
-      t = T[x];
-
-      fll = line_mapl + xl * depth;
-      fhl = line_mapl + xh * depth;
-      flh = line_maph + xl * depth;
-      fhh = line_maph + xh * depth;
-
-      dst_map[0] = (unsigned char)(u * t * (fhh[0] - flh[0] - fhl[0] + fll[0]) + t * (fhl[0] - fll[0]) + u * (flh[0] - fll[0]) + fll[0]);
-      dst_map[1] = (unsigned char)(u * t * (fhh[1] - flh[1] - fhl[1] + fll[1]) + t * (fhl[1] - fll[1]) + u * (flh[1] - fll[1]) + fll[1]);
-      dst_map[2] = (unsigned char)(u * t * (fhh[2] - flh[2] - fhl[2] + fll[2]) + t * (fhl[2] - fll[2]) + u * (flh[2] - fll[2]) + fll[2]);
-      if (depth == 4)
-        dst_map[3] = (unsigned char)(u * t * (fhh[3] - flh[3] - fhl[3] + fll[3]) + t * (fhl[3] - fll[3]) + u * (flh[3] - fll[3]) + fll[3]);
-
-      dst_map += depth;
-    }
-  }
-
-  free(XL);
-  free(T);
-}
-
 static void iDataStretchMap(int src_width, int src_height, unsigned char *src_map, int dst_width, int dst_height, unsigned char *dst_map)
 {
   int x, y, offset;
   double factor;
-  unsigned char *line_map;
+  unsigned char *line_map, *last_line_map = NULL, *last_dst_map = NULL;
   int* XTab = (int*)malloc(dst_width*sizeof(int));
   if (!XTab) return;
 
@@ -101,11 +42,17 @@ static void iDataStretchMap(int src_width, int src_height, unsigned char *src_ma
 
   for (y = 0; y < dst_height; y++)
   {
-    for (x = 0; x < dst_width; x++)
+    if (line_map == last_line_map)
+      memcpy(dst_map, last_dst_map, dst_width);  /* same source line, when enlarging */
+    else
     {
-      offset = XTab[x];
-      *(dst_map++) = line_map[offset];
+      for (x = 0; x < dst_width; x++)
+        dst_map[x] = line_map[XTab[x]];
+
+      last_line_map = line_map;
+      last_dst_map = dst_map;
     }
+    dst_map += dst_width;
 
     offset = ((int)(factor * y + 0.5)) * src_width;
     line_map = src_map + offset;
@@ -114,6 +61,31 @@ static void iDataStretchMap(int src_width, int src_height, unsigned char *src_ma
   free(XTab);
 }
 
+/* changes every time the image pixels change, used by the draw display lists */
+static unsigned int iimage_stamp = 0;
+
+static void iImageUpdateStamp(Ihandle* ih)
+{
+  iimage_stamp++;
+  if (iimage_stamp == 0)  /* 0 is for images without a handle */
+    iimage_stamp = 1;
+  iupAttribSetStrf(ih, "_IUPIMAGE_STAMP", "%u", iimage_stamp);
+}
+
+unsigned int iupImageGetStamp(const char* name)
+{
+  Ihandle* ih = IupGetHandle(name);
+  char* value;
+  if (!ih)
+    return 0;
+
+  value = iupAttribGet(ih, "_IUPIMAGE_STAMP");
+  if (!value)
+    return 0;
+
+  return (unsigned int)strtoul(value, NULL, 10);
+}
+
 static void iImageResize(Ihandle* ih, int new_width, int new_height)
 {
   unsigned char* imgdata = (unsigned char*)iupAttribGet(ih, "WID");
@@ -131,13 +103,18 @@ static void iImageResize(Ihandle* ih, int new_width, int new_height)
   if (bpp == 8)
     iDataStretchMap(ih->currentwidth, ih->currentheight, imgdata, new_width, new_height, new_imgdata);
   else
-    iupImageResizeRGBA(ih->currentwidth, ih->currentheight, imgdata, new_width, new_height, new_imgdata, channels);
+  {
+    char* filter = iupAttribGet(ih, "RESIZEFILTER");
+    if (!filter) filter = IupGetGlobal("IMAGERESIZEFILTER");
+    iupImageResizeRGBAFilter(ih->currentwidth, ih->currentheight, imgdata, new_width, new_height, new_imgdata, channels, iupImageGetResizeFilter(filter));
+  }
 
   ih->currentwidth = new_width;
   ih->currentheight = new_height;
 
   free(imgdata);
   iupAttribSet(ih, "WID", (char*)new_imgdata);
+  iImageUpdateStamp(ih);
 }
 
 /**************************************************************************************************/
@@ -1209,6 +1186,7 @@ static void iImageClearCache(Ihandle* ih)
 static int iImageSetClearCacheAttrib(Ihandle *ih, const char* value)
 {
   iImageClearCache(ih);
+  iImageUpdateStamp(ih);
   (void)value;
   return 0;
 }
@@ -1242,6 +1220,7 @@ static int iImageSetReshapeAttrib(Ihandle *ih, const char* value)
 
     ih->currentwidth = w;
     ih->currentheight = h;
+    iImageUpdateStamp(ih);
   }
   return 0;
 }
@@ -1357,6 +1336,7 @@ static int iImageCreate(Ihandle* ih, void** params, int bpp)
   iupAttribSet(ih, "WID", (char*)imgdata);
   iupAttribSetInt(ih, "BPP", bpp);
   iupAttribSetInt(ih, "CHANNELS", channels);
+  iImageUpdateStamp(ih);
 
   return IUP_NOERROR;
 }
@@ -1565,6 +1545,7 @@ static Iclass* iImageNewClassBase(const char* name, const char* cons)
   iupClassRegisterAttribute(ic, "CLEARCACHE", NULL, iImageSetClearCacheAttrib, NULL, NULL, IUPAF_WRITEONLY | IUPAF_NOT_MAPPED | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "RESHAPE", NULL, iImageSetReshapeAttrib, NULL, NULL, IUPAF_WRITEONLY | IUPAF_NOT_MAPPED | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "RESIZE", NULL, iImageSetResizeAttrib, NULL, NULL, IUPAF_WRITEONLY | IUPAF_NOT_MAPPED | IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "RESIZEFILTER", NULL, NULL, NULL, NULL, IUPAF_NOT_MAPPED | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "SCALED", NULL, NULL, NULL, NULL, IUPAF_READONLY | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "ORIGINALSCALE", NULL, NULL, NULL, NULL, IUPAF_READONLY | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "AUTOSCALE", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
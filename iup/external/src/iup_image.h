@@ -50,6 +50,11 @@ IUP_SDK_API void* iupImageGetImageTint(const char* name, Ihandle* parent, int ma
  * \ingroup image */
 IUP_SDK_API unsigned char* iupImageGetRGBAData(Ihandle* ih, int make_inactive, const char* bgcolor, int *img_w, int *img_h);
 IUP_SDK_API void iupImageGetInfo(const char* name, int *w, int *h, int *bpp);
+
+/** Returns a number that changes when the image pixels change (creation, RESHAPE, RESIZE and CLEARCACHE),
+ * or 0 if there is no image with that name.
+ * \ingroup image */
+unsigned int iupImageGetStamp(const char* name);
 void iupImageRemoveFromCache(Ihandle* ih, void* handle);
 
 IUP_SDK_API int iupImageInitColorTable(Ihandle *ih, iupColor* colors, int *colors_count);
@@ -57,7 +62,16 @@ void iupImageInitNonBgColors(Ihandle* ih, unsigned char *colors);
 IUP_SDK_API void iupImageColorMakeInactive(unsigned char *r, unsigned char *g, unsigned char *b, unsigned char bg_r, unsigned char bg_g, unsigned char bg_b);
 int iupImageNormBpp(int bpp);
 
+/* Resize filters, see iup_image_resize.c */
+enum { IUP_IMGRESIZE_BILINEAR, IUP_IMGRESIZE_BOX };
+
+/* depth is 3 or 4, uses bilinear interpolation */
 void iupImageResizeRGBA(int src_width, int src_height, unsigned char *src_map, int dst_width, int dst_height, unsigned char *dst_map, int depth);
+/* BOX is used only when reducing in both directions, else uses BILINEAR.
+   Large images are split in several threads. */
+void iupImageResizeRGBAFilter(int src_width, int src_height, unsigned char *src_map, int dst_width, int dst_height, unsigned char *dst_map, int depth, int filter);
+/* "BILINEAR" (default) or "BOX" */
+int iupImageGetResizeFilter(const char* value);
 
 #define iupALPHABLEND(_src,_dst,_alpha) (unsigned char)(((_src) * (_alpha) + (_dst) * (255 - (_alpha))) / 255)
 
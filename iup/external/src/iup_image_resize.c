@@ -0,0 +1,495 @@
+/** \file
+ * \brief Image Resize
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IRESIZE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IRESIZE_NEON
+#endif
+
+#include "iup.h"
+
+#include "iup_str.h"
+#include "iup_image.h"
+
+
+/* All kernels use integer weights:
+   bilinear uses 8 bits for each direction, the result is truncated as in the old floating point code.
+   box uses 12 bits for each direction, and 4 extra bits between the passes, the result is rounded. */
+
+#define IRESIZE_BOX_SHIFT 12
+#define IRESIZE_BOX_ONE   (1 << IRESIZE_BOX_SHIFT)
+
+/* images smaller than this are always resized in the calling thread */
+#define IRESIZE_THREAD_MIN_PIXELS (256*256)
+#define IRESIZE_THREAD_MIN_ROWS   32
+#define IRESIZE_THREAD_MAX        8
+
+typedef struct _IresizeTaps
+{
+  int* start;     /* first tap of each destination pixel */
+  int* count;     /* number of taps of each destination pixel */
+  int* index;     /* source index of each tap */
+  int* weight;    /* weight of each tap, they add up to IRESIZE_BOX_ONE */
+} IresizeTaps;
+
+typedef struct _IresizeContext
+{
+  int src_width, src_height, dst_width, dst_height, depth, filter;
+  const unsigned char *src_map;
+  unsigned char *dst_map;
+
+  /* bilinear */
+  int *XL, *XH;    /* byte offsets of the left and right source pixels */
+  int *T;          /* horizontal weight of the right pixel, 0-255 */
+
+  /* box */
+  IresizeTaps xtaps, ytaps;
+} IresizeContext;
+
+typedef struct _IresizeJob
+{
+  IresizeContext* ctx;
+  int y0, y1;
+} IresizeJob;
+
+
+/******************************************************************************************/
+
+
+static void iResizeBlendRows(const unsigned char* line_l, const unsigned char* line_h, unsigned short* row, int n, int u)
+{
+  /* row = line_l*(256-u) + line_h*u, 16 bits without overflow */
+  int i = 0;
+
+  if (u == 0)
+  {
+    for (; i < n; i++)
+      row[i] = (unsigned short)(line_l[i] << 8);
+    return;
+  }
+
+#if defined(IRESIZE_SSE2)
+  {
+    __m128i zero = _mm_setzero_si128();
+    __m128i wl = _mm_set1_epi16((short)(256 - u));
+    __m128i wh = _mm_set1_epi16((short)u);
+    for (; i + 16 <= n; i += 16)
+    {
+      __m128i l = _mm_loadu_si128((const __m128i*)(line_l + i));
+      __m128i h = _mm_loadu_si128((const __m128i*)(line_h + i));
+      __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(l, zero), wl), _mm_mullo_epi16(_mm_unpacklo_epi8(h, zero), wh));
+      __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(l, zero), wl), _mm_mullo_epi16(_mm_unpackhi_epi8(h, zero), wh));
+      _mm_storeu_si128((__m128i*)(row + i), lo);
+      _mm_storeu_si128((__m128i*)(row + i + 8), hi);
+    }
+  }
+#elif defined(IRESIZE_NEON)
+  {
+    uint8x8_t wl = vdup_n_u8((uint8_t)(256 - u));
+    uint8x8_t wh = vdup_n_u8((uint8_t)u);
+    for (; i + 16 <= n; i += 16)
+    {
+      uint8x16_t l = vld1q_u8(line_l + i);
+      uint8x16_t h = vld1q_u8(line_h + i);
+      vst1q_u16(row + i, vmlal_u8(vmull_u8(vget_low_u8(l), wl), vget_low_u8(h), wh));
+      vst1q_u16(row + i + 8, vmlal_u8(vmull_u8(vget_high_u8(l), wl), vget_high_u8(h), wh));
+    }
+  }
+#endif
+
+  for (; i < n; i++)
+    row[i] = (unsigned short)(line_l[i] * (256 - u) + line_h[i] * u);
+}
+
+static void iResizeBilinearRows(IresizeContext* ctx, int y0, int y1, unsigned short* row)
+{
+  int src_line_size = ctx->src_width * ctx->depth;
+  int dst_width = ctx->dst_width;
+  int depth = ctx->depth;
+  int x, y;
+
+  for (y = y0; y < y1; y++)
+  {
+    /* same mapping as the old floating point code: src_y = y * src_height / dst_height */
+    int64_t pos = ((int64_t)y * ctx->src_height * 256) / ctx->dst_height;
+    int yl = (int)(pos >> 8);
+    int yh = (yl == ctx->src_height - 1) ? yl : yl + 1;
+    int u = (int)(pos & 0xFF);
+    unsigned char* dst_map = ctx->dst_map + (size_t)y * dst_width * depth;
+
+    /* first the vertical pass over the whole source line, then the horizontal pass */
+    iResizeBlendRows(ctx->src_map + (size_t)yl * src_line_size, ctx->src_map + (size_t)yh * src_line_size, row, src_line_size, u);
+
+    if (depth == 4)
+    {
+      for (x = 0; x < dst_width; x++)
+      {
+        const unsigned short* fl = row + ctx->XL[x];
+        const unsigned short* fh = row + ctx->XH[x];
+        unsigned int t = (unsigned int)ctx->T[x], s = 256 - t;
+
+        dst_map[0] = (unsigned char)((fl[0] * s + fh[0] * t) >> 16);
+        dst_map[1] = (unsigned char)((fl[1] * s + fh[1] * t) >> 16);
+        dst_map[2] = (unsigned char)((fl[2] * s + fh[2] * t) >> 16);
+        dst_map[3] = (unsigned char)((fl[3] * s + fh[3] * t) >> 16);
+        dst_map += 4;
+      }
+    }
+    else
+    {
+      for (x = 0; x < dst_width; x++)
+      {
+        const unsigned short* fl = row + ctx->XL[x];
+        const unsigned short* fh = row + ctx->XH[x];
+        unsigned int t = (unsigned int)ctx->T[x], s = 256 - t;
+
+        dst_map[0] = (unsigned char)((fl[0] * s + fh[0] * t) >> 16);
+        dst_map[1] = (unsigned char)((fl[1] * s + fh[1] * t) >> 16);
+        dst_map[2] = (unsigned char)((fl[2] * s + fh[2] * t) >> 16);
+        dst_map += 3;
+      }
+    }
+  }
+}
+
+static void iResizeBoxRows(IresizeContext* ctx, int y0, int y1, unsigned int* row)
+{
+  int src_line_size = ctx->src_width * ctx->depth;
+  int depth = ctx->depth;
+  int x, y, i, c, k;
+
+  for (y = y0; y < y1; y++)
+  {
+    const int* yindex = ctx->ytaps.index + ctx->ytaps.start[y];
+    const int* yweight = ctx->ytaps.weight + ctx->ytaps.start[y];
+    int ycount = ctx->ytaps.count[y];
+    unsigned char* dst_map = ctx->dst_map + (size_t)y * ctx->dst_width * depth;
+
+    /* vertical pass, at most 255*IRESIZE_BOX_ONE for each sample */
+    {
+      const unsigned char* line = ctx->src_map + (size_t)yindex[0] * src_line_size;
+      unsigned int w = (unsigned int)yweight[0];
+      for (i = 0; i < src_line_size; i++)
+        row[i] = line[i] * w;
+    }
+    for (k = 1; k < ycount; k++)
+    {
+      const unsigned char* line = ctx->src_map + (size_t)yindex[k] * src_line_size;
+      unsigned int w = (unsigned int)yweight[k];
+      for (i = 0; i < src_line_size; i++)
+        row[i] += line[i] * w;
+    }
+
+    /* reduce to 16 bits, so the horizontal pass also fits in 32 bits */
+    for (i = 0; i < src_line_size; i++)
+      row[i] >>= IRESIZE_BOX_SHIFT - 4;
+
+    /* horizontal pass */
+    for (x = 0; x < ctx->dst_width; x++)
+    {
+      const int* xindex = ctx->xtaps.index + ctx->xtaps.start[x];
+      const int* xweight = ctx->xtaps.weight + ctx->xtaps.start[x];
+      int xcount = ctx->xtaps.count[x];
+      unsigned int sum[4] = { 0, 0, 0, 0 };
+
+      for (k = 0; k < xcount; k++)
+      {
+        const unsigned int* p = row + xindex[k] * depth;
+        unsigned int w = (unsigned int)xweight[k];
+        sum[0] += p[0] * w;
+        sum[1] += p[1] * w;
+        sum[2] += p[2] * w;
+        if (depth == 4)
+          sum[3] += p[3] * w;
+      }
+
+      for (c = 0; c < depth; c++)
+      {
+        unsigned int v = (sum[c] + (1u << (IRESIZE_BOX_SHIFT + 3))) >> (IRESIZE_BOX_SHIFT + 4);
+        dst_map[c] = (unsigned char)(v > 255 ? 255 : v);
+      }
+
+      dst_map += depth;
+    }
+  }
+}
+
+static void iResizeRunJob(IresizeJob* job)
+{
+  IresizeContext* ctx = job->ctx;
+  int n = ctx->src_width * ctx->depth;
+
+  if (ctx->filter == IUP_IMGRESIZE_BOX)
+  {
+    unsigned int* row = (unsigned int*)malloc(n * sizeof(unsigned int));
+    if (!row) return;
+    iResizeBoxRows(ctx, job->y0, job->y1, row);
+    free(row);
+  }
+  else
+  {
+    unsigned short* row = (unsigned short*)malloc(n * sizeof(unsigned short));
+    if (!row) return;
+    iResizeBilinearRows(ctx, job->y0, job->y1, row);
+    free(row);
+  }
+}
+
+
+/******************************************************************************************/
+
+
+static int iResizeInitTaps(IresizeTaps* taps, int src_size, int dst_size)
+{
+  /* Each destination pixel covers [d*src_size, (d+1)*src_size) and
+     each source pixel covers [s*dst_size, (s+1)*dst_size), in the same units.
+     The weight of a source pixel is its coverage normalized to IRESIZE_BOX_ONE. */
+  int d, s, n = 0;
+  int max_taps = dst_size * (src_size / dst_size + 2);
+
+  taps->start = (int*)malloc(dst_size * sizeof(int));
+  taps->count = (int*)malloc(dst_size * sizeof(int));
+  taps->index = (int*)malloc(max_taps * sizeof(int));
+  taps->weight = (int*)malloc(max_taps * sizeof(int));
+  if (!taps->start || !taps->count || !taps->index || !taps->weight)
+    return 0;
+
+  for (d = 0; d < dst_size; d++)
+  {
+    int64_t d0 = (int64_t)d * src_size, d1 = d0 + src_size;
+    int64_t covered = 0;
+    int sum = 0;
+
+    taps->start[d] = n;
+    for (s = (int)(d0 / dst_size); s < src_size && (int64_t)s * dst_size < d1; s++)
+    {
+      int64_t s0 = (int64_t)s * dst_size, s1 = s0 + dst_size;
+      int64_t overlap = (s1 < d1 ? s1 : d1) - (s0 > d0 ? s0 : d0);
+      int w;
+      if (overlap <= 0)
+        continue;
+
+      /* cumulative rounding, so the weights add up exactly to IRESIZE_BOX_ONE */
+      covered += overlap;
+      w = (int)((covered * IRESIZE_BOX_ONE) / src_size) - sum;
+      sum += w;
+
+      taps->index[n] = s;
+      taps->weight[n] = w;
+      n++;
+    }
+    taps->count[d] = n - taps->start[d];
+  }
+
+  return 1;
+}
+
+static void iResizeFreeTaps(IresizeTaps* taps)
+{
+  free(taps->start);
+  free(taps->count);
+  free(taps->index);
+  free(taps->weight);
+}
+
+static int iResizeInitBilinear(IresizeContext* ctx)
+{
+  int x;
+
+  ctx->XL = (int*)malloc(ctx->dst_width * sizeof(int));
+  ctx->XH = (int*)malloc(ctx->dst_width * sizeof(int));
+  ctx->T = (int*)malloc(ctx->dst_width * sizeof(int));
+  if (!ctx->XL || !ctx->XH || !ctx->T)
+    return 0;
+
+  for (x = 0; x < ctx->dst_width; x++)
+  {
+    int64_t pos = ((int64_t)x * ctx->src_width * 256) / ctx->dst_width;
+    int xl = (int)(pos >> 8);
+    int xh = (xl == ctx->src_width - 1) ? xl : xl + 1;
+    ctx->XL[x] = xl * ctx->depth;
+    ctx->XH[x] = xh * ctx->depth;
+    ctx->T[x] = (int)(pos & 0xFF);
+  }
+
+  return 1;
+}
+
+static int iResizeGetThreadCount(int dst_width, int dst_height)
+{
+  int count = 1;
+
+  if (dst_width * dst_height < IRESIZE_THREAD_MIN_PIXELS)
+    return 1;
+
+#if defined(WIN32)
+  {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    count = (int)info.dwNumberOfProcessors;
+  }
+#elif !defined(__EMSCRIPTEN__) && defined(_SC_NPROCESSORS_ONLN)
+  count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+  if (count > IRESIZE_THREAD_MAX)
+    count = IRESIZE_THREAD_MAX;
+  if (count > dst_height / IRESIZE_THREAD_MIN_ROWS)
+    count = dst_height / IRESIZE_THREAD_MIN_ROWS;
+  if (count < 1)
+    count = 1;
+  return count;
+}
+
+#if defined(WIN32)
+static DWORD WINAPI iResizeThreadFunc(LPVOID arg)
+{
+  iResizeRunJob((IresizeJob*)arg);
+  return 0;
+}
+#elif !defined(__EMSCRIPTEN__)
+static void* iResizeThreadFunc(void* arg)
+{
+  iResizeRunJob((IresizeJob*)arg);
+  return NULL;
+}
+#endif
+
+static void iResizeRun(IresizeContext* ctx)
+{
+  IresizeJob jobs[IRESIZE_THREAD_MAX];
+  int i, count = iResizeGetThreadCount(ctx->dst_width, ctx->dst_height);
+
+  for (i = 0; i < count; i++)
+  {
+    jobs[i].ctx = ctx;
+    jobs[i].y0 = (int)(((int64_t)ctx->dst_height * i) / count);
+    jobs[i].y1 = (int)(((int64_t)ctx->dst_height * (i + 1)) / count);
+  }
+
+  if (count == 1)
+  {
+    iResizeRunJob(&jobs[0]);
+    return;
+  }
+
+#if defined(WIN32)
+  {
+    HANDLE threads[IRESIZE_THREAD_MAX];
+
+    /* the calling thread takes the first job */
+    for (i = 1; i < count; i++)
+    {
+      threads[i] = CreateThread(NULL, 0, iResizeThreadFunc, &jobs[i], 0, NULL);
+      if (!threads[i])
+        iResizeRunJob(&jobs[i]);
+    }
+
+    iResizeRunJob(&jobs[0]);
+
+    for (i = 1; i < count; i++)
+    {
+      if (threads[i])
+      {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+      }
+    }
+  }
+#elif !defined(__EMSCRIPTEN__)
+  {
+    pthread_t threads[IRESIZE_THREAD_MAX];
+    int created[IRESIZE_THREAD_MAX];
+
+    for (i = 1; i < count; i++)
+    {
+      created[i] = (pthread_create(&threads[i], NULL, iResizeThreadFunc, &jobs[i]) == 0);
+      if (!created[i])
+        iResizeRunJob(&jobs[i]);
+    }
+
+    iResizeRunJob(&jobs[0]);
+
+    for (i = 1; i < count; i++)
+    {
+      if (created[i])
+        pthread_join(threads[i], NULL);
+    }
+  }
+#else
+  for (i = 0; i < count; i++)
+    iResizeRunJob(&jobs[i]);
+#endif
+}
+
+void iupImageResizeRGBAFilter(int src_width, int src_height, unsigned char *src_map, int dst_width, int dst_height, unsigned char *dst_map, int depth, int filter)
+{
+  IresizeContext ctx;
+
+  if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0)
+    return;
+
+  memset(&ctx, 0, sizeof(IresizeContext));
+  ctx.src_width = src_width;
+  ctx.src_height = src_height;
+  ctx.dst_width = dst_width;
+  ctx.dst_height = dst_height;
+  ctx.depth = depth;
+  ctx.src_map = src_map;
+  ctx.dst_map = dst_map;
+
+  /* box is only an improvement when reducing in both directions */
+  if (filter == IUP_IMGRESIZE_BOX && dst_width <= src_width && dst_height <= src_height)
+    ctx.filter = IUP_IMGRESIZE_BOX;
+  else
+    ctx.filter = IUP_IMGRESIZE_BILINEAR;
+
+  if (ctx.filter == IUP_IMGRESIZE_BOX)
+  {
+    if (iResizeInitTaps(&ctx.xtaps, src_width, dst_width) &&
+        iResizeInitTaps(&ctx.ytaps, src_height, dst_height))
+      iResizeRun(&ctx);
+
+    iResizeFreeTaps(&ctx.xtaps);
+    iResizeFreeTaps(&ctx.ytaps);
+  }
+  else
+  {
+    if (iResizeInitBilinear(&ctx))
+      iResizeRun(&ctx);
+
+    free(ctx.XL);
+    free(ctx.XH);
+    free(ctx.T);
+  }
+}
+
+void iupImageResizeRGBA(int src_width, int src_height, unsigned char *src_map, int dst_width, int dst_height, unsigned char *dst_map, int depth)
+{
+  iupImageResizeRGBAFilter(src_width, src_height, src_map, dst_width, dst_height, dst_map, depth, IUP_IMGRESIZE_BILINEAR);
+}
+
+int iupImageGetResizeFilter(const char* value)
+{
+  if (iupStrEqualNoCase(value, "BOX"))
+    return IUP_IMGRESIZE_BOX;
+  return IUP_IMGRESIZE_BILINEAR;
+}
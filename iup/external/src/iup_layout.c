@@ -43,6 +43,10 @@ IUP_API void IupRefreshChildren(Ihandle* ih)
 
   shrink = iupAttribGetBoolean(dialog, "SHRINK");
 
+  /* compute the children again, they may have changed since the last layout */
+  for (child = ih->firstchild; child; child = child->brother)
+    iupLayoutMarkDirtyTree(child);
+
   /* children only iupBaseComputeNaturalSize */
   {
     int w=0, h=0, children_expand=ih->expand;
@@ -67,6 +71,17 @@ IUP_API void IupRefreshChildren(Ihandle* ih)
   }
 }
 
+static void iLayoutCompute(Ihandle* ih);
+static int iLayoutUpdateTree(Ihandle* ih, int all, int update);
+
+static void iLayoutRefresh(Ihandle* dialog)
+{
+  iLayoutCompute(dialog);
+
+  /* also clear the marks when not mapped */
+  iLayoutUpdateTree(dialog, 0, dialog->handle != NULL);
+}
+
 IUP_API void IupRefresh(Ihandle* ih)
 {
   Ihandle* dialog;
@@ -78,10 +93,59 @@ IUP_API void IupRefresh(Ihandle* ih)
   dialog = IupGetDialog(ih);
   if (dialog)
   {
-    iupLayoutCompute(dialog);
+    /* the element and its children may have changed in ways not known by the layout,
+       like attributes, fonts or the native system, so compute all of them again */
+    iupLayoutMarkDirtyTree(ih);
 
-    if (dialog->handle)
-      iupLayoutUpdate(dialog);
+    if (iupAttribGetInt(dialog, "_IUP_REFRESH_LOCK") > 0)
+    {
+      iupAttribSet(dialog, "_IUP_REFRESH_PENDING", "1");
+      return;
+    }
+
+    iLayoutRefresh(dialog);
+  }
+}
+
+IUP_API void IupRefreshBegin(Ihandle* ih)
+{
+  Ihandle* dialog;
+
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return;
+
+  dialog = IupGetDialog(ih);
+  if (dialog)
+    iupAttribSetInt(dialog, "_IUP_REFRESH_LOCK", iupAttribGetInt(dialog, "_IUP_REFRESH_LOCK") + 1);
+}
+
+IUP_API void IupRefreshEnd(Ihandle* ih)
+{
+  Ihandle* dialog;
+  int lock;
+
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return;
+
+  dialog = IupGetDialog(ih);
+  if (!dialog)
+    return;
+
+  lock = iupAttribGetInt(dialog, "_IUP_REFRESH_LOCK") - 1;
+  if (lock > 0)
+  {
+    iupAttribSetInt(dialog, "_IUP_REFRESH_LOCK", lock);
+    return;
+  }
+
+  iupAttribSet(dialog, "_IUP_REFRESH_LOCK", NULL);
+
+  if (iupAttribGet(dialog, "_IUP_REFRESH_PENDING"))
+  {
+    iupAttribSet(dialog, "_IUP_REFRESH_PENDING", NULL);
+    iLayoutRefresh(dialog);
   }
 }
 
@@ -139,30 +203,107 @@ IUP_API void IupRedraw(Ihandle* ih, int children)
     iLayoutDisplayRedrawChildren(ih);
 }
 
-IUP_SDK_API void iupLayoutUpdate(Ihandle* ih)
+IUP_SDK_API void iupLayoutMarkDirty(Ihandle* ih)
+{
+  /* already marked, unless it was just inserted in a new parent */
+  if ((ih->flags & IUP_LAYOUT_DIRTY) && (!ih->parent || (ih->parent->flags & IUP_LAYOUT_CHILD_DIRTY)))
+    return;
+
+  ih->flags |= IUP_LAYOUT_DIRTY;
+
+  /* stop at the first parent already marked, its own parents are also marked */
+  ih = ih->parent;
+  while (ih && !(ih->flags & IUP_LAYOUT_CHILD_DIRTY))
+  {
+    ih->flags |= IUP_LAYOUT_CHILD_DIRTY;
+    ih = ih->parent;
+  }
+}
+
+IUP_SDK_API void iupLayoutResetCache(Ihandle* ih)
+{
+  ih->flags &= ~IUP_LAYOUT_CACHED;
+}
+
+static void iLayoutMarkDirtyChildren(Ihandle* ih)
 {
   Ihandle* child;
+  for (child = ih->firstchild; child; child = child->brother)
+  {
+    child->flags |= IUP_LAYOUT_DIRTY;
 
-  if (ih->flags & IUP_FLOATING_IGNORE)
-    return;
+    if (child->firstchild)
+    {
+      child->flags |= IUP_LAYOUT_CHILD_DIRTY;
+      iLayoutMarkDirtyChildren(child);
+    }
+  }
+}
+
+IUP_SDK_API void iupLayoutMarkDirtyTree(Ihandle* ih)
+{
+  iupLayoutMarkDirty(ih);
+
+  if (ih->firstchild)
+  {
+    ih->flags |= IUP_LAYOUT_CHILD_DIRTY;
+    iLayoutMarkDirtyChildren(ih);
+  }
+}
+
+/* Updates the native elements and clears the layout flags.
+   If "all" is 0 only the elements marked in the last layout pass are visited.
+   Returns 1 if some element in the tree still needs its natural size computed. */
+static int iLayoutUpdateTree(Ihandle* ih, int all, int update)
+{
+  Ihandle* child;
+  int flags = ih->flags, dirty = 0;
+
+  if (!all && !(flags & (IUP_LAYOUT_CHANGED|IUP_LAYOUT_CHILD_DIRTY|IUP_LAYOUT_DIRTY)))
+    return 0;
+
+  ih->flags &= ~(IUP_LAYOUT_CHANGED|IUP_LAYOUT_CHILD_DIRTY);
+
+  if (flags & IUP_FLOATING_IGNORE)
+    update = 0;
 
   /* update size and position of the native control */
-  iupClassObjectLayoutUpdate(ih);
+  if (update && (all || (flags & (IUP_LAYOUT_CHANGED|IUP_LAYOUT_DIRTY))))
+    iupClassObjectLayoutUpdate(ih);
 
   /* update its children */
   for (child = ih->firstchild; child; child = child->brother)
   {
-    if (child->handle)
-      iupLayoutUpdate(child);
+    if (iLayoutUpdateTree(child, all, update && child->handle))
+      dirty = 1;
   }
+
+  /* elements not reached by the last layout pass keep their marks */
+  if (dirty)
+    ih->flags |= IUP_LAYOUT_CHILD_DIRTY;
+
+  return dirty || (ih->flags & IUP_LAYOUT_DIRTY);
 }
 
-IUP_SDK_API void iupLayoutCompute(Ihandle* ih)
+IUP_SDK_API void iupLayoutUpdate(Ihandle* ih)
 {
-  /* usually called only for the dialog */
+  if (ih->flags & IUP_FLOATING_IGNORE)
+    return;
 
+  iLayoutUpdateTree(ih, 1, 1);
+}
+
+static void iLayoutCompute(Ihandle* ih)
+{
   int shrink = iupAttribGetBoolean(ih, "SHRINK");
 
+  /* SHRINK is used in the whole tree */
+  if (shrink != iupAttribGetInt(ih, "_IUP_LAYOUT_SHRINK"))
+  {
+    iupAttribSet(ih, "_IUP_LAYOUT_SHRINK", shrink? "1": NULL);
+    iupLayoutMarkDirtyTree(ih);
+  }
+
   /* Compute the natural size for all elements in the dialog,
      using the minimum visible size and the defined user size.
      The minimum visible size is the size where all the controls can display
@@ -172,6 +313,7 @@ IUP_SDK_API void iupLayoutCompute(Ihandle* ih)
      So the native size will be the maximum value between
      minimum visible size and defined user size.
      Also calculates the expand configuration for each element, but expand is used only in SetChildrenCurrentSize.
+     Elements not marked as dirty reuse the natural size of the previous computation.
      SEQUENCE: will first calculate the native size for the children, then for the element. */
   iupBaseComputeNaturalSize(ih);
 
@@ -180,6 +322,7 @@ IUP_SDK_API void iupLayoutCompute(Ihandle* ih)
      If shrink is 0 (default) the current size of containers can be only larger than the natural size,
      the result will depend on the EXPAND attribute.
      If shrink is 1 the containers can be resized to sizes smaller than the natural size.
+     Children are skipped when the size of the element did not change and nothing inside it changed.
      SEQUENCE: will first calculate the current size of the element, then for the children. */
   iupBaseSetCurrentSize(ih, 0, 0, shrink);
 
@@ -189,6 +332,16 @@ IUP_SDK_API void iupLayoutCompute(Ihandle* ih)
   iupBaseSetPosition(ih, 0, 0);
 }
 
+IUP_SDK_API void iupLayoutCompute(Ihandle* ih)
+{
+  /* usually called only for the dialog */
+
+  /* compute everything, the native system may have changed sizes behind our back */
+  iupLayoutMarkDirtyTree(ih);
+
+  iLayoutCompute(ih);
+}
+
 IUP_SDK_API void iupLayoutApplyMinMaxSize(Ihandle* ih, int *w, int *h)
 {
   if (ih->flags & IUP_MINSIZE)
@@ -216,6 +369,17 @@ IUP_SDK_API void iupLayoutApplyMinMaxSize(Ihandle* ih, int *w, int *h)
 
 void iupBaseComputeNaturalSize(Ihandle* ih)
 {
+  int old_width = ih->naturalwidth,
+      old_height = ih->naturalheight,
+      old_expand = ih->expand;
+
+  /* nothing changed inside the element since the last computation,
+     the natural size of the dialog depends on its current size so it is always computed */
+  if ((ih->flags & IUP_LAYOUT_CACHED) &&
+      !(ih->flags & (IUP_LAYOUT_DIRTY|IUP_LAYOUT_CHILD_DIRTY)) &&
+      ih->iclass->nativetype != IUP_TYPEDIALOG)
+    return;
+
   /* always initialize the natural size using the user size */
   ih->naturalwidth = ih->userwidth;
   ih->naturalheight = ih->userheight;
@@ -267,10 +431,21 @@ void iupBaseComputeNaturalSize(Ihandle* ih)
 
   /* crop the natural size */
   iupLayoutApplyMinMaxSize(ih, &(ih->naturalwidth), &(ih->naturalheight));
+
+  /* the parent must distribute its space again */
+  if ((ih->flags & IUP_LAYOUT_DIRTY) || !(ih->flags & IUP_LAYOUT_CACHED) ||
+      ih->naturalwidth != old_width || ih->naturalheight != old_height || ih->expand != old_expand)
+    ih->flags |= IUP_LAYOUT_CHANGED;
+
+  ih->flags &= ~IUP_LAYOUT_DIRTY;
+  ih->flags |= IUP_LAYOUT_CACHED;
 }
 
 void iupBaseSetCurrentSize(Ihandle* ih, int w, int h, int shrink)
 {
+  int old_width = ih->currentwidth,
+      old_height = ih->currentheight;
+
   if (ih->iclass->nativetype == IUP_TYPEDIALOG)
   {
     /* w and h parameters here are ignored, because they are always 0 for the dialog. */
@@ -300,15 +475,23 @@ void iupBaseSetCurrentSize(Ihandle* ih, int w, int h, int shrink)
       ih->expand & IUP_EXPAND_WFREE || ih->expand & IUP_EXPAND_HFREE)
     iupLayoutApplyMinMaxSize(ih, &(ih->currentwidth), &(ih->currentheight));
 
-  if (ih->firstchild)
+  if (ih->currentwidth != old_width || ih->currentheight != old_height)
+    ih->flags |= IUP_LAYOUT_CHANGED;
+
+  /* the children keep their sizes if the element size and the children natural sizes did not change */
+  if (ih->firstchild && (ih->flags & (IUP_LAYOUT_CHANGED|IUP_LAYOUT_CHILD_DIRTY|IUP_LAYOUT_DIRTY)))
     iupClassObjectSetChildrenCurrentSize(ih, shrink);
 }
 
 void iupBaseSetPosition(Ihandle* ih, int x, int y)
 {
-  ih->x = x;
-  ih->y = y;
+  if (ih->x != x || ih->y != y)
+  {
+    ih->x = x;
+    ih->y = y;
+    ih->flags |= IUP_LAYOUT_CHANGED;
+  }
 
-  if (ih->firstchild)
+  if (ih->firstchild && (ih->flags & (IUP_LAYOUT_CHANGED|IUP_LAYOUT_CHILD_DIRTY|IUP_LAYOUT_DIRTY)))
     iupClassObjectSetChildrenPosition(ih, x, y);
 }
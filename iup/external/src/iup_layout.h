@@ -13,13 +13,27 @@ extern "C" {
 #endif
 
 /* called from IupMap and IupRefresh */
-IUP_SDK_API void iupLayoutCompute(Ihandle* ih);  /* can be called before map */
+IUP_SDK_API void iupLayoutCompute(Ihandle* ih);  /* can be called before map, always computes the whole tree */
 IUP_SDK_API void iupLayoutUpdate(Ihandle* ih);   /* called after map */
 
 IUP_SDK_API void iupLayoutApplyMinMaxSize(Ihandle* ih, int *w, int *h);
 
+/* Marks the element so its natural size is computed again in the next IupRefresh,
+   and marks its parents so the layout pass can find it.
+   Called by IupRefresh and when the child tree changes.
+   Elements not marked reuse the natural size of the previous layout pass. */
+IUP_SDK_API void iupLayoutMarkDirty(Ihandle* ih);
+IUP_SDK_API void iupLayoutMarkDirtyTree(Ihandle* ih);  /* the element and all its children */
+
+/* Discards the cached natural size of the element, without marking its parents.
+   Used when a parent replaces the natural size of a child (NORMALIZESIZE, IupSbox, IupExpander),
+   and when the natural size is needed outside a layout pass. */
+IUP_SDK_API void iupLayoutResetCache(Ihandle* ih);
+
 /* Other functions declared in <iup.h> and implemented here.
 IupRefresh
+IupRefreshBegin
+IupRefreshEnd
 */
 
 /* at iup_elempropdlg */
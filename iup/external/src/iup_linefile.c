@@ -13,12 +13,15 @@
 #include "iup_linefile.h"
 
 #define LINEFILE_STRING_BLOCK 80
+#define LINEFILE_READ_BLOCK 65536
 
 struct _IlineFile
 {
   FILE* file;
   char* line_buffer;
   int buffer_maxsize;
+  char* read_buffer;
+  int read_pos, read_size;
 };
 
 IUP_SDK_API const char* iupLineFileGetBuffer(IlineFile* line_file)
@@ -28,7 +31,7 @@ IUP_SDK_API const char* iupLineFileGetBuffer(IlineFile* line_file)
 
 IUP_SDK_API int iupLineFileEOF(IlineFile* line_file)
 {
-  return feof(line_file->file);
+  return line_file->read_pos >= line_file->read_size && feof(line_file->file);
 }
 
 IUP_SDK_API IlineFile* iupLineFileOpen(const char* filename)
@@ -49,9 +52,12 @@ IUP_SDK_API IlineFile* iupLineFileOpen(const char* filename)
     line_file->file = file;
     line_file->buffer_maxsize = LINEFILE_STRING_BLOCK;
     line_file->line_buffer = (char*)malloc(line_file->buffer_maxsize);
-    if (!line_file->line_buffer)
+    line_file->read_buffer = (char*)malloc(LINEFILE_READ_BLOCK);
+    if (!line_file->line_buffer || !line_file->read_buffer)
     {
       fclose(file);
+      free(line_file->line_buffer);
+      free(line_file->read_buffer);
       free(line_file);
       return NULL;
     }
@@ -64,42 +70,68 @@ IUP_SDK_API void iupLineFileClose(IlineFile* line_file)
 {
   fclose(line_file->file);
   free(line_file->line_buffer);  /* use free because of realloc */
+  free(line_file->read_buffer);
   free(line_file);
 }
 
 IUP_SDK_API int iupLineFileReadLine(IlineFile* line_file)
 {
-  char char_buffer[1];
-  int ret, count = 0;
+  int count = 0;
 
-  do
+  for (;;)
   {
-    ret = (int)fread(char_buffer, 1, 1, line_file->file);
-    if (ret == 0)
-    {
-      if (feof(line_file->file))  /* last line */
-        break;
+    char *start, *end;
+    int size, i;
 
-      return -1;  /* error reading */
+    if (line_file->read_pos >= line_file->read_size)
+    {
+      /* reads the file in blocks instead of one character at a time */
+      line_file->read_pos = 0;
+      line_file->read_size = (int)fread(line_file->read_buffer, 1, LINEFILE_READ_BLOCK, line_file->file);
+      if (line_file->read_size == 0)
+      {
+        if (feof(line_file->file))  /* last line */
+          break;
+
+        return -1;  /* error reading */
+      }
     }
 
-    if (count+1 >= line_file->buffer_maxsize)
+    start = line_file->read_buffer + line_file->read_pos;
+    end = (char*)memchr(start, '\n', line_file->read_size - line_file->read_pos);
+    size = end ? (int)(end - start) : line_file->read_size - line_file->read_pos;
+
+    if (count + size + 1 > line_file->buffer_maxsize)
     {
-      int new_maxsize = line_file->buffer_maxsize + LINEFILE_STRING_BLOCK;
-      char* new_buffer = (char*)realloc(line_file->line_buffer, new_maxsize);
+      int new_maxsize = line_file->buffer_maxsize * 2;
+      char* new_buffer;
+      if (new_maxsize < count + size + 1)
+        new_maxsize = count + size + LINEFILE_STRING_BLOCK;
+
+      new_buffer = (char*)realloc(line_file->line_buffer, new_maxsize);
       if (!new_buffer)
         return -1;
       line_file->line_buffer = new_buffer;
-      memset(line_file->line_buffer + line_file->buffer_maxsize, 0, LINEFILE_STRING_BLOCK);
       line_file->buffer_maxsize = new_maxsize;
     }
 
-    if (char_buffer[0] != '\r' && char_buffer[0] != '\n')
+    for (i = 0; i < size; i++)
     {
-      line_file->line_buffer[count] = char_buffer[0];
-      count++;
+      if (start[i] != '\r')
+      {
+        line_file->line_buffer[count] = start[i];
+        count++;
+      }
     }
-  } while (char_buffer[0] != '\n');
+
+    if (end)
+    {
+      line_file->read_pos += size + 1;
+      break;
+    }
+
+    line_file->read_pos += size;
+  }
 
   line_file->line_buffer[count] = 0;
   return count;
@@ -15,6 +15,7 @@
 #include "iup_array.h"
 #include "iup_stdcontrols.h"
 #include "iup_normalizer.h"
+#include "iup_layout.h"
 #include "iup_varg.h"
 
 
@@ -60,6 +61,9 @@ void iupNormalizeSizeBoxChild(Ihandle *ih, int normalize, int children_natural_m
         child->naturalwidth = children_natural_maxwidth;
       if (normalize & NORMALIZE_HEIGHT)
         child->naturalheight = children_natural_maxheight;
+
+      /* the child own size must be used next time, or the maximum could never shrink */
+      iupLayoutResetCache(child);
     }
   }
 }
@@ -80,6 +84,7 @@ static int iNormalizerSetNormalizeAttrib(Ihandle* ih, const char* value)
   for (i = 0; i < count; i++)
   {
     ih_control = ih_list[i];
+    iupLayoutMarkDirtyTree(ih_control);  /* called outside IupRefresh, the cached size may be old */
     iupBaseComputeNaturalSize(ih_control);
     natural_maxwidth = iupMAX(natural_maxwidth, ih_control->naturalwidth);
     natural_maxheight = iupMAX(natural_maxheight, ih_control->naturalheight);
@@ -96,6 +101,8 @@ static int iNormalizerSetNormalizeAttrib(Ihandle* ih, const char* value)
         ih_control->userwidth = natural_maxwidth;
       if (normalize & NORMALIZE_HEIGHT)
         ih_control->userheight = natural_maxheight;
+
+      iupLayoutMarkDirty(ih_control);
     }
   }
   return 1;
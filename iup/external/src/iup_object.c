@@ -40,6 +40,8 @@ static Ihandle* iHandleCreate(void)
 static void iHandleDestroy(Ihandle* ih)
 {
   iupTableDestroy(ih->attrib);
+  if (ih->attrib_id)
+    iupIdTableDestroy(ih->attrib_id);
   memset(ih, 0, sizeof(Ihandle));
   free(ih);
 }
@@ -9,6 +9,7 @@
 
 #include <stdarg.h>
 #include "iup_class.h"
+#include "iup_idtable.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -94,7 +95,11 @@ enum Iflags {
   IUP_FLOATING_IGNORE  = 0x02,   /**< is a floating element. FLOATING=Ignore. Do not compute layout. */
   IUP_MAXSIZE          = 0x04,   /**< has the MAXSIZE attribute set */
   IUP_MINSIZE          = 0x08,   /**< has the MAXSIZE attribute set */
-  IUP_INTERNAL         = 0x10    /**< it is an internal element of the container */
+  IUP_INTERNAL         = 0x10,   /**< it is an internal element of the container */
+  IUP_LAYOUT_DIRTY     = 0x20,   /**< something that affects the natural size changed. See \ref iupLayoutMarkDirty */
+  IUP_LAYOUT_CHILD_DIRTY = 0x40, /**< some descendant has IUP_LAYOUT_DIRTY */
+  IUP_LAYOUT_CACHED    = 0x80,   /**< the natural size was computed and can be reused */
+  IUP_LAYOUT_CHANGED   = 0x100   /**< size or position changed in the current layout pass */
 };
 
 /** Structure used by all the elements.
@@ -104,6 +109,7 @@ struct Ihandle_
   char sig[4];           /**< IUP Signature, initialized with "IUP", cleared on destroy */
   Iclass* iclass;        /**< Ihandle Class */
   Itable* attrib;        /**< attributes table */
+  Iidtable* attrib_id;   /**< numbered attributes table, created on demand. See \ref iupAttribSetId */
   int serial;            /**< serial number used for controls that need a numeric id, initialized with -1 */
   InativeHandle* handle; /**< native handle. initialized when mapped. InativeHandle definition is system dependent. */
   int expand;            /**< expand configuration, a combination of \ref Iexpand, for containers is a combination of the children expands */
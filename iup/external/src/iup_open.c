@@ -24,6 +24,7 @@
 #include "iup_dlglist.h"
 #include "iup_assert.h"
 #include "iup_strmessage.h"
+#include "iup_atom.h"
 
 
 static int iup_opened = 0;
@@ -50,6 +51,7 @@ IUP_API int IupOpen(int *argc, char ***argv)
   iupFuncInit();
   iupStrMessageInit();
   iupGlobalAttribInit();
+  iupAtomInit();
   iupRegisterInit();
   iupKeyInit();
   iupImageStockInit();
@@ -117,6 +119,7 @@ IUP_API void IupClose(void)
   iupStrMessageFinish();    /* release messages hash table */
   iupFuncFinish();          /* release callbacks hash table */
   iupNamesFinish();         /* release names hash table */
+  iupAtomFinish();          /* release atoms, after all classes are released */
 
   iupStrGetMemory(-1); /* Frees internal buffer */
 }
@@ -336,6 +336,7 @@ static void iSboxComputeNaturalSizeMethod(Ihandle* ih, int *w, int *h, int *chil
     Ihandle* child = ih->firstchild->brother;
     child->naturalwidth = ih->data->w - iSboxGetXborder(ih, bar_size);
     child->naturalheight = ih->data->h - iSboxGetYborder(ih, bar_size);
+    iupLayoutResetCache(child);
   }
 
   *w = ih->data->w;
@@ -11,6 +11,12 @@
 #include <stdarg.h>
 #include <locale.h>
 
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "iup_export.h"
 #include "iup_str.h"
 
@@ -323,140 +329,281 @@ static char *iStrDupUntilNoCase(char **str, char sep)
   }
 }
 
-IUP_SDK_API char *iupStrGetLargeMem(int *size)
+/* Return buffers.
+   Each thread has its own arena, so attribute getters can be called from worker threads.
+   Buffers are reused in a ring, the ring index works as a generation counter,
+   and buffers are not cleared when reused. */
+
+#define ISTR_SMALL_COUNT 100
+#define ISTR_SMALL_SIZE 80  /* maximum for iupStrReturnFloat and iupStrReturnDouble */
+#define ISTR_MEM_COUNT 50
+#define ISTR_LARGE_COUNT 10
+#define ISTR_LARGE_SIZE SHRT_MAX
+
+typedef struct _IstrArena
 {
-#define LARGE_MAX_BUFFERS 10
-#define LARGE_SIZE SHRT_MAX
-  static char buffers[LARGE_MAX_BUFFERS][LARGE_SIZE];
-  static int buffers_index = -1;
-  char* ret_str;
+  char small_buffers[ISTR_SMALL_COUNT][ISTR_SMALL_SIZE];
+  int small_index;
+
+  char* buffers[ISTR_MEM_COUNT];
+  int buffers_sizes[ISTR_MEM_COUNT];
+  int buffers_index;
+
+  char* large_buffers[ISTR_LARGE_COUNT];
+  int large_index;
+} IstrArena;
+
+#if defined(_MSC_VER)
+#define ISTR_THREAD_LOCAL __declspec(thread)
+#else
+#define ISTR_THREAD_LOCAL __thread
+#endif
+
+static ISTR_THREAD_LOCAL IstrArena* istr_arena = NULL;
+
+static void iStrArenaDestroy(void* data)
+{
+  IstrArena* arena = (IstrArena*)data;
+  int i;
+
+  if (!arena)
+    return;
+
+  for (i = 0; i < ISTR_MEM_COUNT; i++)
+    free(arena->buffers[i]);
+  for (i = 0; i < ISTR_LARGE_COUNT; i++)
+    free(arena->large_buffers[i]);
+  free(arena);
+
+  if (istr_arena == arena)
+    istr_arena = NULL;
+}
+
+/* The arena of a worker thread is released when the thread ends.
+   The arena of the main thread is released in IupClose. */
+#ifdef WIN32
+static DWORD istr_arena_fls = FLS_OUT_OF_INDEXES;
+static INIT_ONCE istr_arena_once = INIT_ONCE_STATIC_INIT;
+
+static VOID WINAPI iStrArenaFlsCallback(PVOID data)
+{
+  iStrArenaDestroy(data);
+}
 
-  /* init buffers array */
-  if (buffers_index == -1)
+static BOOL CALLBACK iStrArenaKeyCreate(PINIT_ONCE once, PVOID param, PVOID *context)
+{
+  (void)once; (void)param; (void)context;
+  istr_arena_fls = FlsAlloc(iStrArenaFlsCallback);
+  return TRUE;
+}
+
+static void iStrArenaSetKey(IstrArena* arena)
+{
+  InitOnceExecuteOnce(&istr_arena_once, iStrArenaKeyCreate, NULL, NULL);
+  if (istr_arena_fls != FLS_OUT_OF_INDEXES)
+    FlsSetValue(istr_arena_fls, arena);
+}
+#else
+static pthread_key_t istr_arena_key;
+static pthread_once_t istr_arena_once = PTHREAD_ONCE_INIT;
+static int istr_arena_key_created = 0;
+
+static void iStrArenaKeyCreate(void)
+{
+  istr_arena_key_created = (pthread_key_create(&istr_arena_key, iStrArenaDestroy) == 0);
+}
+
+static void iStrArenaSetKey(IstrArena* arena)
+{
+  pthread_once(&istr_arena_once, iStrArenaKeyCreate);
+  if (istr_arena_key_created)
+    pthread_setspecific(istr_arena_key, arena);
+}
+#endif
+
+static IstrArena* iStrGetArena(void)
+{
+  IstrArena* arena = istr_arena;
+  if (!arena)
   {
-    int i;
-    /* clear all memory */
-    for (i=0; i<LARGE_MAX_BUFFERS; i++)
-      memset(buffers[i], 0, sizeof(char)*LARGE_SIZE);
+    arena = (IstrArena*)calloc(1, sizeof(IstrArena));
+    if (!arena)
+      return NULL;
 
-    buffers_index = 0;
+    istr_arena = arena;
+    iStrArenaSetKey(arena);
   }
+  return arena;
+}
+
+static void iStrReleaseArena(void)
+{
+  IstrArena* arena = istr_arena;
+  if (arena)
+  {
+    iStrArenaSetKey(NULL);
+    iStrArenaDestroy(arena);
+  }
+}
+
+IUP_SDK_API char *iupStrGetLargeMem(int *size)
+{
+  IstrArena* arena = iStrGetArena();
+  char* ret_str;
+
+  if (!arena)
+    return NULL;
 
   /* DON'T clear memory everytime because the buffer is too large */
-  ret_str = buffers[buffers_index];
+  ret_str = arena->large_buffers[arena->large_index];
+  if (!ret_str)
+  {
+    ret_str = (char*)malloc(ISTR_LARGE_SIZE);
+    if (!ret_str)
+      return NULL;
+    arena->large_buffers[arena->large_index] = ret_str;
+  }
   ret_str[0] = 0;
 
-  buffers_index++;
-  if (buffers_index == LARGE_MAX_BUFFERS)
-    buffers_index = 0;
+  arena->large_index++;
+  if (arena->large_index == ISTR_LARGE_COUNT)
+    arena->large_index = 0;
 
-  if (size) *size = LARGE_SIZE;
+  if (size) *size = ISTR_LARGE_SIZE;
   return ret_str;
-#undef LARGE_MAX_BUFFERS
-#undef LARGE_SIZE
 }
 
-static char* iupStrGetSmallMem(void)
+static char* iStrGetSmallMem(void)
 {
-#define SMALL_MAX_BUFFERS 100
-#define SMALL_SIZE 80  /* maximum for iupStrReturnFloat and iupStrReturnDouble */
-  static char buffers[SMALL_MAX_BUFFERS][SMALL_SIZE];
-  static int buffers_index = -1;
+  IstrArena* arena = iStrGetArena();
   char* ret_str;
 
-  /* init buffers array */
-  if (buffers_index == -1)
-  {
-    int i;
-    /* clear all memory */
-    for (i = 0; i<SMALL_MAX_BUFFERS; i++)
-      memset(buffers[i], 0, sizeof(char)*SMALL_SIZE);
+  if (!arena)
+    return NULL;
+
+  /* not cleared, callers always write a terminated string */
+  ret_str = arena->small_buffers[arena->small_index];
 
-    buffers_index = 0;
+  arena->small_index++;
+  if (arena->small_index == ISTR_SMALL_COUNT)
+    arena->small_index = 0;
+
+  return ret_str;
+}
+
+/* returns a buffer with at least size+1 bytes, NOT cleared */
+static char* iStrGetMem(int size)
+{
+  IstrArena* arena;
+  char* ret_str;
+  int index;
+
+  if (size < ISTR_SMALL_SIZE)
+    return iStrGetSmallMem();
+
+  arena = iStrGetArena();
+  if (!arena)
+    return NULL;
+
+  index = arena->buffers_index;
+
+  if (arena->buffers_sizes[index] < size + 1)  /* allocate or reallocate if necessary */
+  {
+    char* new_buf = (char*)realloc(arena->buffers[index], size + 1);
+    if (!new_buf)
+      return NULL;
+    arena->buffers[index] = new_buf;
+    arena->buffers_sizes[index] = size + 1;
   }
 
-  /* always clear memory before returning a new buffer */
-  memset(buffers[buffers_index], 0, SMALL_SIZE);
-  ret_str = buffers[buffers_index];
+  ret_str = arena->buffers[index];
 
-  buffers_index++;
-  if (buffers_index == SMALL_MAX_BUFFERS)
-    buffers_index = 0;
+  arena->buffers_index++;
+  if (arena->buffers_index == ISTR_MEM_COUNT)
+    arena->buffers_index = 0;
 
   return ret_str;
-#undef SMALL_MAX_BUFFERS
-#undef SMALL_SIZE
 }
 
 IUP_SDK_API char *iupStrGetMemory(int size)
 {
-#define MAX_BUFFERS 50
-  static char* buffers[MAX_BUFFERS];
-  static int buffers_sizes[MAX_BUFFERS];
-  static int buffers_index = -1;
+  char* ret_str;
 
   if (size == -1) /* Frees memory */
   {
-    int i;
-    buffers_index = -1;
-    for (i = 0; i < MAX_BUFFERS; i++)
-    {
-      if (buffers[i])
-      {
-        free(buffers[i]);
-        buffers[i] = NULL;
-      }
-      buffers_sizes[i] = 0;
-    }
+    iStrReleaseArena();
     return NULL;
   }
-  else
-  {
-    char* ret_str;
 
-    /* init buffers array */
-    if (buffers_index == -1)
-    {
-      memset(buffers, 0, sizeof(char*)*MAX_BUFFERS);
-      memset(buffers_sizes, 0, sizeof(int)*MAX_BUFFERS);
-      buffers_index = 0;
-    }
+  ret_str = iStrGetMem(size);
 
-    /* first allocation */
-    if (!(buffers[buffers_index]))
-    {
-      buffers_sizes[buffers_index] = size+1;
-      buffers[buffers_index] = (char*)malloc(buffers_sizes[buffers_index]);
-    }
-    else if (buffers_sizes[buffers_index] < size+1)  /* reallocate if necessary */
-    {
-      char* new_buf = (char*)realloc(buffers[buffers_index], size+1);
-      if (!new_buf)
-        return NULL;
-      buffers[buffers_index] = new_buf;
-      buffers_sizes[buffers_index] = size+1;
-    }
+  /* clear only the requested memory, callers may rely on it */
+  if (ret_str)
+    memset(ret_str, 0, size + 1);
 
-    /* always clear memory before returning a new buffer */
-    memset(buffers[buffers_index], 0, buffers_sizes[buffers_index]);
-    ret_str = buffers[buffers_index];
+  return ret_str;
+}
 
-    buffers_index++;
-    if (buffers_index == MAX_BUFFERS)
-      buffers_index = 0;
+/* faster than snprintf "%d" and "%u" */
+static char* iStrFormatUInt(char* str, unsigned int u, int negative)
+{
+  char digits[12];
+  int n = 0;
 
-    return ret_str;
-  }
-#undef MAX_BUFFERS
+  do
+  {
+    digits[n++] = (char)('0' + (u % 10));
+    u /= 10;
+  } while (u);
+
+  if (negative)
+    *str++ = '-';
+  while (n)
+    *str++ = digits[--n];
+  *str = 0;
+  return str;
+}
+
+static char* iStrFormatInt(char* str, int i)
+{
+  if (i < 0)
+    return iStrFormatUInt(str, 0u - (unsigned int)i, 1);
+  else
+    return iStrFormatUInt(str, (unsigned int)i, 0);
 }
 
+/* integral values that "%.9g" and "%.17g" would write without exponent */
+#define iStrIsSmallIntegral(_d) ((_d) > -1e9 && (_d) < 1e9 && (_d) == (double)(int)(_d) && ((_d) != 0 || 1/(_d) > 0))
+
 IUP_SDK_API char* iupStrReturnStrf(const char* format, ...)
 {
-  char* str = iupStrGetMemory(10240);
+  char* str = iStrGetSmallMem();
+  int size;
   va_list arglist;
+
+  if (!str)
+    return NULL;
+
   va_start(arglist, format);
-  vsnprintf(str, 10240, format, arglist);
+  size = vsnprintf(str, ISTR_SMALL_SIZE, format, arglist);
   va_end(arglist);
+
+  if (size >= ISTR_SMALL_SIZE)  /* did not fit, format again in a larger buffer */
+  {
+    if (size > 10240 - 1)
+      size = 10240 - 1;   /* same limit as before */
+
+    str = iStrGetMem(size);
+    if (!str)
+      return NULL;
+
+    va_start(arglist, format);
+    vsnprintf(str, size + 1, format, arglist);
+    va_end(arglist);
+  }
+  else if (size < 0)
+    str[0] = 0;
+
   return str;
 }
 
@@ -465,7 +612,9 @@ IUP_SDK_API char* iupStrReturnStr(const char* str)
   if (str)
   {
     int size = (int)strlen(str)+1;
-    char* ret_str = iupStrGetMemory(size);
+    char* ret_str = iStrGetMem(size);
+    if (!ret_str)
+      return NULL;
     memcpy(ret_str, str, size);
     return ret_str;
   }
@@ -493,43 +642,66 @@ IUP_SDK_API char* iupStrReturnChecked(int check)
 
 IUP_SDK_API char* iupStrReturnUInt(unsigned int i)
 {
-  char* str = iupStrGetSmallMem();  /* 20 */
-  snprintf(str, 80, "%u", i);
+  char* str = iStrGetSmallMem();  /* 20 */
+  if (str)
+    iStrFormatUInt(str, i, 0);
   return str;
 }
 
 IUP_SDK_API char* iupStrReturnInt(int i)
 {
-  char* str = iupStrGetSmallMem();  /* 20 */
-  snprintf(str, 80, "%d", i);
+  char* str = iStrGetSmallMem();  /* 20 */
+  if (str)
+    iStrFormatInt(str, i);
   return str;
 }
 
 IUP_SDK_API char* iupStrReturnFloat(float f)
 {
-  char* str = iupStrGetSmallMem();  /* 80 */
-  snprintf(str, 80, IUP_FLOAT2STR, f);
+  char* str = iStrGetSmallMem();  /* 80 */
+  if (!str)
+    return NULL;
+  if (iStrIsSmallIntegral((double)f))
+    iStrFormatInt(str, (int)f);
+  else
+    snprintf(str, ISTR_SMALL_SIZE, IUP_FLOAT2STR, f);
   return str;
 }
 
 IUP_SDK_API char* iupStrReturnDouble(double d)
 {
-  char* str = iupStrGetSmallMem();  /* 80 */
-  snprintf(str, 80, IUP_DOUBLE2STR, d);
+  char* str = iStrGetSmallMem();  /* 80 */
+  if (!str)
+    return NULL;
+  if (iStrIsSmallIntegral(d))
+    iStrFormatInt(str, (int)d);
+  else
+    snprintf(str, ISTR_SMALL_SIZE, IUP_DOUBLE2STR, d);
   return str;
 }
 
 IUP_SDK_API char* iupStrReturnRGB(unsigned char r, unsigned char g, unsigned char b)
 {
-  char* str = iupStrGetSmallMem();  /* 3*20 */
-  snprintf(str, 80, "%d %d %d", (int)r, (int)g, (int)b);
+  char* str = iStrGetSmallMem();  /* 3*20 */
+  char* p = str;
+  if (!str)
+    return NULL;
+  p = iStrFormatUInt(p, r, 0); *p++ = ' ';
+  p = iStrFormatUInt(p, g, 0); *p++ = ' ';
+  iStrFormatUInt(p, b, 0);
   return str;
 }
 
 IUP_SDK_API char* iupStrReturnRGBA(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
 {
-  char* str = iupStrGetSmallMem();  /* 4*20 */
-  snprintf(str, 80, "%d %d %d %d", (int)r, (int)g, (int)b, (int)a);
+  char* str = iStrGetSmallMem();  /* 4*20 */
+  char* p = str;
+  if (!str)
+    return NULL;
+  p = iStrFormatUInt(p, r, 0); *p++ = ' ';
+  p = iStrFormatUInt(p, g, 0); *p++ = ' ';
+  p = iStrFormatUInt(p, b, 0); *p++ = ' ';
+  iStrFormatUInt(p, a, 0);
   return str;
 }
 
@@ -541,7 +713,9 @@ IUP_SDK_API char* iupStrReturnStrStr(const char *str1, const char *str2, char se
     int size1=0, size2=0;
     if (str1) size1 = (int)strlen(str1);
     if (str2) size2 = (int)strlen(str2);
-    ret_str = iupStrGetMemory(size1+size2+2);
+    ret_str = iStrGetMem(size1+size2+2);
+    if (!ret_str)
+      return NULL;
     if (str1 && size1) memcpy(ret_str, str1, size1);
     ret_str[size1] = sep;
     if (str2 && size2) memcpy(ret_str+size1+1, str2, size2);
@@ -554,8 +728,13 @@ IUP_SDK_API char* iupStrReturnStrStr(const char *str1, const char *str2, char se
 
 IUP_SDK_API char* iupStrReturnIntInt(int i1, int i2, char sep)
 {
-  char* str = iupStrGetSmallMem();  /* 2*20 */
-  snprintf(str, 80, "%d%c%d", i1, sep, i2);
+  char* str = iStrGetSmallMem();  /* 2*20 */
+  char* p;
+  if (!str)
+    return NULL;
+  p = iStrFormatInt(str, i1);
+  *p++ = sep;
+  iStrFormatInt(p, i2);
   return str;
 }
 
@@ -1544,6 +1723,68 @@ IUP_SDK_API int iupStrCompare(const char *l, const char *r, int casesensitive, i
   return 0;
 }
 
+/* Key values: 0 is the terminator, 1 starts a number followed by the number of significant digits plus 1 and the digits,
+   other characters are their position in the map plus 2. So numbers are before text and shorter strings are first. */
+IUP_SDK_API int iupStrCompareKey(const char* str, unsigned short* key, int casesensitive, int utf8)
+{
+  unsigned char* map;
+  int n = 0;
+
+  if (!Latin1_map)
+    iStrInitLatin1_map();
+
+  map = casesensitive ? Latin1_map : Latin1_map_nocase;
+
+  if (str)
+  {
+    while (*str)
+    {
+      if (iup_isdigit(*str))
+      {
+        int len_pos;
+
+        /* skip leading zeros */
+        while (*str == '0') str++;
+
+        key[n++] = 1;
+        len_pos = n++;
+
+        while (*str && iup_isdigit(*str))
+        {
+          key[n++] = (unsigned char)*str;
+          str++;
+        }
+
+        key[len_pos] = (unsigned short)(n - len_pos);  /* never 0 */
+      }
+      else
+      {
+        char c = *str;
+
+        if (utf8)
+          c = iStrUTF8toLatin1(&str);  /* increment n-1 an utf8 character */
+
+        key[n++] = (unsigned short)(map[(unsigned char)c] + 2);
+        str++;
+      }
+    }
+  }
+
+  key[n++] = 0;
+  return n;
+}
+
+IUP_SDK_API int iupStrCompareKeyCmp(const unsigned short* key1, const unsigned short* key2)
+{
+  while (*key1 && *key1 == *key2)
+  {
+    key1++;
+    key2++;
+  }
+
+  return (int)*key1 - (int)*key2;
+}
+
 IUP_SDK_API int iupStrCompareEqual(const char *l, const char *r, int casesensitive, int utf8, int partial)
 {
   if (!l || !r)
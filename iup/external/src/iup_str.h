@@ -96,14 +96,17 @@ IUP_SDK_API char* iupStrDupUntil(const char **str, char c);
  * \ingroup str */
 IUP_SDK_API void iupStrCopyN(char* dst_str, int dst_max_size, const char* src_str);
 
-/** Returns a buffer with the specified size+1. \n
- * The buffer is reused after 50 calls. It must NOT be freed.
- * Use size=-1 to free all the internal buffers.
+/** Returns a buffer with the specified size+1, filled with zeros. \n
+ * The buffer is reused after 50 calls in the same thread. It must NOT be freed. \n
+ * Each thread has its own buffers, so it can be used from worker threads.
+ * The buffers of a thread are freed when the thread ends.
+ * Use size=-1 to free all the internal buffers of the current thread.
  * \ingroup str */
 IUP_SDK_API char* iupStrGetMemory(int size);
 
 /** Returns a very large buffer to be used in unknown size string construction.
- * Use snprintf or vsnprintf with the given size.
+ * Use snprintf or vsnprintf with the given size. The buffer is not cleared.
+ * It is reused after 10 calls in the same thread.
  * \ingroup str */
 IUP_SDK_API char* iupStrGetLargeMem(int *size);
 
@@ -372,6 +375,16 @@ IUP_SDK_API int iupStrFindMnemonic(const char* str);
  * \ingroup str */
 IUP_SDK_API int iupStrCompare(const char* str1, const char* str2, int casesensitive, int utf8);
 
+/** Builds a key for the string that, compared value by value with \ref iupStrCompareKeyCmp,
+ *  gives the same order as \ref iupStrCompare. Useful to sort many strings without converting them at each comparison. \n
+ *  key must have room for 3*strlen(str)+1 values. Returns the number of values including the terminator.
+ * \ingroup str */
+IUP_SDK_API int iupStrCompareKey(const char* str, unsigned short* key, int casesensitive, int utf8);
+
+/** Compares two keys built by \ref iupStrCompareKey, returns <0, 0 or >0 like strcmp.
+ * \ingroup str */
+IUP_SDK_API int iupStrCompareKeyCmp(const unsigned short* key1, const unsigned short* key2);
+
 /** Returns a non-zero value if the two strings are equal. \n
  *  If partial=1 the compare up to a number of characters defined by the strlen of the second string. \n
  *  Case-insensitive will work only for Latin-1 characters, even when using utf8=1.
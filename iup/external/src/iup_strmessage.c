@@ -12,6 +12,7 @@
 #include "iup.h"
 
 #include "iup_object.h"
+#include "iup_attrib.h"
 #include "iup_str.h"
 #include "iup_strmessage.h"
 #include "iup_hashtable.h"
@@ -59,17 +60,17 @@ IUP_API void IupSetLanguagePack(Ihandle* ih)
   {
     char *name, *value;
 
-    name = iupTableFirst(ih->attrib);
+    name = iupAttribFirst(ih);
     while (name)
     {
-      value = (char*)iupTableGetCurr(ih->attrib);
+      value = (char*)iupAttribGetCurr(ih);
 
-      if (iupTableGetCurrType(ih->attrib)==IUPTABLE_STRING)
+      if (iupAttribGetCurrType(ih)==IUPTABLE_STRING)
         iupTableSet(istrmessage_table, name, value, IUPTABLE_STRING);
       else
         iupTableSet(istrmessage_table, name, value, IUPTABLE_POINTER);
 
-      name = iupTableNext(ih->attrib);
+      name = iupAttribNext(ih);
     }
   }
 }
@@ -10,13 +10,14 @@
 #include "iup.h"
 
 #include "iup_object.h"
+#include "iup_attrib.h"
 #include "iup_stdcontrols.h"
 
 
 static int iUserSetClearAttributesAttrib(Ihandle* ih, const char* value)
 {
   (void)value;
-  iupTableClear(ih->attrib);
+  iupAttribClear(ih);
   return 0;
 }
 
@@ -581,6 +581,66 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
     free(pnt);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  int i;
+  XPoint stack_pnt[256];
+  XPoint* pnt;
+  int use_heap = 0;
+
+  if (count < 2)
+    return;
+
+  if (count <= 256)
+    pnt = stack_pnt;
+  else
+  {
+    pnt = (XPoint*)malloc(count * sizeof(XPoint));
+    if (!pnt)
+      return;
+    use_heap = 1;
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    pnt[i].x = (short)points[2*i];
+    pnt[i].y = (short)points[2*i+1];
+  }
+
+  if (motDrawAlphaColor(dc, color))
+  {
+    ImotAlphaMask m;
+    int bx1 = pnt[0].x, by1 = pnt[0].y, bx2 = pnt[0].x, by2 = pnt[0].y;
+    for (i = 1; i < count; i++)
+    {
+      if (pnt[i].x < bx1) bx1 = pnt[i].x;
+      if (pnt[i].y < by1) by1 = pnt[i].y;
+      if (pnt[i].x > bx2) bx2 = pnt[i].x;
+      if (pnt[i].y > by2) by2 = pnt[i].y;
+    }
+    if (motDrawAlphaMaskBegin(dc, &m, bx1, by1, bx2, by2, line_width))
+    {
+      iDrawSetLineStyleAndWidth(m.gc, style, line_width);
+      XDrawLines(iupmot_display, m.pixmap, m.gc, pnt, count, CoordModeOrigin);
+      motDrawAlphaMaskEnd(dc, &m, color);
+    }
+
+    if (use_heap)
+      free(pnt);
+    return;
+  }
+
+  XSetForeground(iupmot_display, dc->pixmap_gc, iupmotColorGetPixel(iupDrawRed(color),iupDrawGreen(color),iupDrawBlue(color)));
+
+  iDrawSetLineStyleAndWidth(dc->pixmap_gc, style, line_width);
+
+  /* a single request, so X joins the segments and continues the dashes */
+  XDrawLines(iupmot_display, dc->pixmap, dc->pixmap_gc, pnt, count, CoordModeOrigin);
+
+  if (use_heap)
+    free(pnt);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   if (motDrawAlphaColor(dc, color))
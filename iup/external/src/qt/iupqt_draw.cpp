@@ -586,6 +586,54 @@ extern "C" IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int
   }
 }
 
+/****************************************************************************
+ * Polyline Draw
+ ****************************************************************************/
+
+extern "C" IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  if (!dc || !dc->painter || count < 2)
+    return;
+
+  QColor qcolor;
+  qtDrawGetColor(color, qcolor);
+
+  QPolygon polyline;
+  polyline.reserve(count);
+  for (int i = 0; i < count; i++)
+    polyline << QPoint(points[i * 2], points[i * 2 + 1]);
+
+  QPen pen(qcolor);
+  pen.setWidth(line_width);
+
+  switch (style)
+  {
+    case IUP_DRAW_STROKE_DASH:
+      pen.setStyle(Qt::DashLine);
+      break;
+    case IUP_DRAW_STROKE_DOT:
+      pen.setStyle(Qt::DotLine);
+      break;
+    case IUP_DRAW_STROKE_DASH_DOT:
+      pen.setStyle(Qt::DashDotLine);
+      break;
+    case IUP_DRAW_STROKE_DASH_DOT_DOT:
+      pen.setStyle(Qt::DashDotDotLine);
+      break;
+    default:
+      pen.setStyle(Qt::SolidLine);
+      break;
+  }
+
+  pen.setCapStyle(Qt::FlatCap);
+  pen.setJoinStyle(Qt::MiterJoin);
+
+  /* a single polyline, so the joins and the dash pattern are continuous */
+  dc->painter->setPen(pen);
+  dc->painter->setBrush(Qt::NoBrush);
+  dc->painter->drawPolyline(polyline);
+}
+
 /****************************************************************************
  * Pixel Draw
  ****************************************************************************/
@@ -161,6 +161,17 @@ EM_JS(void, iupwasmJsDrawPolygon, (int cid, int ptr, int count, int r, int g, in
   }
 })
 
+EM_JS(void, iupwasmJsDrawPolyline, (int cid, int ptr, int count, int r, int g, int b, int a, int style, int lw), {
+  var ctx = globalThis.__iupCtx(cid); if (!ctx) return;
+  ctx.beginPath();
+  ctx.moveTo(HEAP32[ptr >> 2], HEAP32[(ptr >> 2) + 1]);
+  for (var i = 1; i < count; i++)
+    ctx.lineTo(HEAP32[(ptr >> 2) + 2 * i], HEAP32[(ptr >> 2) + 2 * i + 1]);
+  globalThis.__iupDash(ctx, style, lw);
+  ctx.strokeStyle = globalThis.__iupRGBA(r, g, b, a);
+  ctx.stroke();
+})
+
 EM_JS(void, iupwasmJsDrawPixel, (int cid, int x, int y, int r, int g, int b, int a), {
   var ctx = globalThis.__iupCtx(cid); if (!ctx) return;
   ctx.setLineDash([]);
@@ -424,6 +435,13 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
   iupwasmJsDrawPolygon(dc->cid, (int)(intptr_t)points, count, iupDrawRed(color), iupDrawGreen(color), iupDrawBlue(color), iupDrawAlpha(color), style, line_width);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  if (!points || count < 2)
+    return;
+  iupwasmJsDrawPolyline(dc->cid, (int)(intptr_t)points, count, iupDrawRed(color), iupDrawGreen(color), iupDrawBlue(color), iupDrawAlpha(color), style, line_width);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   iupwasmJsDrawPixel(dc->cid, x, y, iupDrawRed(color), iupDrawGreen(color), iupDrawBlue(color), iupDrawAlpha(color));
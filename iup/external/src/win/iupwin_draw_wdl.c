@@ -373,6 +373,37 @@ IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int count, long
   wdDestroyBrush(brush);
 }
 
+IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  WD_HBRUSH brush;
+  WD_HPATH path;
+  WD_PATHSINK sink;
+  WD_HSTROKESTYLE stroke_style;
+  int i;
+
+  if (count < 2)
+    return;
+
+  brush = wdCreateSolidBrush(dc->hCanvas, iupColor2ARGB(color));
+
+  path = wdCreatePath(dc->hCanvas);
+  wdOpenPathSink(&sink, path);
+
+  wdBeginFigure(&sink, iupInt2Float(points[0]), iupInt2Float(points[1]));
+  for (i = 2; i < count * 2; i = i + 2)
+    wdAddLine(&sink, iupInt2Float(points[i]), iupInt2Float(points[i + 1]));
+
+  /* open figure, the last point is not connected to the first */
+  wdEndFigure(&sink, FALSE);
+  wdClosePathSink(&sink);
+
+  stroke_style = iCreateStrokeStyle(style);
+  wdDrawPathStyled(dc->hCanvas, brush, path, iupInt2FloatW(line_width), stroke_style);
+
+  wdDestroyPath(path);
+  wdDestroyBrush(brush);
+}
+
 IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   WD_HBRUSH brush = wdCreateSolidBrush(dc->hCanvas, iupColor2ARGB(color));
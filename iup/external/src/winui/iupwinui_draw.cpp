@@ -645,6 +645,38 @@ extern "C" IUP_SDK_API void iupdrvDrawPolygon(IdrawCanvas* dc, int* points, int
   }
 }
 
+extern "C" IUP_SDK_API void iupdrvDrawPolyline(IdrawCanvas* dc, int* points, int count, long color, int style, int line_width)
+{
+  if (!dc || !dc->d2dContext || count < 2)
+    return;
+
+  dc->solidBrush->SetColor(winuiDrawColor(color));
+
+  com_ptr<ID2D1PathGeometry> pathGeometry;
+  g_d2dFactory->CreatePathGeometry(pathGeometry.put());
+
+  com_ptr<ID2D1GeometrySink> sink;
+  pathGeometry->Open(sink.put());
+
+  sink->BeginFigure(D2D1::Point2F((float)points[0], (float)points[1]), D2D1_FIGURE_BEGIN_HOLLOW);
+
+  for (int i = 1; i < count; i++)
+    sink->AddLine(D2D1::Point2F((float)points[2 * i], (float)points[2 * i + 1]));
+
+  sink->EndFigure(D2D1_FIGURE_END_OPEN);
+  sink->Close();
+
+  if (style == IUP_DRAW_STROKE || style == IUP_DRAW_FILL)
+  {
+    dc->d2dContext->DrawGeometry(pathGeometry.get(), dc->solidBrush.get(), (float)line_width);
+  }
+  else
+  {
+    auto strokeStyle = winuiDrawStrokeStyle(style);
+    dc->d2dContext->DrawGeometry(pathGeometry.get(), dc->solidBrush.get(), (float)line_width, strokeStyle);
+  }
+}
+
 extern "C" IUP_SDK_API void iupdrvDrawPixel(IdrawCanvas* dc, int x, int y, long color)
 {
   if (!dc || !dc->d2dContext)
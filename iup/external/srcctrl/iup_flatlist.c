@@ -776,6 +776,46 @@ static void iFlatListScrollFocusVisible(Ihandle* ih)
   }
 }
 
+static int iFlatListGetFirstSelected(Ihandle* ih)
+{
+  iFlatListItem* items = (iFlatListItem*)iupArrayGetData(ih->data->items_array);
+  int i, count = iupArrayCount(ih->data->items_array);
+
+  for (i = 0; i < count; i++)
+  {
+    if (items[i].selected)
+      return i + 1;
+  }
+
+  return 0;
+}
+
+static void iFlatListUpdateFocusChange(Ihandle* ih, int old_focus_pos, int old_selected_pos, int old_posy)
+{
+  int item_height = ih->data->line_height + ih->data->spacing;
+  int posy = IupGetInt(ih, "POSY");
+  int pos1, pos2, y1, y2;
+
+  /* when scrolled or with multiple selection the whole list may have changed */
+  if (posy != old_posy || ih->data->is_multiple)
+  {
+    IupUpdate(ih);
+    return;
+  }
+
+  pos1 = ih->data->focus_pos;
+  pos2 = ih->data->focus_pos;
+  if (old_focus_pos > 0 && old_focus_pos < pos1) pos1 = old_focus_pos;
+  if (old_focus_pos > pos2) pos2 = old_focus_pos;
+  if (old_selected_pos > 0 && old_selected_pos < pos1) pos1 = old_selected_pos;
+  if (old_selected_pos > pos2) pos2 = old_selected_pos;
+
+  /* redraw only the area of the items that changed */
+  y1 = ih->data->border_width - posy + (pos1 - 1) * item_height;
+  y2 = ih->data->border_width - posy + pos2 * item_height - 1;
+  IupSetStrf(ih, "UPDATERECT", "%d %d %d %d", 0, y1, ih->currentwidth - 1, y2);
+}
+
 static int iFlatListKUp_CB(Ihandle* ih)
 {
   if (ih->data->has_focus)
@@ -784,11 +824,14 @@ static int iFlatListKUp_CB(Ihandle* ih)
     {
       int ctrlPressed = 0; /* behave as no ctrl key pressed when using arrow keys */
       int shftPressed = IupGetInt(NULL, "SHIFTKEY");
+      int old_focus_pos = ih->data->focus_pos;
+      int old_selected_pos = iFlatListGetFirstSelected(ih);
+      int old_posy = IupGetInt(ih, "POSY");
 
       iFlatListSelectItem(ih, ih->data->focus_pos - 1, ctrlPressed, shftPressed);
 
       iFlatListScrollFocusVisible(ih);
-      IupUpdate(ih);
+      iFlatListUpdateFocusChange(ih, old_focus_pos, old_selected_pos, old_posy);
     }
   }
   return IUP_DEFAULT;
@@ -803,11 +846,14 @@ static int iFlatListKDown_CB(Ihandle* ih)
     {
       int ctrlPressed = 0; /* behave as no ctrl key pressed when using arrow keys */
       int shftPressed = IupGetInt(NULL, "SHIFTKEY");
+      int old_focus_pos = ih->data->focus_pos;
+      int old_selected_pos = iFlatListGetFirstSelected(ih);
+      int old_posy = IupGetInt(ih, "POSY");
 
       iFlatListSelectItem(ih, ih->data->focus_pos + 1, ctrlPressed, shftPressed);
 
       iFlatListScrollFocusVisible(ih);
-      IupUpdate(ih);
+      iFlatListUpdateFocusChange(ih, old_focus_pos, old_selected_pos, old_posy);
     }
   }
   return IUP_DEFAULT;
@@ -848,11 +894,14 @@ static int iFlatListKAny_CB(Ihandle* ih, int c)
     {
       int ctrlPressed = 0; /* behave as no ctrl key pressed when using arrow keys */
       int shftPressed = IupGetInt(NULL, "SHIFTKEY");
+      int old_focus_pos = ih->data->focus_pos;
+      int old_selected_pos = iFlatListGetFirstSelected(ih);
+      int old_posy = IupGetInt(ih, "POSY");
 
       iFlatListSelectItem(ih, pos, ctrlPressed, shftPressed);
 
       iFlatListScrollFocusVisible(ih);
-      IupUpdate(ih);
+      iFlatListUpdateFocusChange(ih, old_focus_pos, old_selected_pos, old_posy);
     }
   }
   return IUP_CONTINUE;
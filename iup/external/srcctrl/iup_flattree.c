@@ -1240,24 +1240,28 @@ static int iFlatTreeDrawNodes(Ihandle *ih, IdrawCanvas* dc, iFlatTreeNode *node,
     /* guidelines */
     if (node->depth != 0 && !hide_lines)
     {
-      int px1 = (node_x - (ih->data->indentation / 2)) + 1;
-      int py1 = node_y + node_h / 2;
-      int px2 = node_x;
-      int py2 = py1;  /* horizontal line */
-      if (py1 > 0 && py1 < ih->currentheight)
-        iupdrvDrawLine(dc, px1, py1, px2, py2, line_rgba, IUP_DRAW_STROKE_DOT, 1);
-
-      if (!node->brother)  /* on the last child draw the vertical line */
+      int px = node_x - (ih->data->indentation / 2);
+      int py = node_y + node_h / 2;
+
+      if (!node->brother)  /* on the last child draw the vertical and the horizontal lines as a single stroke */
       {
-        px1 = node_x - (ih->data->indentation / 2);
-        py1 = y - ih->data->spacing;
-        px2 = px1;   /* vertical line */
-        py2 = node_y + node_h / 2;
+        int py1 = y - ih->data->spacing;
         if ((py1 >= 0 && py1 < ih->currentheight) ||
-            (py2 >= 0 && py2 < ih->currentheight) ||
-            (py1 < 0 && py2 >= ih->currentheight))
-          iupdrvDrawLine(dc, px1, py1, px2, py2, line_rgba, IUP_DRAW_STROKE_DOT, 1);
+            (py >= 0 && py < ih->currentheight) ||
+            (py1 < 0 && py >= ih->currentheight))
+        {
+          int points[6];
+          points[0] = px;
+          points[1] = py1;
+          points[2] = px;
+          points[3] = py;
+          points[4] = node_x;
+          points[5] = py;
+          iupdrvDrawPolyline(dc, points, 3, line_rgba, IUP_DRAW_STROKE_DOT, 1);
+        }
       }
+      else if (py > 0 && py < ih->currentheight)  /* horizontal line */
+        iupdrvDrawLine(dc, px + 1, py, node_x, py, line_rgba, IUP_DRAW_STROKE_DOT, 1);
     }
 
     if (node_y + node_h > 0 && node_y < ih->currentheight)
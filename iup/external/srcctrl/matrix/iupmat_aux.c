@@ -18,6 +18,7 @@
 #include "iupmat_aux.h"
 #include "iupmat_getset.h"
 #include "iupmat_numlc.h"
+#include "iupmat_mem.h"
 
 
 int iupMatrixAuxCanvasPx(int hw)
@@ -477,6 +478,9 @@ void iupMatrixAuxCopyCol(Ihandle* ih, int from_col, int to_col)
   int old_undo = ih->data->undo_redo;
   ih->data->undo_redo = 0;
 
+  if (ih->data->values)
+    iupMatrixMemSetStorage(ih, to_col, ih->data->values[from_col].type);
+
   for(lin = 0; lin < lines_num; lin++)
     iMatrixAuxCopyValue(ih, lin, from_col, lin, to_col);
 
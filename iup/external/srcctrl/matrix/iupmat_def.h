@@ -64,10 +64,25 @@ typedef double (*ImatNumericConvertFunc)(double number, int quantity, int src_un
 /***************************************************************************/
 typedef struct _ImatCell
 {
-  char *value;          /* Cell value */
   unsigned char flags;  /* Attribute flags for the cell */
 } ImatCell;
 
+/* Storage of the values of a column, see the STORAGE attribute */
+#define IMAT_STORE_TEXT    0  /* one allocated string for each cell (default) */
+#define IMAT_STORE_DOUBLE  1  /* double for each cell, empty cells are NaN */
+#define IMAT_STORE_INT64   2  /* 64 bits integer for each cell, empty cells are INT64_MIN */
+#define IMAT_STORE_STRING  3  /* int index of an interned string for each cell, empty cells are 0 */
+
+typedef struct _ImatColumnValues
+{
+  unsigned char type;    /* IMAT_STORE_* */
+  char* title;           /* value of line 0, always stored as text */
+  void* data;            /* one item for each allocated line, item 0 is not used */
+  char** strings;        /* IMAT_STORE_STRING, strings[0] is always NULL */
+  int strings_count, strings_alloc;
+  Itable* strings_table; /* IMAT_STORE_STRING, index of each string */
+} ImatColumnValues;
+
 typedef struct _ImatLinCol
 {
   int size;             /* Width/height of the column/line */
@@ -117,7 +132,10 @@ struct _IcontrolData
 {
   iupCanvas canvas; /* from IupCanvas (must reserve it) */
 
-  ImatCell** cells; /* Cell value, this will be NULL if in callback mode (allocated after map) */
+  ImatCell** cells; /* Cell flags, this will be NULL if in callback mode (allocated after map),
+                       all lines are in a single block starting at cells[0] */
+  ImatColumnValues* values; /* Cell values of each column, this will be NULL if in callback mode (allocated after map) */
+  char value_buffer[50];    /* value of cells that are not stored as text, IMAT_VALUE_BUFFER_SIZE */
 
   Ihandle* texth;   /* Text handle                    */
   Ihandle* droph;   /* Dropdown handle                */
@@ -136,9 +154,11 @@ struct _IcontrolData
   int callback_mode;
   int need_calcsize;
   int need_redraw;
+  int bulk_load;   /* BULKLOAD=YES, drawing and size calculation are postponed */
   int inside_markedit_cb;   /* avoid recursion */
   int inside_scroll_update;  /* ignore SCROLL_CB when setting DX/DY programmatically */
   int last_sort_col;
+  unsigned int values_version;  /* changed when cell values are set, moved or sorted */
 
   /* attributes */
   int mark_continuous, mark_mode, mark_multiple;
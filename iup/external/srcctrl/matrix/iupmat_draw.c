@@ -1622,23 +1622,78 @@ static void iMatrixDrawMatrix(Ihandle* ih)
   }
 }
 
+static int iMatrixDrawClampVisible(ImatLinColData* p, int *i1, int *i2)
+{
+  /* restrict the range to the non scrollable and the visible scrollable items */
+  if (*i1 < 0) *i1 = 0;
+  if (*i2 > p->num - 1) *i2 = p->num - 1;
+  if (*i2 >= p->num_noscroll && *i2 > p->last) *i2 = p->last;
+  if (*i1 >= p->num_noscroll && *i1 < p->first) *i1 = p->first;
+  if (*i2 >= p->num_noscroll && *i2 < p->first) *i2 = p->num_noscroll - 1;
+  return *i1 <= *i2;
+}
+
+static void iMatrixDrawPostRect(Ihandle* ih, int lin1, int col1, int lin2, int col2)
+{
+  int x1, y1, x2, y2, w, h;
+
+  if (!ih->handle)
+    return;
+
+  if (ih->data->need_calcsize || ih->data->merge_info_count)
+  {
+    iupdrvPostRedraw(ih);
+    return;
+  }
+
+  if (!iMatrixDrawClampVisible(&(ih->data->lines), &lin1, &lin2) ||
+      !iMatrixDrawClampVisible(&(ih->data->columns), &col1, &col2))
+    return;
+
+  iupMatrixGetVisibleCellDim(ih, lin1, col1, &x1, &y1, &w, &h);
+  iupMatrixGetVisibleCellDim(ih, lin2, col2, &x2, &y2, &w, &h);
+  x2 += w;  /* include the frame lines */
+  y2 += h;
+
+  IupSetStrf(ih, "UPDATERECT", "%d %d %d %d", x1, y1, x2, y2);
+}
+
+/* Outside the ACTION callback the cells are not drawn,
+   only their area is posted to be redrawn by the next ACTION. */
+
 void iupMatrixDrawCells(Ihandle* ih, int lin1, int col1, int lin2, int col2)
 {
-  iMatrixDrawCells(ih, lin1, col1, lin2, col2);
+  if (!iupAttribGet(ih, "_IUP_DRAW_DC"))
+    iMatrixDrawPostRect(ih, lin1, col1, lin2, col2);
+  else
+    iMatrixDrawCells(ih, lin1, col1, lin2, col2);
 }
 
 void iupMatrixDrawTitleColumns(Ihandle* ih, int col1, int col2)
 {
-  iMatrixDrawTitleColumns(ih, col1, col2);
+  if (!iupAttribGet(ih, "_IUP_DRAW_DC"))
+    iMatrixDrawPostRect(ih, 0, col1, 0, col2);
+  else
+    iMatrixDrawTitleColumns(ih, col1, col2);
 }
 
 void iupMatrixDrawTitleLines(Ihandle* ih, int lin1, int lin2)
 {
-  iMatrixDrawTitleLines(ih, lin1, lin2);
+  if (!iupAttribGet(ih, "_IUP_DRAW_DC"))
+    iMatrixDrawPostRect(ih, lin1, 0, lin2, 0);
+  else
+    iMatrixDrawTitleLines(ih, lin1, lin2);
 }
 
 void iupMatrixDraw(Ihandle* ih, int update)
 {
+  if (ih->data->bulk_load)
+  {
+    /* will draw when the bulk load ends */
+    ih->data->need_redraw = 1;
+    return;
+  }
+
   /* For IupDraw system: Just clear the flag, actual drawing happens in iupMatrixDrawCB (ACTION callback) */
   ih->data->need_redraw = 0;
 
@@ -19,6 +19,7 @@
 #include "iupmat_def.h"
 #include "iupmat_getset.h"
 #include "iupmat_draw.h"
+#include "iupmat_sort.h"
 
 
 /* Exported to IupMatrixEx */
@@ -36,6 +37,13 @@ void iupMatrixExSetCellValue(Ihandle* ih, int lin, int col, const char* value)
   iupMatrixModifyValue(ih, lin, col, value);
 }
 
+/* Exported to IupMatrixEx */
+unsigned int iupMatrixExGetValuesVersion(Ihandle* ih)
+{
+  /* changes in callback mode are not known */
+  return ih->data->values_version;
+}
+
 static int iMatrixInitNumericColumns(Ihandle* ih, int col)
 {
   if (!iupMATRIX_CHECK_COL(ih, col))
@@ -159,72 +167,45 @@ static int iMatrixSetNumericUnitShownIndexAttrib(Ihandle* ih, int col, const cha
   return 0;
 }
 
-static IFniii   iMatrixQSort_sort_cb = NULL;
-static Ihandle* iMatrixQSort_ih = NULL;
-static int      iMatrixQSort_col = 0;
-
-static int iMatrixCompareCallbackFunc(const void* elem1, const void* elem2)
+static void iMatrixInitSortLineIndex(Ihandle* ih)
 {
-  int lin1 = *((int*)elem1);
-  int lin2 = *((int*)elem2);
-  return iMatrixQSort_sort_cb(iMatrixQSort_ih, iMatrixQSort_col, lin1, lin2);
-}
+  /* Notice that sort_line_index[0] is always 0 */
 
-typedef struct _ImatSortNumber {
-  int lin;
-  double number;
-} ImatSortNumber;
+  ih->data->values_version++;  /* the lines will be reordered */
 
-static int iMatrixCompareNumberFunc(const void* elem1, const void* elem2)
-{
-  ImatSortNumber* num1 = (ImatSortNumber*)elem1;
-  ImatSortNumber* num2 = (ImatSortNumber*)elem2;
-  if (num1->number < num2->number)
-    return -1;
-  if (num1->number > num2->number)
-    return 1;
-  return 0;
-}
-
-static int iMatrixQSort_utf8 = 0;
-static int iMatrixQSort_casesensitive = 1;
+  if (!ih->data->sort_line_index)
+    ih->data->sort_line_index = (int*)calloc(ih->data->lines.num_alloc, sizeof(int));
 
-typedef struct _ImatSortText {
-  int lin;
-  char* text;
-} ImatSortText;
+  if (!ih->data->sort_has_index)
+  {
+    int lin;
+    for (lin = 0; lin < ih->data->lines.num; lin++)
+      ih->data->sort_line_index[lin] = lin;
+  }
+}
 
-static int iMatrixCompareTextFunc(const void* elem1, const void* elem2)
+static void iMatrixSetSortSign(Ihandle* ih, int col, int ascending)
 {
-  ImatSortText* txt1 = (ImatSortText*)elem1;
-  ImatSortText* txt2 = (ImatSortText*)elem2;
-  if ((!txt1->text || txt1->text[0]==0) && (!txt2->text || txt2->text[0]==0)) return 0;
-  if (!txt1->text || txt1->text[0]==0) return -1;    /* txt1 < txt2 => -1 */
-  if (!txt2->text || txt2->text[0]==0) return 1;
-  return iupStrCompare(txt1->text, txt2->text, iMatrixQSort_casesensitive, iMatrixQSort_utf8);
+  iupAttribSetId(ih, "SORTSIGN", ih->data->last_sort_col, NULL);
+  if (ascending)
+    iupAttribSetId(ih, "SORTSIGN", col, "DOWN");
+  else
+    iupAttribSetId(ih, "SORTSIGN", col, "UP");
+
+  ih->data->sort_has_index = 1;
+  ih->data->last_sort_col = col;
 }
 
 static int iMatrixSetSortColumnAttrib(Ihandle* ih, int col, const char* value)
 {
-  int lines_num = ih->data->lines.num;
-  int lin, lin1=1, lin2=lines_num-1;   /* ALL */
+  int lin1=1, lin2=ih->data->lines.num-1;   /* ALL */
   int ascending;
   int* sort_line_index;
-  IFniii sort_cb;
-
-  /* Notice that sort_line_index[0] is always 0 */
-
-  if (!ih->data->sort_line_index)
-    ih->data->sort_line_index = (int*)calloc(ih->data->lines.num_alloc, sizeof(int));
+  ImatSortKey key;
 
+  iMatrixInitSortLineIndex(ih);
   sort_line_index = ih->data->sort_line_index;
 
-  if (!ih->data->sort_has_index)
-  {
-    for (lin = 0; lin < lines_num; lin++)
-      sort_line_index[lin] = lin;
-  }
-
   if (iupStrEqualNoCase(value, "RESET"))
   {
     ih->data->sort_has_index = 0;
@@ -270,82 +251,72 @@ static int iMatrixSetSortColumnAttrib(Ihandle* ih, int col, const char* value)
   iupAttribSetStrf(ih, "SORTCOLUMNINTERVAL", "%d,%d", lin1, lin2);
 
   if (lin1 < 1) lin1 = 1;
+  if (lin2 > ih->data->lines.num-1) lin2 = ih->data->lines.num-1;
   if (lin2 < lin1) lin2 = lin1;
 
   ascending = iupStrEqualNoCase(iupAttribGetStr(ih, "SORTCOLUMNORDER"), "ASCENDING");
 
-  sort_cb = (IFniii)IupGetCallback(ih, "SORTCOLUMNCOMPARE_CB");
-  if (sort_cb)
-  {
-    iMatrixQSort_sort_cb = sort_cb;
-    iMatrixQSort_ih = ih;
-    iMatrixQSort_col = col;
-    qsort(sort_line_index+lin1,lin2-lin1+1,sizeof(int),iMatrixCompareCallbackFunc);
-  }
-  else
-  {
-    if (ih->data->numeric_columns && ih->data->numeric_columns[col].flags & IMAT_IS_NUMERIC)
-    {
-      ImatSortNumber* sort_line_number = (ImatSortNumber*)malloc((lin2-lin1+1)*sizeof(ImatSortNumber));
+  key.col = col;
+  key.descending = !ascending;
 
-      for (lin=lin1; lin<=lin2; lin++)
-      {
-        sort_line_number[lin-lin1].lin = sort_line_index[lin];
-        sort_line_number[lin-lin1].number = iupMatrixGetValueNumeric(ih, lin, col);
-      }
+  /* the callback defines the order, as in previous versions */
+  if (IupGetCallback(ih, "SORTCOLUMNCOMPARE_CB"))
+    key.descending = 0;
 
-      qsort(sort_line_number,lin2-lin1+1,sizeof(ImatSortNumber), iMatrixCompareNumberFunc);
+  iupMatrixSortLines(ih, &key, 1, lin1, lin2);
 
-      for (lin=lin1; lin<=lin2; lin++)
-      {
-        if (ascending)
-          sort_line_index[lin] = sort_line_number[lin-lin1].lin;
-        else
-          sort_line_index[lin2 - (lin-lin1)] = sort_line_number[lin-lin1].lin;
-      }
+  iMatrixSetSortSign(ih, col, ascending);
+  iupMatrixDraw(ih, 1);
+  return 0;
+}
 
-      free(sort_line_number);
-    }
-    else
+static int iMatrixSetSortColumnsAttrib(Ihandle* ih, const char* value)
+{
+  ImatSortKey keys[IMAT_SORT_MAX_KEYS];
+  int count = 0, lin2 = ih->data->lines.num - 1;
+
+  /* "col[:ASC|:DESC],col[:ASC|:DESC],..." */
+  while (value && *value && count < IMAT_SORT_MAX_KEYS)
+  {
+    char item[50];
+    const char* next = strchr(value, ',');
+    int len = next ? (int)(next - value) : (int)strlen(value);
+    char* order;
+    int col;
+
+    if (len >= (int)sizeof(item))
+      len = (int)sizeof(item) - 1;
+    memcpy(item, value, len);
+    item[len] = 0;
+
+    order = strchr(item, ':');
+    if (order)
     {
-      ImatSortText* sort_line_text = (ImatSortText*)malloc((lin2-lin1+1)*sizeof(ImatSortText));
+      *order = 0;
+      order++;
+    }
 
-      for (lin=lin1; lin<=lin2; lin++)
-      {
-        sort_line_text[lin-lin1].lin = sort_line_index[lin];
-        sort_line_text[lin-lin1].text = iupMatrixGetValueDisplay(ih, lin, col);
+    value = next ? next + 1 : NULL;
 
-        if (ih->data->callback_mode)
-          sort_line_text[lin-lin1].text = iupStrDup(sort_line_text[lin-lin1].text);
-      }
+    /* an invalid column is skipped, the other keys are still used */
+    if (!iupStrToInt(item, &col) || !iupMATRIX_CHECK_COL(ih, col))
+      continue;
 
-      iMatrixQSort_utf8 = IupGetInt(NULL, "UTF8MODE");
-      iMatrixQSort_casesensitive = iupAttribGetInt(ih, "SORTCOLUMNCASESENSITIVE");
-      qsort(sort_line_text,lin2-lin1+1,sizeof(ImatSortText), iMatrixCompareTextFunc);
+    keys[count].col = col;
+    keys[count].descending = (order && (iupStrEqualNoCase(order, "DESC") || iupStrEqualNoCase(order, "DESCENDING")));
+    count++;
+  }
 
-      for (lin=lin1; lin<=lin2; lin++)
-      {
-        if (ascending)
-          sort_line_index[lin] = sort_line_text[lin-lin1].lin;
-        else
-          sort_line_index[lin2 - (lin-lin1)] = sort_line_text[lin-lin1].lin;
+  if (count == 0)
+    return 0;
 
-        if (ih->data->callback_mode && sort_line_text[lin-lin1].text)
-          free(sort_line_text[lin-lin1].text);
-      }
+  iMatrixInitSortLineIndex(ih);
 
-      free(sort_line_text);
-    }
-  }
+  iupAttribSetStrf(ih, "SORTCOLUMNINTERVAL", "%d,%d", 1, lin2);
 
-  iupAttribSetId(ih, "SORTSIGN", ih->data->last_sort_col, NULL);
-  if (ascending)
-    iupAttribSetId(ih, "SORTSIGN", col, "DOWN");
-  else
-    iupAttribSetId(ih, "SORTSIGN", col, "UP");
+  iupMatrixSortLines(ih, keys, count, 1, lin2);
 
-  ih->data->sort_has_index = 1;
-  ih->data->last_sort_col = col;
+  iMatrixSetSortSign(ih, keys[0].col, !keys[0].descending);
   iupMatrixDraw(ih, 1);
   return 0;
 }
@@ -397,6 +368,7 @@ void iupMatrixRegisterEx(Iclass* ic)
   /* IupMatrixEx Attributes - Sort Columns */
   iupClassRegisterAttribute(ic, "LASTSORTCOLUMN", iMatrixGetLastSortColumnAttrib, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NOT_MAPPED | IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId(ic, "SORTCOLUMN", NULL, iMatrixSetSortColumnAttrib, IUPAF_WRITEONLY|IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "SORTCOLUMNS", NULL, iMatrixSetSortColumnsAttrib, NULL, NULL, IUPAF_WRITEONLY|IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "SORTCOLUMNORDER", NULL, NULL, IUPAF_SAMEASSYSTEM, "ASCENDING",  IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "SORTCOLUMNCASESENSITIVE", NULL, NULL, IUPAF_SAMEASSYSTEM, "YES", IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "SORTCOLUMNINTERVAL", NULL, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NO_INHERIT);
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
+#include <string.h>
 
 #include "iup.h"
 #include "iupcbs.h"
@@ -23,6 +24,7 @@
 #include "iupmat_def.h"
 #include "iupmat_getset.h"
 #include "iupmat_aux.h"
+#include "iupmat_mem.h"
 
 
 int iupMatrixCheckCellPos(Ihandle* ih, int lin, int col)
@@ -80,13 +82,22 @@ void iupMatrixSetValue(Ihandle* ih, int lin, int col, const char* value, int use
 {
   /* NOTICE: this function is NOT called before map */
   char* old_value = NULL;
+  char value_buffer[IMAT_VALUE_BUFFER_SIZE];
 
-  if (ih->data->undo_redo) old_value = iupMatrixGetValue(ih, lin, col);
+  if (value == ih->data->value_buffer)
+  {
+    /* the value of another cell that is not stored as text, it will be replaced by old_value */
+    strcpy(value_buffer, value);
+    value = value_buffer;
+  }
+
+  /* values loaded in bulk are not recorded for undo */
+  if (ih->data->undo_redo && !ih->data->bulk_load) old_value = iupMatrixGetValue(ih, lin, col);
 
   if (lin != 0 && ih->data->sort_has_index)
     lin = ih->data->sort_line_index[lin];
 
-  if (ih->data->undo_redo) iupAttribSetClassObjectId2(ih, "UNDOPUSHCELL", lin, col, old_value);
+  if (ih->data->undo_redo && !ih->data->bulk_load) iupAttribSetClassObjectId2(ih, "UNDOPUSHCELL", lin, col, old_value);
 
   if (value && ih->data->numeric_columns && ih->data->numeric_columns[col].flags & IMAT_IS_NUMERIC)
   {
@@ -96,12 +107,7 @@ void iupMatrixSetValue(Ihandle* ih, int lin, int col, const char* value, int use
   }
 
   if (!ih->data->callback_mode)
-  {
-    if (ih->data->cells[lin][col].value)
-      free(ih->data->cells[lin][col].value);
-
-    ih->data->cells[lin][col].value = iupStrDup(value);
-  }
+    iupMatrixMemSetValue(ih, lin, col, value);
 
   if (user_edited)
   {
@@ -113,6 +119,7 @@ void iupMatrixSetValue(Ihandle* ih, int lin, int col, const char* value, int use
       value_edit_cb(ih, lin, col, (char*)value);
   }
 
+  ih->data->values_version++;
   ih->data->need_redraw = 1;
   if (lin == 0 || col == 0)
     ih->data->need_calcsize = 1;
@@ -135,25 +142,52 @@ static char* iMatrixGetValueText(Ihandle* ih, int lin, int col)
       value = NULL; /* application error!!!! value_cb must exist */
   }
   else
-    value = ih->data->cells[lin][col].value;
+    value = iupMatrixMemGetValue(ih, lin, col);
 
   return value;
 }
 
+static int iMatrixGetValueStoredNumber(Ihandle* ih, int lin, int col, double* number)
+{
+  /* Returns -1 if the number must be obtained from the text value,
+     0 if the cell is empty, or 1 if the number is stored in the column */
+
+  if (ih->data->callback_mode || !iupMATRIX_STORES_NUMBER(ih, col) || IupGetCallback(ih, "TRANSLATEVALUE_CB"))
+    return -1;
+
+  if (lin != 0 && ih->data->sort_has_index)
+    lin = ih->data->sort_line_index[lin];
+
+  return iupMatrixMemGetNumber(ih, lin, col, number);
+}
+
 double iupMatrixGetValueNumeric(Ihandle* ih, int lin, int col)
 {
-  sIFniis translate_cb;
   double number;
 
   /* here lin!=0 */
 
-  char* value = iMatrixGetValueText(ih, lin, col);
+  int ret = iMatrixGetValueStoredNumber(ih, lin, col, &number);
+  if (ret == -1)
+  {
+    sIFniis translate_cb;
+    char* value = iMatrixGetValueText(ih, lin, col);
 
-  translate_cb = (sIFniis)IupGetCallback(ih, "TRANSLATEVALUE_CB");
-  if (translate_cb)
-    value = translate_cb(ih, lin, col, value);
+    translate_cb = (sIFniis)IupGetCallback(ih, "TRANSLATEVALUE_CB");
+    if (translate_cb)
+      value = translate_cb(ih, lin, col, value);
 
-  if (!value)
+    if (value)
+    {
+      if (!iupStrToDouble(value, &number))
+        return 0;
+      ret = 1;
+    }
+    else
+      ret = 0;
+  }
+
+  if (!ret)
   {
     dIFnii getvalue_cb = (dIFnii)IupGetCallback(ih, "NUMERICGETVALUE_CB");
     if (getvalue_cb)
@@ -161,11 +195,6 @@ double iupMatrixGetValueNumeric(Ihandle* ih, int lin, int col)
     else
       return 0;
   }
-  else
-  {
-    if (!iupStrToDouble(value, &number))
-      return 0;
-  }
 
   if (ih->data->numeric_columns[col].unit_shown != ih->data->numeric_columns[col].unit)
     number = ih->data->numeric_convert_func(number, ih->data->numeric_columns[col].quantity,
@@ -239,9 +268,27 @@ static char* iMatrixGetValueNumericTitle(Ihandle* ih, int col, const char* value
   return (char*)value;
 }
 
-static char* iMatrixGetValueNumericFormatted(Ihandle* ih, int lin, int col, const char* value)
+static char* iMatrixGetNumberFormatted(Ihandle* ih, int col, double number)
 {
   char *format = NULL;
+
+  if (ih->data->numeric_columns[col].unit_shown != ih->data->numeric_columns[col].unit)
+    number = ih->data->numeric_convert_func(number, ih->data->numeric_columns[col].quantity,
+    ih->data->numeric_columns[col].unit, /* from */
+    ih->data->numeric_columns[col].unit_shown);  /* to */
+
+  if (ih->data->numeric_columns[col].flags & IMAT_HAS_FORMAT)
+    format = iupAttribGetId(ih, "NUMERICFORMAT", col);
+
+  if (format == NULL)
+    format = iupMatrixGetNumericFormatDef(ih);
+
+  iupStrPrintfDoubleLocale(ih->data->numeric_buffer_get, format, number, IupGetAttribute(ih, "NUMERICDECIMALSYMBOL"));  /* this will also check for global "DEFAULTDECIMALSYMBOL" */
+  return ih->data->numeric_buffer_get;
+}
+
+static char* iMatrixGetValueNumericFormatted(Ihandle* ih, int lin, int col, const char* value)
+{
   double number;
 
   /* here lin!=0 */
@@ -260,19 +307,7 @@ static char* iMatrixGetValueNumericFormatted(Ihandle* ih, int lin, int col, cons
       return (char*)value;
   }
 
-  if (ih->data->numeric_columns[col].unit_shown != ih->data->numeric_columns[col].unit)
-    number = ih->data->numeric_convert_func(number, ih->data->numeric_columns[col].quantity,
-    ih->data->numeric_columns[col].unit, /* from */
-    ih->data->numeric_columns[col].unit_shown);  /* to */
-
-  if (ih->data->numeric_columns[col].flags & IMAT_HAS_FORMAT)
-    format = iupAttribGetId(ih, "NUMERICFORMAT", col);
-
-  if (format == NULL)
-    format = iupMatrixGetNumericFormatDef(ih);
-
-  iupStrPrintfDoubleLocale(ih->data->numeric_buffer_get, format, number, IupGetAttribute(ih, "NUMERICDECIMALSYMBOL"));  /* this will also check for global "DEFAULTDECIMALSYMBOL" */
-  return ih->data->numeric_buffer_get;
+  return iMatrixGetNumberFormatted(ih, col, number);
 }
 
 char* iupMatrixGetValueDisplay(Ihandle* ih, int lin, int col)
@@ -283,8 +318,17 @@ char* iupMatrixGetValueDisplay(Ihandle* ih, int lin, int col)
   else
   {
     sIFniis translate_cb;
+    char* value;
 
-    char* value = iMatrixGetValueText(ih, lin, col);
+    if (lin != 0 && ih->data->numeric_columns && ih->data->numeric_columns[col].flags & IMAT_IS_NUMERIC)
+    {
+      /* format the stored number, without converting it to text first */
+      double number;
+      if (iMatrixGetValueStoredNumber(ih, lin, col, &number) == 1)
+        return iMatrixGetNumberFormatted(ih, col, number);
+    }
+
+    value = iMatrixGetValueText(ih, lin, col);
 
     translate_cb = (sIFniis)IupGetCallback(ih, "TRANSLATEVALUE_CB");
     if (translate_cb)
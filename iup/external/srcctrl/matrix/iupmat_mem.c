@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include <memory.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
 
 #include "iup.h"
 
@@ -23,11 +25,379 @@
 #include "iupmat_mem.h"
 
 
+#define IMAT_INT64_EMPTY INT64_MIN
+
+
+/**************************************************************************/
+/*  Column Values Storage                                                 */
+/**************************************************************************/
+
+static double iMatrixStoreEmptyDouble(void)
+{
+  /* quiet NaN */
+  uint64_t bits = 0x7FF8000000000000ULL;
+  double d;
+  memcpy(&d, &bits, sizeof(double));
+  return d;
+}
+
+/* only spaces can follow the number, "12abc" is not a number */
+static int iMatrixStoreIsNumberEnd(const char* value, const char* end)
+{
+  if (end == value)
+    return 0;
+  while (*end == ' ' || *end == '\t' || *end == '\r' || *end == '\n')
+    end++;
+  return *end == 0;
+}
+
+static size_t iMatrixStoreItemSize(int type)
+{
+  switch (type)
+  {
+  case IMAT_STORE_DOUBLE: return sizeof(double);
+  case IMAT_STORE_INT64:  return sizeof(int64_t);
+  case IMAT_STORE_STRING: return sizeof(int);
+  default:                return sizeof(char*);
+  }
+}
+
+/* set the items as empty, does not release memory */
+static void iMatrixStoreReset(ImatColumnValues* values, int lin, int count)
+{
+  int i;
+
+  switch (values->type)
+  {
+  case IMAT_STORE_DOUBLE:
+    {
+      double* data = (double*)values->data + lin;
+      double empty = iMatrixStoreEmptyDouble();
+      for (i = 0; i < count; i++)
+        data[i] = empty;
+      break;
+    }
+  case IMAT_STORE_INT64:
+    {
+      int64_t* data = (int64_t*)values->data + lin;
+      for (i = 0; i < count; i++)
+        data[i] = IMAT_INT64_EMPTY;
+      break;
+    }
+  default:
+    memset((char*)values->data + lin * iMatrixStoreItemSize(values->type), 0, count * iMatrixStoreItemSize(values->type));
+    break;
+  }
+}
+
+/* release the text of the items and set them as empty */
+static void iMatrixStoreRelease(ImatColumnValues* values, int lin, int count)
+{
+  if (values->type == IMAT_STORE_TEXT)
+  {
+    char** data = (char**)values->data + lin;
+    int i;
+    for (i = 0; i < count; i++)
+    {
+      if (data[i])
+        free(data[i]);
+    }
+  }
+
+  iMatrixStoreReset(values, lin, count);
+}
+
+static void iMatrixStoreAlloc(ImatColumnValues* values, int type, int num_alloc)
+{
+  values->type = (unsigned char)type;
+  values->data = malloc(num_alloc * iMatrixStoreItemSize(type));
+  iMatrixStoreReset(values, 0, num_alloc);
+}
+
+static void iMatrixStoreReAlloc(ImatColumnValues* values, int old_alloc, int num_alloc)
+{
+  values->data = realloc(values->data, num_alloc * iMatrixStoreItemSize(values->type));
+  iMatrixStoreReset(values, old_alloc, num_alloc - old_alloc);
+}
+
+static void iMatrixStoreFree(ImatColumnValues* values, int num_alloc)
+{
+  if (values->data)
+  {
+    iMatrixStoreRelease(values, 0, num_alloc);
+    free(values->data);
+  }
+
+  if (values->title)
+    free(values->title);
+
+  if (values->strings)
+  {
+    int i;
+    for (i = 1; i < values->strings_count; i++)
+      free(values->strings[i]);
+    free(values->strings);
+  }
+
+  if (values->strings_table)
+    iupTableDestroy(values->strings_table);
+
+  memset(values, 0, sizeof(ImatColumnValues));
+}
+
+/* free all the memory and restart as an empty text column */
+static void iMatrixStoreClearColumn(ImatColumnValues* values, int num_alloc)
+{
+  iMatrixStoreFree(values, num_alloc);
+  iMatrixStoreAlloc(values, IMAT_STORE_TEXT, num_alloc);
+}
+
+static int iMatrixStoreInternString(ImatColumnValues* values, const char* value)
+{
+  int index;
+
+  if (!values->strings_table)
+    values->strings_table = iupTableCreate(IUPTABLE_STRINGINDEXED);
+
+  index = (int)(intptr_t)iupTableGet(values->strings_table, value);
+  if (index)
+    return index;
+
+  if (values->strings_count == values->strings_alloc)
+  {
+    values->strings_alloc = values->strings_alloc ? 2 * values->strings_alloc : 64;
+    values->strings = (char**)realloc(values->strings, values->strings_alloc * sizeof(char*));
+    if (values->strings_count == 0)
+      values->strings[values->strings_count++] = NULL;  /* 0 is the empty cell */
+  }
+
+  index = values->strings_count++;
+  values->strings[index] = iupStrDup(value);
+  iupTableSet(values->strings_table, value, (void*)(intptr_t)index, IUPTABLE_POINTER);
+  return index;
+}
+
+static const char* iMatrixStoreGet(ImatColumnValues* values, int lin, char* buffer)
+{
+  if (lin == 0)
+    return values->title;
+
+  switch (values->type)
+  {
+  case IMAT_STORE_DOUBLE:
+    {
+      double number = ((double*)values->data)[lin];
+      double check;
+      if (number != number)  /* NaN */
+        return NULL;
+
+      /* the shortest format that keeps the number */
+      snprintf(buffer, IMAT_VALUE_BUFFER_SIZE, "%.15g", number);
+      if (!iupStrToDouble(buffer, &check) || check != number)
+        snprintf(buffer, IMAT_VALUE_BUFFER_SIZE, IUP_DOUBLE2STR, number);
+      return buffer;
+    }
+  case IMAT_STORE_INT64:
+    {
+      int64_t number = ((int64_t*)values->data)[lin];
+      if (number == IMAT_INT64_EMPTY)
+        return NULL;
+      snprintf(buffer, IMAT_VALUE_BUFFER_SIZE, "%lld", (long long)number);
+      return buffer;
+    }
+  case IMAT_STORE_STRING:
+    return values->strings ? values->strings[((int*)values->data)[lin]] : NULL;
+  default:
+    return ((char**)values->data)[lin];
+  }
+}
+
+static void iMatrixStoreSet(ImatColumnValues* values, int lin, const char* value)
+{
+  if (lin == 0)
+  {
+    if (values->title)
+      free(values->title);
+    values->title = iupStrDup(value);
+    return;
+  }
+
+  switch (values->type)
+  {
+  case IMAT_STORE_DOUBLE:
+    {
+      double number = iMatrixStoreEmptyDouble();
+      if (value)
+      {
+        char* end;
+        double d = strtod(value, &end);
+        if (iMatrixStoreIsNumberEnd(value, end))
+          number = d;
+      }
+      ((double*)values->data)[lin] = number;
+      break;
+    }
+  case IMAT_STORE_INT64:
+    {
+      int64_t number = IMAT_INT64_EMPTY;
+      if (value)
+      {
+        char* end;
+        long long ll;
+        errno = 0;
+        ll = strtoll(value, &end, 10);
+        if (iMatrixStoreIsNumberEnd(value, end) && errno != ERANGE)
+          number = (int64_t)ll;
+      }
+      ((int64_t*)values->data)[lin] = number;
+      break;
+    }
+  case IMAT_STORE_STRING:
+    ((int*)values->data)[lin] = (value && *value) ? iMatrixStoreInternString(values, value) : 0;
+    break;
+  default:
+    {
+      char** data = (char**)values->data;
+      if (data[lin])
+        free(data[lin]);
+      data[lin] = iupStrDup(value);
+      break;
+    }
+  }
+}
+
+/* move columns from [src, src+count) to dst, the columns at dst are moved to the opened space.
+   So each column keeps its own memory. */
+static void iMatrixStoreRotateColumns(ImatColumnValues* values, int dst, int src, int count, int shift_num)
+{
+  ImatColumnValues* tmp = (ImatColumnValues*)malloc(count * sizeof(ImatColumnValues));
+  memcpy(tmp, values + src, count * sizeof(ImatColumnValues));
+  if (dst < src)
+    memmove(values + dst + count, values + dst, shift_num * sizeof(ImatColumnValues));
+  else
+    memmove(values + src, values + src + count, shift_num * sizeof(ImatColumnValues));
+  memcpy(values + dst, tmp, count * sizeof(ImatColumnValues));
+  free(tmp);
+}
+
+char* iupMatrixMemGetValue(Ihandle* ih, int lin, int col)
+{
+  return (char*)iMatrixStoreGet(ih->data->values + col, lin, ih->data->value_buffer);
+}
+
+const char* iupMatrixMemGetValueBuffer(Ihandle* ih, int lin, int col, char* buffer)
+{
+  return iMatrixStoreGet(ih->data->values + col, lin, buffer);
+}
+
+void iupMatrixMemSetValue(Ihandle* ih, int lin, int col, const char* value)
+{
+  iMatrixStoreSet(ih->data->values + col, lin, value);
+}
+
+int iupMatrixMemGetNumber(Ihandle* ih, int lin, int col, double* number)
+{
+  ImatColumnValues* values = ih->data->values + col;
+
+  if (lin == 0)
+    return 0;
+
+  if (values->type == IMAT_STORE_DOUBLE)
+  {
+    double d = ((double*)values->data)[lin];
+    if (d != d)  /* NaN */
+      return 0;
+    *number = d;
+    return 1;
+  }
+  else if (values->type == IMAT_STORE_INT64)
+  {
+    int64_t i = ((int64_t*)values->data)[lin];
+    if (i == IMAT_INT64_EMPTY)
+      return 0;
+    *number = (double)i;
+    return 1;
+  }
+
+  return 0;
+}
+
+void iupMatrixMemSetStorage(Ihandle* ih, int col, int type)
+{
+  ImatColumnValues* values = ih->data->values + col;
+  ImatColumnValues new_values;
+  char buffer[IMAT_VALUE_BUFFER_SIZE];
+  int lin;
+
+  if (values->type == type)
+    return;
+
+  ih->data->values_version++;  /* the display format may change */
+
+  memset(&new_values, 0, sizeof(ImatColumnValues));
+  iMatrixStoreAlloc(&new_values, type, ih->data->lines.num_alloc);
+
+  for (lin = 1; lin < ih->data->lines.num; lin++)
+    iMatrixStoreSet(&new_values, lin, iMatrixStoreGet(values, lin, buffer));
+
+  new_values.title = values->title;
+  values->title = NULL;
+
+  iMatrixStoreFree(values, ih->data->lines.num_alloc);
+  *values = new_values;
+}
+
+
+/**************************************************************************/
+/*  Matrix Memory                                                         */
+/**************************************************************************/
+
+/* grow the allocated space geometrically, so adding one line or column at a time is amortized */
+static int iMatrixMemGrowAlloc(int num_alloc, int num)
+{
+  int grow_alloc = num_alloc + num_alloc / 2;
+  if (grow_alloc < 5)
+    grow_alloc = 5;
+  return num > grow_alloc ? num : grow_alloc;
+}
+
+/* all the cells are stored in a single block starting at cells[0],
+   each line uses columns.num_alloc cells */
+static void iMatrixMemSetCellLines(Ihandle* ih, ImatCell* block)
+{
+  int lin;
+  for (lin = 0; lin < ih->data->lines.num_alloc; lin++)
+    ih->data->cells[lin] = block + (size_t)lin * ih->data->columns.num_alloc;
+}
+
+static size_t iMatrixMemCellLinesSize(Ihandle* ih, int count)
+{
+  return (size_t)count * ih->data->columns.num_alloc * sizeof(ImatCell);
+}
+
+int iupMatrixMemGetStorageType(const char* value)
+{
+  if (iupStrEqualNoCase(value, "DOUBLE"))
+    return IMAT_STORE_DOUBLE;
+  if (iupStrEqualNoCase(value, "INT64"))
+    return IMAT_STORE_INT64;
+  if (iupStrEqualNoCase(value, "STRING"))
+    return IMAT_STORE_STRING;
+  return IMAT_STORE_TEXT;
+}
+
 static void iMatrixGetInitialValues(Ihandle* ih)
 {
   int lin, col;
   char* value;
 
+  for (col=0; col<ih->data->columns.num; col++)
+  {
+    value = iupAttribGetId(ih, "STORAGE", col);
+    if (value)
+      iupMatrixMemSetStorage(ih, col, iupMatrixMemGetStorageType(value));
+  }
+
   for (lin=0; lin<ih->data->lines.num; lin++)
   {
     for (col=0; col<ih->data->columns.num; col++)
@@ -38,7 +408,7 @@ static void iMatrixGetInitialValues(Ihandle* ih)
         /* get the initial value and remove it from the hash table */
 
         if (*value)
-          ih->data->cells[lin][col].value = iupStrDup(value);
+          iupMatrixMemSetValue(ih, lin, col, value);
 
         iupAttribSetId2(ih, "", lin, col, NULL);
       }
@@ -58,11 +428,14 @@ void iupMatrixMemAlloc(Ihandle* ih)
 
   if (!ih->data->callback_mode)
   {
-    int lin;
+    int col;
+
+    ih->data->cells = (ImatCell**)malloc(ih->data->lines.num_alloc * sizeof(ImatCell*));
+    iMatrixMemSetCellLines(ih, (ImatCell*)calloc((size_t)ih->data->lines.num_alloc * ih->data->columns.num_alloc, sizeof(ImatCell)));
 
-    ih->data->cells = (ImatCell**)calloc(ih->data->lines.num_alloc, sizeof(ImatCell*));
-    for (lin = 0; lin < ih->data->lines.num_alloc; lin++)
-      ih->data->cells[lin] = (ImatCell*)calloc(ih->data->columns.num_alloc, sizeof(ImatCell));
+    ih->data->values = (ImatColumnValues*)calloc(ih->data->columns.num_alloc, sizeof(ImatColumnValues));
+    for (col = 0; col < ih->data->columns.num_alloc; col++)
+      iMatrixStoreAlloc(ih->data->values + col, IMAT_STORE_TEXT, ih->data->lines.num_alloc);
 
     iMatrixGetInitialValues(ih);
   }
@@ -78,25 +451,20 @@ void iupMatrixMemRelease(Ihandle* ih)
 {
   if (ih->data->cells)
   {
-    int lin, col;
-    for (lin = 0; lin < ih->data->lines.num_alloc; lin++)
-    {
-      for (col = 0; col < ih->data->columns.num_alloc; col++)
-      {
-        ImatCell* cell = &(ih->data->cells[lin][col]);
-        if (cell->value)
-        {
-          free(cell->value);
-          cell->value = NULL;
-        }
-      }
-      free(ih->data->cells[lin]);
-      ih->data->cells[lin] = NULL;
-    }
+    free(ih->data->cells[0]);  /* the block of all cells */
     free(ih->data->cells);
     ih->data->cells = NULL;
   }
 
+  if (ih->data->values)
+  {
+    int col;
+    for (col = 0; col < ih->data->columns.num_alloc; col++)
+      iMatrixStoreFree(ih->data->values + col, ih->data->lines.num_alloc);
+    free(ih->data->values);
+    ih->data->values = NULL;
+  }
+
   if (ih->data->columns.dt)
   {
     free(ih->data->columns.dt);
@@ -132,9 +500,12 @@ void iupMatrixMemRelease(Ihandle* ih)
 
 void iupMatrixMemReAllocLines(Ihandle* ih, int old_num, int num, int base)
 {
-  int end, diff_num, shift_num, lin;
+  int end, diff_num, shift_num, col;
+
+  ih->data->values_version++;
 
-  if (ih->data->undo_redo) iupAttribSetClassObject(ih, "UNDOCLEAR", NULL);
+  /* the undo stack is cleared once when the bulk load starts */
+  if (ih->data->undo_redo && !ih->data->bulk_load) iupAttribSetClassObject(ih, "UNDOCLEAR", NULL);
 
   /* base is the first line where the change started */
 
@@ -142,15 +513,19 @@ void iupMatrixMemReAllocLines(Ihandle* ih, int old_num, int num, int base)
   if (num > ih->data->lines.num_alloc)  /* this also implicates that num>old_num */
   {
     int old_alloc = ih->data->lines.num_alloc;
-    ih->data->lines.num_alloc = num;
+    ih->data->lines.num_alloc = iMatrixMemGrowAlloc(old_alloc, num);
 
     if (!ih->data->callback_mode)
     {
+      /* new space are allocated at the end, later we need to move the old data and clear the available space */
+      ImatCell* block = (ImatCell*)realloc(ih->data->cells[0], iMatrixMemCellLinesSize(ih, ih->data->lines.num_alloc));
+      memset(block + (size_t)old_alloc * ih->data->columns.num_alloc, 0, iMatrixMemCellLinesSize(ih, ih->data->lines.num_alloc - old_alloc));
+
       ih->data->cells = (ImatCell**)realloc(ih->data->cells, ih->data->lines.num_alloc*sizeof(ImatCell*));
+      iMatrixMemSetCellLines(ih, block);
 
-      /* new space are allocated at the end, later we need to move the old data and clear the available space */
-      for(lin = old_alloc; lin < num; lin++)
-        ih->data->cells[lin] = (ImatCell*)calloc(ih->data->columns.num_alloc, sizeof(ImatCell));
+      for (col = 0; col < ih->data->columns.num_alloc; col++)
+        iMatrixStoreReAlloc(ih->data->values + col, old_alloc, ih->data->lines.num_alloc);
     }
 
     ih->data->lines.dt = (ImatLinCol*)realloc(ih->data->lines.dt, ih->data->lines.num_alloc*sizeof(ImatLinCol));
@@ -172,15 +547,28 @@ void iupMatrixMemReAllocLines(Ihandle* ih, int old_num, int num, int base)
     if (shift_num)
     {
       if (!ih->data->callback_mode)
-        for (lin = shift_num-1; lin >= 0; lin--)   /* all columns, shift_num lines */
-          memmove(ih->data->cells[lin+end], ih->data->cells[lin+base], ih->data->columns.num_alloc*sizeof(ImatCell));
+      {
+        /* all columns, shift_num lines */
+        memmove(ih->data->cells[end], ih->data->cells[base], iMatrixMemCellLinesSize(ih, shift_num));
+
+        for (col = 0; col < ih->data->columns.num_alloc; col++)
+        {
+          ImatColumnValues* values = ih->data->values + col;
+          size_t size = iMatrixStoreItemSize(values->type);
+          memmove((char*)values->data + end*size, (char*)values->data + base*size, shift_num*size);
+        }
+      }
       memmove(ih->data->lines.dt+end, ih->data->lines.dt+base, shift_num*sizeof(ImatLinCol));
     }
 
     /* then clear the new space starting at base */
     if (!ih->data->callback_mode)
-      for (lin = 0; lin < diff_num; lin++)        /* all columns, diff_num lines */
-        memset(ih->data->cells[lin+base], 0, ih->data->columns.num_alloc*sizeof(ImatCell));
+    {
+      memset(ih->data->cells[base], 0, iMatrixMemCellLinesSize(ih, diff_num));  /* all columns, diff_num lines */
+
+      for (col = 0; col < ih->data->columns.num_alloc; col++)
+        iMatrixStoreReset(ih->data->values + col, base, diff_num);
+    }
     memset(ih->data->lines.dt+base, 0, diff_num*sizeof(ImatLinCol));
 
     /* reset sort indices */
@@ -195,36 +583,38 @@ void iupMatrixMemReAllocLines(Ihandle* ih, int old_num, int num, int base)
     /* release memory from the opened space */
     if (!ih->data->callback_mode)
     {
-      int col;
+      memset(ih->data->cells[base], 0, iMatrixMemCellLinesSize(ih, diff_num));  /* all columns, base-end lines */
 
-      for(lin = base; lin < end; lin++)   /* all columns, base-end lines */
-      {
-        for (col = 0; col < ih->data->columns.num_alloc; col++)
-        {
-          ImatCell* cell = &(ih->data->cells[lin][col]);
-          if (cell->value)
-          {
-            free(cell->value);
-            cell->value = NULL;
-          }
-          cell->flags = 0;
-        }
-      }
+      for (col = 0; col < ih->data->columns.num_alloc; col++)
+        iMatrixStoreRelease(ih->data->values + col, base, diff_num);
     }
 
     /* move the old data to opened space from end to base */
     if (shift_num)
     {
       if (!ih->data->callback_mode)
-        for (lin = 0; lin < shift_num; lin++) /* all columns, shift_num lines */
-          memmove(ih->data->cells[lin+base], ih->data->cells[lin+end], ih->data->columns.num_alloc*sizeof(ImatCell));
+      {
+        /* all columns, shift_num lines */
+        memmove(ih->data->cells[base], ih->data->cells[end], iMatrixMemCellLinesSize(ih, shift_num));
+
+        for (col = 0; col < ih->data->columns.num_alloc; col++)
+        {
+          ImatColumnValues* values = ih->data->values + col;
+          size_t size = iMatrixStoreItemSize(values->type);
+          memmove((char*)values->data + base*size, (char*)values->data + end*size, shift_num*size);
+        }
+      }
       memmove(ih->data->lines.dt+base, ih->data->lines.dt+end, shift_num*sizeof(ImatLinCol));
     }
 
     /* then clear the remaining space starting at num */
     if (!ih->data->callback_mode)
-      for (lin = 0; lin < diff_num; lin++)   /* all columns, diff_num lines */
-        memset(ih->data->cells[lin+num], 0, ih->data->columns.num_alloc*sizeof(ImatCell));
+    {
+      memset(ih->data->cells[num], 0, iMatrixMemCellLinesSize(ih, diff_num));  /* all columns, diff_num lines */
+
+      for (col = 0; col < ih->data->columns.num_alloc; col++)
+        iMatrixStoreReset(ih->data->values + col, num, diff_num);
+    }
     memset(ih->data->lines.dt+num, 0, diff_num*sizeof(ImatLinCol));
 
     /* reset sort indices */
@@ -236,21 +626,37 @@ void iupMatrixMemReAllocColumns(Ihandle* ih, int old_num, int num, int base)
 {
   int lin, end, diff_num, shift_num;
 
-  if (ih->data->undo_redo) iupAttribSetClassObject(ih, "UNDOCLEAR", NULL);
+  ih->data->values_version++;
+
+  /* the undo stack is cleared once when the bulk load starts */
+  if (ih->data->undo_redo && !ih->data->bulk_load) iupAttribSetClassObject(ih, "UNDOCLEAR", NULL);
 
   /* base is the first column where the change started */
 
   /* If it doesn't have enough columns allocated, then allocate more space */
   if (num > ih->data->columns.num_alloc)  /* this also implicates that also num>old_num */
   {
-    ih->data->columns.num_alloc = num;
+    int col, old_alloc = ih->data->columns.num_alloc;
+    ih->data->columns.num_alloc = iMatrixMemGrowAlloc(old_alloc, num);
 
     /* new space are allocated at the end, later we need to move the old data and clear the available space */
 
     if (!ih->data->callback_mode)
     {
-      for(lin = 0; lin < ih->data->lines.num_alloc; lin++)
-        ih->data->cells[lin] = (ImatCell*)realloc(ih->data->cells[lin], ih->data->columns.num_alloc*sizeof(ImatCell));
+      /* the lines are larger, so copy them to a new block */
+      ImatCell* old_block = ih->data->cells[0];
+      ImatCell* block = (ImatCell*)calloc((size_t)ih->data->lines.num_alloc * ih->data->columns.num_alloc, sizeof(ImatCell));
+      for (lin = 0; lin < ih->data->lines.num_alloc; lin++)
+        memcpy(block + (size_t)lin * ih->data->columns.num_alloc, ih->data->cells[lin], old_alloc * sizeof(ImatCell));
+      free(old_block);
+      iMatrixMemSetCellLines(ih, block);
+
+      ih->data->values = (ImatColumnValues*)realloc(ih->data->values, ih->data->columns.num_alloc*sizeof(ImatColumnValues));
+      for (col = old_alloc; col < ih->data->columns.num_alloc; col++)
+      {
+        memset(ih->data->values + col, 0, sizeof(ImatColumnValues));
+        iMatrixStoreAlloc(ih->data->values + col, IMAT_STORE_TEXT, ih->data->lines.num_alloc);
+      }
     }
 
     ih->data->columns.dt = (ImatLinCol*)realloc(ih->data->columns.dt, ih->data->columns.num_alloc*sizeof(ImatLinCol));
@@ -274,8 +680,13 @@ void iupMatrixMemReAllocColumns(Ihandle* ih, int old_num, int num, int base)
     if (shift_num)
     {
       if (!ih->data->callback_mode)
+      {
         for (lin = 0; lin < ih->data->lines.num_alloc; lin++)  /* all lines, shift_num columns */
           memmove(ih->data->cells[lin]+end, ih->data->cells[lin]+base, shift_num*sizeof(ImatCell));
+
+        /* the empty columns at the end are moved to the opened space */
+        iMatrixStoreRotateColumns(ih->data->values, base, old_num, diff_num, shift_num);
+      }
       memmove(ih->data->columns.dt+end, ih->data->columns.dt+base, shift_num*sizeof(ImatLinCol));
       if (ih->data->numeric_columns)
         memmove(ih->data->numeric_columns+end, ih->data->numeric_columns+base, shift_num*sizeof(ImatNumericData));
@@ -301,18 +712,10 @@ void iupMatrixMemReAllocColumns(Ihandle* ih, int old_num, int num, int base)
       int col;
 
       for (lin = 0; lin < ih->data->lines.num_alloc; lin++)  /* all lines, base-end columns */
-      {
-        for(col = base; col < end; col++)
-        {
-          ImatCell* cell = &(ih->data->cells[lin][col]);
-          if (cell->value)
-          {
-            free(cell->value);
-            cell->value = NULL;
-          }
-          cell->flags = 0;
-        }
-      }
+        memset(ih->data->cells[lin]+base, 0, diff_num*sizeof(ImatCell));
+
+      for (col = base; col < end; col++)
+        iMatrixStoreClearColumn(ih->data->values + col, ih->data->lines.num_alloc);
     }
 
     /* move the old data to opened space from end to base */
@@ -320,8 +723,13 @@ void iupMatrixMemReAllocColumns(Ihandle* ih, int old_num, int num, int base)
     if (shift_num)
     {
       if (!ih->data->callback_mode)
+      {
         for (lin = 0; lin < ih->data->lines.num_alloc; lin++)  /* all lines, shift_num columns */
           memmove(ih->data->cells[lin]+base, ih->data->cells[lin]+end, shift_num*sizeof(ImatCell));
+
+        /* the cleared columns are moved to the end */
+        iMatrixStoreRotateColumns(ih->data->values, num, base, diff_num, shift_num);
+      }
       memmove(ih->data->columns.dt+base, ih->data->columns.dt+end, shift_num*sizeof(ImatLinCol));
       if (ih->data->numeric_columns)
         memmove(ih->data->numeric_columns+base, ih->data->numeric_columns+end, shift_num*sizeof(ImatNumericData));
@@ -17,6 +17,22 @@ void iupMatrixMemRelease(Ihandle* ih);
 void iupMatrixMemReAllocLines  (Ihandle* ih, int old_num, int num, int base);
 void iupMatrixMemReAllocColumns(Ihandle* ih, int old_num, int num, int base);
 
+/* Values of the cells in normal mode, lin is the line in the original order.
+   Values of cells that are not stored as text are returned in a buffer. */
+char* iupMatrixMemGetValue(Ihandle* ih, int lin, int col);
+/* Same as iupMatrixMemGetValue, but uses the given buffer, so it can be called from other threads. */
+const char* iupMatrixMemGetValueBuffer(Ihandle* ih, int lin, int col, char* buffer);
+void  iupMatrixMemSetValue(Ihandle* ih, int lin, int col, const char* value);
+/* Returns 0 if the column does not store numbers or the cell is empty. */
+int   iupMatrixMemGetNumber(Ihandle* ih, int lin, int col, double* number);
+/* Converts the values already stored in the column. */
+void  iupMatrixMemSetStorage(Ihandle* ih, int col, int type);
+int   iupMatrixMemGetStorageType(const char* value);
+
+#define IMAT_VALUE_BUFFER_SIZE 50
+
+#define iupMATRIX_STORES_NUMBER(_ih, _col) ((_ih)->data->values && ((_ih)->data->values[_col].type == IMAT_STORE_DOUBLE || (_ih)->data->values[_col].type == IMAT_STORE_INT64))
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,547 @@
+/** \file
+ * \brief iupmatrix control
+ * sort lines by the values of one or more columns
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+/**************************************************************************/
+/*  The values of the sorted columns are converted once to keys that are  */
+/*  faster to compare: numbers or text keys. Then the lines are sorted    */
+/*  with a stable merge sort. The keys of large matrices are extracted by */
+/*  several threads when the values can be read directly.                 */
+/**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "iup.h"
+#include "iupcbs.h"
+
+#include "iup_object.h"
+#include "iup_attrib.h"
+#include "iup_str.h"
+
+#include "iupmat_def.h"
+#include "iupmat_getset.h"
+#include "iupmat_mem.h"
+#include "iupmat_sort.h"
+
+
+/* matrices with less lines are always processed in the calling thread */
+#define IMAT_SORT_THREAD_MIN_LINES 20000
+#define IMAT_SORT_THREAD_MAX       8
+
+/* size of the runs sorted by insertion before merging */
+#define IMAT_SORT_RUN 32
+
+enum { IMAT_SORT_NUMBER, IMAT_SORT_TEXT, IMAT_SORT_CALLBACK };
+
+typedef struct _ImatSortColumn {
+  int col;
+  int descending;
+  int type;
+  double* numbers;            /* IMAT_SORT_NUMBER, one for each position */
+  unsigned short** texts;     /* IMAT_SORT_TEXT, one for each position */
+  size_t* offsets;            /* offset of each text key in the storage of its job */
+  unsigned short* text_keys[IMAT_SORT_THREAD_MAX];  /* storage of the text keys of each job */
+  size_t text_size[IMAT_SORT_THREAD_MAX], text_alloc[IMAT_SORT_THREAD_MAX];
+} ImatSortColumn;
+
+typedef struct _ImatSortContext {
+  Ihandle* ih;
+  IFniii sort_cb;
+  int lin1;
+  int* lines;      /* original line of each position */
+  int read_cells;  /* cells can be read directly, without callbacks */
+  int casesensitive, utf8;
+  int count;
+  ImatSortColumn columns[IMAT_SORT_MAX_KEYS];
+} ImatSortContext;
+
+typedef struct _ImatSortJob {
+  ImatSortContext* ctx;
+  int index;
+  int p0, p1;   /* positions [p0,p1) */
+  int error;
+} ImatSortJob;
+
+
+/********************************************************************/
+/*  Key Extraction                                                  */
+/********************************************************************/
+
+static int iMatrixSortAddTextKey(ImatSortJob* job, ImatSortColumn* column, int p, const char* value)
+{
+  size_t len = value ? strlen(value) : 0;
+  size_t need = column->text_size[job->index] + 3 * len + 1;
+
+  if (need > column->text_alloc[job->index])
+  {
+    size_t new_alloc = column->text_alloc[job->index] * 2;
+    unsigned short* new_keys;
+
+    if (new_alloc < need)
+      new_alloc = need + 1024;
+
+    new_keys = (unsigned short*)realloc(column->text_keys[job->index], new_alloc * sizeof(unsigned short));
+    if (!new_keys)
+      return 0;
+
+    column->text_keys[job->index] = new_keys;
+    column->text_alloc[job->index] = new_alloc;
+  }
+
+  column->offsets[p] = column->text_size[job->index];
+  column->text_size[job->index] += iupStrCompareKey(value, column->text_keys[job->index] + column->text_size[job->index], job->ctx->casesensitive, job->ctx->utf8);
+  return 1;
+}
+
+static void iMatrixSortRunJob(ImatSortJob* job)
+{
+  ImatSortContext* ctx = job->ctx;
+  Ihandle* ih = ctx->ih;
+  char buffer[IMAT_VALUE_BUFFER_SIZE];
+  int k, p;
+
+  for (k = 0; k < ctx->count; k++)
+  {
+    ImatSortColumn* column = ctx->columns + k;
+    int col = column->col;
+
+    if (column->type == IMAT_SORT_CALLBACK)
+      continue;
+
+    for (p = job->p0; p < job->p1; p++)
+    {
+      if (column->type == IMAT_SORT_NUMBER)
+      {
+        if (ctx->read_cells)
+        {
+          double number;
+          if (iupMATRIX_STORES_NUMBER(ih, col))
+          {
+            if (!iupMatrixMemGetNumber(ih, ctx->lines[p], col, &number))
+              number = 0;
+          }
+          else if (!iupStrToDouble(iupMatrixMemGetValueBuffer(ih, ctx->lines[p], col, buffer), &number))
+            number = 0;
+          column->numbers[p] = number;
+        }
+        else
+          column->numbers[p] = iupMatrixGetValueNumeric(ih, ctx->lin1 + p, col);
+      }
+      else
+      {
+        const char* value;
+
+        if (ctx->read_cells)
+          value = iupMatrixMemGetValueBuffer(ih, ctx->lines[p], col, buffer);
+        else
+          value = iupMatrixGetValueDisplay(ih, ctx->lin1 + p, col);
+
+        if (!iMatrixSortAddTextKey(job, column, p, value))
+        {
+          job->error = 1;
+          return;
+        }
+      }
+    }
+  }
+}
+
+static int iMatrixSortCanReadCells(Ihandle* ih, ImatSortContext* ctx)
+{
+  int k;
+
+  /* values must not be returned by callbacks, that can be called only in the main thread */
+  if (!ih->handle || ih->data->callback_mode || !ih->data->values)
+    return 0;
+
+  if (IupGetCallback(ih, "TRANSLATEVALUE_CB"))
+    return 0;
+
+  for (k = 0; k < ctx->count; k++)
+  {
+    ImatSortColumn* column = ctx->columns + k;
+    if (column->type == IMAT_SORT_NUMBER)
+    {
+      int col = column->col;
+
+      if (IupGetCallback(ih, "NUMERICGETVALUE_CB"))
+        return 0;
+
+      if (ih->data->numeric_columns[col].unit_shown != ih->data->numeric_columns[col].unit)
+        return 0;
+    }
+  }
+
+  return 1;
+}
+
+static int iMatrixSortGetThreadCount(int lines)
+{
+  int count = 1;
+
+  if (lines < 2 * IMAT_SORT_THREAD_MIN_LINES)
+    return 1;
+
+#if defined(WIN32)
+  {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    count = (int)info.dwNumberOfProcessors;
+  }
+#elif !defined(__EMSCRIPTEN__) && defined(_SC_NPROCESSORS_ONLN)
+  count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+  if (count > IMAT_SORT_THREAD_MAX)
+    count = IMAT_SORT_THREAD_MAX;
+  if (count > lines / IMAT_SORT_THREAD_MIN_LINES)
+    count = lines / IMAT_SORT_THREAD_MIN_LINES;
+  if (count < 1)
+    count = 1;
+  return count;
+}
+
+#if defined(WIN32)
+static DWORD WINAPI iMatrixSortThreadFunc(LPVOID arg)
+{
+  iMatrixSortRunJob((ImatSortJob*)arg);
+  return 0;
+}
+#elif !defined(__EMSCRIPTEN__)
+static void* iMatrixSortThreadFunc(void* arg)
+{
+  iMatrixSortRunJob((ImatSortJob*)arg);
+  return NULL;
+}
+#endif
+
+static void iMatrixSortRunJobs(ImatSortJob* jobs, int count)
+{
+  int i;
+
+  if (count == 1)
+  {
+    iMatrixSortRunJob(&jobs[0]);
+    return;
+  }
+
+#if defined(WIN32)
+  {
+    HANDLE threads[IMAT_SORT_THREAD_MAX];
+
+    /* the calling thread takes the first job */
+    for (i = 1; i < count; i++)
+    {
+      threads[i] = CreateThread(NULL, 0, iMatrixSortThreadFunc, &jobs[i], 0, NULL);
+      if (!threads[i])
+        iMatrixSortRunJob(&jobs[i]);
+    }
+
+    iMatrixSortRunJob(&jobs[0]);
+
+    for (i = 1; i < count; i++)
+    {
+      if (threads[i])
+      {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+      }
+    }
+  }
+#elif !defined(__EMSCRIPTEN__)
+  {
+    pthread_t threads[IMAT_SORT_THREAD_MAX];
+    int created[IMAT_SORT_THREAD_MAX];
+
+    for (i = 1; i < count; i++)
+    {
+      created[i] = (pthread_create(&threads[i], NULL, iMatrixSortThreadFunc, &jobs[i]) == 0);
+      if (!created[i])
+        iMatrixSortRunJob(&jobs[i]);
+    }
+
+    iMatrixSortRunJob(&jobs[0]);
+
+    for (i = 1; i < count; i++)
+    {
+      if (created[i])
+        pthread_join(threads[i], NULL);
+    }
+  }
+#else
+  for (i = 0; i < count; i++)
+    iMatrixSortRunJob(&jobs[i]);
+#endif
+}
+
+
+/********************************************************************/
+/*  Merge Sort                                                      */
+/********************************************************************/
+
+static int iMatrixSortCompare(ImatSortContext* ctx, int p1, int p2)
+{
+  int k;
+
+  for (k = 0; k < ctx->count; k++)
+  {
+    ImatSortColumn* column = ctx->columns + k;
+    int ret;
+
+    if (column->type == IMAT_SORT_NUMBER)
+    {
+      double n1 = column->numbers[p1];
+      double n2 = column->numbers[p2];
+      ret = (n1 < n2) ? -1 : (n1 > n2) ? 1 : 0;
+    }
+    else if (column->type == IMAT_SORT_TEXT)
+      ret = iupStrCompareKeyCmp(column->texts[p1], column->texts[p2]);
+    else
+      ret = ctx->sort_cb(ctx->ih, column->col, ctx->lines[p1], ctx->lines[p2]);
+
+    if (ret != 0)
+      return column->descending ? -ret : ret;
+  }
+
+  return 0;
+}
+
+static void iMatrixSortMerge(ImatSortContext* ctx, int* perm, int* tmp, int n)
+{
+  int *src = perm, *dst = tmp;
+  int i, width;
+
+  for (i = 0; i < n; i += IMAT_SORT_RUN)
+  {
+    int end = (i + IMAT_SORT_RUN < n) ? i + IMAT_SORT_RUN : n;
+    int j;
+
+    for (j = i + 1; j < end; j++)
+    {
+      int p = perm[j], k = j;
+      while (k > i && iMatrixSortCompare(ctx, perm[k - 1], p) > 0)
+      {
+        perm[k] = perm[k - 1];
+        k--;
+      }
+      perm[k] = p;
+    }
+  }
+
+  for (width = IMAT_SORT_RUN; width < n; width *= 2)
+  {
+    int* swap;
+
+    for (i = 0; i < n; i += 2 * width)
+    {
+      int mid = (i + width < n) ? i + width : n;
+      int end = (i + 2 * width < n) ? i + 2 * width : n;
+      int a = i, b = mid, o = i;
+
+      /* already in order, also when there is nothing to merge */
+      if (mid == end || iMatrixSortCompare(ctx, src[mid - 1], src[mid]) <= 0)
+      {
+        memcpy(dst + i, src + i, (end - i) * sizeof(int));
+        continue;
+      }
+
+      /* takes from the left when equal, so the sort is stable */
+      while (a < mid && b < end)
+      {
+        if (iMatrixSortCompare(ctx, src[b], src[a]) < 0)
+          dst[o++] = src[b++];
+        else
+          dst[o++] = src[a++];
+      }
+      while (a < mid) dst[o++] = src[a++];
+      while (b < end) dst[o++] = src[b++];
+    }
+
+    swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != perm)
+    memcpy(perm, src, n * sizeof(int));
+}
+
+
+/********************************************************************/
+/*  Sort Lines                                                      */
+/********************************************************************/
+
+static void iMatrixSortReleaseColumns(ImatSortContext* ctx)
+{
+  int k, i;
+
+  for (k = 0; k < ctx->count; k++)
+  {
+    ImatSortColumn* column = ctx->columns + k;
+
+    if (column->numbers) free(column->numbers);
+    if (column->texts) free(column->texts);
+    if (column->offsets) free(column->offsets);
+
+    for (i = 0; i < IMAT_SORT_THREAD_MAX; i++)
+    {
+      if (column->text_keys[i])
+        free(column->text_keys[i]);
+    }
+  }
+}
+
+static int iMatrixSortInitColumns(ImatSortContext* ctx, const ImatSortKey* keys, int key_count, int n)
+{
+  Ihandle* ih = ctx->ih;
+  int k;
+
+  ctx->count = 0;
+
+  for (k = 0; k < key_count && k < IMAT_SORT_MAX_KEYS; k++)
+  {
+    ImatSortColumn* column = ctx->columns + ctx->count;
+    int col = keys[k].col;
+
+    memset(column, 0, sizeof(ImatSortColumn));
+    column->col = col;
+    column->descending = keys[k].descending;
+    ctx->count++;
+
+    if (ctx->sort_cb)
+      column->type = IMAT_SORT_CALLBACK;
+    else if (ih->data->numeric_columns && ih->data->numeric_columns[col].flags & IMAT_IS_NUMERIC)
+    {
+      column->type = IMAT_SORT_NUMBER;
+      column->numbers = (double*)malloc(n * sizeof(double));
+      if (!column->numbers)
+        return 0;
+    }
+    else
+    {
+      column->type = IMAT_SORT_TEXT;
+      column->texts = (unsigned short**)malloc(n * sizeof(unsigned short*));
+      column->offsets = (size_t*)malloc(n * sizeof(size_t));
+      if (!column->texts || !column->offsets)
+        return 0;
+    }
+  }
+
+  return 1;
+}
+
+static int iMatrixSortExtractKeys(ImatSortContext* ctx, int n)
+{
+  ImatSortJob jobs[IMAT_SORT_THREAD_MAX];
+  int i, k, count = 1, error = 0;
+
+  /* the callback compares the lines, there are no keys */
+  if (ctx->sort_cb)
+    return 1;
+
+  ctx->read_cells = iMatrixSortCanReadCells(ctx->ih, ctx);
+  if (ctx->read_cells)
+  {
+    unsigned short dummy;
+    count = iMatrixSortGetThreadCount(n);
+
+    /* initializes the character maps in the calling thread */
+    iupStrCompareKey(NULL, &dummy, ctx->casesensitive, ctx->utf8);
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    jobs[i].ctx = ctx;
+    jobs[i].index = i;
+    jobs[i].p0 = (int)(((int64_t)n * i) / count);
+    jobs[i].p1 = (int)(((int64_t)n * (i + 1)) / count);
+    jobs[i].error = 0;
+  }
+
+  iMatrixSortRunJobs(jobs, count);
+
+  for (i = 0; i < count; i++)
+  {
+    if (jobs[i].error)
+      error = 1;
+  }
+  if (error)
+    return 0;
+
+  /* the storage of the keys is complete, offsets can be converted to pointers */
+  for (k = 0; k < ctx->count; k++)
+  {
+    ImatSortColumn* column = ctx->columns + k;
+    if (column->type == IMAT_SORT_TEXT)
+    {
+      for (i = 0; i < count; i++)
+      {
+        int p;
+        for (p = jobs[i].p0; p < jobs[i].p1; p++)
+          column->texts[p] = column->text_keys[i] + column->offsets[p];
+      }
+    }
+  }
+
+  return 1;
+}
+
+void iupMatrixSortLines(Ihandle* ih, const ImatSortKey* keys, int key_count, int lin1, int lin2)
+{
+  ImatSortContext ctx;
+  int* sort_line_index = ih->data->sort_line_index;
+  int n = lin2 - lin1 + 1;
+
+  if (n < 2 || key_count < 1)
+    return;
+
+  memset(&ctx, 0, sizeof(ImatSortContext));
+  ctx.ih = ih;
+  ctx.lin1 = lin1;
+  ctx.sort_cb = (IFniii)IupGetCallback(ih, "SORTCOLUMNCOMPARE_CB");
+  ctx.utf8 = IupGetInt(NULL, "UTF8MODE");
+  ctx.casesensitive = iupAttribGetInt(ih, "SORTCOLUMNCASESENSITIVE");
+
+  ctx.lines = (int*)malloc(n * sizeof(int));
+  if (!ctx.lines)
+    return;
+  memcpy(ctx.lines, sort_line_index + lin1, n * sizeof(int));
+
+  if (iMatrixSortInitColumns(&ctx, keys, key_count, n) && iMatrixSortExtractKeys(&ctx, n))
+  {
+    int* perm = (int*)malloc(n * sizeof(int));
+    int* tmp = (int*)malloc(n * sizeof(int));
+
+    if (perm && tmp)
+    {
+      int i;
+
+      for (i = 0; i < n; i++)
+        perm[i] = i;
+
+      iMatrixSortMerge(&ctx, perm, tmp, n);
+
+      for (i = 0; i < n; i++)
+        sort_line_index[lin1 + i] = ctx.lines[perm[i]];
+    }
+
+    if (perm) free(perm);
+    if (tmp) free(tmp);
+  }
+
+  iMatrixSortReleaseColumns(&ctx);
+  free(ctx.lines);
+}
@@ -0,0 +1,31 @@
+/** \file
+ * \brief iupmatrix control
+ * sort lines by the values of one or more columns.
+ *
+ * See Copyright Notice in "iup.h"
+ */
+
+#ifndef __IUPMAT_SORT_H
+#define __IUPMAT_SORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IMAT_SORT_MAX_KEYS 16
+
+typedef struct _ImatSortKey {
+  int col;
+  int descending;
+} ImatSortKey;
+
+/* Sorts the lines lin1 to lin2 by the given columns, the first key has precedence.
+   The sort is stable, lines with equal keys keep their current order.
+   The result is stored in sort_line_index, that must be already initialized. */
+void iupMatrixSortLines(Ihandle* ih, const ImatSortKey* keys, int key_count, int lin1, int lin2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -838,6 +838,66 @@ static int iMatrixSetCopyColAttrib(Ihandle* ih, int from_col, const char* value)
   return 0;
 }
 
+static int iMatrixSetStorageAttrib(Ihandle* ih, int col, const char* value)
+{
+  if (!ih->handle)
+    return 1;  /* applied when mapped */
+
+  if (!ih->data->values || !iupMATRIX_CHECK_COL(ih, col))
+    return 0;
+
+  iupMatrixMemSetStorage(ih, col, iupMatrixMemGetStorageType(value));
+  ih->data->need_redraw = 1;
+  return 0;
+}
+
+static char* iMatrixGetStorageAttrib(Ihandle* ih, int col)
+{
+  static const char* storage_str[] = { "TEXT", "DOUBLE", "INT64", "STRING" };
+
+  if (!ih->data->values)
+    return iupAttribGetId(ih, "STORAGE", col);  /* set before map */
+
+  if (!iupMATRIX_CHECK_COL(ih, col))
+    return NULL;
+
+  return (char*)storage_str[ih->data->values[col].type];
+}
+
+static int iMatrixSetBulkLoadAttrib(Ihandle* ih, const char* value)
+{
+  int bulk_load = iupStrBoolean(value);
+
+  if (!ih->handle || bulk_load == ih->data->bulk_load)
+    return 0;
+
+  if (bulk_load)
+  {
+    if (ih->data->editing)
+      iupMatrixEditHide(ih);
+
+    /* the loaded values and the added lines and columns are not recorded for undo */
+    if (ih->data->undo_redo) iupAttribSetClassObject(ih, "UNDOCLEAR", NULL);
+
+    ih->data->bulk_load = 1;
+  }
+  else
+  {
+    ih->data->bulk_load = 0;
+
+    /* sizes are calculated only once for all the changes */
+    ih->data->need_calcsize = 1;
+    iupMatrixDraw(ih, 1);
+  }
+
+  return 0;
+}
+
+static char* iMatrixGetBulkLoadAttrib(Ihandle* ih)
+{
+  return iupStrReturnBoolean(ih->data->bulk_load);
+}
+
 static int iMatrixSetMoveColAttrib(Ihandle* ih, int from_col, const char* value)
 {
   char str[50];
@@ -2268,6 +2328,7 @@ Iclass* iupMatrixNewClass(void)
   iupClassRegisterAttributeId(ic, "COPYCOL", NULL, iMatrixSetCopyColAttrib, IUPAF_WRITEONLY | IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId(ic, "MOVELIN", NULL, iMatrixSetMoveLinAttrib, IUPAF_WRITEONLY | IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId(ic, "MOVECOL", NULL, iMatrixSetMoveColAttrib, IUPAF_WRITEONLY | IUPAF_NO_INHERIT);
+  iupClassRegisterAttributeId(ic, "STORAGE", iMatrixGetStorageAttrib, iMatrixSetStorageAttrib, IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId(ic, "MINCOLWIDTH", NULL, NULL, IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "MINCOLWIDTHDEF", NULL, NULL, NULL, NULL, IUPAF_NO_INHERIT);
 
@@ -2297,6 +2358,7 @@ Iclass* iupMatrixNewClass(void)
   iupClassRegisterAttribute(ic, "EDITING", iMatrixGetEditingAttrib, NULL, NULL, NULL, IUPAF_READONLY | IUPAF_NO_SAVE | IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "EDITNEXT", iMatrixGetEditNextAttrib, iMatrixSetEditNextAttrib, IUPAF_SAMEASSYSTEM, "LIN", IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "REDRAW", NULL, iupMatrixDrawSetRedrawAttrib, NULL, NULL, IUPAF_WRITEONLY | IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "BULKLOAD", iMatrixGetBulkLoadAttrib, iMatrixSetBulkLoadAttrib, NULL, NULL, IUPAF_NO_SAVE | IUPAF_NO_DEFAULTVALUE | IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId2(ic, "CLEARVALUE", NULL, iMatrixSetClearValueAttrib, IUPAF_WRITEONLY | IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId2(ic, "CLEARATTRIB", NULL, iMatrixSetClearAttribAttrib, IUPAF_WRITEONLY | IUPAF_NO_INHERIT);
 
@@ -1058,6 +1058,9 @@ static void iMatrixExDestroyMethod(Ihandle* ih)
   if (matex_data->find_dlg)
     IupDestroy(matex_data->find_dlg);
 
+  if (matex_data->find)
+    iupMatrixExFindRelease(matex_data);
+
   if (matex_data->undo_stack)
   {
     iupAttribSetClassObject(ih, "UNDOCLEAR", NULL);
@@ -26,14 +26,17 @@ typedef struct _ImatExData
   Ihandle* busy_progress_dlg;
 
   Ihandle* find_dlg;
+  struct _ImatExFind* find;  /* FINDALL results and background search */
 
   Iarray* undo_stack;
   int undo_stack_pos;
   int undo_stack_hold;
+  size_t undo_memory, undo_max_memory;  /* in bytes, max=0 is no limit */
 } ImatExData;
 
 /* Busy */
 void iupMatrixExBusyStart(ImatExData* matex_data, int count, const char* busyname);
+void iupMatrixExBusyStartReadOnly(ImatExData* matex_data, int count, const char* busyname);
 int iupMatrixExBusyInc(ImatExData* matex_data);
 void iupMatrixExBusyEnd(ImatExData* matex_data);
 
@@ -47,6 +50,7 @@ void iupMatrixExSortShowDialog(ImatExData* matex_data);
 
 /* Find */
 void iupMatrixExFindShowDialog(ImatExData* matex_data);
+void iupMatrixExFindRelease(ImatExData* matex_data);
 
 /* Visible */
 int iupMatrixExIsColumnVisible(Ihandle* ih, int col);
@@ -69,6 +73,7 @@ void iupMatrixExRegisterSort(Iclass* ic);
 /* Implemented in IupMatrix */
 char* iupMatrixExGetCellValue(Ihandle* ih, int lin, int col, int display);
 void  iupMatrixExSetCellValue(Ihandle* ih, int lin, int col, const char* value);  /* NO numeric conversion */
+unsigned int iupMatrixExGetValuesVersion(Ihandle* ih);  /* changed when cell values are set, moved or sorted */
 
 
 #ifdef __cplusplus
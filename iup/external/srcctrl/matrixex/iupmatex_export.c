@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "iup.h"
@@ -15,94 +16,211 @@
 #include "iup_matrixex.h"
 
 
-static void iMatrixExStrCopyNoSepHTML(char* buffer, const char* str)
+/* Exported data is written to a large buffer that is saved when full,
+   instead of one write for each cell. */
+
+#define IMATEX_EXPORT_BUFFER_SIZE (256*1024)
+
+typedef struct _IexportFile {
+  FILE* file;
+  char* buffer;
+  int size;
+  int error;
+
+  /* the exported lines and columns, including the titles, computed only once */
+  int *lin, lin_count;
+  int *col, col_count;
+} IexportFile;
+
+static void iMatrixExFileFlush(IexportFile* ef)
 {
-  while (*str)
+  if (ef->size && fwrite(ef->buffer, 1, ef->size, ef->file) != (size_t)ef->size)
+    ef->error = 1;
+  ef->size = 0;
+}
+
+static void iMatrixExFileWrite(IexportFile* ef, const char* str, int len)
+{
+  if (ef->size + len > IMATEX_EXPORT_BUFFER_SIZE)
   {
-    if (*str=='\n')
+    iMatrixExFileFlush(ef);
+
+    if (len > IMATEX_EXPORT_BUFFER_SIZE)
     {
-      *buffer = '<'; buffer++;
-      *buffer = 'B'; buffer++;
-      *buffer = 'R'; buffer++;
-      *buffer = '>';
+      if (fwrite(str, 1, len, ef->file) != (size_t)len)
+        ef->error = 1;
+      return;
     }
+  }
+
+  memcpy(ef->buffer + ef->size, str, len);
+  ef->size += len;
+}
+
+static void iMatrixExFileWriteStr(IexportFile* ef, const char* str)
+{
+  iMatrixExFileWrite(ef, str, (int)strlen(str));
+}
+
+static void iMatrixExFileWriteChar(IexportFile* ef, char c)
+{
+  if (ef->size == IMATEX_EXPORT_BUFFER_SIZE)
+    iMatrixExFileFlush(ef);
+
+  ef->buffer[ef->size] = c;
+  ef->size++;
+}
+
+static void iMatrixExFileWriteHTML(IexportFile* ef, const char* str)
+{
+  while (*str)
+  {
+    if (*str=='\n')
+      iMatrixExFileWrite(ef, "<BR>", 4);
     else
-      *buffer = *str;
+      iMatrixExFileWriteChar(ef, *str);
 
-    buffer++;
     str++;
   }
-  *buffer = 0;
 }
 
-static void iMatrixExStrCopyNoSepLaTeX(char* buffer, const char* str)
+static void iMatrixExFileWriteLaTeX(IexportFile* ef, const char* str)
 {
   while (*str)
   {
     if (*str=='\n' || *str=='_')
-      *buffer = ' ';
+      iMatrixExFileWriteChar(ef, ' ');
     else if (*str=='%')
-    {
-      *buffer = '\\'; buffer++;
-      *buffer = '%';
-    }
+      iMatrixExFileWrite(ef, "\\%", 2);
     else
-      *buffer = *str;
+      iMatrixExFileWriteChar(ef, *str);
 
-    buffer++;
     str++;
   }
-  *buffer = 0;
 }
 
-static void iMatrixExCopyTXT(Ihandle *ih, FILE* file, int num_lin, int num_col, int skip_lin, int skip_col)
+/* RFC 4180, fields with separators, quotes or line breaks are quoted and the quotes are doubled */
+static void iMatrixExFileWriteCSV(IexportFile* ef, const char* str, char sep)
+{
+  const char* s = str;
+
+  while (*s && *s != sep && *s != '\"' && *s != '\n' && *s != '\r')
+    s++;
+
+  if (*s == 0)
+  {
+    iMatrixExFileWrite(ef, str, (int)(s - str));
+    return;
+  }
+
+  iMatrixExFileWriteChar(ef, '\"');
+  while (*str)
+  {
+    if (*str == '\"')
+      iMatrixExFileWriteChar(ef, '\"');
+    iMatrixExFileWriteChar(ef, *str);
+    str++;
+  }
+  iMatrixExFileWriteChar(ef, '\"');
+}
+
+static void iMatrixExFileInitCells(Ihandle *ih, IexportFile* ef, int num_lin, int num_col, int skip_lin, int skip_col)
 {
-  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
   int lin, col;
-  int add_sep;
+
+  ef->lin = (int*)malloc((num_lin + 1) * sizeof(int));
+  ef->col = (int*)malloc((num_col + 1) * sizeof(int));
+  ef->lin_count = 0;
+  ef->col_count = 0;
+
+  /* Here includes the title cells */
+  for (lin = 0; lin <= num_lin; ++lin)
+  {
+    if (iupMatrixExIsLineVisible(ih, lin))
+    {
+      ef->lin[ef->lin_count] = lin;
+      ef->lin_count++;
+    }
+
+    if (lin == 0) lin += skip_lin;
+  }
+
+  for (col = 0; col <= num_col; ++col)
+  {
+    if (iupMatrixExIsColumnVisible(ih, col))
+    {
+      ef->col[ef->col_count] = col;
+      ef->col_count++;
+    }
+
+    if (col == 0) col += skip_col;
+  }
+}
+
+/* progress is reported for each line, returns 0 if aborted */
+static int iMatrixExFileLineDone(ImatExData* matex_data, IexportFile* ef)
+{
+  if (ef->error)
+    return 0;
+
+  return iupMatrixExBusyInc(matex_data);
+}
+
+static void iMatrixExCopyTXT(Ihandle *ih, IexportFile* ef, int csv)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  int l, c;
   char* str, sep;
 
-  sep = *(iupAttribGetStr(ih, "TEXTSEPARATOR"));
+  if (csv)
+    sep = ',';
+  else
+    sep = *(iupAttribGetStr(ih, "TEXTSEPARATOR"));
 
   str = iupAttribGetStr(ih, "COPYCAPTION");
-  if (str)
-    fprintf(file,"%s\n",str);
+  if (str && !csv)
+  {
+    iMatrixExFileWriteStr(ef, str);
+    iMatrixExFileWriteChar(ef, '\n');
+  }
 
-  /* Here includes the title cells */
-  for (lin = 0; lin <= num_lin; ++lin)
+  for (l = 0; l < ef->lin_count; ++l)
   {
-    add_sep = 0;
+    int lin = ef->lin[l];
 
-    if (iupMatrixExIsLineVisible(ih, lin))
+    for (c = 0; c < ef->col_count; ++c)
     {
-      for (col = 0; col <= num_col; ++col)
+      if (c > 0)
+        iMatrixExFileWriteChar(ef, sep);
+
+      str = iupMatrixExGetCellValue(matex_data->ih, lin, ef->col[c], 1);  /* get displayed value */
+      if (csv)
+      {
+        if (str)
+          iMatrixExFileWriteCSV(ef, str, sep);
+      }
+      else if (str)
       {
-        if (iupMatrixExIsColumnVisible(ih, col))
+        if (strchr(str, sep))
         {
-          if (add_sep)
-            fprintf(file, "%c", sep);
-
-          str = iupMatrixExGetCellValue(matex_data->ih, lin, col, 1);  /* get displayed value */
-          if (str)
-          {
-            if (strchr(str, sep))
-              fprintf(file, "\"%s\"", str);
-            else
-              fprintf(file, "%s", str);
-          }
-          else
-            fprintf(file, "%s", " ");
-
-          add_sep = 1;
+          iMatrixExFileWriteChar(ef, '\"');
+          iMatrixExFileWriteStr(ef, str);
+          iMatrixExFileWriteChar(ef, '\"');
         }
-
-        if (col == 0) col += skip_col;
+        else
+          iMatrixExFileWriteStr(ef, str);
       }
-
-      fprintf(file, "%s", "\n");
+      else
+        iMatrixExFileWriteChar(ef, ' ');
     }
 
-    if (lin == 0) lin += skip_lin;
+    if (csv)
+      iMatrixExFileWrite(ef, "\r\n", 2);
+    else
+      iMatrixExFileWriteChar(ef, '\n');
+
+    if (!iMatrixExFileLineDone(matex_data, ef))
+      return;
   }
 }
 
@@ -206,10 +324,10 @@ static char* iMatrixExGetCellFormat(Ihandle *ih, int lin, int col, char* format)
   return format;
 }
 
-static void iMatrixExCopyHTML(Ihandle *ih, FILE* file, int num_lin, int num_col, char* buffer, int skip_lin, int skip_col)
+static void iMatrixExCopyHTML(Ihandle *ih, IexportFile* ef)
 {
   ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
-  int lin, col;
+  int l, c;
   char* str, *caption, f[512];
 
   int add_format = iupAttribGetInt(ih, "HTMLADDFORMAT");
@@ -225,54 +343,56 @@ static void iMatrixExCopyHTML(Ihandle *ih, FILE* file, int num_lin, int num_col,
   if (!td) td = "";
   if (!caption) caption = "";
 
-  fprintf(file,"<!-- File automatically generated by IUP -->\n");
-  fprintf(file,"<TABLE%s>\n", table);
+  iMatrixExFileWriteStr(ef, "<!-- File automatically generated by IUP -->\n");
+  iMatrixExFileWriteStr(ef, "<TABLE");
+  iMatrixExFileWriteStr(ef, table);
+  iMatrixExFileWriteStr(ef, ">\n");
 
   str = iupAttribGetStr(ih, "COPYCAPTION");
   if (str)
-    fprintf(file,"<CAPTION%s>%s</CAPTION>\n", caption, str);
-
-  /* Here includes the title cells */
-  for (lin = 0; lin <= num_lin; ++lin)
   {
-    if (iupMatrixExIsLineVisible(ih, lin))
-    {
-      fprintf(file,"<TR%s> ", tr);
+    iMatrixExFileWriteStr(ef, "<CAPTION");
+    iMatrixExFileWriteStr(ef, caption);
+    iMatrixExFileWriteStr(ef, ">");
+    iMatrixExFileWriteStr(ef, str);
+    iMatrixExFileWriteStr(ef, "</CAPTION>\n");
+  }
 
-      for (col = 0; col <= num_col; ++col)
-      {
-        if (iupMatrixExIsColumnVisible(ih, col))
-        {
-          if (lin==0||col==0)
-            fprintf(file,"<TH%s%s>", th, add_format? iMatrixExGetCellFormat(ih, lin, col, f): "");
-          else
-            fprintf(file,"<TD%s%s>", td, add_format? iMatrixExGetCellFormat(ih, lin, col, f): "");
-
-          str = iupMatrixExGetCellValue(matex_data->ih, lin, col, 1);  /* get displayed value */
-          if (str)
-          {
-            iMatrixExStrCopyNoSepHTML(buffer, str);
-            fprintf(file, "%s", buffer);
-          }
-          else
-            fprintf(file, "%s", " ");
-
-          if (lin==0||col==0)
-            fprintf(file,"</TH> ");
-          else
-            fprintf(file,"</TD> ");
-        }
+  for (l = 0; l < ef->lin_count; ++l)
+  {
+    int lin = ef->lin[l];
 
-        if (col == 0) col += skip_col;
-      }
+    iMatrixExFileWriteStr(ef, "<TR");
+    iMatrixExFileWriteStr(ef, tr);
+    iMatrixExFileWriteStr(ef, "> ");
 
-      fprintf(file,"</TR>\n");
+    for (c = 0; c < ef->col_count; ++c)
+    {
+      int col = ef->col[c];
+      int is_title = (lin==0||col==0);
+
+      iMatrixExFileWriteStr(ef, is_title? "<TH": "<TD");
+      iMatrixExFileWriteStr(ef, is_title? th: td);
+      if (add_format)
+        iMatrixExFileWriteStr(ef, iMatrixExGetCellFormat(ih, lin, col, f));
+      iMatrixExFileWriteChar(ef, '>');
+
+      str = iupMatrixExGetCellValue(matex_data->ih, lin, col, 1);  /* get displayed value */
+      if (str)
+        iMatrixExFileWriteHTML(ef, str);
+      else
+        iMatrixExFileWriteChar(ef, ' ');
+
+      iMatrixExFileWriteStr(ef, is_title? "</TH> ": "</TD> ");
     }
 
-    if (lin == 0) lin += skip_lin;
+    iMatrixExFileWriteStr(ef, "</TR>\n");
+
+    if (!iMatrixExFileLineDone(matex_data, ef))
+      return;
   }
 
-  fprintf(file,"</TABLE>\n");
+  iMatrixExFileWriteStr(ef, "</TABLE>\n");
 }
 
 static int iMatrixExIsBoldLine(Ihandle* ih, int lin)
@@ -292,87 +412,78 @@ static int iMatrixExIsBoldLine(Ihandle* ih, int lin)
   return 0;
 }
 
-static void iMatrixExCopyLaTeX(Ihandle *ih, FILE* file, int num_lin, int num_col, char* buffer, int skip_lin, int skip_col)
+static void iMatrixExCopyLaTeX(Ihandle *ih, IexportFile* ef)
 {
   ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
-  int lin, col;
-  int add_sep;
+  int l, c;
   char* str;
 
-  fprintf(file,"%% File automatically generated by IUP\n");
-
-  fprintf(file,"\\begin{table}\n");
-  fprintf(file,"\\begin{center}\n");
-  fprintf(file,"\\begin{tabular}{");
+  iMatrixExFileWriteStr(ef, "% File automatically generated by IUP\n");
 
-  for (col = 0; col <= num_col; ++col)
-  {
-    if (iupMatrixExIsColumnVisible(ih, col))
-      fprintf(file,"|r");
+  iMatrixExFileWriteStr(ef, "\\begin{table}\n");
+  iMatrixExFileWriteStr(ef, "\\begin{center}\n");
+  iMatrixExFileWriteStr(ef, "\\begin{tabular}{");
 
-    if (col == 0) col += skip_col;
-  }
-  fprintf(file,"|} \\hline\n");
+  for (c = 0; c < ef->col_count; ++c)
+    iMatrixExFileWriteStr(ef, "|r");
+  iMatrixExFileWriteStr(ef, "|} \\hline\n");
 
-  /* Here includes the title cells */
-  for (lin = 0; lin <= num_lin; ++lin)
+  for (l = 0; l < ef->lin_count; ++l)
   {
-    add_sep = 0;
+    int lin = ef->lin[l];
+    int is_bold = iMatrixExIsBoldLine(ih, lin);
 
-    if (iupMatrixExIsLineVisible(ih, lin))
+    for (c = 0; c < ef->col_count; ++c)
     {
-      int is_bold = iMatrixExIsBoldLine(ih, lin);
-
-      for (col = 0; col <= num_col; ++col)
-      {
-        if (iupMatrixExIsColumnVisible(ih, col))
-        {
-          if (add_sep)
-            fprintf(file,"& ");
-
-          if (is_bold)
-            fprintf(file,"\\bf{");
-
-          str = iupMatrixExGetCellValue(matex_data->ih, lin, col, 1);  /* get displayed value */
-          if (str)
-          {
-            iMatrixExStrCopyNoSepLaTeX(buffer, str);
-            fprintf(file, "%s", buffer);
-          }
-          else
-            fprintf(file, "%s", " ");
-
-          if (is_bold)
-            fprintf(file,"}");
+      if (c > 0)
+        iMatrixExFileWriteStr(ef, "& ");
 
-          add_sep = 1;
-        }
+      if (is_bold)
+        iMatrixExFileWriteStr(ef, "\\bf{");
 
-        if (col == 0) col += skip_col;
-      }
+      str = iupMatrixExGetCellValue(matex_data->ih, lin, ef->col[c], 1);  /* get displayed value */
+      if (str)
+        iMatrixExFileWriteLaTeX(ef, str);
+      else
+        iMatrixExFileWriteChar(ef, ' ');
 
-      fprintf(file,"\\\\ \\hline\n");
+      if (is_bold)
+        iMatrixExFileWriteChar(ef, '}');
     }
 
-    if (lin == 0) lin += skip_lin;
+    iMatrixExFileWriteStr(ef, "\\\\ \\hline\n");
+
+    if (!iMatrixExFileLineDone(matex_data, ef))
+      return;
   }
 
-  fprintf(file,"\\end{tabular}\n");
+  iMatrixExFileWriteStr(ef, "\\end{tabular}\n");
 
   str = iupAttribGetStr(ih, "COPYCAPTION");
-  if (str) fprintf(file,"\\caption{%s.}\n", str);
+  if (str)
+  {
+    iMatrixExFileWriteStr(ef, "\\caption{");
+    iMatrixExFileWriteStr(ef, str);
+    iMatrixExFileWriteStr(ef, ".}\n");
+  }
 
   str = iupAttribGetStr(ih, "LATEXLABEL");
-  if (str) fprintf(file,"\\label{tab:%s}\n", str);
+  if (str)
+  {
+    iMatrixExFileWriteStr(ef, "\\label{tab:");
+    iMatrixExFileWriteStr(ef, str);
+    iMatrixExFileWriteStr(ef, "}\n");
+  }
 
-  fprintf(file,"\\end{center}\n");
-  fprintf(file,"\\end{table}\n");
+  iMatrixExFileWriteStr(ef, "\\end{center}\n");
+  iMatrixExFileWriteStr(ef, "\\end{table}\n");
 }
 
 static int iMatrixExSetCopyFileAttrib(Ihandle *ih, const char* value)
 {
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
   int num_lin, num_col, skip_lin, skip_col;
-  char buffer[1024];
+  IexportFile ef;
   char* format;
 
   FILE *file = fopen(value, "wb");
@@ -391,14 +502,31 @@ static int iMatrixExSetCopyFileAttrib(Ihandle *ih, const char* value)
   skip_lin = iupAttribGetInt(ih, "SKIPLINES");
   skip_col = iupAttribGetInt(ih, "SKIPCOLUMNS");
 
+  memset(&ef, 0, sizeof(IexportFile));
+  ef.file = file;
+  ef.buffer = (char*)malloc(IMATEX_EXPORT_BUFFER_SIZE);
+  iMatrixExFileInitCells(ih, &ef, num_lin, num_col, skip_lin, skip_col);
+
+  iupMatrixExBusyStartReadOnly(matex_data, ef.lin_count, "EXPORT");
+
   format = iupAttribGetStr(ih, "FILEFORMAT");
   if (iupStrEqualNoCase(format, "HTML"))
-    iMatrixExCopyHTML(ih, file, num_lin, num_col, buffer, skip_lin, skip_col);
+    iMatrixExCopyHTML(ih, &ef);
   else if (iupStrEqualNoCase(format, "LaTeX"))
-    iMatrixExCopyLaTeX(ih, file, num_lin, num_col, buffer, skip_lin, skip_col);
+    iMatrixExCopyLaTeX(ih, &ef);
   else
-    iMatrixExCopyTXT(ih, file, num_lin, num_col, skip_lin, skip_col);
+    iMatrixExCopyTXT(ih, &ef, iupStrEqualNoCase(format, "CSV"));
+
+  /* if aborted the busy state already ended */
+  iupMatrixExBusyEnd(matex_data);
+
+  iMatrixExFileFlush(&ef);
+  if (ef.error)
+    iupAttribSet(ih, "LASTERROR", "IUP_ERRORFILESAVE");
 
+  free(ef.buffer);
+  free(ef.lin);
+  free(ef.col);
   fclose(file);
   return 0;
 }
@@ -8,7 +8,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#endif
+
 #include "iup.h"
+#include "iupcbs.h"
 
 #include "iup_object.h"
 #include "iup_attrib.h"
@@ -207,9 +214,8 @@ void iupMatrixExFindShowDialog(ImatExData* matex_data)
     IupShow(matex_data->find_dlg);
 }
 
-static int iMatrixMatch(Ihandle *ih, const char* findvalue, int lin, int col, int matchcase, int matchwholecell, int utf8)
+static int iMatrixMatchValue(const char* value, const char* findvalue, int matchcase, int matchwholecell, int utf8)
 {
-  char* value = iupMatrixExGetCellValue(ih, lin, col, 1);  /* get displayed value */
   if (!value || value[0] == 0)
     return 0;
 
@@ -219,6 +225,795 @@ static int iMatrixMatch(Ihandle *ih, const char* findvalue, int lin, int col, in
     return iupStrCompareFind(value, findvalue, matchcase, utf8);  /* search only for the first occurrence */
 }
 
+static int iMatrixMatch(Ihandle *ih, const char* findvalue, int lin, int col, int matchcase, int matchwholecell, int utf8)
+{
+  char* value = iupMatrixExGetCellValue(ih, lin, col, 1);  /* get displayed value */
+  return iMatrixMatchValue(value, findvalue, matchcase, matchwholecell, utf8);
+}
+
+
+/********************************************************************/
+/*  Find All                                                        */
+/********************************************************************/
+
+/* The displayed values are copied on the main thread, because the
+   numeric formatting uses shared buffers. The copy is done in chunks,
+   one for each posted message, so the application keeps responding.
+   The chunks are queued to a single worker thread that matches them
+   and posts each one back to the main thread, where it is appended
+   to the sorted list of matches. */
+
+#define IMATEX_FIND_CHUNK 16384  /* cells copied in each step */
+#define IMATEX_FIND_COPY  -1     /* message that copies the next chunk */
+
+typedef struct _ImatExFindCell
+{
+  int lin, col;
+  int marked;  /* the mark was set by FINDALL */
+} ImatExFindCell;
+
+typedef struct _ImatExFindChunk
+{
+  int index;
+
+  /* copy of the non empty visible cells, in line order */
+  char* buffer;
+  size_t* offset;
+  ImatExFindCell* cells;
+  int cell_count;
+
+  /* filled by the worker */
+  ImatExFindCell* match;
+  int match_count;
+  int failed;  /* not enough memory for the matches */
+
+  int arrived;  /* the worker posted the chunk */
+} ImatExFindChunk;
+
+typedef struct _ImatExFindJob
+{
+  Ihandle* msg;
+  int generation;
+
+  char* text;
+  int matchcase, matchwholecell, utf8;
+
+  int* cols;
+  int col_count;
+  int lin;  /* next line to copy */
+  int copied;  /* all the lines were copied */
+
+  /* queue of copied chunks, protected by the lock */
+  ImatExFindChunk** chunks;
+  int chunk_count, chunk_max;
+  int chunk_next;  /* next chunk taken by the worker */
+  int chunk_done;  /* chunks appended to the result, used only in the main thread */
+
+  int cancel;
+
+  int started;  /* the worker is running, or else the chunks are matched when queued */
+#if defined(WIN32)
+  CRITICAL_SECTION lock;
+  HANDLE wake;  /* auto reset event */
+  HANDLE thread;
+#elif !defined(__EMSCRIPTEN__)
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_t thread;
+#endif
+} ImatExFindJob;
+
+typedef struct _ImatExFind
+{
+  Ihandle* msg;   /* receives the messages posted by the worker */
+  int generation;
+
+  char* text;
+  int matchcase, matchwholecell, find_col, utf8;
+  unsigned int version;  /* values version when the search started, see iupMatrixExGetValuesVersion */
+
+  ImatExFindJob* job;  /* NULL when the search is done */
+
+  ImatExFindCell* match;  /* sorted by line then column */
+  int match_count, match_max;
+
+  ImatExFindCell* match_by_col;  /* sorted by column then line, created on demand */
+  int match_by_col_count;
+} ImatExFind;
+
+static void iMatrixExFindLock(ImatExFindJob* job)
+{
+#if defined(WIN32)
+  EnterCriticalSection(&job->lock);
+#elif !defined(__EMSCRIPTEN__)
+  pthread_mutex_lock(&job->lock);
+#else
+  (void)job;
+#endif
+}
+
+static void iMatrixExFindUnlock(ImatExFindJob* job)
+{
+#if defined(WIN32)
+  LeaveCriticalSection(&job->lock);
+#elif !defined(__EMSCRIPTEN__)
+  pthread_mutex_unlock(&job->lock);
+#else
+  (void)job;
+#endif
+}
+
+/* called with the lock */
+static void iMatrixExFindWake(ImatExFindJob* job)
+{
+#if defined(WIN32)
+  if (job->wake)
+    SetEvent(job->wake);
+#elif !defined(__EMSCRIPTEN__)
+  pthread_cond_signal(&job->wake);
+#else
+  (void)job;
+#endif
+}
+
+/* called with the lock, only by the worker */
+static void iMatrixExFindWait(ImatExFindJob* job)
+{
+#if defined(WIN32)
+  LeaveCriticalSection(&job->lock);
+  WaitForSingleObject(job->wake, INFINITE);  /* a SetEvent done before the wait is not lost */
+  EnterCriticalSection(&job->lock);
+#elif !defined(__EMSCRIPTEN__)
+  pthread_cond_wait(&job->wake, &job->lock);
+#else
+  (void)job;
+#endif
+}
+
+static void iMatrixExFindFreeChunk(ImatExFindChunk* chunk)
+{
+  free(chunk->buffer);
+  free(chunk->offset);
+  free(chunk->cells);
+  free(chunk->match);
+  free(chunk);
+}
+
+static void iMatrixExFindRunChunk(ImatExFindJob* job, ImatExFindChunk* chunk)
+{
+  int i, max = 0;
+
+  /* a chunk is small, the cancel flag is checked under the lock before taking the next one */
+  for (i = 0; i < chunk->cell_count; i++)
+  {
+    if (iMatrixMatchValue(chunk->buffer + chunk->offset[i], job->text, job->matchcase, job->matchwholecell, job->utf8))
+    {
+      if (chunk->match_count == max)
+      {
+        ImatExFindCell* match;
+        max = max ? max * 2 : 64;
+        match = (ImatExFindCell*)realloc(chunk->match, max * sizeof(ImatExFindCell));
+        if (!match)
+        {
+          chunk->failed = 1;
+          break;
+        }
+        chunk->match = match;
+      }
+      chunk->match[chunk->match_count] = chunk->cells[i];
+      chunk->match_count++;
+    }
+  }
+
+  IupPostMessage(job->msg, NULL, chunk->index, (double)job->generation, NULL);
+}
+
+/* matches the queued chunks until the copy is complete and the queue is empty, or the search is canceled */
+static void iMatrixExFindRunWorker(ImatExFindJob* job)
+{
+  for (;;)
+  {
+    ImatExFindChunk* chunk;
+
+    iMatrixExFindLock(job);
+    while (!job->cancel && !job->copied && job->chunk_next == job->chunk_count)
+      iMatrixExFindWait(job);
+
+    if (job->cancel || job->chunk_next == job->chunk_count)
+    {
+      iMatrixExFindUnlock(job);
+      return;
+    }
+
+    chunk = job->chunks[job->chunk_next];
+    job->chunk_next++;
+    iMatrixExFindUnlock(job);
+
+    iMatrixExFindRunChunk(job, chunk);
+  }
+}
+
+#if defined(WIN32)
+static DWORD WINAPI iMatrixExFindThreadFunc(LPVOID arg)
+{
+  iMatrixExFindRunWorker((ImatExFindJob*)arg);
+  return 0;
+}
+#elif !defined(__EMSCRIPTEN__)
+static void* iMatrixExFindThreadFunc(void* arg)
+{
+  iMatrixExFindRunWorker((ImatExFindJob*)arg);
+  return NULL;
+}
+#endif
+
+static void iMatrixExFindStartWorker(ImatExFindJob* job)
+{
+#if defined(WIN32)
+  InitializeCriticalSection(&job->lock);
+  job->wake = CreateEvent(NULL, FALSE, FALSE, NULL);
+  if (job->wake)
+  {
+    job->thread = CreateThread(NULL, 0, iMatrixExFindThreadFunc, job, 0, NULL);
+    job->started = (job->thread != NULL);
+  }
+#elif !defined(__EMSCRIPTEN__)
+  pthread_mutex_init(&job->lock, NULL);
+  pthread_cond_init(&job->wake, NULL);
+  job->started = (pthread_create(&job->thread, NULL, iMatrixExFindThreadFunc, job) == 0);
+#else
+  job->started = 0;
+#endif
+}
+
+static void iMatrixExFindDestroyJob(ImatExFindJob* job)
+{
+  int i;
+
+  iMatrixExFindLock(job);
+  job->cancel = 1;
+  iMatrixExFindWake(job);
+  iMatrixExFindUnlock(job);
+
+#if defined(WIN32)
+  if (job->started)
+  {
+    WaitForSingleObject(job->thread, INFINITE);
+    CloseHandle(job->thread);
+  }
+  if (job->wake)
+    CloseHandle(job->wake);
+  DeleteCriticalSection(&job->lock);
+#elif !defined(__EMSCRIPTEN__)
+  if (job->started)
+    pthread_join(job->thread, NULL);
+  pthread_cond_destroy(&job->wake);
+  pthread_mutex_destroy(&job->lock);
+#endif
+
+  /* the chunks already appended to the result were released */
+  for (i = job->chunk_done; i < job->chunk_count; i++)
+    iMatrixExFindFreeChunk(job->chunks[i]);
+
+  free(job->chunks);
+  free(job->cols);
+  free(job->text);
+  free(job);
+}
+
+/* returns NULL if there is not enough memory */
+static ImatExFindJob* iMatrixExFindCreateJob(ImatExData* matex_data, ImatExFind* find)
+{
+  Ihandle* ih = matex_data->ih;
+  int num_col = IupGetInt(ih, "NUMCOL");
+  int c;
+  ImatExFindJob* job = (ImatExFindJob*)calloc(1, sizeof(ImatExFindJob));
+  if (!job)
+    return NULL;
+
+  job->msg = find->msg;
+  job->generation = find->generation;
+  job->text = iupStrDup(find->text);
+  job->matchcase = find->matchcase;
+  job->matchwholecell = find->matchwholecell;
+  job->utf8 = find->utf8;
+  job->lin = 1;
+
+  job->cols = (int*)malloc((num_col + 1) * sizeof(int));
+  if (!job->text || !job->cols)
+  {
+    free(job->text);
+    free(job->cols);
+    free(job);
+    return NULL;
+  }
+
+  for (c = 1; c <= num_col; c++)
+  {
+    if (find->find_col != 0 && c != find->find_col)
+      continue;
+    if (iupMatrixExIsColumnVisible(ih, c))
+      job->cols[job->col_count++] = c;
+  }
+
+  iMatrixExFindStartWorker(job);
+
+  return job;
+}
+
+/* returns 0 if there is not enough memory */
+static int iMatrixExFindQueueChunk(ImatExFindJob* job, ImatExFindChunk* chunk)
+{
+  int ret = 1;
+
+  iMatrixExFindLock(job);
+
+  if (job->chunk_count == job->chunk_max)
+  {
+    int chunk_max = job->chunk_max ? job->chunk_max * 2 : 16;
+    ImatExFindChunk** chunks = (ImatExFindChunk**)realloc(job->chunks, chunk_max * sizeof(ImatExFindChunk*));
+    if (chunks)
+    {
+      job->chunks = chunks;
+      job->chunk_max = chunk_max;
+    }
+    else
+      ret = 0;
+  }
+
+  if (ret)
+  {
+    chunk->index = job->chunk_count;
+    job->chunks[job->chunk_count] = chunk;
+    job->chunk_count++;
+    iMatrixExFindWake(job);
+  }
+
+  iMatrixExFindUnlock(job);
+
+  /* without the worker the chunk is matched here, the result is still posted */
+  if (ret && !job->started)
+    iMatrixExFindRunChunk(job, chunk);
+
+  return ret;
+}
+
+/* copies the next chunk of cells and queues it,
+   returns 1 if there is more to copy, 0 when the copy is complete and -1 if there is not enough memory */
+static int iMatrixExFindCopyChunk(Ihandle* ih, ImatExFindJob* job)
+{
+  int num_lin = IupGetInt(ih, "NUMLIN");
+  int c, cell_max = 0;
+  size_t buffer_size = 0, buffer_max = 0;
+  ImatExFindChunk* chunk = (ImatExFindChunk*)calloc(1, sizeof(ImatExFindChunk));
+  if (!chunk)
+    return -1;
+
+  if (job->col_count == 0)
+    job->lin = num_lin + 1;
+
+  for (; job->lin <= num_lin && chunk->cell_count < IMATEX_FIND_CHUNK; job->lin++)
+  {
+    if (!iupMatrixExIsLineVisible(ih, job->lin))
+      continue;
+
+    for (c = 0; c < job->col_count; c++)
+    {
+      size_t len;
+      char* value = iupMatrixExGetCellValue(ih, job->lin, job->cols[c], 1);  /* get displayed value */
+      if (!value || value[0] == 0)
+        continue;
+
+      len = strlen(value) + 1;
+      if (buffer_size + len > buffer_max)
+      {
+        size_t new_max = (buffer_size + len) + (buffer_size + len) / 2;
+        char* buffer = (char*)realloc(chunk->buffer, new_max);
+        if (!buffer)
+        {
+          iMatrixExFindFreeChunk(chunk);
+          return -1;
+        }
+        chunk->buffer = buffer;
+        buffer_max = new_max;
+      }
+
+      if (chunk->cell_count == cell_max)
+      {
+        int new_max = cell_max ? cell_max + cell_max / 2 : 1024;
+        size_t* offset = (size_t*)realloc(chunk->offset, new_max * sizeof(size_t));
+        ImatExFindCell* cells;
+        if (!offset)
+        {
+          iMatrixExFindFreeChunk(chunk);
+          return -1;
+        }
+        chunk->offset = offset;
+
+        cells = (ImatExFindCell*)realloc(chunk->cells, new_max * sizeof(ImatExFindCell));
+        if (!cells)
+        {
+          iMatrixExFindFreeChunk(chunk);
+          return -1;
+        }
+        chunk->cells = cells;
+        cell_max = new_max;
+      }
+
+      memcpy(chunk->buffer + buffer_size, value, len);
+      chunk->offset[chunk->cell_count] = buffer_size;
+      chunk->cells[chunk->cell_count].lin = job->lin;
+      chunk->cells[chunk->cell_count].col = job->cols[c];
+      chunk->cells[chunk->cell_count].marked = 0;
+      chunk->cell_count++;
+      buffer_size += len;
+    }
+  }
+
+  if (chunk->cell_count == 0)
+    iMatrixExFindFreeChunk(chunk);
+  else if (!iMatrixExFindQueueChunk(job, chunk))
+  {
+    iMatrixExFindFreeChunk(chunk);
+    return -1;
+  }
+
+  if (job->lin > num_lin)
+  {
+    /* the worker ends when the queue is empty */
+    iMatrixExFindLock(job);
+    job->copied = 1;
+    iMatrixExFindWake(job);
+    iMatrixExFindUnlock(job);
+    return 0;
+  }
+
+  IupPostMessage(job->msg, NULL, IMATEX_FIND_COPY, (double)job->generation, NULL);
+  return 1;
+}
+
+/* removes only the marks set by FINDALL */
+static void iMatrixExFindUnmark(Ihandle* ih, ImatExFind* find)
+{
+  int i;
+  for (i = 0; i < find->match_count; i++)
+  {
+    if (find->match[i].marked)
+      IupSetAttributeId2(ih, "MARK", find->match[i].lin, find->match[i].col, "0");
+  }
+}
+
+static void iMatrixExFindClear(ImatExFind* find)
+{
+  if (find->job)
+  {
+    iMatrixExFindDestroyJob(find->job);
+    find->job = NULL;
+  }
+
+  if (find->text)
+  {
+    free(find->text);
+    find->text = NULL;
+  }
+
+  if (find->match_by_col)
+  {
+    free(find->match_by_col);
+    find->match_by_col = NULL;
+  }
+  find->match_by_col_count = 0;
+
+  find->match_count = 0;
+}
+
+static void iMatrixExFindDone(ImatExData* matex_data, ImatExFind* find)
+{
+  IFnii cb = (IFnii)IupGetCallback(matex_data->ih, "FINDALL_CB");
+
+  if (find->job)
+  {
+    iMatrixExFindDestroyJob(find->job);
+    find->job = NULL;
+  }
+
+  if (cb)
+    cb(matex_data->ih, find->match_count, 0);
+}
+
+/* not enough memory, the search ends with the cells found so far */
+static void iMatrixExFindAbort(ImatExData* matex_data, ImatExFind* find)
+{
+  find->generation++;  /* the messages already posted are ignored */
+  IupSetAttribute(matex_data->ih, "REDRAW", "ALL");
+  iMatrixExFindDone(matex_data, find);
+}
+
+static int iMatrixExFindPostMessage_CB(Ihandle* msg, char* s, int chunk_index, double generation, void* p)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(msg, "_IUP_MATEX_DATA");
+  ImatExFind* find = matex_data->find;
+  ImatExFindJob* job = find->job;
+  Ihandle* ih = matex_data->ih;
+  int num_lin, num_col;
+  IFnii cb;
+
+  if (!job || job->generation != (int)generation)
+    return IUP_DEFAULT;  /* from a canceled search */
+
+  if (chunk_index == IMATEX_FIND_COPY)
+  {
+    int ret = iMatrixExFindCopyChunk(ih, job);
+    if (ret < 0)
+      iMatrixExFindAbort(matex_data, find);
+    else if (ret == 0 && job->chunk_done == job->chunk_count)
+      iMatrixExFindDone(matex_data, find);
+    return IUP_DEFAULT;
+  }
+
+  /* the queue is only changed in this thread, the lock is not necessary to read it */
+  job->chunks[chunk_index]->arrived = 1;
+
+  /* lines or columns may have been removed since the copy */
+  num_lin = IupGetInt(ih, "NUMLIN");
+  num_col = IupGetInt(ih, "NUMCOL");
+
+  /* the chunks are appended in order */
+  while (job->chunk_done < job->chunk_count && job->chunks[job->chunk_done]->arrived)
+  {
+    ImatExFindChunk* chunk = job->chunks[job->chunk_done];
+    int i;
+
+    if (chunk->failed)
+    {
+      iMatrixExFindAbort(matex_data, find);
+      return IUP_DEFAULT;
+    }
+
+    if (find->match_count + chunk->match_count > find->match_max)
+    {
+      int match_max = find->match_count + chunk->match_count;
+      ImatExFindCell* match;
+      match_max += match_max / 2;
+      match = (ImatExFindCell*)realloc(find->match, match_max * sizeof(ImatExFindCell));
+      if (!match)
+      {
+        iMatrixExFindAbort(matex_data, find);
+        return IUP_DEFAULT;
+      }
+      find->match = match;
+      find->match_max = match_max;
+    }
+
+    for (i = 0; i < chunk->match_count; i++)
+    {
+      ImatExFindCell* match = find->match + find->match_count;
+      if (chunk->match[i].lin > num_lin || chunk->match[i].col > num_col)
+        continue;
+
+      *match = chunk->match[i];
+
+      /* cells already marked by the user are kept as they are */
+      if (!IupGetIntId2(ih, "MARK", match->lin, match->col))
+      {
+        IupSetAttributeId2(ih, "MARK", match->lin, match->col, "1");
+        match->marked = 1;
+      }
+
+      find->match_count++;
+    }
+
+    /* the worker already took the chunk, it will not be used again */
+    iMatrixExFindFreeChunk(chunk);
+    job->chunks[job->chunk_done] = NULL;
+    job->chunk_done++;
+  }
+
+  IupSetAttribute(ih, "REDRAW", "ALL");
+
+  if (job->copied && job->chunk_done == job->chunk_count)
+    iMatrixExFindDone(matex_data, find);
+  else
+  {
+    cb = (IFnii)IupGetCallback(ih, "FINDALL_CB");
+    if (cb)
+      cb(ih, find->match_count, 1);
+  }
+
+  (void)s;
+  (void)p;
+  return IUP_DEFAULT;
+}
+
+static ImatExFind* iMatrixExFindGet(ImatExData* matex_data)
+{
+  if (!matex_data->find)
+  {
+    ImatExFind* find = (ImatExFind*)calloc(1, sizeof(ImatExFind));
+
+    find->msg = IupUser();
+    iupAttribSet(find->msg, "_IUP_MATEX_DATA", (char*)matex_data);
+    IupSetCallback(find->msg, "POSTMESSAGE_CB", (Icallback)iMatrixExFindPostMessage_CB);
+
+    matex_data->find = find;
+  }
+
+  return matex_data->find;
+}
+
+void iupMatrixExFindRelease(ImatExData* matex_data)
+{
+  ImatExFind* find = matex_data->find;
+
+  iMatrixExFindClear(find);
+
+  if (find->match)
+    free(find->match);
+
+  /* messages still in the queue are ignored, the handle will be invalid */
+  IupDestroy(find->msg);
+
+  free(find);
+  matex_data->find = NULL;
+}
+
+static int iMatrixExSetFindAllAttrib(Ihandle* ih, const char* value)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  ImatExFind* find;
+  int ret;
+
+  if (!matex_data->find && (!value || value[0] == 0))
+    return 0;
+
+  find = iMatrixExFindGet(matex_data);
+
+  iMatrixExFindUnmark(ih, find);
+  iMatrixExFindClear(find);
+  find->generation++;
+
+  if (!value || value[0] == 0)
+  {
+    IupSetAttribute(ih, "REDRAW", "ALL");
+    return 0;
+  }
+
+  find->text = iupStrDup(value);
+  find->matchcase = iupAttribGetInt(ih, "FINDMATCHCASE");
+  find->matchwholecell = iupAttribGetInt(ih, "FINDMATCHWHOLECELL");
+  find->find_col = iupAttribGetInt(ih, "FINDCOL");
+  find->utf8 = IupGetInt(NULL, "UTF8MODE");
+  find->version = iupMatrixExGetValuesVersion(ih);
+
+  /* initialize the character maps here and not in the worker */
+  iupStrCompareEqual("", "", 0, 0, 0);
+
+  find->job = iMatrixExFindCreateJob(matex_data, find);
+  if (!find->job)
+  {
+    iMatrixExFindAbort(matex_data, find);
+    return 0;
+  }
+
+  ret = iMatrixExFindCopyChunk(ih, find->job);
+  if (ret < 0)
+    iMatrixExFindAbort(matex_data, find);
+  else if (ret == 0 && find->job->chunk_count == 0)
+  {
+    IupSetAttribute(ih, "REDRAW", "ALL");
+    iMatrixExFindDone(matex_data, find);
+  }
+
+  return 0;
+}
+
+static char* iMatrixExGetFindAllAttrib(Ihandle* ih)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  if (!matex_data->find)
+    return NULL;
+  return iupStrReturnStr(matex_data->find->text);
+}
+
+static char* iMatrixExGetMatchCountAttrib(Ihandle* ih)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  if (!matex_data->find)
+    return "0";
+  return iupStrReturnInt(matex_data->find->match_count);
+}
+
+static char* iMatrixExGetFindAllRunningAttrib(Ihandle* ih)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  return iupStrReturnBoolean(matex_data->find && matex_data->find->job);
+}
+
+static int iMatrixExFindCompareCol(const void* a, const void* b)
+{
+  const ImatExFindCell* c1 = (const ImatExFindCell*)a;
+  const ImatExFindCell* c2 = (const ImatExFindCell*)b;
+  if (c1->col != c2->col)
+    return c1->col < c2->col ? -1 : 1;
+  if (c1->lin != c2->lin)
+    return c1->lin < c2->lin ? -1 : 1;
+  return 0;
+}
+
+/* returns the number of matches before lin:col, or before and at lin:col when "at" is set */
+static int iMatrixExFindBound(const ImatExFindCell* match, int count, int lin, int col, int flip, int at)
+{
+  int lo = 0, hi = count;
+
+  while (lo < hi)
+  {
+    int mid = lo + (hi - lo) / 2;
+    int key1 = flip ? match[mid].col : match[mid].lin,
+        key2 = flip ? match[mid].lin : match[mid].col,
+        ref1 = flip ? col : lin,
+        ref2 = flip ? lin : col;
+
+    if (key1 < ref1 || (key1 == ref1 && (key2 < ref2 || (at && key2 == ref2))))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/* returns -1 if the FINDALL result can not be used */
+static int iMatrixExFindIndex(Ihandle* ih, const char* value, int inc, int flip, int matchcase, int matchwholecell, int find_col, int *lin, int *col, int search_cur_cell)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  ImatExFind* find = matex_data->find;
+  const ImatExFindCell* match;
+  int pos;
+
+  if (!find || !find->text || find->job || find->match_count == 0 ||
+      strcmp(find->text, value) != 0 ||
+      find->matchcase != matchcase || find->matchwholecell != matchwholecell ||
+      find->find_col != find_col || find->utf8 != IupGetInt(NULL, "UTF8MODE") ||
+      find->version != iupMatrixExGetValuesVersion(ih))  /* cells were edited, moved or sorted since the search */
+    return -1;
+
+  if (flip)
+  {
+    if (find->match_by_col_count != find->match_count)
+    {
+      find->match_by_col = (ImatExFindCell*)realloc(find->match_by_col, find->match_count * sizeof(ImatExFindCell));
+      memcpy(find->match_by_col, find->match, find->match_count * sizeof(ImatExFindCell));
+      qsort(find->match_by_col, find->match_count, sizeof(ImatExFindCell), iMatrixExFindCompareCol);
+      find->match_by_col_count = find->match_count;
+    }
+    match = find->match_by_col;
+  }
+  else
+    match = find->match;
+
+  if (inc > 0)
+  {
+    pos = iMatrixExFindBound(match, find->match_count, *lin, *col, flip, !search_cur_cell);
+    if (pos == find->match_count)
+      pos = 0;
+  }
+  else
+  {
+    pos = iMatrixExFindBound(match, find->match_count, *lin, *col, flip, search_cur_cell) - 1;
+    if (pos < 0)
+      pos = find->match_count - 1;
+  }
+
+  /* the cells may have changed since the search */
+  if (!iupMatrixExIsLineVisible(ih, match[pos].lin) || !iupMatrixExIsColumnVisible(ih, match[pos].col) ||
+      !iMatrixMatch(ih, value, match[pos].lin, match[pos].col, matchcase, matchwholecell, find->utf8))
+    return -1;
+
+  *lin = match[pos].lin;
+  *col = match[pos].col;
+  return 1;
+}
+
 static int iMatrixExSetFind(Ihandle *ih, const char* value, int inc, int flip, int matchcase, int matchwholecell, int find_col, int *lin, int *col, int search_cur_cell)
 {
   int utf8 = IupGetInt(NULL, "UTF8MODE");
@@ -349,12 +1144,26 @@ static int iMatrixExSetFindAttrib(Ihandle *ih, const char* value)
       search_cur_cell = 1;  /* search in the current cell */
   }
 
-  if (iMatrixExSetFind(ih, value, inc, flip, matchcase, matchwholecell, find_col, &lin, &col, search_cur_cell))
+  if (iMatrixExFindIndex(ih, value, inc, flip, matchcase, matchwholecell, find_col, &lin, &col, search_cur_cell) == 1 ||
+      iMatrixExSetFind(ih, value, inc, flip, matchcase, matchwholecell, find_col, &lin, &col, search_cur_cell))
   {
     IupSetfAttribute(ih,"FOCUSCELL", "%d:%d", lin, col);
     IupSetfAttribute(ih,"SHOW", "%d:%d", lin, col);
-    IupSetAttribute(ih,"MARKED",NULL);
-    IupSetAttributeId2(ih,"MARK",lin,col,"1");
+    /* remove only the mark of the previous find, keep the user selection */
+    {
+      int mark_lin=0, mark_col=0;
+      if (IupGetIntInt(ih, "_IUP_FIND_MARKED", &mark_lin, &mark_col) == 2)
+      {
+        IupSetAttributeId2(ih,"MARK",mark_lin,mark_col,"0");
+        IupSetfAttribute(ih,"REDRAW","L%d", mark_lin);
+      }
+      IupSetAttribute(ih,"_IUP_FIND_MARKED", NULL);
+    }
+    if (!IupGetIntId2(ih,"MARK",lin,col))
+    {
+      IupSetAttributeId2(ih,"MARK",lin,col,"1");
+      IupSetfAttribute(ih,"_IUP_FIND_MARKED", "%d:%d", lin, col);
+    }
     IupSetfAttribute(ih,"REDRAW","L%d", lin);
     IupSetfAttribute(ih,"_IUP_LAST_FOUND", "%d:%d", lin, col);
     IupSetFocus(ih);
@@ -373,4 +1182,10 @@ void iupMatrixExRegisterFind(Iclass* ic)
   iupClassRegisterAttribute(ic, "FINDMATCHCASE", NULL, NULL, IUPAF_SAMEASSYSTEM, "Yes", IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "FINDMATCHWHOLECELL", NULL, NULL, IUPAF_SAMEASSYSTEM, "Yes", IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "FINDCOL", NULL, NULL, IUPAF_SAMEASSYSTEM, NULL, IUPAF_NO_INHERIT);
+
+  iupClassRegisterCallback(ic, "FINDALL_CB", "ii");
+
+  iupClassRegisterAttribute(ic, "FINDALL", iMatrixExGetFindAllAttrib, iMatrixExSetFindAllAttrib, NULL, NULL, IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "FINDALLRUNNING", iMatrixExGetFindAllRunningAttrib, NULL, NULL, NULL, IUPAF_READONLY | IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "MATCHCOUNT", iMatrixExGetMatchCountAttrib, NULL, NULL, NULL, IUPAF_READONLY | IUPAF_NO_INHERIT);
 }
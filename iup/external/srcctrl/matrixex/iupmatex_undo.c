@@ -18,17 +18,40 @@
 
 static IattribSetFunc iMatrixSetUndoRedoAttrib = NULL;
 
+/* Each undo level is a journal of the changed cells, in the order they were changed.
+   Cells changed in sequence along a line or a column are stored as a single run,
+   and the values of all cells are stored in a single buffer. */
+
+typedef struct _IundoRun {
+  int lin, col;
+  int count;
+  int along_col;   /* next cell is in the next line, else in the next column */
+} IundoRun;
+
 typedef struct _IundoData {
   int cell_count;
   const char* name;
-  Itable* data_table;
+
+  IundoRun* runs;
+  int run_count, run_alloc;
+
+  int* offsets;        /* offset of the value of each cell in the buffer, -1 is a NULL value */
+  int offset_alloc;
+
+  char* buffer;        /* values of all the cells, each with its terminator */
+  int buffer_size, buffer_alloc;
 } IundoData;
 
-static void iMatrixExUndoDataInit(IundoData* undo_data, const char* name)
+static size_t iMatrixExUndoDataMemory(IundoData* undo_data)
 {
-  undo_data->cell_count = 0;
+  return sizeof(IundoData) + undo_data->run_alloc * sizeof(IundoRun) +
+         undo_data->offset_alloc * sizeof(int) + undo_data->buffer_alloc;
+}
+
+static void iMatrixExUndoDataInit(ImatExData* matex_data, IundoData* undo_data, const char* name)
+{
+  memset(undo_data, 0, sizeof(IundoData));
   undo_data->name = name;
-  undo_data->data_table = iupTableCreate(IUPTABLE_STRINGINDEXED);
 
   if (name)
   {
@@ -38,55 +61,181 @@ static void iMatrixExUndoDataInit(IundoData* undo_data, const char* name)
     if (name != str)
       undo_data->name = name;
   }
+
+  matex_data->undo_memory += iMatrixExUndoDataMemory(undo_data);
 }
 
-static void iMatrixExUndoDataClear(IundoData* undo_data)
+static void iMatrixExUndoDataClear(ImatExData* matex_data, IundoData* undo_data)
 {
-  iupTableDestroy(undo_data->data_table);
+  matex_data->undo_memory -= iMatrixExUndoDataMemory(undo_data);
+
+  if (undo_data->runs) free(undo_data->runs);
+  if (undo_data->offsets) free(undo_data->offsets);
+  if (undo_data->buffer) free(undo_data->buffer);
   memset(undo_data, 0, sizeof(IundoData));
 }
 
-static void iMatrixExUndoDataAddCell(IundoData* undo_data, int lin, int col, const char* value)
+static int iMatrixExUndoBufferAdd(char** buffer, int *buffer_size, int *buffer_alloc, const char* value)
 {
-  char id[40];
-  snprintf(id, sizeof(id), "%d:%d", lin, col);
+  int offset, len;
+
   if (!value)
-    iupTableSet(undo_data->data_table, id, (void*)"", IUPTABLE_POINTER);  /* store NULL pointers so they can be restored later */
-  else
-    iupTableSet(undo_data->data_table, id, (void*)value, IUPTABLE_STRING);
-  undo_data->cell_count++;
+    return -1;
+
+  len = (int)strlen(value) + 1;
+  if (*buffer_size + len > *buffer_alloc)
+  {
+    int alloc = *buffer_alloc ? 2 * (*buffer_alloc) : 1024;
+    while (alloc < *buffer_size + len)
+      alloc *= 2;
+    *buffer = (char*)realloc(*buffer, alloc);
+    *buffer_alloc = alloc;
+  }
+
+  offset = *buffer_size;
+  memcpy(*buffer + offset, value, len);
+  *buffer_size += len;
+  return offset;
 }
 
-static int iMatrixExUndoDataSwap(ImatExData* matex_data, IundoData* undo_data)
+static int iMatrixExUndoRunExtend(IundoRun* run, int lin, int col)
 {
-  char* id = iupTableFirst(undo_data->data_table);
-  while (id)
+  if ((run->count == 1 || !run->along_col) && lin == run->lin && col == run->col + run->count)
   {
-    char *value, *old_value;
-    int lin=1, col=1;
-    iupStrToIntInt(id, &lin, &col, ':');
+    run->along_col = 0;
+    run->count++;
+    return 1;
+  }
 
-    value = (char*)iupTableGetCurr(undo_data->data_table);
+  if ((run->count == 1 || run->along_col) && col == run->col && lin == run->lin + run->count)
+  {
+    run->along_col = 1;
+    run->count++;
+    return 1;
+  }
 
-    old_value = iupStrDup(iupMatrixExGetCellValue(matex_data->ih, lin, col, 0));  /* get internal value */
+  return 0;
+}
 
-    iupMatrixExSetCellValue(matex_data->ih, lin, col, value);
+static void iMatrixExUndoDataAddCell(ImatExData* matex_data, IundoData* undo_data, int lin, int col, const char* value)
+{
+  size_t memory = iMatrixExUndoDataMemory(undo_data);
 
-    if (!old_value)
-      iupTableSetCurr(undo_data->data_table, (void*)"", IUPTABLE_POINTER);
-    else
+  if (!undo_data->run_count || !iMatrixExUndoRunExtend(undo_data->runs + undo_data->run_count - 1, lin, col))
+  {
+    IundoRun* run;
+
+    if (undo_data->run_count == undo_data->run_alloc)
     {
-      iupTableSetCurr(undo_data->data_table, (void*)old_value, IUPTABLE_STRING);
-      free(old_value);
+      undo_data->run_alloc = undo_data->run_alloc ? 2 * undo_data->run_alloc : 16;
+      undo_data->runs = (IundoRun*)realloc(undo_data->runs, undo_data->run_alloc * sizeof(IundoRun));
     }
 
-    if (!iupMatrixExBusyInc(matex_data))
-      return 0;
+    run = undo_data->runs + undo_data->run_count;
+    run->lin = lin;
+    run->col = col;
+    run->count = 1;
+    run->along_col = 0;
+    undo_data->run_count++;
+  }
+
+  if (undo_data->cell_count == undo_data->offset_alloc)
+  {
+    undo_data->offset_alloc = undo_data->offset_alloc ? 2 * undo_data->offset_alloc : 64;
+    undo_data->offsets = (int*)realloc(undo_data->offsets, undo_data->offset_alloc * sizeof(int));
+  }
+
+  undo_data->offsets[undo_data->cell_count] = iMatrixExUndoBufferAdd(&undo_data->buffer, &undo_data->buffer_size, &undo_data->buffer_alloc, value);
+  undo_data->cell_count++;
+
+  matex_data->undo_memory += iMatrixExUndoDataMemory(undo_data) - memory;
+}
+
+/* Restore the stored values and store the current values in their place.
+   Undo is done in reverse order, so a cell changed more than once gets its first value,
+   and redo is done in the recorded order. */
+static int iMatrixExUndoDataSwap(ImatExData* matex_data, IundoData* undo_data, int reverse)
+{
+  char* buffer = NULL;
+  int buffer_size = 0, buffer_alloc = 0;
+  size_t memory = iMatrixExUndoDataMemory(undo_data);
+  int n, cell = reverse ? undo_data->cell_count : 0;
+  int ret = 1;
+
+  for (n = 0; n < undo_data->run_count; n++)
+  {
+    IundoRun* run = undo_data->runs + (reverse ? undo_data->run_count - 1 - n : n);
+    int i;
+
+    if (reverse)
+      cell -= run->count;
 
-    id = iupTableNext(undo_data->data_table);
+    for (i = 0; i < run->count; i++)
+    {
+      int pos = reverse ? run->count - 1 - i : i;
+      int* offset = undo_data->offsets + cell + pos;
+      const char* value = (*offset < 0) ? NULL : undo_data->buffer + *offset;
+      int lin = run->lin, col = run->col;
+
+      if (run->along_col)
+        lin += pos;
+      else
+        col += pos;
+
+      if (ret)
+      {
+        *offset = iMatrixExUndoBufferAdd(&buffer, &buffer_size, &buffer_alloc, iupMatrixExGetCellValue(matex_data->ih, lin, col, 0));  /* get internal value */
+
+        iupMatrixExSetCellValue(matex_data->ih, lin, col, value);
+
+        if (!iupMatrixExBusyInc(matex_data))
+          ret = 0;
+      }
+      else
+        *offset = iMatrixExUndoBufferAdd(&buffer, &buffer_size, &buffer_alloc, value);  /* aborted, keep the stored value */
+    }
+
+    if (!reverse)
+      cell += run->count;
   }
 
-  return 1;
+  if (undo_data->buffer)
+    free(undo_data->buffer);
+  undo_data->buffer = buffer;
+  undo_data->buffer_size = buffer_size;
+  undo_data->buffer_alloc = buffer_alloc;
+
+  matex_data->undo_memory += iMatrixExUndoDataMemory(undo_data) - memory;
+
+  return ret;
+}
+
+/* Remove the oldest undo levels and then the last redo levels until the memory is inside the limit,
+   but keep the level being recorded or the last recorded level. */
+static void iMatrixExUndoCheckMemory(ImatExData* matex_data)
+{
+  if (!matex_data->undo_max_memory)
+    return;
+
+  while (matex_data->undo_memory > matex_data->undo_max_memory)
+  {
+    int undo_stack_count = iupArrayCount(matex_data->undo_stack);
+    IundoData* undo_stack_data = (IundoData*)iupArrayGetData(matex_data->undo_stack);
+
+    if (matex_data->undo_stack_pos > (matex_data->undo_stack_hold ? 0 : 1))
+    {
+      iMatrixExUndoDataClear(matex_data, &(undo_stack_data[0]));
+      iupArrayRemove(matex_data->undo_stack, 0, 1);
+      matex_data->undo_stack_pos--;
+    }
+    else if (undo_stack_count > matex_data->undo_stack_pos + matex_data->undo_stack_hold)
+    {
+      iMatrixExUndoDataClear(matex_data, &(undo_stack_data[undo_stack_count - 1]));
+      iupArrayRemove(matex_data->undo_stack, undo_stack_count - 1, 1);
+    }
+    else
+      break;
+  }
 }
 
 static void iMatrixExUndoStackInit(ImatExData* matex_data)
@@ -102,11 +251,11 @@ static void iMatrixUndoStackAdd(ImatExData* matex_data, const char* name)
 
   /* Remove all Redo data */
   for (i=matex_data->undo_stack_pos; i<undo_stack_count; i++)
-    iMatrixExUndoDataClear(&(undo_stack_data[i]));
+    iMatrixExUndoDataClear(matex_data, &(undo_stack_data[i]));
   iupArrayRemove(matex_data->undo_stack, matex_data->undo_stack_pos, undo_stack_count-matex_data->undo_stack_pos);
 
   undo_stack_data = (IundoData*)iupArrayInc(matex_data->undo_stack);
-  iMatrixExUndoDataInit(&(undo_stack_data[matex_data->undo_stack_pos]), name);
+  iMatrixExUndoDataInit(matex_data, &(undo_stack_data[matex_data->undo_stack_pos]), name);
 }
 
 void iupMatrixExUndoPushBegin(ImatExData* matex_data, const char* name)
@@ -135,16 +284,18 @@ static int iMatrixSetUndoPushCellAttrib(Ihandle* ih, int lin, int col, const cha
   if (matex_data->undo_stack_hold)
   {
     undo_stack_data = (IundoData*)iupArrayGetData(matex_data->undo_stack);
-    iMatrixExUndoDataAddCell(&(undo_stack_data[matex_data->undo_stack_pos]), lin, col, value);
+    iMatrixExUndoDataAddCell(matex_data, &(undo_stack_data[matex_data->undo_stack_pos]), lin, col, value);
   }
   else
   {
     iMatrixUndoStackAdd(matex_data, "SETCELL");
     undo_stack_data = (IundoData*)iupArrayGetData(matex_data->undo_stack);
-    iMatrixExUndoDataAddCell(&(undo_stack_data[matex_data->undo_stack_pos]), lin, col, value);
+    iMatrixExUndoDataAddCell(matex_data, &(undo_stack_data[matex_data->undo_stack_pos]), lin, col, value);
     matex_data->undo_stack_pos++;
   }
 
+  iMatrixExUndoCheckMemory(matex_data);
+
   return 0;
 }
 
@@ -157,7 +308,7 @@ static int iMatrixSetUndoClearAttrib(Ihandle* ih, const char* value)
     int i;
     IundoData* undo_stack_data = (IundoData*)iupArrayGetData(matex_data->undo_stack);
     for (i=0; i<undo_stack_count; i++)
-      iMatrixExUndoDataClear(&(undo_stack_data[i]));
+      iMatrixExUndoDataClear(matex_data, &(undo_stack_data[i]));
     iupArrayRemove(matex_data->undo_stack, 0, undo_stack_count);
     matex_data->undo_stack_pos = 0;
   }
@@ -165,6 +316,31 @@ static int iMatrixSetUndoClearAttrib(Ihandle* ih, const char* value)
   return 0;
 }
 
+static int iMatrixSetUndoMaxMemoryAttrib(Ihandle* ih, const char* value)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  double max_memory = 0;
+  iupStrToDouble(value, &max_memory);
+  if (max_memory < 0) max_memory = 0;
+  matex_data->undo_max_memory = (size_t)max_memory;
+
+  if (matex_data->undo_stack)
+    iMatrixExUndoCheckMemory(matex_data);
+  return 0;
+}
+
+static char* iMatrixGetUndoMaxMemoryAttrib(Ihandle* ih)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  return iupStrReturnStrf("%.0f", (double)matex_data->undo_max_memory);
+}
+
+static char* iMatrixGetUndoMemoryAttrib(Ihandle* ih)
+{
+  ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
+  return iupStrReturnStrf("%.0f", (double)matex_data->undo_memory);
+}
+
 static char* iMatrixGetUndoCountAttrib(Ihandle* ih)
 {
   ImatExData* matex_data = (ImatExData*)iupAttribGet(ih, "_IUP_MATEX_DATA");
@@ -211,7 +387,7 @@ static int iMatrixSetUndoAttrib(Ihandle* ih, const char* value)
 
     for (i=0; i<count; i++)
     {
-      if (!iMatrixExUndoDataSwap(matex_data, &(undo_stack_data[matex_data->undo_stack_pos-1 - i])))
+      if (!iMatrixExUndoDataSwap(matex_data, &(undo_stack_data[matex_data->undo_stack_pos-1 - i]), 1))
       {
         matex_data->undo_stack_pos -= i;
         iMatrixSetUndoRedoAttrib(ih, "Yes");
@@ -223,6 +399,8 @@ static int iMatrixSetUndoAttrib(Ihandle* ih, const char* value)
     iMatrixSetUndoRedoAttrib(ih, "Yes");
     matex_data->undo_stack_pos -= i;
 
+    iMatrixExUndoCheckMemory(matex_data);
+
     iupBaseCallValueChangedCb(ih);
   }
   return 0;
@@ -267,7 +445,7 @@ static int iMatrixSetRedoAttrib(Ihandle* ih, const char* value)
 
     for (i=0; i<count; i++)
     {
-      if (!iMatrixExUndoDataSwap(matex_data, &(undo_stack_data[matex_data->undo_stack_pos + i])))
+      if (!iMatrixExUndoDataSwap(matex_data, &(undo_stack_data[matex_data->undo_stack_pos + i]), 0))
       {
         matex_data->undo_stack_pos += i;
         iMatrixSetUndoRedoAttrib(ih, "Yes");
@@ -279,6 +457,8 @@ static int iMatrixSetRedoAttrib(Ihandle* ih, const char* value)
     iMatrixSetUndoRedoAttrib(ih, "Yes");
     matex_data->undo_stack_pos += i;
 
+    iMatrixExUndoCheckMemory(matex_data);
+
     iupBaseCallValueChangedCb(ih);
   }
   return 0;
@@ -412,6 +592,8 @@ void iupMatrixExRegisterUndo(Iclass* ic)
   iupClassRegisterAttribute(ic, "UNDOCLEAR", NULL, iMatrixSetUndoClearAttrib, NULL, NULL, IUPAF_WRITEONLY|IUPAF_NO_INHERIT);
   iupClassRegisterAttributeId(ic, "UNDONAME", iMatrixGetUndoNameAttrib, NULL, IUPAF_READONLY|IUPAF_NO_INHERIT);
   iupClassRegisterAttribute(ic, "UNDOCOUNT", iMatrixGetUndoCountAttrib, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "UNDOMAXMEMORY", iMatrixGetUndoMaxMemoryAttrib, iMatrixSetUndoMaxMemoryAttrib, NULL, NULL, IUPAF_NO_DEFAULTVALUE|IUPAF_NO_INHERIT);
+  iupClassRegisterAttribute(ic, "UNDOMEMORY", iMatrixGetUndoMemoryAttrib, NULL, NULL, NULL, IUPAF_READONLY|IUPAF_NO_INHERIT);
 
   /* Internal attributes */
   iupClassRegisterAttributeId2(ic, "UNDOPUSHCELL", NULL, iMatrixSetUndoPushCellAttrib, IUPAF_WRITEONLY|IUPAF_NO_INHERIT);
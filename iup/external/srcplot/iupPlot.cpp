@@ -13,7 +13,8 @@ iupPlot::iupPlot(Ihandle* _ih, int inDefaultFontStyle, int inDefaultFontSize)
    mGrid(true), mGridMinor(false), mViewportSquare(false), mScaleEqual(false), mHighlightMode(IUP_PLOT_HIGHLIGHT_NONE),
    mDefaultFontSize(inDefaultFontSize), mDefaultFontStyle(inDefaultFontStyle), mScreenTolerance(5),
    mAxisX(inDefaultFontStyle, inDefaultFontSize), mAxisY(inDefaultFontStyle, inDefaultFontSize),
-   mCrossHairX(0), mCrossHairY(0), mShowSelectionBand(false), mDataSetListMax(20), mDataSetClipping(IUP_PLOT_CLIPAREA)
+   mCrossHairX(0), mCrossHairY(0), mShowSelectionBand(false), mDataSetListMax(20), mDataSetClipping(IUP_PLOT_CLIPAREA),
+   mBackLayer(NULL), mFrontLayer(NULL), mLayerKey(0), mLayerValid(false)
 {
   mDataSetList = (iupPlotDataSet**)malloc(sizeof(iupPlotDataSet*)* mDataSetListMax); /* use malloc because we will use realloc */
   memset(mDataSetList, 0, sizeof(iupPlotDataSet*)* mDataSetListMax);
@@ -23,6 +24,11 @@ iupPlot::~iupPlot()
 {
   RemoveAllDataSets();
   free(mDataSetList);  /* use free because we used malloc */
+
+  if (mBackLayer)
+    iupDrawLayerKill(mBackLayer);
+  if (mFrontLayer)
+    iupDrawLayerKill(mFrontLayer);
 }
 
 void iupPlot::SetViewport(int x, int y, int w, int h)
@@ -458,47 +464,21 @@ bool iupPlot::PrepareRender(iupPlotDrawContext* ctx)
   return true;
 }
 
-bool iupPlot::Render(iupPlotDrawContext* ctx)
+unsigned int iupPlot::GetLayerKey() const
 {
-  ctx->viewportX = mViewport.mX;
-  ctx->viewportY = mViewport.mY;
-  ctx->viewportW = mViewport.mWidth;
-  ctx->viewportH = mViewport.mHeight;
-
-  DrawBackground(ctx);
-
-  {
-    int clipX1 = iupPlotDrawCalcX(ctx, 0);
-    int clipY1 = iupPlotDrawCalcY(ctx, mViewport.mHeight - 1);
-    int clipX2 = iupPlotDrawCalcX(ctx, mViewport.mWidth - 1);
-    int clipY2 = iupPlotDrawCalcY(ctx, 0);
-    IupDrawSetClipRect(ctx->ih, clipX1, clipY1, clipX2, clipY2);
-  }
-
-  if (!mDataSetListCount)
-    return true;
-
-  iupPlotRect theDataSetArea;
-  theDataSetArea.mX = mBack.mMargin.mLeft + mBack.mHorizPadding;
-  theDataSetArea.mY = mBack.mMargin.mBottom + mBack.mVertPadding;
-  theDataSetArea.mWidth = mViewport.mWidth - mBack.mMargin.mLeft - mBack.mMargin.mRight - 2 * mBack.mHorizPadding;
-  theDataSetArea.mHeight = mViewport.mHeight - mBack.mMargin.mTop - mBack.mMargin.mBottom - 2 * mBack.mVertPadding;
-
-  if (!CalculateTickSpacing(theDataSetArea, ih))
-  {
-    return false;
-  }
+  // samples can be changed without setting mRedraw
+  unsigned int theKey = (unsigned int)mDataSetListCount;
+  for (int ds = 0; ds < mDataSetListCount; ds++)
+    theKey = theKey * 31 + (unsigned int)mDataSetList[ds]->GetDataVersion();
 
-  if (!CalculateXTransformation(theDataSetArea))
-  {
-    return false;
-  }
+  if (!IupGetInt(ih, "ACTIVE"))
+    theKey = ~theKey;
 
-  if (!CalculateYTransformation(theDataSetArea))
-  {
-    return false;
-  }
+  return theKey;
+}
 
+bool iupPlot::DrawDataLayer(const iupPlotRect &inDataSetArea, iupPlotDrawContext* ctx)
+{
   IFn pre_cb = (IFn)IupGetCallback(ih, "PREDRAW_CB");
   if (pre_cb)
     pre_cb(ih);
@@ -506,28 +486,28 @@ bool iupPlot::Render(iupPlotDrawContext* ctx)
   if (mBack.GetImage())
     DrawBackgroundImage(ctx);
 
-  if (!mGrid.DrawX(mAxisX.mTickIter, mAxisX.mTrafo, theDataSetArea, ctx))
+  if (!mGrid.DrawX(mAxisX.mTickIter, mAxisX.mTrafo, inDataSetArea, ctx))
     return false;
 
   if (mGrid.mShowX)
-    mGridMinor.DrawX(mAxisX.mTickIter, mAxisX.mTrafo, theDataSetArea, ctx);
+    mGridMinor.DrawX(mAxisX.mTickIter, mAxisX.mTrafo, inDataSetArea, ctx);
 
-  if (!mGrid.DrawY(mAxisY.mTickIter, mAxisY.mTrafo, theDataSetArea, ctx))
+  if (!mGrid.DrawY(mAxisY.mTickIter, mAxisY.mTrafo, inDataSetArea, ctx))
     return false;
 
   if (mGrid.mShowY)
-    mGridMinor.DrawY(mAxisY.mTickIter, mAxisY.mTrafo, theDataSetArea, ctx);
+    mGridMinor.DrawY(mAxisY.mTickIter, mAxisY.mTrafo, inDataSetArea, ctx);
 
-  if (!mAxisX.DrawX(theDataSetArea, ctx, mAxisY))
+  if (!mAxisX.DrawX(inDataSetArea, ctx, mAxisY))
     return false;
 
-  if (!mAxisY.DrawY(theDataSetArea, ctx, mAxisX))
+  if (!mAxisY.DrawY(inDataSetArea, ctx, mAxisX))
     return false;
 
   if (mBox.mShow)
-    mBox.Draw(theDataSetArea, ctx);
+    mBox.Draw(inDataSetArea, ctx);
 
-  DataSetClipArea(ctx, theDataSetArea.mX, theDataSetArea.mX + theDataSetArea.mWidth - 1, theDataSetArea.mY, theDataSetArea.mY + theDataSetArea.mHeight - 1);
+  DataSetClipArea(ctx, inDataSetArea.mX, inDataSetArea.mX + inDataSetArea.mWidth - 1, inDataSetArea.mY, inDataSetArea.mY + inDataSetArea.mHeight - 1);
 
   IFniiddi drawsample_cb = (IFniiddi)IupGetCallback(ih, "DRAWSAMPLE_CB");
 
@@ -549,6 +529,117 @@ bool iupPlot::Render(iupPlotDrawContext* ctx)
     dataset->DrawData(mAxisX.mTrafo, mAxisY.mTrafo, ctx, &theNotify);
   }
 
+  return true;
+}
+
+bool iupPlot::DrawFrontLayer(const iupPlotRect &inDataSetArea, iupPlotDrawContext* ctx)
+{
+  iupPlotDataSet* pie_dataset = HasPie();
+  if (pie_dataset)
+    DrawSampleColorLegend(pie_dataset, inDataSetArea, ctx, mLegend.mPos);
+  else if (!DrawLegend(inDataSetArea, ctx, mLegend.mPos))
+    return false;
+
+  {
+    int clipX1 = iupPlotDrawCalcX(ctx, 0);
+    int clipY1 = iupPlotDrawCalcY(ctx, mViewport.mHeight - 1);
+    int clipX2 = iupPlotDrawCalcX(ctx, mViewport.mWidth - 1);
+    int clipY2 = iupPlotDrawCalcY(ctx, 0);
+    IupDrawSetClipRect(ctx->ih, clipX1, clipY1, clipX2, clipY2);
+  }
+
+  DrawTitle(ctx);
+
+  if (!IupGetInt(ih, "ACTIVE"))
+    DrawInactive(ctx);
+
+  return true;
+}
+
+bool iupPlot::Render(iupPlotDrawContext* ctx)
+{
+  ctx->viewportX = mViewport.mX;
+  ctx->viewportY = mViewport.mY;
+  ctx->viewportW = mViewport.mWidth;
+  ctx->viewportH = mViewport.mHeight;
+
+  iupPlotRect theDataSetArea;
+  theDataSetArea.mX = mBack.mMargin.mLeft + mBack.mHorizPadding;
+  theDataSetArea.mY = mBack.mMargin.mBottom + mBack.mVertPadding;
+  theDataSetArea.mWidth = mViewport.mWidth - mBack.mMargin.mLeft - mBack.mMargin.mRight - 2 * mBack.mHorizPadding;
+  theDataSetArea.mHeight = mViewport.mHeight - mBack.mMargin.mTop - mBack.mMargin.mBottom - 2 * mBack.mVertPadding;
+
+  if (!mDataSetListCount ||
+      !CalculateTickSpacing(theDataSetArea, ih) ||
+      !CalculateXTransformation(theDataSetArea) ||
+      !CalculateYTransformation(theDataSetArea))
+  {
+    DrawBackground(ctx);
+
+    int clipX1 = iupPlotDrawCalcX(ctx, 0);
+    int clipY1 = iupPlotDrawCalcY(ctx, mViewport.mHeight - 1);
+    int clipX2 = iupPlotDrawCalcX(ctx, mViewport.mWidth - 1);
+    int clipY2 = iupPlotDrawCalcY(ctx, 0);
+    IupDrawSetClipRect(ctx->ih, clipX1, clipY1, clipX2, clipY2);
+
+    mLayerValid = false;
+    return mDataSetListCount == 0;
+  }
+
+  // The background, the grid, the axis and the datasets are kept in a layer,
+  // and the legend and the title in another, so the crosshair, the highlight and the selection band
+  // can be drawn over them without drawing all the samples again.
+  unsigned int theLayerKey = GetLayerKey();
+  bool theRedraw = mRedraw || !mLayerValid || theLayerKey != mLayerKey;
+
+  if (theRedraw || !iupDrawLayerPlay(ih, mBackLayer))
+  {
+    theRedraw = true;
+
+    struct _IdrawList* theLayer = iupDrawLayerBegin(ih, mBackLayer);
+    if (theLayer)
+      mBackLayer = theLayer;
+
+    DrawBackground(ctx);
+
+    {
+      int clipX1 = iupPlotDrawCalcX(ctx, 0);
+      int clipY1 = iupPlotDrawCalcY(ctx, mViewport.mHeight - 1);
+      int clipX2 = iupPlotDrawCalcX(ctx, mViewport.mWidth - 1);
+      int clipY2 = iupPlotDrawCalcY(ctx, 0);
+      IupDrawSetClipRect(ctx->ih, clipX1, clipY1, clipX2, clipY2);
+    }
+
+    bool theDrawn = DrawDataLayer(theDataSetArea, ctx);
+
+    if (theLayer)
+      iupDrawLayerEnd(ih, theLayer);
+
+    if (!theDrawn)
+    {
+      mLayerValid = false;
+      return false;
+    }
+  }
+
+  DataSetClipArea(ctx, theDataSetArea.mX, theDataSetArea.mX + theDataSetArea.mWidth - 1, theDataSetArea.mY, theDataSetArea.mY + theDataSetArea.mHeight - 1);
+
+  IFniiddi drawsample_cb = (IFniiddi)IupGetCallback(ih, "DRAWSAMPLE_CB");
+
+  iupPlotDataSet* pie_dataset = HasPie();
+
+  for (int ds = 0; ds < mDataSetListCount; ds++)
+  {
+    iupPlotDataSet* dataset = mDataSetList[ds];
+    iupPlotSampleNotify theNotify = { ih, ds, drawsample_cb };
+
+    if (pie_dataset && dataset != pie_dataset)
+      continue;
+
+    if (dataset->mHighlightedSample != -1 || dataset->mHighlightedCurve)
+      dataset->DrawHighlight(mAxisX.mTrafo, mAxisY.mTrafo, ctx, &theNotify);
+  }
+
   {
     int clipX1 = iupPlotDrawCalcX(ctx, theDataSetArea.mX);
     int clipY1 = iupPlotDrawCalcY(ctx, theDataSetArea.mY + theDataSetArea.mHeight - 1);
@@ -586,24 +677,26 @@ bool iupPlot::Render(iupPlotDrawContext* ctx)
   if (post_cb)
     post_cb(ih);
 
-  if (pie_dataset)
-    DrawSampleColorLegend(pie_dataset, theDataSetArea, ctx, mLegend.mPos);
-  else if (!DrawLegend(theDataSetArea, ctx, mLegend.mPos))
-    return false;
-
+  if (theRedraw || !iupDrawLayerPlay(ih, mFrontLayer))
   {
-    int clipX1 = iupPlotDrawCalcX(ctx, 0);
-    int clipY1 = iupPlotDrawCalcY(ctx, mViewport.mHeight - 1);
-    int clipX2 = iupPlotDrawCalcX(ctx, mViewport.mWidth - 1);
-    int clipY2 = iupPlotDrawCalcY(ctx, 0);
-    IupDrawSetClipRect(ctx->ih, clipX1, clipY1, clipX2, clipY2);
-  }
+    struct _IdrawList* theLayer = iupDrawLayerBegin(ih, mFrontLayer);
+    if (theLayer)
+      mFrontLayer = theLayer;
 
-  DrawTitle(ctx);
+    bool theDrawn = DrawFrontLayer(theDataSetArea, ctx);
 
-  if (!IupGetInt(ih, "ACTIVE"))
-    DrawInactive(ctx);
+    if (theLayer)
+      iupDrawLayerEnd(ih, theLayer);
+
+    if (!theDrawn)
+    {
+      mLayerValid = false;
+      return false;
+    }
+  }
 
+  mLayerKey = theLayerKey;
+  mLayerValid = true;
   mRedraw = false;
   return true;
 }
@@ -1,10 +1,24 @@
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 #include "iup_plot.h"
 #include "iup_drvfont.h"
 
 
+// blocks of samples transformed at once
+#define IPLOT_SCREEN_BLOCK 262144
+// blocks smaller than this are always transformed in the calling thread
+#define IPLOT_THREAD_MIN_SAMPLES 32768
+
+
 static int iPlotCountDigit(int inNum)
 {
   int theCount = 0;
@@ -83,6 +97,14 @@ double iupPlotTrafoLinear::Transform(double inValue) const
   return inValue * mSlope + mOffset;
 }
 
+void iupPlotTrafoLinear::TransformArray(const double* inValues, double* outValues, int inCount) const
+{
+  // simple enough to be vectorized by the compiler
+  const double theSlope = mSlope, theOffset = mOffset;
+  for (int i = 0; i < inCount; i++)
+    outValues[i] = inValues[i] * theSlope + theOffset;
+}
+
 double iupPlotTrafoLinear::TransformBack(double inValue) const
 {
   if (mSlope != 0)
@@ -127,6 +149,46 @@ double iupPlotTrafoLog::Transform(double inValue) const
   return iupPlotLog(inValue, mBase)*mSlope + mOffset;
 }
 
+// log2 for positive normal values, without a function call.
+// The series for ln((1+t)/(1-t)) is used with the mantissa in [sqrt(2)/2, sqrt(2)),
+// so |t| < 0.172 and the error is below 1e-10, much less than a pixel.
+static inline double iPlotFastLog2(double inValue)
+{
+  uint64_t theBits;
+  memcpy(&theBits, &inValue, sizeof(double));
+
+  double theExp = (double)((int)((theBits >> 52) & 0x7FF) - 1023);
+  theBits = (theBits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+
+  double theMantissa;
+  memcpy(&theMantissa, &theBits, sizeof(double));
+  if (theMantissa > 1.4142135623730951)
+  {
+    theMantissa *= 0.5;
+    theExp += 1;
+  }
+
+  double t = (theMantissa - 1) / (theMantissa + 1);
+  double t2 = t * t;
+  double theLn = t * (2.0 + t2 * (2.0 / 3.0 + t2 * (2.0 / 5.0 + t2 * (2.0 / 7.0 + t2 * (2.0 / 9.0 + t2 * (2.0 / 11.0))))));
+  return theExp + theLn * 1.4426950408889634;  // 1/ln(2)
+}
+
+void iupPlotTrafoLog::TransformArray(const double* inValues, double* outValues, int inCount) const
+{
+  const double theScale = mSlope / (log10(mBase) / log10(2.0)), theOffset = mOffset;
+  for (int i = 0; i < inCount; i++)
+  {
+    double theValue = inValues[i];
+    if (theValue < kLogMinClipValue) theValue = kLogMinClipValue;
+
+    if (theValue <= 1e300)
+      outValues[i] = iPlotFastLog2(theValue) * theScale + theOffset;
+    else
+      outValues[i] = Transform(theValue);  // infinite or NaN
+  }
+}
+
 double iupPlotTrafoLog::TransformBack(double inValue) const
 {
   if (mSlope != 0)
@@ -161,6 +223,189 @@ bool iupPlotTrafoLog::Calculate(int inBegin, int inEnd, const iupPlotAxis& inAxi
 
 /************************************************************************************************/
 
+int iupPlotGetThreadCount(int inWork, int inMinWork)
+{
+  int theThreadCount = 1;
+
+  if (inWork < 2 * inMinWork)
+    return 1;
+
+#if defined(WIN32)
+  {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    theThreadCount = (int)info.dwNumberOfProcessors;
+  }
+#elif !defined(__EMSCRIPTEN__) && defined(_SC_NPROCESSORS_ONLN)
+  theThreadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+  if (theThreadCount > IUP_PLOT_THREAD_MAX)
+    theThreadCount = IUP_PLOT_THREAD_MAX;
+  if (theThreadCount > inWork / inMinWork)
+    theThreadCount = inWork / inMinWork;
+  if (theThreadCount < 1)
+    theThreadCount = 1;
+  return theThreadCount;
+}
+
+struct iPlotThreadJob
+{
+  iupPlotJobFunc func;
+  void* job;
+};
+
+#if defined(WIN32)
+static DWORD WINAPI iPlotThreadFunc(LPVOID arg)
+{
+  iPlotThreadJob* theJob = (iPlotThreadJob*)arg;
+  theJob->func(theJob->job);
+  return 0;
+}
+#elif !defined(__EMSCRIPTEN__)
+static void* iPlotThreadFunc(void* arg)
+{
+  iPlotThreadJob* theJob = (iPlotThreadJob*)arg;
+  theJob->func(theJob->job);
+  return NULL;
+}
+#endif
+
+void iupPlotRunJobs(iupPlotJobFunc inFunc, void* inJobs, int inJobSize, int inJobCount)
+{
+  iPlotThreadJob jobs[IUP_PLOT_THREAD_MAX];
+
+  for (int i = 0; i < inJobCount; i++)
+  {
+    jobs[i].func = inFunc;
+    jobs[i].job = (char*)inJobs + (size_t)i * inJobSize;
+  }
+
+  if (inJobCount == 1)
+  {
+    inFunc(jobs[0].job);
+    return;
+  }
+
+#if defined(WIN32)
+  {
+    HANDLE threads[IUP_PLOT_THREAD_MAX];
+
+    // the calling thread takes the first job
+    for (int i = 1; i < inJobCount; i++)
+    {
+      threads[i] = CreateThread(NULL, 0, iPlotThreadFunc, &jobs[i], 0, NULL);
+      if (!threads[i])
+        inFunc(jobs[i].job);
+    }
+
+    inFunc(jobs[0].job);
+
+    for (int i = 1; i < inJobCount; i++)
+    {
+      if (threads[i])
+      {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+      }
+    }
+  }
+#elif !defined(__EMSCRIPTEN__)
+  {
+    pthread_t threads[IUP_PLOT_THREAD_MAX];
+    bool created[IUP_PLOT_THREAD_MAX];
+
+    for (int i = 1; i < inJobCount; i++)
+    {
+      created[i] = (pthread_create(&threads[i], NULL, iPlotThreadFunc, &jobs[i]) == 0);
+      if (!created[i])
+        inFunc(jobs[i].job);
+    }
+
+    inFunc(jobs[0].job);
+
+    for (int i = 1; i < inJobCount; i++)
+    {
+      if (created[i])
+        pthread_join(threads[i], NULL);
+    }
+  }
+#else
+  for (int i = 0; i < inJobCount; i++)
+    inFunc(jobs[i].job);
+#endif
+}
+
+struct iPlotTransformJob
+{
+  const iupPlotData* dataX;
+  const iupPlotData* dataY;
+  const iupPlotTrafo* trafoX;
+  const iupPlotTrafo* trafoY;
+  int begin, count;
+  double *x, *y;
+};
+
+static void iPlotTransformRunJob(void* arg)
+{
+  iPlotTransformJob* job = (iPlotTransformJob*)arg;
+  job->dataX->GetSamples(job->begin, job->count, job->x);
+  job->trafoX->TransformArray(job->x, job->x, job->count);
+  job->dataY->GetSamples(job->begin, job->count, job->y);
+  job->trafoY->TransformArray(job->y, job->y, job->count);
+}
+
+bool iupPlotScreenBlock::Load(int inSampleIndex)
+{
+  int theTotal = mDataX->GetCount();
+
+  if (!mX)
+  {
+    // the allocation is not retried for every sample
+    if (mFailed)
+      return false;
+
+    int theCapacity = theTotal < IPLOT_SCREEN_BLOCK ? theTotal : IPLOT_SCREEN_BLOCK;
+    mX = (double*)malloc(2 * (size_t)theCapacity * sizeof(double));
+    if (!mX)
+    {
+      mFailed = true;
+      return false;
+    }
+    mY = mX + theCapacity;
+  }
+
+  int theCount = theTotal - inSampleIndex;
+  if (theCount > IPLOT_SCREEN_BLOCK)
+    theCount = IPLOT_SCREEN_BLOCK;
+
+  mBegin = inSampleIndex;
+  mEnd = inSampleIndex + theCount;
+
+  iPlotTransformJob jobs[IUP_PLOT_THREAD_MAX];
+  int theThreadCount = iupPlotGetThreadCount(theCount, IPLOT_THREAD_MIN_SAMPLES);
+
+  for (int i = 0; i < theThreadCount; i++)
+  {
+    int theFirst = (int)(((int64_t)theCount * i) / theThreadCount);
+    int theLast = (int)(((int64_t)theCount * (i + 1)) / theThreadCount);
+
+    jobs[i].dataX = mDataX;
+    jobs[i].dataY = mDataY;
+    jobs[i].trafoX = mTrafoX;
+    jobs[i].trafoY = mTrafoY;
+    jobs[i].begin = mBegin + theFirst;
+    jobs[i].count = theLast - theFirst;
+    jobs[i].x = mX + theFirst;
+    jobs[i].y = mY + theFirst;
+  }
+
+  iupPlotRunJobs(iPlotTransformRunJob, jobs, sizeof(iPlotTransformJob), theThreadCount);
+  return true;
+}
+
+/************************************************************************************************/
+
 void iupPlotAxis::Init()
 {
   if (mLogScale)
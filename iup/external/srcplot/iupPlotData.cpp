@@ -2,10 +2,16 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "iup_plot.h"
 
 
+#define IPLOT_FIND_LINEAR_MAX 1000
+#define IPLOT_GRID_MAX_SIZE 1024
+#define IPLOT_DENSITY_MIN_SAMPLES 65536
+#define IPLOT_DENSITY_BLOCK 4096
+
 static bool iPlotCheckInsideBox(double x, double y, double boxMinX, double boxMaxX, double boxMinY, double boxMaxY)
 {
   if (x > boxMaxX || x < boxMinX || y > boxMaxY || y < boxMinY)
@@ -16,30 +22,318 @@ static bool iPlotCheckInsideBox(double x, double y, double boxMinX, double boxMa
 
 /************************************************************************************************/
 
+bool iupPlotData::Reserve(int inCount)
+{
+  if (inCount <= mCapacity && mOwnBuffer)
+    return true;
+
+  int theCapacity = mCapacity < 32 ? 32 : mCapacity;
+  while (theCapacity < inCount)
+    theCapacity = (theCapacity > 0x3FFFFFFF) ? inCount : theCapacity * 2;
+
+  // a circular buffer does not need to grow beyond its maximum count
+  if (mMaxCount > 0 && inCount <= mMaxCount && theCapacity > mMaxCount)
+    theCapacity = mMaxCount;
+
+  return Relocate(theCapacity);
+}
+
+// Moves the samples to an owned buffer, with the first sample at the start
+bool iupPlotData::Relocate(int inCapacity)
+{
+  void* theBuffer;
+
+  if (mOwnBuffer && mStart == 0)
+  {
+    theBuffer = realloc(mBuffer, (size_t)inCapacity * mElemSize);
+    if (!theBuffer)
+      return false;
+  }
+  else
+  {
+    theBuffer = malloc((size_t)inCapacity * mElemSize);
+    if (!theBuffer)
+      return false;
+
+    if (mCount)
+    {
+      int theFirstCount = mCapacity - mStart;
+      if (theFirstCount > mCount)
+        theFirstCount = mCount;
+
+      memcpy(theBuffer, (char*)mBuffer + (size_t)mStart * mElemSize, (size_t)theFirstCount * mElemSize);
+      if (theFirstCount < mCount)
+        memcpy((char*)theBuffer + (size_t)theFirstCount * mElemSize, mBuffer, (size_t)(mCount - theFirstCount) * mElemSize);
+    }
+
+    ReleaseBuffer();
+  }
+
+  mBuffer = theBuffer;
+  mCapacity = inCapacity;
+  mStart = 0;
+  mOwnBuffer = true;
+  return true;
+}
+
+void iupPlotData::ReleaseBuffer()
+{
+  if (mShareCount)
+  {
+    (*mShareCount)--;
+    if (*mShareCount == 0)
+    {
+      free(mShareCount);
+      free(mBuffer);
+    }
+    mShareCount = NULL;
+  }
+  else if (mOwnBuffer && mBuffer)
+    free(mBuffer);
+}
+
+// Uses the buffer of inData, a mapped buffer is simply mapped again
+bool iupPlotData::ShareBuffer(iupPlotData* inData)
+{
+  if (inData->mOwnBuffer && inData->mBuffer)
+  {
+    inData->mShareCount = (int*)malloc(sizeof(int));
+    if (!inData->mShareCount)
+      return false;
+    *inData->mShareCount = 1;
+    inData->mOwnBuffer = false;
+  }
+
+  if (inData->mShareCount)
+    (*inData->mShareCount)++;
+
+  ReleaseBuffer();
+  mBuffer = inData->mBuffer;
+  mCount = inData->mCount;
+  mCapacity = inData->mCapacity;
+  mStart = inData->mStart;
+  mOwnBuffer = false;
+  mShareCount = inData->mShareCount;
+  return true;
+}
+
+void* iupPlotData::InsertRoom(int inSampleIndex, int inCount)
+{
+  if (inCount <= 0)
+    return NULL;
+
+  if (inSampleIndex < 0) inSampleIndex = 0;
+  if (inSampleIndex > mCount) inSampleIndex = mCount;
+
+  if (inCount == 1 && IsStreamAppend(inSampleIndex))
+  {
+    // O(1), the first sample is dropped when the buffer is full
+    if (mCount >= mMaxCount)
+      RemoveFirst();
+    if (!Reserve(mCount + 1))
+      return NULL;
+
+    char* theData = (char*)mBuffer + (size_t)Index(mCount) * mElemSize;
+    mCount++;
+    return theData;
+  }
+
+  if (mStart != 0 && !Relocate(mCapacity))
+    return NULL;
+  if (!Reserve(mCount + inCount))
+    return NULL;
+
+  char* theData = (char*)mBuffer + (size_t)inSampleIndex * mElemSize;
+  if (inSampleIndex < mCount)
+    memmove(theData + (size_t)inCount * mElemSize, theData, (size_t)(mCount - inSampleIndex) * mElemSize);
+  mCount += inCount;
+  return theData;
+}
+
+void iupPlotData::RemoveFirst()
+{
+  ReleaseSample(0);
+
+  mCount--;
+  if (mCount == 0)
+    mStart = 0;
+  else
+  {
+    mStart++;
+    if (mStart == mCapacity)
+      mStart = 0;
+  }
+}
+
+void iupPlotData::RemoveSample(int inSampleIndex)
+{
+  if (inSampleIndex < 0 || inSampleIndex >= mCount)
+    return;
+
+  if (inSampleIndex == 0 && (mStart != 0 || mMaxCount > 0))
+  {
+    RemoveFirst();
+    return;
+  }
+
+  ReleaseSample(inSampleIndex);
+
+  // a mapped buffer is copied before it is changed in size
+  if ((mStart != 0 || !mOwnBuffer) && !Relocate(mCapacity))
+    return;
+
+  char* theBuffer = (char*)mBuffer;
+  memmove(theBuffer + (size_t)inSampleIndex * mElemSize, theBuffer + (size_t)(inSampleIndex + 1) * mElemSize, (size_t)(mCount - inSampleIndex - 1) * mElemSize);
+  mCount--;
+}
+
+void iupPlotData::InsertZeros(int inSampleIndex, int inCount)
+{
+  if (inCount <= 0)
+    return;
+
+  if (IsStreamAppend(inSampleIndex))
+  {
+    if (inCount > mMaxCount)
+      inCount = mMaxCount;
+
+    for (int i = 0; i < inCount; i++)
+    {
+      void* theData = InsertRoom(mCount, 1);
+      if (theData)
+        memset(theData, 0, mElemSize);
+    }
+    return;
+  }
+
+  void* theData = InsertRoom(inSampleIndex, inCount);
+  if (theData)
+    memset(theData, 0, (size_t)inCount * mElemSize);
+  Trim();
+}
+
+void iupPlotDataReal::InsertSamples(int inSampleIndex, const double* inReal, int inCount)
+{
+  if (inCount <= 0)
+    return;
+
+  if (inSampleIndex < 0) inSampleIndex = 0;
+  if (inSampleIndex > mCount) inSampleIndex = mCount;
+
+  bool theEmpty = (mCount == 0);
+  if (theEmpty)
+    mAscending = true;
+
+  if (mAscending)
+  {
+    if (inSampleIndex > 0 && inReal[0] < Sample(inSampleIndex - 1))
+      mAscending = false;
+    else if (inSampleIndex < mCount && inReal[inCount - 1] > Sample(inSampleIndex))
+      mAscending = false;
+    else
+    {
+      for (int i = 1; i < inCount; i++)
+      {
+        if (inReal[i] < inReal[i - 1])
+        {
+          mAscending = false;
+          break;
+        }
+      }
+    }
+  }
+
+  if (IsStreamAppend(inSampleIndex))
+  {
+    // only the last samples will remain
+    if (inCount > mMaxCount)
+    {
+      inReal += inCount - mMaxCount;
+      inCount = mMaxCount;
+    }
+
+    for (int i = 0; i < inCount; i++)
+    {
+      double* theData = (double*)InsertRoom(mCount, 1);
+      if (!theData)
+        return;
+      *theData = inReal[i];
+    }
+  }
+  else
+  {
+    double* theData = (double*)InsertRoom(inSampleIndex, inCount);
+    if (!theData)
+      return;
+    memcpy(theData, inReal, (size_t)inCount * sizeof(double));
+  }
+
+  if (theEmpty)
+  {
+    mRangeValid = true;
+    mRangeMin = mRangeMax = inReal[0];
+  }
+  for (int i = 0; i < inCount; i++)
+    UpdateRange(inReal[i]);
+
+  Trim();
+}
+
 bool iupPlotDataReal::CalculateRange(double &outMin, double &outMax) const
 {
-  int theCount = iupArrayCount(mArray);
-  if (theCount > 0)
+  if (mCount > 0)
   {
-    double* theData = (double*)iupArrayGetData(mArray);
-    outMax = outMin = theData[0];
-    for (int i = 1; i < theCount; i++)
+    if (mAscending)
     {
-      if (theData[i] > outMax)
-        outMax = theData[i];
-      if (theData[i] < outMin)
-        outMin = theData[i];
+      // O(1), usually the X values of a time series
+      outMin = Sample(0);
+      outMax = Sample(mCount - 1);
+      return true;
+    }
+
+    if (!mRangeValid)
+    {
+      double thePrev = mRangeMax = mRangeMin = Sample(0);
+      bool theAscending = true;
+      for (int i = 1; i < mCount; i++)
+      {
+        double theReal = Sample(i);
+        if (theReal > mRangeMax)
+          mRangeMax = theReal;
+        if (theReal < mRangeMin)
+          mRangeMin = theReal;
+        if (theReal < thePrev)
+          theAscending = false;
+        thePrev = theReal;
+      }
+      mRangeValid = true;
+      mAscending = theAscending;
     }
+
+    outMin = mRangeMin;
+    outMax = mRangeMax;
     return true;
   }
 
   return false;
 }
 
+void iupPlotDataReal::GetSamples(int inSampleIndex, int inCount, double* outValues) const
+{
+  // at most two parts of the circular buffer
+  int theFirstCount = mCapacity - Index(inSampleIndex);
+  if (theFirstCount > inCount)
+    theFirstCount = inCount;
+
+  memcpy(outValues, (double*)mBuffer + Index(inSampleIndex), (size_t)theFirstCount * sizeof(double));
+  if (theFirstCount < inCount)
+    memcpy(outValues + theFirstCount, mBuffer, (size_t)(inCount - theFirstCount) * sizeof(double));
+}
+
 iupPlotDataString::~iupPlotDataString()
 {
   for (int i = 0; i < mCount; i++)
-    free(mData[i]);
+    ReleaseSample(i);
 }
 
 bool iupPlotDataString::CalculateRange(double &outMin, double &outMax) const
@@ -73,7 +367,10 @@ iupPlotDataSet::iupPlotDataSet(bool strXdata)
   mMultibarIndex(-1), mMultibarCount(0), mBarOutlineColor(0), mBarShowOutline(false), mBarSpacingPercent(10),
   mPieStartAngle(0), mPieRadius(0.95), mPieContour(false), mPieHole(0), mPieSliceLabelPos(0.95),
   mHighlightedSample(-1), mHighlightedCurve(false), mBarMulticolor(false), mOrderedX(false), mSelectedCurve(false),
-  mPieSliceLabel(IUP_PLOT_NONE), mMode(IUP_PLOT_LINE), mName(NULL), mHasSelected(false), mUserData(0)
+  mPieSliceLabel(IUP_PLOT_NONE), mMode(IUP_PLOT_LINE), mName(NULL), mHasSelected(false), mUserData(0),
+  mDecimation(IUP_PLOT_DECIMATION_NONE), mDensityColors(0), mDataVersion(0), mDecimatedIndex(NULL), mDecimatedCount(0), mDecimatedCapacity(0), mDecimatedValid(false),
+  mGridIndex(NULL), mGridCellStart(NULL), mGridCols(0), mGridRows(0), mGridMinX(0), mGridMinY(0), mGridCellW(1), mGridCellH(1), mGridVersion(-1),
+  mDensityImage(NULL)
 {
   if (strXdata)
     mDataX = (iupPlotData*)(new iupPlotDataString());
@@ -98,6 +395,15 @@ iupPlotDataSet::~iupPlotDataSet()
     delete mSegment;
   if (mExtra)
     delete mExtra;
+  if (mDecimatedIndex)
+    free(mDecimatedIndex);
+  if (mGridIndex)
+  {
+    free(mGridIndex);
+    free(mGridCellStart);
+  }
+  if (mDensityImage)
+    IupDestroy(mDensityImage);
 }
 
 bool iupPlotDataSet::FindSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY, double inScreenTolerance,
@@ -121,27 +427,38 @@ bool iupPlotDataSet::FindSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY,
 bool iupPlotDataSet::FindPointSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY, double inScreenTolerance,
                                      int &outSampleIndex, double &outX, double &outY) const
 {
-  double theX, theY, theScreenX, theScreenY;
-  double thePrevScreenX = 0;
-
   int theCount = mDataX->GetCount();
+  int theBegin = 0, theEnd = theCount;
 
-  for (int i = 0; i < theCount; i++)
+  if (theCount > IPLOT_FIND_LINEAR_MAX)
   {
-    theX = mDataX->GetSample(i);
-    theY = mDataY->GetSample(i);
-    theScreenX = inTrafoX->Transform(theX);
-    theScreenY = inTrafoY->Transform(theY);
-
-    // optimization when X values are ordered
-    if (mOrderedX && i > 0 && (inScreenX < thePrevScreenX - inScreenTolerance || inScreenX > theScreenX + inScreenTolerance))
+    // the tolerance box in data space
+    double theMinX = inTrafoX->TransformBack(inScreenX - inScreenTolerance);
+    double theMaxX = inTrafoX->TransformBack(inScreenX + inScreenTolerance);
+    double theMinY = inTrafoY->TransformBack(inScreenY - inScreenTolerance);
+    double theMaxY = inTrafoY->TransformBack(inScreenY + inScreenTolerance);
+    if (theMinX > theMaxX) { double tmp = theMinX; theMinX = theMaxX; theMaxX = tmp; }
+    if (theMinY > theMaxY) { double tmp = theMinY; theMinY = theMaxY; theMaxY = tmp; }
+
+    if (std::isfinite(theMinX) && std::isfinite(theMaxX) && std::isfinite(theMinY) && std::isfinite(theMaxY))
     {
-      if (inScreenX < thePrevScreenX - inScreenTolerance)
-        break;
-
-      thePrevScreenX = theScreenX;
-      continue;
+      if (IsOrderedX())
+      {
+        // only the samples inside the X interval are checked
+        theBegin = FindFirstX(theMinX);
+        theEnd = FindFirstX(nextafter(theMaxX, HUGE_VAL));
+      }
+      else if (BuildGrid())
+        return FindPointSampleGrid(inTrafoX, inTrafoY, inScreenX, inScreenY, inScreenTolerance, theMinX, theMaxX, theMinY, theMaxY, outSampleIndex, outX, outY);
     }
+  }
+
+  for (int i = theBegin; i < theEnd; i++)
+  {
+    double theX = mDataX->GetSample(i);
+    double theY = mDataY->GetSample(i);
+    double theScreenX = inTrafoX->Transform(theX);
+    double theScreenY = inTrafoY->Transform(theY);
 
     if (fabs(theScreenX - inScreenX) < inScreenTolerance &&
         fabs(theScreenY - inScreenY) < inScreenTolerance)
@@ -151,13 +468,160 @@ bool iupPlotDataSet::FindPointSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTra
       outSampleIndex = i;
       return true;
     }
-
-    thePrevScreenX = theScreenX;
   }
 
   return false;
 }
 
+bool iupPlotDataSet::FindPointSampleGrid(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY, double inScreenTolerance,
+                                         double inMinX, double inMaxX, double inMinY, double inMaxY, int &outSampleIndex, double &outX, double &outY) const
+{
+  int theFound = -1;
+  int theCol1 = GridCol(inMinX), theCol2 = GridCol(inMaxX);
+  int theRow1 = GridRow(inMinY), theRow2 = GridRow(inMaxY);
+
+  for (int row = theRow1; row <= theRow2; row++)
+  {
+    for (int col = theCol1; col <= theCol2; col++)
+    {
+      int theCell = row * mGridCols + col;
+
+      for (int p = mGridCellStart[theCell]; p < mGridCellStart[theCell + 1]; p++)
+      {
+        // the result is the first sample found by a linear search
+        int i = mGridIndex[p];
+        if (theFound >= 0 && i >= theFound)
+          break;  // indices are in ascending order inside a cell
+
+        double theScreenX = inTrafoX->Transform(mDataX->GetSample(i));
+        double theScreenY = inTrafoY->Transform(mDataY->GetSample(i));
+
+        if (fabs(theScreenX - inScreenX) < inScreenTolerance &&
+            fabs(theScreenY - inScreenY) < inScreenTolerance)
+          theFound = i;
+      }
+    }
+  }
+
+  if (theFound < 0)
+    return false;
+
+  outX = mDataX->GetSample(theFound);
+  outY = mDataY->GetSample(theFound);
+  outSampleIndex = theFound;
+  return true;
+}
+
+// Returns the first sample with X greater or equal to inX, samples must be ordered in X
+int iupPlotDataSet::FindFirstX(double inX) const
+{
+  int theLow = 0, theHigh = mDataX->GetCount();
+
+  while (theLow < theHigh)
+  {
+    int theMiddle = theLow + (theHigh - theLow) / 2;
+    if (mDataX->GetSample(theMiddle) < inX)
+      theLow = theMiddle + 1;
+    else
+      theHigh = theMiddle;
+  }
+
+  return theLow;
+}
+
+// Sorts the sample indices in a uniform grid of cells in data space.
+// Built only when needed, and again only when the samples change.
+bool iupPlotDataSet::BuildGrid() const
+{
+  if (mGridVersion == mDataVersion)
+    return mGridIndex != NULL;
+
+  mGridVersion = mDataVersion;
+  if (mGridIndex)
+  {
+    free(mGridIndex);
+    free(mGridCellStart);
+    mGridIndex = NULL;
+    mGridCellStart = NULL;
+  }
+
+  int theCount = mDataX->GetCount();
+  double theMinX = 0, theMaxX = 0, theMinY = 0, theMaxY = 0;
+  bool theFirst = true;
+
+  for (int i = 0; i < theCount; i++)
+  {
+    double theX = mDataX->GetSample(i);
+    double theY = mDataY->GetSample(i);
+    if (!std::isfinite(theX) || !std::isfinite(theY))
+      continue;
+
+    if (theFirst)
+    {
+      theMinX = theMaxX = theX;
+      theMinY = theMaxY = theY;
+      theFirst = false;
+    }
+    if (theX < theMinX) theMinX = theX;
+    if (theX > theMaxX) theMaxX = theX;
+    if (theY < theMinY) theMinY = theY;
+    if (theY > theMaxY) theMaxY = theY;
+  }
+
+  if (theFirst)
+    return false;
+
+  // about 2 samples per cell
+  int theSize = (int)sqrt(theCount / 2.0) + 1;
+  if (theSize > IPLOT_GRID_MAX_SIZE)
+    theSize = IPLOT_GRID_MAX_SIZE;
+
+  mGridCols = mGridRows = theSize;
+  mGridMinX = theMinX;
+  mGridMinY = theMinY;
+  mGridCellW = (theMaxX > theMinX) ? (theMaxX - theMinX) / theSize : 1;
+  mGridCellH = (theMaxY > theMinY) ? (theMaxY - theMinY) / theSize : 1;
+
+  int theCellCount = mGridCols * mGridRows;
+  mGridCellStart = (int*)calloc(theCellCount + 1, sizeof(int));
+  mGridIndex = (int*)malloc(theCount * sizeof(int));
+  if (!mGridCellStart || !mGridIndex)
+  {
+    free(mGridCellStart);
+    free(mGridIndex);
+    mGridCellStart = NULL;
+    mGridIndex = NULL;
+    return false;
+  }
+
+  // counting sort, indices remain in ascending order inside each cell
+  for (int i = 0; i < theCount; i++)
+  {
+    double theX = mDataX->GetSample(i);
+    double theY = mDataY->GetSample(i);
+    if (std::isfinite(theX) && std::isfinite(theY))
+      mGridCellStart[GridRow(theY) * mGridCols + GridCol(theX) + 1]++;
+  }
+
+  for (int c = 0; c < theCellCount; c++)
+    mGridCellStart[c + 1] += mGridCellStart[c];
+
+  for (int i = 0; i < theCount; i++)
+  {
+    double theX = mDataX->GetSample(i);
+    double theY = mDataY->GetSample(i);
+    if (std::isfinite(theX) && std::isfinite(theY))
+      mGridIndex[mGridCellStart[GridRow(theY) * mGridCols + GridCol(theX)]++] = i;
+  }
+
+  // each start was moved to the start of the next cell
+  for (int c = theCellCount; c > 0; c--)
+    mGridCellStart[c] = mGridCellStart[c - 1];
+  mGridCellStart[0] = 0;
+
+  return true;
+}
+
 bool iupPlotDataSet::FindMultipleBarSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY,
                                            int &outSampleIndex, double &outX, double &outY) const
 {
@@ -379,23 +843,38 @@ bool iupPlotDataSet::FindSegment(iupPlotTrafo *mTrafoX, iupPlotTrafo *mTrafoY, d
   double found_x1 = 0, found_y1 = 0, found_x2 = 0, found_y2 = 0;
   bool found = false;
 
-  double theX1 = mDataX->GetSample(0);
-  double theY1 = mDataY->GetSample(0);
+  int theCount = mDataX->GetCount();
+  int theBegin = 0;
+
+  // optimization when X values are ordered, compared in data space so a reversed axis is also handled
+  bool theOrderedX = IsOrderedX();
+  double theInX = mTrafoX->TransformBack(inScreenX);
+  if (theOrderedX)
+  {
+    // the first segment that ends after inX
+    theBegin = FindFirstX(theInX) - 1;
+    if (theBegin < 0)
+      theBegin = 0;
+  }
+
+  if (theBegin >= theCount - 1)
+    return false;
+
+  double theX1 = mDataX->GetSample(theBegin);
+  double theY1 = mDataY->GetSample(theBegin);
   double theScreenX1 = mTrafoX->Transform(theX1);
   double theScreenY1 = mTrafoY->Transform(theY1);
 
-  int theCount = mDataX->GetCount();
-  for (int i = 0; i < theCount - 1; i++)
+  for (int i = theBegin; i < theCount - 1; i++)
   {
     double theX2 = mDataX->GetSample(i + 1);
     double theY2 = mDataY->GetSample(i + 1);
     double theScreenX2 = mTrafoX->Transform(theX2);
     double theScreenY2 = mTrafoY->Transform(theY2);
 
-    // optimization when X values are ordered
-    if (mOrderedX && (inScreenX < theScreenX1 || inScreenX > theScreenX2))
+    if (theOrderedX && (theInX < theX1 || theInX > theX2))
     {
-      if (inScreenX < theScreenX1)
+      if (theInX < theX1)
         break;
 
       theX1 = theX2;
@@ -608,6 +1087,7 @@ void iupPlotDataSet::AddSample(double inX, double inY)
   if (theXData->IsString())
     return;
 
+  mDataVersion++;
   theXData->AddSample(inX);
   theYData->AddSample(inY);
   mSelection->AddSample(false);
@@ -625,6 +1105,7 @@ void iupPlotDataSet::InsertSample(int inSampleIndex, double inX, double inY)
   if (theXData->IsString())
     return;
 
+  mDataVersion++;
   theXData->InsertSample(inSampleIndex, inX);
   theYData->InsertSample(inSampleIndex, inY);
   mSelection->InsertSample(inSampleIndex, false);
@@ -634,55 +1115,144 @@ void iupPlotDataSet::InsertSample(int inSampleIndex, double inX, double inY)
     mExtra->InsertSample(inSampleIndex, 0);
 }
 
-void iupPlotDataSet::InitSegment()
-{
-  mSegment = new iupPlotDataBool();
-
-  int theCount = mDataX->GetCount();
-  for (int i = 0; i < theCount; i++)
-    mSegment->AddSample(false);
-}
-
-void iupPlotDataSet::InitExtra()
+void iupPlotDataSet::AddSamples(const double* inX, const double* inY, int inCount)
 {
-  mExtra = new iupPlotDataReal();
-
-  int theCount = mDataX->GetCount();
-  for (int i = 0; i < theCount; i++)
-    mExtra->AddSample(0);
+  InsertSamples(mDataX->GetCount(), inX, inY, inCount);
 }
 
-void iupPlotDataSet::AddSampleSegment(double inX, double inY, bool inSegment)
+void iupPlotDataSet::InsertSamples(int inSampleIndex, const double* inX, const double* inY, int inCount)
 {
   iupPlotDataReal *theXData = (iupPlotDataReal*)mDataX;
   iupPlotDataReal *theYData = (iupPlotDataReal*)mDataY;
 
-  if (theXData->IsString())
+  if (theXData->IsString() || inCount <= 0)
     return;
 
-  if (!mSegment)
-    InitSegment();
+  int theCount = theXData->GetCount();
+  if (inSampleIndex < 0) inSampleIndex = 0;
+  if (inSampleIndex > theCount) inSampleIndex = theCount;
 
-  theXData->AddSample(inX);
-  theYData->AddSample(inY);
-  mSelection->AddSample(false);
-  mSegment->AddSample(inSegment);
+  mDataVersion++;
+  theXData->InsertSamples(inSampleIndex, inX, inCount);
+  theYData->InsertSamples(inSampleIndex, inY, inCount);
+  mSelection->InsertZeros(inSampleIndex, inCount);
+  if (mSegment)
+    mSegment->InsertZeros(inSampleIndex, inCount);
   if (mExtra)
-    mExtra->AddSample(0);
+    mExtra->InsertZeros(inSampleIndex, inCount);
 }
 
-void iupPlotDataSet::InsertSampleSegment(int inSampleIndex, double inX, double inY, bool inSegment)
+bool iupPlotDataSet::SetSamplesBuffer(double* inX, double* inY, int inCount, bool inOwnBuffer)
 {
   iupPlotDataReal *theXData = (iupPlotDataReal*)mDataX;
   iupPlotDataReal *theYData = (iupPlotDataReal*)mDataY;
 
-  if (theXData->IsString())
-    return;
-
-  if (!mSegment)
-    InitSegment();
+  if (theXData->IsString() || inCount < 0 || (inCount > 0 && (!inX || !inY)))
+  {
+    if (inOwnBuffer)
+    {
+      free(inX);
+      free(inY);
+    }
+    return false;
+  }
 
-  theXData->InsertSample(inSampleIndex, inX);
+  mDataVersion++;
+  theXData->SetSamplesBuffer(inX, inCount, inOwnBuffer);
+  theYData->SetSamplesBuffer(inY, inCount, inOwnBuffer);
+  mSelection->ResetZeros(inCount);
+  mHasSelected = false;
+  if (mSegment)
+    mSegment->ResetZeros(inCount);
+  if (mExtra)
+    mExtra->ResetZeros(inCount);
+  return true;
+}
+
+bool iupPlotDataSet::SetSamplesBuffer(iupPlotDataSet* inDataSet, double* inY, bool inOwnBuffer)
+{
+  iupPlotDataReal *theXData = (iupPlotDataReal*)mDataX;
+  iupPlotDataReal *theYData = (iupPlotDataReal*)mDataY;
+  int theCount = inDataSet->mDataX->GetCount();
+
+  if (theXData->IsString() || inDataSet->mDataX->IsString() || (theCount > 0 && !inY) ||
+      !theXData->ShareSamplesBuffer((iupPlotDataReal*)inDataSet->mDataX))
+  {
+    if (inOwnBuffer)
+      free(inY);
+    return false;
+  }
+
+  mDataVersion++;
+  theYData->SetSamplesBuffer(inY, theCount, inOwnBuffer);
+  mSelection->ResetZeros(theCount);
+  mHasSelected = false;
+  if (mSegment)
+    mSegment->ResetZeros(theCount);
+  if (mExtra)
+    mExtra->ResetZeros(theCount);
+  return true;
+}
+
+void iupPlotDataSet::SetMaxCount(int inMaxCount)
+{
+  mDataVersion++;
+  mDataX->SetMaxCount(inMaxCount);
+  mDataY->SetMaxCount(inMaxCount);
+  mSelection->SetMaxCount(inMaxCount);
+  if (mSegment)
+    mSegment->SetMaxCount(inMaxCount);
+  if (mExtra)
+    mExtra->SetMaxCount(inMaxCount);
+}
+
+void iupPlotDataSet::InitSegment()
+{
+  mSegment = new iupPlotDataBool();
+  mSegment->SetMaxCount(mDataX->GetMaxCount());
+  mSegment->ResetZeros(mDataX->GetCount());
+}
+
+void iupPlotDataSet::InitExtra()
+{
+  mExtra = new iupPlotDataReal();
+  mExtra->SetMaxCount(mDataX->GetMaxCount());
+  mExtra->ResetZeros(mDataX->GetCount());
+}
+
+void iupPlotDataSet::AddSampleSegment(double inX, double inY, bool inSegment)
+{
+  iupPlotDataReal *theXData = (iupPlotDataReal*)mDataX;
+  iupPlotDataReal *theYData = (iupPlotDataReal*)mDataY;
+
+  if (theXData->IsString())
+    return;
+
+  if (!mSegment)
+    InitSegment();
+
+  mDataVersion++;
+  theXData->AddSample(inX);
+  theYData->AddSample(inY);
+  mSelection->AddSample(false);
+  mSegment->AddSample(inSegment);
+  if (mExtra)
+    mExtra->AddSample(0);
+}
+
+void iupPlotDataSet::InsertSampleSegment(int inSampleIndex, double inX, double inY, bool inSegment)
+{
+  iupPlotDataReal *theXData = (iupPlotDataReal*)mDataX;
+  iupPlotDataReal *theYData = (iupPlotDataReal*)mDataY;
+
+  if (theXData->IsString())
+    return;
+
+  if (!mSegment)
+    InitSegment();
+
+  mDataVersion++;
+  theXData->InsertSample(inSampleIndex, inX);
   theYData->InsertSample(inSampleIndex, inY);
   mSelection->InsertSample(inSampleIndex, false);
   mSegment->InsertSample(inSampleIndex, inSegment);
@@ -698,6 +1268,7 @@ void iupPlotDataSet::AddSample(const char* inX, double inY)
   if (!theXData->IsString())
     return;
 
+  mDataVersion++;
   theXData->AddSample(inX);
   theYData->AddSample(inY);
   mSelection->AddSample(false);
@@ -715,6 +1286,7 @@ void iupPlotDataSet::InsertSample(int inSampleIndex, const char* inX, double inY
   if (!theXData->IsString())
     return;
 
+  mDataVersion++;
   theXData->InsertSample(inSampleIndex, inX);
   theYData->InsertSample(inSampleIndex, inY);
   mSelection->InsertSample(inSampleIndex, false);
@@ -726,6 +1298,7 @@ void iupPlotDataSet::InsertSample(int inSampleIndex, const char* inX, double inY
 
 void iupPlotDataSet::RemoveSample(int inSampleIndex)
 {
+  mDataVersion++;
   mDataX->RemoveSample(inSampleIndex);
   mDataY->RemoveSample(inSampleIndex);
   mSelection->RemoveSample(inSampleIndex);
@@ -797,6 +1370,7 @@ void iupPlotDataSet::SetSample(int inSampleIndex, double inX, double inY)
   if (inSampleIndex < 0 || inSampleIndex >= theCount)
     return;
 
+  mDataVersion++;
   theXData->SetSample(inSampleIndex, inX);
   theYData->SetSample(inSampleIndex, inY);
 }
@@ -813,6 +1387,7 @@ void iupPlotDataSet::SetSample(int inSampleIndex, const char* inX, double inY)
   if (inSampleIndex < 0 || inSampleIndex >= theCount)
     return;
 
+  mDataVersion++;
   theXData->SetSampleString(inSampleIndex, inX);
   theYData->SetSample(inSampleIndex, inY);
 }
@@ -870,17 +1445,19 @@ static void iPlotDrawHighlightedArc(iupPlotDrawContext* ctx, int x1, int y1, int
   iupPlotDrawArc(ctx->ih, x1, y1, x2, y2, startAngle, endAngle, hlColor, IUP_DRAW_STROKE, lineWidth + HIGHLIGHT_OFFSET);
 }
 
-static void iPlotDrawHighlightedCurve(iupPlotDrawContext* ctx, int inCount, const iupPlotData* inDataX, const iupPlotData* inDataY, const iupPlotDataBool* inSegment,
+static void iPlotDrawHighlightedCurve(iupPlotDrawContext* ctx, int inCount, const int* inIndex, const iupPlotData* inDataX, const iupPlotData* inDataY, const iupPlotDataBool* inSegment,
                                       const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, long color, int lineWidth, bool inConnectPreviousX, bool inSelected = false)
 {
   long hlColor = iupDrawColor(iupDrawRed(color), iupDrawGreen(color), iupDrawBlue(color), inSelected ? SELECT_ALPHA : HIGHLIGHT_ALPHA);
   int hlWidth = lineWidth + (inSelected ? SELECT_OFFSET : HIGHLIGHT_OFFSET);
+  int prevAbsX = 0;
 
   iupPlotPointBuffer buf;
   buf.Begin(inCount * 2);
 
-  for (int i = 0; i < inCount; i++)
+  for (int k = 0; k < inCount; k++)
   {
+    int i = inIndex ? inIndex[k] : k;
     double theX = inDataX->GetSample(i);
     double theY = inDataY->GetSample(i);
     double theScreenX = inTrafoX->Transform(theX);
@@ -892,40 +1469,283 @@ static void iPlotDrawHighlightedCurve(iupPlotDrawContext* ctx, int inCount, cons
     {
       buf.DrawStroke(ctx, hlColor, IUP_PLOT_LINE_CONTINUOUS, hlWidth);
       buf.Clear();
-      buf.Begin(inCount - i);
+      buf.Begin(inCount - k);
     }
 
-    if (inConnectPreviousX && i > 0)
-    {
-      int prevAbsX = iupPlotDrawCalcX(ctx, inTrafoX->Transform(inDataX->GetSample(i - 1)));
+    if (inConnectPreviousX && k > 0)
       buf.AddVertex(prevAbsX, absY);
-    }
 
     buf.AddVertex(absX, absY);
+    prevAbsX = absX;
   }
 
   buf.DrawStroke(ctx, hlColor, IUP_PLOT_LINE_CONTINUOUS, hlWidth);
 }
 
+static void iPlotDrawHighlightedSample(iupPlotDrawContext* ctx, int inSampleIndex, const iupPlotData* inDataX, const iupPlotData* inDataY,
+                                       const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, long color, int markSize)
+{
+  if (inSampleIndex < 0 || inSampleIndex >= inDataX->GetCount())
+    return;
+
+  int absX = iupPlotDrawCalcX(ctx, inTrafoX->Transform(inDataX->GetSample(inSampleIndex)));
+  int absY = iupPlotDrawCalcY(ctx, inTrafoY->Transform(inDataY->GetSample(inSampleIndex)));
+  iPlotDrawHighlightedMark(ctx, absX, absY, color, markSize);
+}
+
+/************************************************************************************/
+/* Decimation                                                                        */
+/************************************************************************************/
+
+void iupPlotDataSet::AddDecimatedIndex(int inSampleIndex) const
+{
+  if (mDecimatedCount > 0 && mDecimatedIndex[mDecimatedCount - 1] >= inSampleIndex)
+    return;  // already added, indices are always increasing
+
+  if (mDecimatedCount == mDecimatedCapacity)
+  {
+    mDecimatedCapacity = mDecimatedCapacity * 2 + 256;
+    mDecimatedIndex = (int*)realloc(mDecimatedIndex, mDecimatedCapacity * sizeof(int));
+  }
+
+  mDecimatedIndex[mDecimatedCount] = inSampleIndex;
+  mDecimatedCount++;
+}
+
+void iupPlotDataSet::AddDecimatedColumn(int inFirst, int inMin, int inMax, int inLast) const
+{
+  AddDecimatedIndex(inFirst);
+  if (inMin < inMax)
+  {
+    AddDecimatedIndex(inMin);
+    AddDecimatedIndex(inMax);
+  }
+  else
+  {
+    AddDecimatedIndex(inMax);
+    AddDecimatedIndex(inMin);
+  }
+  AddDecimatedIndex(inLast);
+}
+
+void iupPlotDataSet::DecimateMinMax(const iupPlotTrafo *inTrafoX, const iupPlotDrawContext* ctx) const
+{
+  /* All samples in the same pixel column are reduced to the first, the minimum, the maximum and the last.
+     The polyline covers the same pixels as the full one. */
+  int theCount = mDataX->GetCount();
+  int theColumn = 0, theFirst = -1, theMin = 0, theMax = 0, theLast = 0;
+  double theMinY = 0, theMaxY = 0, thePrevX = 0;
+
+  for (int i = 0; i < theCount; i++)
+  {
+    double theX = mDataX->GetSample(i);
+    double theY = mDataY->GetSample(i);
+    int absX = iupPlotDrawCalcX(ctx, inTrafoX->Transform(theX));
+
+    if (i > 0 && theX < thePrevX)
+    {
+      mDecimatedCount = -1;  // X is not ordered
+      return;
+    }
+    thePrevX = theX;
+
+    // a new segment always starts a new column
+    if (theFirst < 0 || absX != theColumn || (mSegment && mSegment->GetSampleBool(i)))
+    {
+      if (theFirst >= 0)
+        AddDecimatedColumn(theFirst, theMin, theMax, theLast);
+
+      theColumn = absX;
+      theFirst = theMin = theMax = theLast = i;
+      theMinY = theMaxY = theY;
+    }
+    else
+    {
+      if (theY < theMinY) { theMinY = theY; theMin = i; }
+      if (theY > theMaxY) { theMaxY = theY; theMax = i; }
+      theLast = i;
+    }
+  }
+
+  if (theFirst >= 0)
+    AddDecimatedColumn(theFirst, theMin, theMax, theLast);
+}
+
+void iupPlotDataSet::DecimateLTTBRange(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, int inBegin, int inEnd, int inThreshold) const
+{
+  /* Largest Triangle Three Buckets, in screen coordinates */
+  int theCount = inEnd - inBegin;
+  if (inThreshold < 3)
+    inThreshold = 3;
+
+  if (theCount <= inThreshold)
+  {
+    for (int i = inBegin; i < inEnd; i++)
+      AddDecimatedIndex(i);
+    return;
+  }
+
+  double theBucketSize = (double)(theCount - 2) / (double)(inThreshold - 2);
+  int theA = inBegin;
+  double theAX = inTrafoX->Transform(mDataX->GetSample(theA));
+  double theAY = inTrafoY->Transform(mDataY->GetSample(theA));
+
+  AddDecimatedIndex(theA);
+
+  for (int b = 0; b < inThreshold - 2; b++)
+  {
+    // average of the next bucket
+    int theAvgBegin = inBegin + (int)((b + 1) * theBucketSize) + 1;
+    int theAvgEnd = inBegin + (int)((b + 2) * theBucketSize) + 1;
+    if (theAvgEnd > inEnd) theAvgEnd = inEnd;
+    if (theAvgBegin >= theAvgEnd) theAvgBegin = inEnd - 1;
+
+    double theAvgX = 0, theAvgY = 0;
+    for (int i = theAvgBegin; i < theAvgEnd; i++)
+    {
+      theAvgX += inTrafoX->Transform(mDataX->GetSample(i));
+      theAvgY += inTrafoY->Transform(mDataY->GetSample(i));
+    }
+    theAvgX /= (theAvgEnd - theAvgBegin);
+    theAvgY /= (theAvgEnd - theAvgBegin);
+
+    // the sample of this bucket that forms the largest triangle
+    int theRangeBegin = inBegin + (int)(b * theBucketSize) + 1;
+    int theRangeEnd = inBegin + (int)((b + 1) * theBucketSize) + 1;
+    int theSelected = theRangeBegin;
+    double theSelectedX = theAX, theSelectedY = theAY, theMaxArea = -1;
+
+    for (int i = theRangeBegin; i < theRangeEnd; i++)
+    {
+      double theX = inTrafoX->Transform(mDataX->GetSample(i));
+      double theY = inTrafoY->Transform(mDataY->GetSample(i));
+      double theArea = fabs((theAX - theAvgX) * (theY - theAY) - (theAX - theX) * (theAvgY - theAY));
+      if (theArea > theMaxArea)
+      {
+        theMaxArea = theArea;
+        theSelected = i;
+        theSelectedX = theX;
+        theSelectedY = theY;
+      }
+    }
+
+    AddDecimatedIndex(theSelected);
+    theA = theSelected;
+    theAX = theSelectedX;
+    theAY = theSelectedY;
+  }
+
+  AddDecimatedIndex(inEnd - 1);
+}
+
+void iupPlotDataSet::DecimateLTTB(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, const iupPlotDrawContext* ctx) const
+{
+  int theCount = mDataX->GetCount();
+  int theThreshold = 2 * ctx->viewportW;
+  int theBegin = 0;
+  double thePrevX = 0;
+
+  for (int i = 0; i < theCount; i++)
+  {
+    double theX = mDataX->GetSample(i);
+    if (i > 0 && theX < thePrevX)
+    {
+      mDecimatedCount = -1;  // X is not ordered
+      return;
+    }
+    thePrevX = theX;
+  }
+
+  // each segment is decimated separately, with a share of the points proportional to its size
+  for (int i = 1; i <= theCount; i++)
+  {
+    if (i == theCount || (mSegment && mSegment->GetSampleBool(i)))
+    {
+      int theRangeThreshold = (int)(((double)(i - theBegin) * theThreshold) / theCount);
+      DecimateLTTBRange(inTrafoX, inTrafoY, theBegin, i, theRangeThreshold);
+      theBegin = i;
+    }
+  }
+}
+
+const int* iupPlotDataSet::GetDecimatedIndex(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, const iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, int &outCount) const
+{
+  int theCount = mDataX->GetCount();
+  outCount = theCount;
+
+  // the callback must be called for every sample, and small datasets are faster drawn directly
+  if (mDecimation == IUP_PLOT_DECIMATION_NONE || inNotify->cb || theCount <= 4 * ctx->viewportW)
+    return NULL;
+
+  // the decimation depends only on the samples and on the screen transformation
+  double theKey[10];
+  theKey[0] = (double)mDecimation;
+  theKey[1] = (double)mDataVersion;
+  theKey[2] = (double)theCount;
+  theKey[3] = (double)ctx->viewportX;
+  theKey[4] = (double)ctx->viewportW;
+  theKey[5] = (double)ctx->viewportH;
+  theKey[6] = inTrafoX->Transform(1);
+  theKey[7] = inTrafoX->Transform(10);
+  theKey[8] = inTrafoY->Transform(1);
+  theKey[9] = inTrafoY->Transform(10);
+
+  if (!mDecimatedValid || memcmp(theKey, mDecimatedKey, sizeof(theKey)) != 0)
+  {
+    memcpy(mDecimatedKey, theKey, sizeof(theKey));
+    mDecimatedCount = 0;
+
+    if (mDecimation == IUP_PLOT_DECIMATION_LTTB)
+      DecimateLTTB(inTrafoX, inTrafoY, ctx);
+    else
+      DecimateMinMax(inTrafoX, ctx);
+
+    mDecimatedValid = true;
+  }
+
+  if (mDecimatedCount < 0)
+    return NULL;
+
+  outCount = mDecimatedCount;
+  return mDecimatedIndex;
+}
+
+/************************************************************************************/
+
 void iupPlotDataSet::DrawDataLine(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, bool inShowMark, bool inErrorBar) const
 {
   int theCount = mDataX->GetCount();
-  int drawStyle = iupPlotLineStyleToDrawStyle(mLineStyle);
+  const int* theIndex = NULL;
+
+  // marks are drawn for every sample
+  if (!inShowMark)
+    theIndex = GetDecimatedIndex(inTrafoX, inTrafoY, ctx, inNotify, theCount);
 
   iupPlotPointBuffer buf;
   buf.Begin(theCount);
 
-  for (int i = 0; i < theCount; i++)
+  iupPlotScreenBlock theBlock(mDataX, mDataY, inTrafoX, inTrafoY);
+
+  for (int k = 0; k < theCount; k++)
   {
-    double theX = mDataX->GetSample(i);
-    double theY = mDataY->GetSample(i);
-    double theScreenX = inTrafoX->Transform(theX);
-    double theScreenY = inTrafoY->Transform(theY);
+    int i = theIndex ? theIndex[k] : k;
+    double theScreenX, theScreenY;
+    if (theIndex)
+    {
+      // only a few samples
+      theScreenX = inTrafoX->Transform(mDataX->GetSample(i));
+      theScreenY = inTrafoY->Transform(mDataY->GetSample(i));
+    }
+    else
+    {
+      theScreenX = theBlock.X(i);
+      theScreenY = theBlock.Y(i);
+    }
     int absX = iupPlotDrawCalcX(ctx, theScreenX);
     int absY = iupPlotDrawCalcY(ctx, theScreenY);
 
     if (inNotify->cb)
-      inNotify->cb(inNotify->ih, inNotify->ds, i, theX, theY, (int)mSelection->GetSampleBool(i));
+      inNotify->cb(inNotify->ih, inNotify->ds, i, mDataX->GetSample(i), mDataY->GetSample(i), (int)mSelection->GetSampleBool(i));
 
     if (inShowMark)
     {
@@ -933,7 +1753,7 @@ void iupPlotDataSet::DrawDataLine(const iupPlotTrafo *inTrafoX, const iupPlotTra
       if (mExtra)
       {
         if (inErrorBar)
-          DrawErrorBar(inTrafoY, ctx, i, theY, theScreenX);
+          DrawErrorBar(inTrafoY, ctx, i, mDataY->GetSample(i), theScreenX);
         else
           SetSampleExtraMarkSize(inTrafoY, i, &theMarkSize);
       }
@@ -941,14 +1761,11 @@ void iupPlotDataSet::DrawDataLine(const iupPlotTrafo *inTrafoX, const iupPlotTra
       iupPlotDrawMark(ctx, absX, absY, mMarkStyle, theMarkSize, mColor);
     }
 
-    if (i == mHighlightedSample)
-      iPlotDrawHighlightedMark(ctx, absX, absY, mColor, mMarkSize);
-
     if (i > 0 && mSegment && mSegment->GetSampleBool(i))
     {
       buf.DrawStroke(ctx, mColor, mLineStyle, mLineWidth);
       buf.Clear();
-      buf.Begin(theCount - i);
+      buf.Begin(theCount - k);
     }
 
     buf.AddVertex(absX, absY);
@@ -956,10 +1773,8 @@ void iupPlotDataSet::DrawDataLine(const iupPlotTrafo *inTrafoX, const iupPlotTra
 
   buf.DrawStroke(ctx, mColor, mLineStyle, mLineWidth);
 
-  if (mHighlightedCurve)
-    iPlotDrawHighlightedCurve(ctx, theCount, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, false);
-  else if (mSelectedCurve)
-    iPlotDrawHighlightedCurve(ctx, theCount, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, false, true);
+  if (mSelectedCurve)
+    iPlotDrawHighlightedCurve(ctx, theCount, theIndex, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, false, true);
 }
 
 void iupPlotDataSet::DrawErrorBar(const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, int index, double theY, double theScreenX) const
@@ -994,29 +1809,208 @@ void iupPlotDataSet::SetSampleExtraMarkSize(const iupPlotTrafo *inTrafoY, int in
 void iupPlotDataSet::DrawDataMark(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const
 {
   int theCount = mDataX->GetCount();
+  iupPlotScreenBlock theBlock(mDataX, mDataY, inTrafoX, inTrafoY);
+
   for (int i = 0; i < theCount; i++)
   {
-    double theX = mDataX->GetSample(i);
-    double theY = mDataY->GetSample(i);
-    double theScreenX = inTrafoX->Transform(theX);
-    double theScreenY = inTrafoY->Transform(theY);
-    int absX = iupPlotDrawCalcX(ctx, theScreenX);
-    int absY = iupPlotDrawCalcY(ctx, theScreenY);
+    int absX = iupPlotDrawCalcX(ctx, theBlock.X(i));
+    int absY = iupPlotDrawCalcY(ctx, theBlock.Y(i));
 
     if (inNotify->cb)
-      inNotify->cb(inNotify->ih, inNotify->ds, i, theX, theY, (int)mSelection->GetSampleBool(i));
+      inNotify->cb(inNotify->ih, inNotify->ds, i, mDataX->GetSample(i), mDataY->GetSample(i), (int)mSelection->GetSampleBool(i));
 
     int theMarkSize = mMarkSize;
     if (mExtra)
       SetSampleExtraMarkSize(inTrafoY, i, &theMarkSize);
 
     iupPlotDrawMark(ctx, absX, absY, mMarkStyle, theMarkSize, mColor);
+  }
+}
+
+// Samples of a range counted in a histogram with one bin for each pixel of the viewport
+struct iPlotDensityJob
+{
+  const iupPlotData* dataX;
+  const iupPlotData* dataY;
+  const iupPlotTrafo* trafoX;
+  const iupPlotTrafo* trafoY;
+  int begin, count;
+  int width, height;
+  unsigned int* bins;
+};
+
+static void iPlotDensityRunJob(void* inJob)
+{
+  iPlotDensityJob* job = (iPlotDensityJob*)inJob;
+  double theX[IPLOT_DENSITY_BLOCK], theY[IPLOT_DENSITY_BLOCK];
+
+  for (int i = 0; i < job->count; i += IPLOT_DENSITY_BLOCK)
+  {
+    int theCount = job->count - i < IPLOT_DENSITY_BLOCK ? job->count - i : IPLOT_DENSITY_BLOCK;
+    job->dataX->GetSamples(job->begin + i, theCount, theX);
+    job->trafoX->TransformArray(theX, theX, theCount);
+    job->dataY->GetSamples(job->begin + i, theCount, theY);
+    job->trafoY->TransformArray(theY, theY, theCount);
 
-    if (i == mHighlightedSample)
-      iPlotDrawHighlightedMark(ctx, absX, absY, mColor, mMarkSize);
+    for (int j = 0; j < theCount; j++)
+    {
+      // also false for NaN
+      if (theX[j] > -0.5 && theX[j] < job->width - 0.5 && theY[j] > -0.5 && theY[j] < job->height - 0.5)
+        job->bins[iupPlotRound(theY[j]) * job->width + iupPlotRound(theX[j])]++;
+    }
   }
 }
 
+void iupPlotDataSet::DrawDataDensity(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const
+{
+  int theCount = mDataX->GetCount();
+  int theWidth = ctx->viewportW;
+  int theHeight = ctx->viewportH;
+  if (theWidth <= 0 || theHeight <= 0)
+    return;
+
+  if (inNotify->cb)
+  {
+    for (int i = 0; i < theCount; i++)
+      inNotify->cb(inNotify->ih, inNotify->ds, i, mDataX->GetSample(i), mDataY->GetSample(i), (int)mSelection->GetSampleBool(i));
+  }
+
+  // each thread counts its samples in its own histogram
+  iPlotDensityJob jobs[IUP_PLOT_THREAD_MAX];
+  int theThreadCount = iupPlotGetThreadCount(theCount, IPLOT_DENSITY_MIN_SAMPLES);
+  size_t theBinCount = (size_t)theWidth * theHeight;
+  unsigned int* theBins = (unsigned int*)calloc(theBinCount * theThreadCount, sizeof(unsigned int));
+  if (!theBins)
+    return;
+
+  for (int t = 0; t < theThreadCount; t++)
+  {
+    int theFirst = (int)(((int64_t)theCount * t) / theThreadCount);
+    int theLast = (int)(((int64_t)theCount * (t + 1)) / theThreadCount);
+
+    jobs[t].dataX = mDataX;
+    jobs[t].dataY = mDataY;
+    jobs[t].trafoX = inTrafoX;
+    jobs[t].trafoY = inTrafoY;
+    jobs[t].begin = theFirst;
+    jobs[t].count = theLast - theFirst;
+    jobs[t].width = theWidth;
+    jobs[t].height = theHeight;
+    jobs[t].bins = theBins + t * theBinCount;
+  }
+
+  iupPlotRunJobs(iPlotDensityRunJob, jobs, sizeof(iPlotDensityJob), theThreadCount);
+
+  // merge the histograms, the image is limited to the bins that have samples
+  unsigned int theMaxCount = 0;
+  int theMinCol = theWidth, theMaxCol = -1, theMinRow = theHeight, theMaxRow = -1;
+  for (int row = 0; row < theHeight; row++)
+  {
+    unsigned int* theRow = theBins + (size_t)row * theWidth;
+    for (int col = 0; col < theWidth; col++)
+    {
+      unsigned int theBin = theRow[col];
+      for (int t = 1; t < theThreadCount; t++)
+        theBin += theRow[t * theBinCount + col];
+
+      if (theBin)
+      {
+        theRow[col] = theBin;
+        if (theBin > theMaxCount) theMaxCount = theBin;
+        if (col < theMinCol) theMinCol = col;
+        if (col > theMaxCol) theMaxCol = col;
+        if (row < theMinRow) theMinRow = row;
+        theMaxRow = row;
+      }
+    }
+  }
+
+  if (theMaxCount == 0)
+  {
+    free(theBins);
+    return;
+  }
+
+  // counts are mapped to 256 levels in a logarithmic scale
+  unsigned char theLevelColor[256][4];
+  for (int l = 0; l < 256; l++)
+  {
+    long theColor;
+    unsigned char theAlpha;
+    if (mDensityColors > 0)
+    {
+      int theIndex = (l * mDensityColors) / 256;
+      theColor = iupPlotDrawGetSampleColorTable(ctx->ih, theIndex);
+      theAlpha = iupDrawAlpha(theColor);
+    }
+    else
+    {
+      // sparse regions are lighter
+      theColor = mColor;
+      theAlpha = (unsigned char)(iupDrawAlpha(mColor) * (64 + (191 * l) / 255) / 255);
+    }
+
+    theLevelColor[l][0] = iupDrawRed(theColor);
+    theLevelColor[l][1] = iupDrawGreen(theColor);
+    theLevelColor[l][2] = iupDrawBlue(theColor);
+    theLevelColor[l][3] = theAlpha;
+  }
+
+  double theLevelScale = theMaxCount > 1 ? 255.0 / log((double)theMaxCount) : 0;
+
+  int theImageW = theMaxCol - theMinCol + 1;
+  int theImageH = theMaxRow - theMinRow + 1;
+
+  // the same image is reused, its change stamp tells recorded frames that the pixels changed
+  if (!mDensityImage)
+  {
+    mDensityImage = IupImageRGBA(theImageW, theImageH, NULL);
+    if (!mDensityImage)
+    {
+      free(theBins);
+      return;
+    }
+
+    char theName[50];
+    sprintf(theName, "_IUP_PLOT_DENSITY%p", (void*)this);
+    IupSetHandle(theName, mDensityImage);
+  }
+  else
+    IupSetStrf(mDensityImage, "RESHAPE", "%dx%d", theImageW, theImageH);
+
+  unsigned char* thePixels = (unsigned char*)IupGetAttribute(mDensityImage, "WID");
+  if (!thePixels || IupGetInt(mDensityImage, "WIDTH") != theImageW || IupGetInt(mDensityImage, "HEIGHT") != theImageH)
+  {
+    free(theBins);
+    return;
+  }
+  memset(thePixels, 0, (size_t)theImageW * theImageH * 4);
+
+  for (int row = theMinRow; row <= theMaxRow; row++)
+  {
+    const unsigned int* theRow = theBins + (size_t)row * theWidth;
+    unsigned char* theLine = thePixels + (size_t)(theMaxRow - row) * theImageW * 4;  // the image starts at the top
+    for (int col = theMinCol; col <= theMaxCol; col++)
+    {
+      unsigned int theBin = theRow[col];
+      if (theBin)
+      {
+        int theLevel = theMaxCount > 1 ? (int)(log((double)theBin) * theLevelScale) : 255;
+        if (theLevel > 255) theLevel = 255;
+        memcpy(theLine + (col - theMinCol) * 4, theLevelColor[theLevel], 4);
+      }
+    }
+  }
+
+  free(theBins);
+
+  IupSetAttribute(mDensityImage, "CLEARCACHE", "1");
+
+  iupAttribSet(ctx->ih, "DRAWIMAGEQUALITY", "NEAREST");
+  iupPlotDrawImage(ctx->ih, IupGetName(mDensityImage), 0, NULL, iupPlotDrawCalcX(ctx, theMinCol), iupPlotDrawCalcY(ctx, theMaxRow), theImageW, theImageH);
+  iupAttribSet(ctx->ih, "DRAWIMAGEQUALITY", NULL);
+}
+
 void iupPlotDataSet::DrawDataStem(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, bool inShowMark) const
 {
   double theScreenY0 = inTrafoY->Transform(0);
@@ -1045,9 +2039,6 @@ void iupPlotDataSet::DrawDataStem(const iupPlotTrafo *inTrafoX, const iupPlotTra
     }
 
     iupPlotDrawLine(ctx->ih, absX, absY0, absX, absY, mColor, IUP_DRAW_STROKE, mLineWidth);
-
-    if (i == mHighlightedSample)
-      iPlotDrawHighlightedStem(ctx, absX, absY0, absX, absY, mColor, mMarkSize, mLineWidth);
   }
 }
 
@@ -1055,6 +2046,7 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
 {
   int theCount = mDataX->GetCount();
   double theScreenY0 = inTrafoY->Transform(0);
+  const int* theIndex = GetDecimatedIndex(inTrafoX, inTrafoY, ctx, inNotify, theCount);
 
   long fillColor = mColor;
   if (mAreaTransparency != 255)
@@ -1065,8 +2057,9 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
 
   double theFirstScreenX = 0, theLastScreenX = 0;
 
-  for (int i = 0; i < theCount; i++)
+  for (int k = 0; k < theCount; k++)
   {
+    int i = theIndex ? theIndex[k] : k;
     double theX = mDataX->GetSample(i);
     double theY = mDataY->GetSample(i);
     double theScreenX = inTrafoX->Transform(theX);
@@ -1077,7 +2070,7 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
     if (inNotify->cb)
       inNotify->cb(inNotify->ih, inNotify->ds, i, theX, theY, (int)mSelection->GetSampleBool(i));
 
-    if (i == 0)
+    if (k == 0)
     {
       theFirstScreenX = theScreenX;
       fillBuf.AddVertex(iupPlotDrawCalcX(ctx, theScreenX), iupPlotDrawCalcY(ctx, theScreenY0));
@@ -1088,15 +2081,12 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
       fillBuf.AddVertex(iupPlotDrawCalcX(ctx, theLastScreenX), iupPlotDrawCalcY(ctx, theScreenY0));
       fillBuf.DrawFill(ctx, fillColor);
       fillBuf.Clear();
-      fillBuf.Begin(theCount - i + 2);
+      fillBuf.Begin(theCount - k + 2);
       fillBuf.AddVertex(iupPlotDrawCalcX(ctx, theScreenX), iupPlotDrawCalcY(ctx, theScreenY0));
     }
 
     fillBuf.AddVertex(absX, absY);
 
-    if (i == mHighlightedSample)
-      iPlotDrawHighlightedMark(ctx, absX, absY, mColor, mMarkSize);
-
     theLastScreenX = theScreenX;
   }
 
@@ -1108,8 +2098,9 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
     iupPlotPointBuffer lineBuf;
     lineBuf.Begin(theCount);
 
-    for (int i = 0; i < theCount; i++)
+    for (int k = 0; k < theCount; k++)
     {
+      int i = theIndex ? theIndex[k] : k;
       double theX = mDataX->GetSample(i);
       double theY = mDataY->GetSample(i);
       double theScreenX = inTrafoX->Transform(theX);
@@ -1119,7 +2110,7 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
       {
         lineBuf.DrawStroke(ctx, mColor, IUP_PLOT_LINE_CONTINUOUS, mLineWidth);
         lineBuf.Clear();
-        lineBuf.Begin(theCount - i);
+        lineBuf.Begin(theCount - k);
       }
 
       lineBuf.AddVertex(iupPlotDrawCalcX(ctx, theScreenX), iupPlotDrawCalcY(ctx, theScreenY));
@@ -1128,10 +2119,8 @@ void iupPlotDataSet::DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTra
     lineBuf.DrawStroke(ctx, mColor, IUP_PLOT_LINE_CONTINUOUS, mLineWidth);
   }
 
-  if (mHighlightedCurve)
-    iPlotDrawHighlightedCurve(ctx, theCount, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, false);
-  else if (mSelectedCurve)
-    iPlotDrawHighlightedCurve(ctx, theCount, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, false, true);
+  if (mSelectedCurve)
+    iPlotDrawHighlightedCurve(ctx, theCount, theIndex, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, false, true);
 }
 
 static void iPlotDrawBarRect(iupPlotDrawContext* ctx, double x, double y, double barWidth, double barHeight, long color, int style, int lineWidth)
@@ -1167,18 +2156,18 @@ void iupPlotDataSet::DrawDataBar(const iupPlotTrafo *inTrafoX, const iupPlotTraf
   double theBarWidth = (theScreenMaxX - theScreenMinX) / (theCount - 1);
   theBarWidth *= 1 - (double)mBarSpacingPercent / 100.0;
 
+  iupPlotScreenBlock theBlock(mDataX, mDataY, inTrafoX, inTrafoY);
+
   for (int i = 0; i < theCount; i++)
   {
-    double theX = mDataX->GetSample(i);
-    double theY = mDataY->GetSample(i);
-    double theScreenX = inTrafoX->Transform(theX);
-    double theScreenY = inTrafoY->Transform(theY);
+    double theScreenX = theBlock.X(i);
+    double theScreenY = theBlock.Y(i);
 
     double theBarX = theScreenX - theBarWidth / 2;
     double theBarHeight = theScreenY - theScreenY0;
 
     if (inNotify->cb)
-      inNotify->cb(inNotify->ih, inNotify->ds, i, theX, theY, (int)mSelection->GetSampleBool(i));
+      inNotify->cb(inNotify->ih, inNotify->ds, i, mDataX->GetSample(i), mDataY->GetSample(i), (int)mSelection->GetSampleBool(i));
 
     if (theBarHeight == 0)
       continue;
@@ -1191,14 +2180,6 @@ void iupPlotDataSet::DrawDataBar(const iupPlotTrafo *inTrafoX, const iupPlotTraf
 
     if (mBarShowOutline)
       iPlotDrawBarRect(ctx, theBarX, theScreenY0, theBarWidth, theBarHeight, mBarOutlineColor, IUP_DRAW_STROKE, mLineWidth);
-
-    if (i == mHighlightedSample)
-    {
-      int bx1, by1, bx2, by2;
-      if (theBarHeight > 0) { bx1 = iupPlotDrawCalcX(ctx, theBarX); by1 = iupPlotDrawCalcY(ctx, theScreenY0 + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theBarX + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theScreenY0); }
-      else { bx1 = iupPlotDrawCalcX(ctx, theBarX); by1 = iupPlotDrawCalcY(ctx, theScreenY0); bx2 = iupPlotDrawCalcX(ctx, theBarX + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theScreenY0 + theBarHeight); }
-      iPlotDrawHighlightedBar(ctx, bx1, by1, bx2, by2, drawColor, mLineWidth);
-    }
   }
 }
 
@@ -1239,14 +2220,6 @@ void iupPlotDataSet::DrawDataHorizontalBar(const iupPlotTrafo *inTrafoX, const i
 
     if (mBarShowOutline)
       iPlotDrawBarRect(ctx, theScreenX0, theBarY, theBarWidth, theBarHeight, mBarOutlineColor, IUP_DRAW_STROKE, mLineWidth);
-
-    if (i == mHighlightedSample)
-    {
-      int bx1, by1, bx2, by2;
-      if (theBarWidth > 0) { bx1 = iupPlotDrawCalcX(ctx, theScreenX0); by1 = iupPlotDrawCalcY(ctx, theBarY + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theScreenX0 + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theBarY); }
-      else { bx1 = iupPlotDrawCalcX(ctx, theScreenX0 + theBarWidth); by1 = iupPlotDrawCalcY(ctx, theBarY + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theScreenX0); by2 = iupPlotDrawCalcY(ctx, theBarY); }
-      iPlotDrawHighlightedBar(ctx, bx1, by1, bx2, by2, drawColor, mLineWidth);
-    }
   }
 }
 
@@ -1284,26 +2257,21 @@ void iupPlotDataSet::DrawDataMultiBar(const iupPlotTrafo *inTrafoX, const iupPlo
 
     if (mBarShowOutline)
       iPlotDrawBarRect(ctx, theBarX, theScreenY0, theBarWidth, theBarHeight, mBarOutlineColor, IUP_DRAW_STROKE, mLineWidth);
-
-    if (i == mHighlightedSample)
-    {
-      int bx1, by1, bx2, by2;
-      if (theBarHeight > 0) { bx1 = iupPlotDrawCalcX(ctx, theBarX); by1 = iupPlotDrawCalcY(ctx, theScreenY0 + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theBarX + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theScreenY0); }
-      else { bx1 = iupPlotDrawCalcX(ctx, theBarX); by1 = iupPlotDrawCalcY(ctx, theScreenY0); bx2 = iupPlotDrawCalcX(ctx, theBarX + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theScreenY0 + theBarHeight); }
-      iPlotDrawHighlightedBar(ctx, bx1, by1, bx2, by2, mColor, mLineWidth);
-    }
   }
 }
 
 void iupPlotDataSet::DrawDataStep(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const
 {
   int theCount = mDataX->GetCount();
+  const int* theIndex = GetDecimatedIndex(inTrafoX, inTrafoY, ctx, inNotify, theCount);
+  int prevAbsX = 0;
 
   iupPlotPointBuffer buf;
   buf.Begin(theCount * 2);
 
-  for (int i = 0; i < theCount; i++)
+  for (int k = 0; k < theCount; k++)
   {
+    int i = theIndex ? theIndex[k] : k;
     double theX = mDataX->GetSample(i);
     double theY = mDataY->GetSample(i);
     double theScreenX = inTrafoX->Transform(theX);
@@ -1318,27 +2286,20 @@ void iupPlotDataSet::DrawDataStep(const iupPlotTrafo *inTrafoX, const iupPlotTra
     {
       buf.DrawStroke(ctx, mColor, mLineStyle, mLineWidth);
       buf.Clear();
-      buf.Begin(theCount - i);
+      buf.Begin(theCount - k);
     }
 
-    if (i > 0)
-    {
-      int prevAbsX = iupPlotDrawCalcX(ctx, inTrafoX->Transform(mDataX->GetSample(i - 1)));
+    if (k > 0)
       buf.AddVertex(prevAbsX, absY);
-    }
 
     buf.AddVertex(absX, absY);
-
-    if (i == mHighlightedSample)
-      iPlotDrawHighlightedMark(ctx, absX, absY, mColor, mMarkSize);
+    prevAbsX = absX;
   }
 
   buf.DrawStroke(ctx, mColor, mLineStyle, mLineWidth);
 
-  if (mHighlightedCurve)
-    iPlotDrawHighlightedCurve(ctx, theCount, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, true);
-  else if (mSelectedCurve)
-    iPlotDrawHighlightedCurve(ctx, theCount, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, true, true);
+  if (mSelectedCurve)
+    iPlotDrawHighlightedCurve(ctx, theCount, theIndex, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, true, true);
 }
 
 static int iPlotGetPieTextAlignment(double bisectrix, double inPieSliceLabelPos)
@@ -1391,11 +2352,6 @@ void iupPlotDataSet::DrawDataPie(const iupPlotTrafo *inTrafoX, const iupPlotTraf
   w *= ((iupPlotTrafoLinear *)inTrafoX)->mSlope;
   h *= ((iupPlotTrafoLinear *)inTrafoY)->mSlope;
 
-  double w1 = 2.0 * (mPieRadius * 1.01);
-  double h1 = 2.0 * (mPieRadius * 1.01);
-  w1 *= ((iupPlotTrafoLinear *)inTrafoX)->mSlope;
-  h1 *= ((iupPlotTrafoLinear *)inTrafoY)->mSlope;
-
   double startAngle = mPieStartAngle;
 
   char fontStr[256];
@@ -1431,15 +2387,6 @@ void iupPlotDataSet::DrawDataPie(const iupPlotTrafo *inTrafoX, const iupPlotTraf
     if (mPieContour)
       iupPlotDrawArc(ctx->ih, ax1, ay1, ax2, ay2, startAngle, startAngle + angle, mColor, IUP_DRAW_STROKE, mLineWidth);
 
-    if (i == mHighlightedSample)
-    {
-      int hx1 = iupPlotDrawCalcX(ctx, xc - w1 / 2);
-      int hy1 = iupPlotDrawCalcY(ctx, yc + h1 / 2);
-      int hx2 = iupPlotDrawCalcX(ctx, xc + w1 / 2);
-      int hy2 = iupPlotDrawCalcY(ctx, yc - h1 / 2);
-      iPlotDrawHighlightedArc(ctx, hx1, hy1, hx2, hy2, startAngle, startAngle + angle, sampleColor, mLineWidth);
-    }
-
     if (mPieSliceLabel != IUP_PLOT_NONE)
     {
       double bisectrix = (startAngle + startAngle + angle) / 2;
@@ -1562,6 +2509,9 @@ void iupPlotDataSet::DrawData(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *
     break;
   case IUP_PLOT_PIE:
     break;
+  case IUP_PLOT_DENSITY:
+    DrawDataDensity(inTrafoX, inTrafoY, ctx, inNotify);
+    break;
   case IUP_PLOT_HORIZONTALBAR:
     DrawDataHorizontalBar(inTrafoX, inTrafoY, ctx, inNotify);
     break;
@@ -1579,3 +2529,155 @@ void iupPlotDataSet::DrawData(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *
   if (mHasSelected)
     DrawSelection(inTrafoX, inTrafoY, ctx, inNotify);
 }
+
+void iupPlotDataSet::DrawHighlightPie(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const
+{
+  int theCount = mDataX->GetCount();
+  double sum = 0;
+
+  for (int i = 0; i < theCount; i++)
+  {
+    double theY = mDataY->GetSample(i);
+    if (theY <= 0)
+      continue;
+    sum += theY;
+  }
+
+  double theHighlightY = mDataY->GetSample(mHighlightedSample);
+  if (theHighlightY <= 0)
+    return;
+
+  double startAngle = mPieStartAngle;
+  for (int i = 0; i < mHighlightedSample; i++)
+  {
+    double theY = mDataY->GetSample(i);
+    if (theY > 0)
+      startAngle += (theY * 360.) / sum;
+  }
+
+  double angle = (theHighlightY * 360.) / sum;
+
+  double xc = inTrafoX->Transform(0);
+  double yc = inTrafoY->Transform(0);
+
+  double w1 = 2.0 * (mPieRadius * 1.01);
+  double h1 = 2.0 * (mPieRadius * 1.01);
+  w1 *= ((iupPlotTrafoLinear *)inTrafoX)->mSlope;
+  h1 *= ((iupPlotTrafoLinear *)inTrafoY)->mSlope;
+
+  int hx1 = iupPlotDrawCalcX(ctx, xc - w1 / 2);
+  int hy1 = iupPlotDrawCalcY(ctx, yc + h1 / 2);
+  int hx2 = iupPlotDrawCalcX(ctx, xc + w1 / 2);
+  int hy2 = iupPlotDrawCalcY(ctx, yc - h1 / 2);
+  long sampleColor = iupPlotDrawGetSampleColorTable(inNotify->ih, mHighlightedSample);
+  iPlotDrawHighlightedArc(ctx, hx1, hy1, hx2, hy2, startAngle, startAngle + angle, sampleColor, mLineWidth);
+}
+
+void iupPlotDataSet::DrawHighlight(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const
+{
+  int theCount = mDataX->GetCount();
+
+  if (theCount == 0 || theCount != mDataY->GetCount())
+    return;
+
+  if (mHighlightedSample >= theCount)
+    return;
+
+  // drawn over the data layer, so they can change without drawing the data again
+  int i = mHighlightedSample;
+
+  switch (mMode)
+  {
+  case IUP_PLOT_LINE:
+  case IUP_PLOT_MARKLINE:
+  case IUP_PLOT_ERRORBAR:
+  case IUP_PLOT_AREA:
+  case IUP_PLOT_STEP:
+    iPlotDrawHighlightedSample(ctx, i, mDataX, mDataY, inTrafoX, inTrafoY, mColor, mMarkSize);
+
+    if (mHighlightedCurve)
+    {
+      const int* theIndex = GetDecimatedIndex(inTrafoX, inTrafoY, ctx, inNotify, theCount);
+      iPlotDrawHighlightedCurve(ctx, theCount, theIndex, mDataX, mDataY, mSegment, inTrafoX, inTrafoY, mColor, mLineWidth, mMode == IUP_PLOT_STEP);
+    }
+    break;
+  case IUP_PLOT_MARK:
+  case IUP_PLOT_DENSITY:
+    iPlotDrawHighlightedSample(ctx, i, mDataX, mDataY, inTrafoX, inTrafoY, mColor, mMarkSize);
+    break;
+  case IUP_PLOT_STEM:
+  case IUP_PLOT_MARKSTEM:
+    if (i >= 0)
+    {
+      int absY0 = iupPlotDrawCalcY(ctx, inTrafoY->Transform(0));
+      int absX = iupPlotDrawCalcX(ctx, inTrafoX->Transform(mDataX->GetSample(i)));
+      int absY = iupPlotDrawCalcY(ctx, inTrafoY->Transform(mDataY->GetSample(i)));
+      iPlotDrawHighlightedStem(ctx, absX, absY0, absX, absY, mColor, mMarkSize, mLineWidth);
+    }
+    break;
+  case IUP_PLOT_BAR:
+  case IUP_PLOT_MULTIBAR:
+    if (i >= 0)
+    {
+      double theScreenY0 = inTrafoY->Transform(0);
+      double theScreenMinX = inTrafoX->Transform(mDataX->GetSample(0));
+      double theScreenMaxX = inTrafoX->Transform(mDataX->GetSample(theCount - 1));
+
+      double theBarWidth = (theScreenMaxX - theScreenMinX) / (theCount - 1);
+      theBarWidth *= 1 - (double)mBarSpacingPercent / 100.0;
+
+      double theScreenX = inTrafoX->Transform(mDataX->GetSample(i));
+      double theBarX = theScreenX - theBarWidth / 2;
+      double theBarHeight = inTrafoY->Transform(mDataY->GetSample(i)) - theScreenY0;
+
+      long drawColor = mColor;
+      if (mMode == IUP_PLOT_MULTIBAR)
+      {
+        double theTotalBarWidth = theBarWidth;
+        theBarWidth = theTotalBarWidth / mMultibarCount;
+        theBarX = (theScreenX - theTotalBarWidth / 2) + (mMultibarIndex*theBarWidth);
+      }
+      else if (mBarMulticolor)
+        drawColor = iupPlotDrawGetSampleColorTable(inNotify->ih, i);
+
+      if (theBarHeight == 0)
+        break;
+
+      int bx1, by1, bx2, by2;
+      if (theBarHeight > 0) { bx1 = iupPlotDrawCalcX(ctx, theBarX); by1 = iupPlotDrawCalcY(ctx, theScreenY0 + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theBarX + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theScreenY0); }
+      else { bx1 = iupPlotDrawCalcX(ctx, theBarX); by1 = iupPlotDrawCalcY(ctx, theScreenY0); bx2 = iupPlotDrawCalcX(ctx, theBarX + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theScreenY0 + theBarHeight); }
+      iPlotDrawHighlightedBar(ctx, bx1, by1, bx2, by2, drawColor, mLineWidth);
+    }
+    break;
+  case IUP_PLOT_HORIZONTALBAR:
+    if (i >= 0)
+    {
+      double theScreenX0 = inTrafoX->Transform(0);
+      double theScreenMinY = inTrafoY->Transform(mDataY->GetSample(0));
+      double theScreenMaxY = inTrafoY->Transform(mDataY->GetSample(theCount - 1));
+
+      double theBarHeight = (theScreenMaxY - theScreenMinY) / (theCount - 1);
+      theBarHeight *= 1 - (double)mBarSpacingPercent / 100.0;
+
+      double theBarY = inTrafoY->Transform(mDataY->GetSample(i)) - theBarHeight / 2;
+      double theBarWidth = inTrafoX->Transform(mDataX->GetSample(i)) - theScreenX0;
+
+      if (theBarWidth == 0)
+        break;
+
+      long drawColor = mColor;
+      if (mBarMulticolor)
+        drawColor = iupPlotDrawGetSampleColorTable(inNotify->ih, i);
+
+      int bx1, by1, bx2, by2;
+      if (theBarWidth > 0) { bx1 = iupPlotDrawCalcX(ctx, theScreenX0); by1 = iupPlotDrawCalcY(ctx, theBarY + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theScreenX0 + theBarWidth); by2 = iupPlotDrawCalcY(ctx, theBarY); }
+      else { bx1 = iupPlotDrawCalcX(ctx, theScreenX0 + theBarWidth); by1 = iupPlotDrawCalcY(ctx, theBarY + theBarHeight); bx2 = iupPlotDrawCalcX(ctx, theScreenX0); by2 = iupPlotDrawCalcY(ctx, theBarY); }
+      iPlotDrawHighlightedBar(ctx, bx1, by1, bx2, by2, drawColor, mLineWidth);
+    }
+    break;
+  case IUP_PLOT_PIE:
+    if (i >= 0)
+      DrawHighlightPie(inTrafoX, inTrafoY, ctx, inNotify);
+    break;
+  }
+}
@@ -5,6 +5,8 @@
 #include "iup_drvfont.h"
 
 
+#define IPLOT_CROSS_BLOCK 1024
+
 void iupPlotBuildFont(Ihandle* ih, int fontStyle, int fontSize, char* fontStr, int fontStrSize)
 {
   char* fontFace = IupGetAttribute(ih, "FONTFACE");
@@ -225,20 +227,28 @@ void iupPlot::DrawCrossSamplesH(const iupPlotRect &inRect, const iupPlotData *in
   long color = iupDrawColor(0, 0, 0, 255);
   IupGetAttribute(ctx->ih, "FGCOLOR");
 
-  for (int i = 0; i < theCount; i++)
+  // the values are read in blocks to avoid a virtual call per sample
+  double theValues[IPLOT_CROSS_BLOCK];
+
+  for (int theBegin = 0; theBegin < theCount; theBegin += IPLOT_CROSS_BLOCK)
   {
-    double theX = inXData->GetSample(i);
-    bool theCurrentIsLess = theX < theXTarget;
+    int theBlockCount = theCount - theBegin < IPLOT_CROSS_BLOCK ? theCount - theBegin : IPLOT_CROSS_BLOCK;
+    inXData->GetSamples(theBegin, theBlockCount, theValues);
 
-    if (theCurrentIsLess != theFirstIsLess)
+    for (int k = 0; k < theBlockCount; k++)
     {
-      double theY = inYData->GetSample(i);
-      double theScreenY = mAxisY.mTrafo->Transform(theY);
-      int absY = iupPlotDrawCalcY(ctx, theScreenY);
+      bool theCurrentIsLess = theValues[k] < theXTarget;
+
+      if (theCurrentIsLess != theFirstIsLess)
+      {
+        double theY = inYData->GetSample(theBegin + k);
+        double theScreenY = mAxisY.mTrafo->Transform(theY);
+        int absY = iupPlotDrawCalcY(ctx, theScreenY);
 
-      iupPlotDrawLine(ctx->ih, absX1, absY, absX2, absY, color, IUP_DRAW_STROKE, 1);
+        iupPlotDrawLine(ctx->ih, absX1, absY, absX2, absY, color, IUP_DRAW_STROKE, 1);
 
-      theFirstIsLess = theCurrentIsLess;
+        theFirstIsLess = theCurrentIsLess;
+      }
     }
   }
 }
@@ -276,20 +286,27 @@ void iupPlot::DrawCrossSamplesV(const iupPlotRect &inRect, const iupPlotData *in
 
   long color = iupDrawColor(0, 0, 0, 255);
 
-  for (int i = 0; i < theCount; i++)
+  double theValues[IPLOT_CROSS_BLOCK];
+
+  for (int theBegin = 0; theBegin < theCount; theBegin += IPLOT_CROSS_BLOCK)
   {
-    double theY = inYData->GetSample(i);
-    bool theCurrentIsLess = theY < theYTarget;
+    int theBlockCount = theCount - theBegin < IPLOT_CROSS_BLOCK ? theCount - theBegin : IPLOT_CROSS_BLOCK;
+    inYData->GetSamples(theBegin, theBlockCount, theValues);
 
-    if (theCurrentIsLess != theFirstIsLess)
+    for (int k = 0; k < theBlockCount; k++)
     {
-      double theX = inXData->GetSample(i);
-      double theScreenX = mAxisX.mTrafo->Transform(theX);
-      int absX = iupPlotDrawCalcX(ctx, theScreenX);
+      bool theCurrentIsLess = theValues[k] < theYTarget;
 
-      iupPlotDrawLine(ctx->ih, absX, absY1, absX, absY2, color, IUP_DRAW_STROKE, 1);
+      if (theCurrentIsLess != theFirstIsLess)
+      {
+        double theX = inXData->GetSample(theBegin + k);
+        double theScreenX = mAxisX.mTrafo->Transform(theX);
+        int absX = iupPlotDrawCalcX(ctx, theScreenX);
 
-      theFirstIsLess = theCurrentIsLess;
+        iupPlotDrawLine(ctx->ih, absX, absY1, absX, absY2, color, IUP_DRAW_STROKE, 1);
+
+        theFirstIsLess = theCurrentIsLess;
+      }
     }
   }
 }
@@ -417,7 +434,7 @@ bool iupPlot::DrawLegend(const iupPlotRect &inRect, iupPlotDrawContext* ctx, iup
       IupSetAttribute(ctx->ih, "DRAWFONT", fontStr);
       iupDrawGetTextSize(ctx->ih, dataset->GetName(), (int)strlen(dataset->GetName()), &theWidth, NULL, 0);
 
-      if (dataset->mMode == IUP_PLOT_MARK || dataset->mMode == IUP_PLOT_MARKLINE)
+      if (dataset->mMode == IUP_PLOT_MARK || dataset->mMode == IUP_PLOT_MARKLINE || dataset->mMode == IUP_PLOT_DENSITY)
       {
         if (dataset->mMarkSize + 6 > theLineSpace)
           theLineSpace = dataset->mMarkSize + 6;
@@ -502,13 +519,13 @@ bool iupPlot::DrawLegend(const iupPlotRect &inRect, iupPlotDrawContext* ctx, iup
       int theLegendCenterY = theLegendY + theFontHeight / 2;
       int theMarkY = theLegendCenterY - theFontHeight / 8;
 
-      if (dataset->mMode == IUP_PLOT_MARK || dataset->mMode == IUP_PLOT_MARKLINE)
+      if (dataset->mMode == IUP_PLOT_MARK || dataset->mMode == IUP_PLOT_MARKLINE || dataset->mMode == IUP_PLOT_DENSITY)
       {
         int absMarkX = iupPlotDrawCalcX(ctx, theLegendX + (theLineSpace - 3) / 2);
         int absMarkY = iupPlotDrawCalcY(ctx, theMarkY);
         iupPlotDrawMark(ctx, absMarkX, absMarkY, dataset->mMarkStyle, dataset->mMarkSize, dataset->mColor);
       }
-      if (dataset->mMode != IUP_PLOT_MARK)
+      if (dataset->mMode != IUP_PLOT_MARK && dataset->mMode != IUP_PLOT_DENSITY)
       {
         int absLX1 = iupPlotDrawCalcX(ctx, theLegendX);
         int absLX2 = iupPlotDrawCalcX(ctx, theLegendX + theLineSpace - 3);
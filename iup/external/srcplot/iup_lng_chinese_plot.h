@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_chinese_plot(void)
     "IUP_DATASETPROPERTIESDLG", "数据集属性...",
     "IUP_DATASETVALUESDLG", "数据集值...",
     "IUP_DECIMALS", "小数位数:",
+    "IUP_DENSITY", "密度",
     "IUP_DIAMOND", "菱形",
     "IUP_DOTTED", "点线",
     "IUP_END", "结束",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_czech_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Vlastnosti datové sady...",
     "IUP_DATASETVALUESDLG", "Hodnoty datové sady...",
     "IUP_DECIMALS", "Desetiny:",
+    "IUP_DENSITY", "Hustota",
     "IUP_DIAMOND", "Diamant",
     "IUP_DOTTED", "Tečkovaná",
     "IUP_END", "Konec",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_english_plot (void)
     "IUP_DATASETPROPERTIESDLG", "Data Set Properties...",
     "IUP_DATASETVALUESDLG", "Data Set Values...",
     "IUP_DECIMALS", "Decimals:",
+    "IUP_DENSITY", "Density",
     "IUP_DIAMOND", "Diamond",
     "IUP_DOTTED", "Dotted",
     "IUP_END", "End",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_french_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Propriétés du jeu de données...",
     "IUP_DATASETVALUESDLG", "Valeurs du jeu de données...",
     "IUP_DECIMALS", "Décimales :",
+    "IUP_DENSITY", "Densité",
     "IUP_DIAMOND", "Losange",
     "IUP_DOTTED", "Pointillé",
     "IUP_END", "Fin",
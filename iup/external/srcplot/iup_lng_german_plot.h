@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_german_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Datensatz-Eigenschaften...",
     "IUP_DATASETVALUESDLG", "Datensatz-Werte...",
     "IUP_DECIMALS", "Dezimalstellen:",
+    "IUP_DENSITY", "Dichte",
     "IUP_DIAMOND", "Raute",
     "IUP_DOTTED", "Gepunktet",
     "IUP_END", "Ende",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_italian_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Proprietà del set di dati...",
     "IUP_DATASETVALUESDLG", "Valori del set di dati...",
     "IUP_DECIMALS", "Decimali:",
+    "IUP_DENSITY", "Densità",
     "IUP_DIAMOND", "Rombo",
     "IUP_DOTTED", "Punteggiato",
     "IUP_END", "Fine",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_japanese_plot(void)
     "IUP_DATASETPROPERTIESDLG", "データセットのプロパティ...",
     "IUP_DATASETVALUESDLG", "データセットの値...",
     "IUP_DECIMALS", "小数桁数:",
+    "IUP_DENSITY", "密度",
     "IUP_DIAMOND", "ひし形",
     "IUP_DOTTED", "点線",
     "IUP_END", "終了",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_portuguese_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Properties dos Dados...",
     "IUP_DATASETVALUESDLG", "Valores dos Dados...",
     "IUP_DECIMALS", "Decimais:",
+    "IUP_DENSITY", "Densidade",
     "IUP_DIAMOND", "Diamante",
     "IUP_DOTTED", "Pontilhado",
     "IUP_END", "Fim",
@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_russian_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Свойства набора данных...",
     "IUP_DATASETVALUESDLG", "Значения набора данных...",
     "IUP_DECIMALS", "Десятичные:",
+    "IUP_DENSITY", "Плотность",
     "IUP_DIAMOND", "Ромб",
     "IUP_DOTTED", "Точечный",
     "IUP_END", "Конец",
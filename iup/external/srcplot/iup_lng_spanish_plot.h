@@ -34,6 +34,7 @@ static Ihandle* iup_load_lng_spanish_plot(void)
     "IUP_DATASETPROPERTIESDLG", "Propiedades de los Datos...",
     "IUP_DATASETVALUESDLG", "Valores de los Datos...",
     "IUP_DECIMALS", "Decimales:",
+    "IUP_DENSITY", "Densidad",
     "IUP_DIAMOND", "Diamante",
     "IUP_DOTTED", "Punteada",
     "IUP_END", "Fin",
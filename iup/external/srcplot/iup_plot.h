@@ -10,11 +10,11 @@
 
 #include <cstdlib>
 #include <cmath>
+#include <cstring>
 
 #include "iup.h"
 #include "iupcbs.h"
 
-#include "iup_array.h"
 #include "iup_str.h"
 
 #include "iupdraw.h"
@@ -33,12 +33,13 @@ inline void iPlotCheckMinMax(double &inoutMin, double &inoutMax)
   }
 }
 
-enum iupPlotMode { IUP_PLOT_LINE, IUP_PLOT_MARK, IUP_PLOT_MARKLINE, IUP_PLOT_AREA, IUP_PLOT_BAR, IUP_PLOT_STEM, IUP_PLOT_MARKSTEM, IUP_PLOT_HORIZONTALBAR, IUP_PLOT_MULTIBAR, IUP_PLOT_STEP, IUP_PLOT_ERRORBAR, IUP_PLOT_PIE };
+enum iupPlotMode { IUP_PLOT_LINE, IUP_PLOT_MARK, IUP_PLOT_MARKLINE, IUP_PLOT_AREA, IUP_PLOT_BAR, IUP_PLOT_STEM, IUP_PLOT_MARKSTEM, IUP_PLOT_HORIZONTALBAR, IUP_PLOT_MULTIBAR, IUP_PLOT_STEP, IUP_PLOT_ERRORBAR, IUP_PLOT_PIE, IUP_PLOT_DENSITY };
 enum iupPlotLegendPosition { IUP_PLOT_TOPRIGHT, IUP_PLOT_TOPLEFT, IUP_PLOT_BOTTOMRIGHT, IUP_PLOT_BOTTOMLEFT, IUP_PLOT_BOTTOMCENTER, IUP_PLOT_XY };
 enum iupPlotSliceLabel { IUP_PLOT_NONE, IUP_PLOT_X, IUP_PLOT_Y, IUP_PLOT_PERCENT };
 enum iupPlotHighlight { IUP_PLOT_HIGHLIGHT_NONE, IUP_PLOT_HIGHLIGHT_SAMPLE, IUP_PLOT_HIGHLIGHT_CURVE, IUP_PLOT_HIGHLIGHT_BOTH };
 enum iupPlotClipping { IUP_PLOT_CLIPNONE, IUP_PLOT_CLIPAREA, IUP_PLOT_CLIPAREAOFFSET };
 enum iupPlotAxisPosition { IUP_PLOT_START, IUP_PLOT_CROSSORIGIN, IUP_PLOT_END };
+enum iupPlotDecimation { IUP_PLOT_DECIMATION_NONE, IUP_PLOT_DECIMATION_MINMAX, IUP_PLOT_DECIMATION_LTTB };
 
 enum iupPlotLineStyle {
   IUP_PLOT_LINE_CONTINUOUS,
@@ -175,6 +176,12 @@ inline void iupPlotDrawPolygon(Ihandle* ih, int* points, int count, long color,
   IupDrawPolygon(ih, points, count);
 }
 
+inline void iupPlotDrawPolyline(Ihandle* ih, int* points, int count, long color, int style, int line_width)
+{
+  iupPlotSetDrawState(ih, color, style, line_width);
+  IupDrawPolyline(ih, points, count);
+}
+
 inline void iupPlotDrawText(Ihandle* ih, const char* text, int len, int x, int y, int w, int h, long color, const char* font, int flags, double orientation)
 {
   iupDrawSetColor(ih, "DRAWCOLOR", color);
@@ -243,6 +250,9 @@ public:
   }
 
   void AddVertex(int x, int y) {
+    // consecutive samples often fall in the same pixel
+    if (mCount > 0 && mPoints[(mCount - 1) * 2] == x && mPoints[(mCount - 1) * 2 + 1] == y)
+      return;
     if (mCount * 2 + 1 >= mCapacity * 2) {
       mCapacity = mCapacity * 2 + 64;
       mPoints = (int*)realloc(mPoints, mCapacity * 2 * sizeof(int));
@@ -254,9 +264,7 @@ public:
 
   void DrawStroke(iupPlotDrawContext* ctx, long color, int lineStyle, int lineWidth) {
     if (mCount < 2) return;
-    int drawStyle = iupPlotLineStyleToDrawStyle(lineStyle);
-    for (int i = 0; i < mCount - 1; i++)
-      iupPlotDrawLine(ctx->ih, mPoints[i*2], mPoints[i*2+1], mPoints[(i+1)*2], mPoints[(i+1)*2+1], color, drawStyle, lineWidth);
+    iupPlotDrawPolyline(ctx->ih, mPoints, mCount, color, iupPlotLineStyleToDrawStyle(lineStyle), lineWidth);
   }
 
   void DrawFill(iupPlotDrawContext* ctx, long color) {
@@ -314,6 +322,11 @@ public:
   virtual double Transform(double inValue) const = 0;
   virtual double TransformBack(double inValue) const = 0;
   virtual bool Calculate(int inBegin, int inEnd, const iupPlotAxis& inAxis) = 0;
+
+  // Transforms an array of values, inValues and outValues can be the same
+  virtual void TransformArray(const double* inValues, double* outValues, int inCount) const {
+    for (int i = 0; i < inCount; i++) outValues[i] = Transform(inValues[i]);
+  }
 };
 
 class iupPlotTrafoLinear : public iupPlotTrafo
@@ -322,6 +335,7 @@ public:
   iupPlotTrafoLinear() :mOffset(0), mSlope(0) {}
   double Transform(double inValue) const override;
   double TransformBack(double inValue) const override;
+  void TransformArray(const double* inValues, double* outValues, int inCount) const override;
 
   bool Calculate(int inBegin, int inEnd, const iupPlotAxis& inAxis) override;
 
@@ -335,6 +349,7 @@ public:
   iupPlotTrafoLog() :mOffset(0), mSlope(0), mBase(10) {}
   double Transform(double inValue) const override;
   double TransformBack(double inValue) const override;
+  void TransformArray(const double* inValues, double* outValues, int inCount) const override;
 
   bool Calculate(int inBegin, int inEnd, const iupPlotAxis& inAxis) override;
 
@@ -343,98 +358,240 @@ public:
   double mBase;
 };
 
+// Samples are stored in contiguous arrays, one for each column of the dataset.
+// Memory grows geometrically, so adding N samples one by one is O(N).
+// The buffer can also be adopted or mapped from the application without copying,
+// a mapped buffer is copied only when samples are added, inserted or removed.
+// An owned buffer can be shared by several datasets, it is copied before it is changed.
+// When a maximum count is set the array is used as a circular buffer,
+// appending a sample at the end drops the first one without moving the others.
 class iupPlotData
 {
 public:
-  iupPlotData(int inSize) : mCount(0), mIsString(false) { mArray = iupArrayCreate(20, inSize); }
-  virtual ~iupPlotData() { iupArrayDestroy(mArray); }
+  iupPlotData(int inSize) : mCount(0), mIsString(false), mBuffer(NULL), mCapacity(0), mElemSize(inSize), mOwnBuffer(true), mShareCount(NULL), mStart(0), mMaxCount(0) {}
+  virtual ~iupPlotData() { ReleaseBuffer(); }
 
   bool IsString() const { return mIsString; }
   int GetCount() const { return mCount; }
 
   virtual bool CalculateRange(double &outMin, double &outMax) const = 0;
   virtual double GetSample(int inSampleIndex) const = 0;
+  virtual bool IsAscending() const { return false; }
+  virtual void GetSamples(int inSampleIndex, int inCount, double* outValues) const {
+    for (int i = 0; i < inCount; i++) outValues[i] = GetSample(inSampleIndex + i);
+  }
+
+  void RemoveSample(int inSampleIndex);
 
-  void RemoveSample(int inSampleIndex) {
-    if (inSampleIndex < 0) inSampleIndex = 0; if (inSampleIndex > mCount) inSampleIndex = mCount;
-    iupArrayRemove(mArray, inSampleIndex, 1); mCount--;
+  // Inserts samples initialized with zeros
+  virtual void InsertZeros(int inSampleIndex, int inCount);
+
+  // Replaces all samples with zeros
+  void ResetZeros(int inCount) {
+    while (mCount > 0) RemoveFirst();
+    InsertZeros(0, inCount);
   }
 
+  // 0 means no limit
+  void SetMaxCount(int inMaxCount) { mMaxCount = inMaxCount > 0 ? inMaxCount : 0; Trim(); }
+  int GetMaxCount() const { return mMaxCount; }
+
 protected:
   int mCount;
-  Iarray* mArray;
   bool mIsString;
+  void* mBuffer;
+  int mCapacity;
+  int mElemSize;
+  bool mOwnBuffer;
+  int* mShareCount;  // number of datasets using a shared buffer, the last one frees it
+  int mStart;     // position of the first sample in the circular buffer
+  int mMaxCount;
+
+  // position of the sample in the buffer
+  int Index(int inSampleIndex) const {
+    int theIndex = mStart + inSampleIndex;
+    return theIndex >= mCapacity ? theIndex - mCapacity : theIndex;
+  }
+
+  // called before a sample is removed from the array
+  virtual void ReleaseSample(int inSampleIndex) { (void)inSampleIndex; }
+
+  bool Reserve(int inCount);
+  bool Relocate(int inCapacity);
+  void* InsertRoom(int inSampleIndex, int inCount);
+  void RemoveFirst();
+  void Trim() { while (mMaxCount > 0 && mCount > mMaxCount) RemoveFirst(); }
+  bool IsStreamAppend(int inSampleIndex) const { return mMaxCount > 0 && inSampleIndex >= mCount; }
+
+  void ReleaseBuffer();
+  bool ShareBuffer(iupPlotData* inData);
+  void SetBuffer(void* inBuffer, int inCount, bool inOwnBuffer) {
+    ReleaseBuffer();
+    mBuffer = inBuffer;
+    mCount = inCount;
+    mCapacity = inCount;
+    mStart = 0;
+    mOwnBuffer = inOwnBuffer;
+  }
 };
 
 class iupPlotDataReal : public iupPlotData
 {
 public:
-  iupPlotDataReal() :iupPlotData(sizeof(double)) { mData = (double*)iupArrayGetData(mArray); }
-
-  double GetSample(int inSampleIndex) const override { return mData[inSampleIndex]; }
-  void SetSample(int inSampleIndex, double inReal) const { mData[inSampleIndex] = inReal; }
+  iupPlotDataReal() :iupPlotData(sizeof(double)), mRangeValid(false), mRangeMin(0), mRangeMax(0), mAscending(true) {}
+
+  double GetSample(int inSampleIndex) const override { return Sample(inSampleIndex); }
+  void GetSamples(int inSampleIndex, int inCount, double* outValues) const override;
+  bool IsAscending() const override {
+    double theMin, theMax;
+    if (!mAscending && !mRangeValid) CalculateRange(theMin, theMax);  // also checks the order
+    return mAscending;
+  }
+  void SetSample(int inSampleIndex, double inReal) {
+    if (mShareCount && !Relocate(mCapacity)) return;
+    double* theData = (double*)mBuffer + Index(inSampleIndex);
+    if (mRangeValid && ((*theData == mRangeMin && inReal > mRangeMin) || (*theData == mRangeMax && inReal < mRangeMax)))
+      mRangeValid = false;
+    if (mAscending && ((inSampleIndex > 0 && inReal < Sample(inSampleIndex - 1)) || (inSampleIndex < mCount - 1 && inReal > Sample(inSampleIndex + 1))))
+      mAscending = false;
+    *theData = inReal;
+    UpdateRange(inReal);
+  }
 
-  void AddSample(double inReal) { mData = (double*)iupArrayInc(mArray); mData[mCount] = inReal; mCount++; }
-  void InsertSample(int inSampleIndex, double inReal) {
-    if (inSampleIndex < 0) inSampleIndex = 0; if (inSampleIndex > mCount) inSampleIndex = mCount;
-    mData = (double*)iupArrayInsert(mArray, inSampleIndex, 1); mData[inSampleIndex] = inReal; mCount++;
+  void AddSample(double inReal) { InsertSample(mCount, inReal); }
+  void InsertSample(int inSampleIndex, double inReal) { InsertSamples(inSampleIndex, &inReal, 1); }
+  void InsertSamples(int inSampleIndex, const double* inReal, int inCount);
+  void InsertZeros(int inSampleIndex, int inCount) override {
+    if (inCount <= 0) return;
+    bool theEmpty = (mCount == 0);
+    if (theEmpty)
+      mAscending = true;
+    else if (mAscending && (inSampleIndex < mCount || Sample(mCount - 1) > 0))
+      mAscending = false;
+    iupPlotData::InsertZeros(inSampleIndex, inCount);
+    if (theEmpty) { mRangeValid = true; mRangeMin = mRangeMax = 0; }
+    UpdateRange(0);
   }
 
+  // if inOwnBuffer is false the array is used directly and must remain valid
+  void SetSamplesBuffer(double* inReal, int inCount, bool inOwnBuffer) { SetBuffer(inReal, inCount, inOwnBuffer); mRangeValid = false; mAscending = false; Trim(); }
+  bool ShareSamplesBuffer(iupPlotDataReal* inData) { if (!ShareBuffer(inData)) return false; mRangeValid = false; mAscending = false; Trim(); return true; }
+
   bool CalculateRange(double &outMin, double &outMax) const override;
 
 protected:
-  double* mData;
+  mutable bool mRangeValid;
+  mutable double mRangeMin, mRangeMax;
+  mutable bool mAscending;  // samples known to be in ascending order, the range is given by the first and last samples
+
+  double Sample(int inSampleIndex) const { return ((double*)mBuffer)[Index(inSampleIndex)]; }
+
+  void UpdateRange(double inReal) {
+    if (!mRangeValid) return;
+    if (inReal < mRangeMin) mRangeMin = inReal;
+    if (inReal > mRangeMax) mRangeMax = inReal;
+  }
+
+  void ReleaseSample(int inSampleIndex) override {
+    double theReal = Sample(inSampleIndex);
+    if (theReal == mRangeMin || theReal == mRangeMax)
+      mRangeValid = false;  // computed again only when needed
+  }
 };
 
 class iupPlotDataString : public iupPlotData
 {
 public:
-  iupPlotDataString() :iupPlotData(sizeof(char*)) { mIsString = true; mData = (char**)iupArrayGetData(mArray); }
+  iupPlotDataString() :iupPlotData(sizeof(char*)) { mIsString = true; }
   ~iupPlotDataString() override;
 
   double GetSample(int inSampleIndex) const override { return inSampleIndex; }
+  bool IsAscending() const override { return true; }
 
-  const char* GetSampleString(int inSampleIndex) const { return mData[inSampleIndex]; }
+  const char* GetSampleString(int inSampleIndex) const { return ((char**)mBuffer)[Index(inSampleIndex)]; }
   void SetSampleString(int inSampleIndex, const char *inString) const {
-    if (inString == mData[inSampleIndex]) return;
-    free(mData[inSampleIndex]);
-    mData[inSampleIndex] = iupStrDup(inString);
+    char** theData = (char**)mBuffer + Index(inSampleIndex);
+    if (inString == *theData) return;
+    free(*theData);
+    *theData = iupStrDup(inString);
   }
 
-  void AddSample(const char *inString) { mData = (char**)iupArrayInc(mArray); mData[mCount] = iupStrDup(inString); mCount++; }
+  void AddSample(const char *inString) { InsertSample(mCount, inString); }
   void InsertSample(int inSampleIndex, const char *inString) {
-    if (inSampleIndex < 0) inSampleIndex = 0; if (inSampleIndex > mCount) inSampleIndex = mCount;
-    mData = (char**)iupArrayInsert(mArray, inSampleIndex, 1); mData[inSampleIndex] = iupStrDup(inString); mCount++;
+    char** theData = (char**)InsertRoom(inSampleIndex, 1);
+    if (theData) *theData = iupStrDup(inString);
+    Trim();
   }
 
   bool CalculateRange(double &outMin, double &outMax) const override;
 
 protected:
-  char** mData;
+  void ReleaseSample(int inSampleIndex) override { free(((char**)mBuffer)[Index(inSampleIndex)]); }
 };
 
 class iupPlotDataBool : public iupPlotData
 {
 public:
-  iupPlotDataBool() :iupPlotData(sizeof(bool)) { mData = (bool*)iupArrayGetData(mArray); }
+  iupPlotDataBool() :iupPlotData(sizeof(bool)) {}
 
-  double GetSample(int inSampleIndex) const override { return (int)mData[inSampleIndex]; }
+  double GetSample(int inSampleIndex) const override { return (int)((bool*)mBuffer)[Index(inSampleIndex)]; }
 
-  bool GetSampleBool(int inSampleIndex) const { return mData[inSampleIndex]; }
-  void SetSampleBool(int inSampleIndex, bool inBool) { mData[inSampleIndex] = inBool; }
+  bool GetSampleBool(int inSampleIndex) const { return ((bool*)mBuffer)[Index(inSampleIndex)]; }
+  void SetSampleBool(int inSampleIndex, bool inBool) { ((bool*)mBuffer)[Index(inSampleIndex)] = inBool; }
 
-  void AddSample(bool inBool) { mData = (bool*)iupArrayInc(mArray); mData[mCount] = inBool; mCount++; }
+  void AddSample(bool inBool) { InsertSample(mCount, inBool); }
   void InsertSample(int inSampleIndex, bool inBool) {
-    if (inSampleIndex < 0) inSampleIndex = 0; if (inSampleIndex > mCount) inSampleIndex = mCount;
-    mData = (bool*)iupArrayInsert(mArray, inSampleIndex, 1); mData[inSampleIndex] = inBool; mCount++;
+    bool* theData = (bool*)InsertRoom(inSampleIndex, 1);
+    if (theData) *theData = inBool;
+    Trim();
   }
 
   bool CalculateRange(double &outMin, double &outMax) const override;
+};
+
+#define IUP_PLOT_THREAD_MAX 8
+
+typedef void (*iupPlotJobFunc)(void* inJob);
+
+// Number of threads for inWork units, each thread must have at least inMinWork units.
+int iupPlotGetThreadCount(int inWork, int inMinWork);
+// Runs each job in a thread, the calling thread takes the first job. inJobCount <= IUP_PLOT_THREAD_MAX.
+void iupPlotRunJobs(iupPlotJobFunc inFunc, void* inJobs, int inJobSize, int inJobCount);
+
+// Screen coordinates of consecutive samples, transformed in blocks with TransformArray.
+// Large blocks are split across threads.
+class iupPlotScreenBlock
+{
+public:
+  iupPlotScreenBlock(const iupPlotData* inDataX, const iupPlotData* inDataY, const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY)
+    : mDataX(inDataX), mDataY(inDataY), mTrafoX(inTrafoX), mTrafoY(inTrafoY), mX(NULL), mY(NULL), mBegin(0), mEnd(0), mFailed(false) {}
+  ~iupPlotScreenBlock() { if (mX) free(mX); }
+
+  // inSampleIndex must be a valid sample, faster when samples are accessed in ascending order.
+  // When the block can not be allocated each sample is transformed when accessed.
+  double X(int inSampleIndex) { if ((inSampleIndex < mBegin || inSampleIndex >= mEnd) && !Load(inSampleIndex)) return mTrafoX->Transform(mDataX->GetSample(inSampleIndex)); return mX[inSampleIndex - mBegin]; }
+  double Y(int inSampleIndex) { if ((inSampleIndex < mBegin || inSampleIndex >= mEnd) && !Load(inSampleIndex)) return mTrafoY->Transform(mDataY->GetSample(inSampleIndex)); return mY[inSampleIndex - mBegin]; }
 
 protected:
-  bool* mData;
+  const iupPlotData* mDataX;
+  const iupPlotData* mDataY;
+  const iupPlotTrafo* mTrafoX;
+  const iupPlotTrafo* mTrafoY;
+  double* mX;
+  double* mY;
+  int mBegin, mEnd;
+  bool mFailed;
+
+  bool Load(int inSampleIndex);
 };
 
+inline int iupPlotGridPos(double inPos, int inSize)
+{
+  if (inPos < 0) return 0;
+  if (inPos >= inSize) return inSize - 1;
+  return (int)inPos;
+}
+
 struct iupPlotSampleNotify
 {
   Ihandle* ih;
@@ -450,6 +607,7 @@ public:
 
   void SetName(const char* inName) { if (inName == mName) return; if (mName) free(mName); mName = iupStrDup(inName); }
   const char* GetName() { return mName; }
+  int GetDataVersion() const { return mDataVersion; }
 
   bool FindSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY, double inScreenTolerance, int &outSampleIndex, double &outX, double &outY) const;
   bool FindPointSample(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY, double inScreenTolerance, int &outSampleIndex, double &outX, double &outY) const;
@@ -461,6 +619,7 @@ public:
 
   void DrawData(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
   void DrawDataPie(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, const iupPlotAxis& inAxisY, long inBackColor) const;
+  void DrawHighlight(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
 
   int GetCount();
   void AddSample(double inX, double inY);
@@ -469,6 +628,13 @@ public:
   void InsertSampleSegment(int inSampleIndex, double inX, double inY, bool inSegment);
   void AddSample(const char* inX, double inY);
   void InsertSample(int inSampleIndex, const char* inX, double inY);
+  void AddSamples(const double* inX, const double* inY, int inCount);
+  void InsertSamples(int inSampleIndex, const double* inX, const double* inY, int inCount);
+  bool SetSamplesBuffer(double* inX, double* inY, int inCount, bool inOwnBuffer);
+  // uses the same X samples of inDataSet without copying them
+  bool SetSamplesBuffer(iupPlotDataSet* inDataSet, double* inY, bool inOwnBuffer);
+  void SetMaxCount(int inMaxCount);
+  int GetMaxCount() const { return mDataX->GetMaxCount(); }
   void RemoveSample(int inSampleIndex);
   void GetSample(int inSampleIndex, double *inX, double *inY);
   void GetSample(int inSampleIndex, const char* *inX, double *inY);
@@ -511,6 +677,8 @@ public:
   void* mUserData;
   bool mOrderedX;
   bool mSelectedCurve;
+  iupPlotDecimation mDecimation;
+  int mDensityColors;  // number of colors of the table used by the DENSITY mode, 0 uses mColor
 
   // Aux
   int mHighlightedSample;
@@ -525,12 +693,46 @@ protected:
   iupPlotDataReal* mExtra;
   iupPlotDataBool* mSegment;
   bool mHasSelected;
+  int mDataVersion;  // changed every time the samples are changed
+
+  // Decimation cache, indices of the samples that are drawn, count is -1 if X is not ordered
+  mutable int* mDecimatedIndex;
+  mutable int mDecimatedCount;
+  mutable int mDecimatedCapacity;
+  mutable bool mDecimatedValid;
+  mutable double mDecimatedKey[10];
+
+  // Spatial index for FindSample, sample indices sorted by the cells of a uniform grid in data space
+  mutable int* mGridIndex;
+  mutable int* mGridCellStart;  // position of the first index of each cell in mGridIndex, one more for the end
+  mutable int mGridCols, mGridRows;
+  mutable double mGridMinX, mGridMinY, mGridCellW, mGridCellH;
+  mutable int mGridVersion;  // mDataVersion when the grid was built
+
+  // Image of the DENSITY mode, reused by every frame
+  mutable Ihandle* mDensityImage;
 
   void InitSegment();
   void InitExtra();
 
+  bool IsOrderedX() const { return mOrderedX || mDataX->IsAscending(); }
+  int FindFirstX(double inX) const;
+  bool BuildGrid() const;
+  int GridCol(double inX) const { return iupPlotGridPos((inX - mGridMinX) / mGridCellW, mGridCols); }
+  int GridRow(double inY) const { return iupPlotGridPos((inY - mGridMinY) / mGridCellH, mGridRows); }
+  bool FindPointSampleGrid(iupPlotTrafo *inTrafoX, iupPlotTrafo *inTrafoY, double inScreenX, double inScreenY, double inScreenTolerance,
+                           double inMinX, double inMaxX, double inMinY, double inMaxY, int &outSampleIndex, double &outX, double &outY) const;
+
+  const int* GetDecimatedIndex(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, const iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, int &outCount) const;
+  void DecimateMinMax(const iupPlotTrafo *inTrafoX, const iupPlotDrawContext* ctx) const;
+  void DecimateLTTB(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, const iupPlotDrawContext* ctx) const;
+  void AddDecimatedIndex(int inSampleIndex) const;
+  void AddDecimatedColumn(int inFirst, int inMin, int inMax, int inLast) const;
+  void DecimateLTTBRange(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, int inBegin, int inEnd, int inThreshold) const;
+
   void DrawDataLine(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, bool inShowMark, bool inErrorBar) const;
   void DrawDataMark(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
+  void DrawDataDensity(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
   void DrawDataStem(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify, bool inShowMark) const;
   void DrawDataArea(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
   void DrawDataBar(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
@@ -538,6 +740,7 @@ protected:
   void DrawDataMultiBar(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
   void DrawSelection(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
   void DrawDataStep(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
+  void DrawHighlightPie(const iupPlotTrafo *inTrafoX, const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, const iupPlotSampleNotify* inNotify) const;
 
   void DrawErrorBar(const iupPlotTrafo *inTrafoY, iupPlotDrawContext* ctx, int index, double theY, double theScreenX) const;
   void SetSampleExtraMarkSize(const iupPlotTrafo *inTrafoY, int inSampleIndex, int *outMarkSize) const;
@@ -938,6 +1141,15 @@ protected:
   Ihandle* ih;
   iupPlotRect mViewportBack;
 
+  struct _IdrawList* mBackLayer;   // background, grid, axis and datasets
+  struct _IdrawList* mFrontLayer;  // legend and title
+  unsigned int mLayerKey;
+  bool mLayerValid;
+
+  unsigned int GetLayerKey() const;
+  bool DrawDataLayer(const iupPlotRect &inDataSetArea, iupPlotDrawContext* ctx);
+  bool DrawFrontLayer(const iupPlotRect &inDataSetArea, iupPlotDrawContext* ctx);
+
   void DataSetClipArea(iupPlotDrawContext* ctx, int xmin, int xmax, int ymin, int ymax) const;
   void ConfigureAxis();
   void SetFont(Ihandle* ih, int inFontStyle, int inFontSize) const;
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "iup_plot.h"
 
@@ -1015,7 +1016,7 @@ static int iPlotDataSetProperties_CB(Ihandle* ih_item)
   iupStrCopyN(color, sizeof(color), ds_color);
 
   const char* ds_mode = IupGetAttribute(ih, "DS_MODE");
-  const char* mode_list[] = { "LINE", "MARK", "MARKLINE", "AREA", "BAR", "STEM", "MARKSTEM", "HORIZONTALBAR", "MULTIBAR", "STEP", "ERRORBAR", "PIE", NULL };
+  const char* mode_list[] = { "LINE", "MARK", "MARKLINE", "AREA", "BAR", "STEM", "MARKSTEM", "HORIZONTALBAR", "MULTIBAR", "STEP", "ERRORBAR", "PIE", "DENSITY", NULL };
   int mode = iPlotGetListIndex(mode_list, ds_mode);
 
   const char* ds_linestyle = IupGetAttribute(ih, "DS_LINESTYLE");
@@ -1051,7 +1052,7 @@ static int iPlotDataSetProperties_CB(Ihandle* ih_item)
   char format[1024] =
     "_@IUP_NAME%s\n"
     "_@IUP_COLOR%c\n"
-    "_@IUP_MODE%l|_@IUP_LINES|_@IUP_MARKS|_@IUP_MARKSLINES|_@IUP_AREA|_@IUP_BARS|_@IUP_STEMS|_@IUP_MARKSSTEMS|_@IUP_HORIZONTALBARS|_@IUP_MULTIBARS|_@IUP_STEPS|_@IUP_ERRORBARS|_@IUP_PIE|\n"
+    "_@IUP_MODE%l|_@IUP_LINES|_@IUP_MARKS|_@IUP_MARKSLINES|_@IUP_AREA|_@IUP_BARS|_@IUP_STEMS|_@IUP_MARKSSTEMS|_@IUP_HORIZONTALBARS|_@IUP_MULTIBARS|_@IUP_STEPS|_@IUP_ERRORBARS|_@IUP_PIE|_@IUP_DENSITY|\n"
     "_@IUP_LINESTYLE%l|_@IUP_CONTINUOUS|_@IUP_DASHED|_@IUP_DOTTED|_@IUP_DASH_DOT|_@IUP_DASH_DOT_DOT|\n"
     "_@IUP_LINEWIDTH%i[1,,]\n"
     "_@IUP_MARKSTYLE%l|_@IUP_PLUS|_@IUP_STAR|_@IUP_CIRCLE|_@IUP_X|_@IUP_BOX|_@IUP_DIAMOND|_@IUP_HOLLOW_CIRCLE|_@IUP_HOLLOW_BOX|_@IUP_HOLLOW_DIAMOND|\n"
@@ -1730,7 +1731,7 @@ static int iPlotMotion_CB(Ihandle* ih, int x, int y, char *status)
   {
     if (iup_iscontrol(status) || iup_isshift(status))
     {
-      ih->data->current_plot->mRedraw = true;
+      // the selection band is drawn over the cached layers
       ih->data->current_plot->mShowSelectionBand = true;
       ih->data->current_plot->mSelectionBand.mX = ih->data->last_click_x < x ? ih->data->last_click_x : x;
       ih->data->current_plot->mSelectionBand.mY = ih->data->last_click_y < y ? ih->data->last_click_y : y;
@@ -1895,11 +1896,9 @@ static int iPlotMotion_CB(Ihandle* ih, int x, int y, char *status)
     }
   }
 
+  // the crosshair and the highlight are drawn over the cached layers
   if (redraw)
-  {
-    ih->data->current_plot->mRedraw = true;
     iPlotRedrawInteract(ih);
-  }
 
   return IUP_DEFAULT;
 }
@@ -1949,16 +1948,8 @@ static int iPlotKeyPress_CB(Ihandle* ih, int c, int press)
 
     for (int p = 0; p < ih->data->plot_list_count; p++)
     {
-      if (ih->data->plot_list[p]->mCrossHairH)
-      {
-        ih->data->plot_list[p]->mRedraw = true;
-        ih->data->plot_list[p]->mCrossHairH = false;
-      }
-      if (ih->data->plot_list[p]->mCrossHairV)
-      {
-        ih->data->plot_list[p]->mRedraw = true;
-        ih->data->plot_list[p]->mCrossHairV = false;
-      }
+      ih->data->plot_list[p]->mCrossHairH = false;
+      ih->data->plot_list[p]->mCrossHairV = false;
     }
 
     if (ih->data->show_cross_hair != IUP_PLOT_CROSSHAIR_NONE)  // was shown, leave it there as reference
@@ -2175,8 +2166,39 @@ IUPPLOT_API void IupPlotAddSamples(Ihandle* ih, int inIndex, double *x, double *
     return;
 
   iupPlotDataSet* theDataSet = ih->data->current_plot->mDataSetList[inIndex];
-  for (int i = 0; i < count; i++)
-    theDataSet->AddSample(x[i], y[i]);
+  theDataSet->AddSamples(x, y, count);
+}
+
+static int iPlotSetSamplesBufferFail(double *x, double *y, int own_buffer)
+{
+  // the plot owns the arrays from the moment it is called
+  if (own_buffer)
+  {
+    free(x);
+    free(y);
+  }
+  return 0;
+}
+
+IUPPLOT_API int IupPlotSetSamplesBuffer(Ihandle* ih, int inIndex, double *x, double *y, int count, int own_buffer)
+{
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return iPlotSetSamplesBufferFail(x, y, own_buffer);
+
+  if (ih->iclass->nativetype != IUP_TYPECANVAS ||
+      !IupClassMatch(ih, "plot"))
+    return iPlotSetSamplesBufferFail(x, y, own_buffer);
+
+  if (inIndex < 0 || inIndex >= ih->data->current_plot->mDataSetListCount)
+    return iPlotSetSamplesBufferFail(x, y, own_buffer);
+
+  iupPlotDataSet* theDataSet = ih->data->current_plot->mDataSetList[inIndex];
+  if (!theDataSet->SetSamplesBuffer(x, y, count, own_buffer ? true : false))
+    return 0;
+
+  ih->data->current_plot->mRedraw = true;
+  return 1;
 }
 
 IUPPLOT_API void IupPlotAddStrSamples(Ihandle* ih, int inIndex, const char** x, double* y, int count)
@@ -2230,9 +2252,7 @@ IUPPLOT_API void IupPlotInsertSamples(Ihandle* ih, int inIndex, int inSampleInde
     return;
 
   iupPlotDataSet* theDataSet = ih->data->current_plot->mDataSetList[inIndex];
-
-  for (int i = 0; i < count; i++)
-    theDataSet->InsertSample(inSampleIndex + i, inX[i], inY[i]);
+  theDataSet->InsertSamples(inSampleIndex, inX, inY, count);
 }
 
 IUPPLOT_API void IupPlotGetSample(Ihandle* ih, int inIndex, int inSampleIndex, double *x, double *y)
@@ -2453,33 +2473,138 @@ static int iPlotCountDataSets(const char* line_buffer)
   return ds_count;
 }
 
-static int iPlotAddToDataSets(Ihandle* ih, const char* line_buffer, int ds_start, int ds_count)
+static const double iPlotPow10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+static int iPlotIsValueEnd(char ch)
 {
-  double x = 0;
-  double value;
+  return ch == ' ' || ch == '\t' || ch == ';' || ch == '\r' || ch == '\n' || ch == 0;
+}
 
-  for (int ds = 0; ds < ds_count; ds++)
-  {
-    int ret = sscanf(line_buffer, "%lf", &value);
-    if (!ret)
-      return 0;
+// Returns the position after the number or NULL if there is no number.
+// When the mantissa has at most 53 bits and the exponent is at most 22,
+// both are exact doubles and a single multiplication or division gives the correctly rounded result,
+// other numbers are converted by strtod.
+static const char* iPlotParseDouble(const char* str, double *value)
+{
+  const char* start = str;
+  unsigned long long mant = 0;
+  int digits = 0, exp10 = 0, found = 0, exact = 1;
+  bool negative = false;
 
-    line_buffer = iPlotSkipValue(line_buffer);
+  if (*str == '-' || *str == '+')
+  {
+    negative = (*str == '-');
+    str++;
+  }
 
-    if (ds == 0)
-      x = value;
+  while (*str >= '0' && *str <= '9')
+  {
+    if (digits < 19)
+    {
+      mant = mant * 10 + (*str - '0');
+      if (mant) digits++;
+    }
     else
+      exact = 0;
+    str++;
+    found = 1;
+  }
+
+  if (*str == '.')
+  {
+    str++;
+    while (*str >= '0' && *str <= '9')
     {
-      double y = value;
+      if (digits < 19)
+      {
+        mant = mant * 10 + (*str - '0');
+        if (mant) digits++;
+        exp10--;
+      }
+      else
+        exact = 0;
+      str++;
+      found = 1;
+    }
+  }
 
-      iupPlotDataSet* theDataSet = ih->data->current_plot->mDataSetList[ds_start + ds - 1];
-      theDataSet->AddSample(x, y);
+  if (found && (*str == 'e' || *str == 'E'))
+  {
+    const char* exp_str = str + 1;
+    bool exp_negative = false;
+    int exp_value = 0;
+
+    if (*exp_str == '-' || *exp_str == '+')
+    {
+      exp_negative = (*exp_str == '-');
+      exp_str++;
+    }
+
+    if (*exp_str >= '0' && *exp_str <= '9')
+    {
+      while (*exp_str >= '0' && *exp_str <= '9')
+      {
+        if (exp_value < 10000)
+          exp_value = exp_value * 10 + (*exp_str - '0');
+        exp_str++;
+      }
+
+      exp10 += exp_negative ? -exp_value : exp_value;
+      str = exp_str;
     }
   }
 
+  if (!found || !exact || !iPlotIsValueEnd(*str) || mant > (1ULL << 53) || exp10 < -22 || exp10 > 22)
+  {
+    // inf, nan, hexadecimal, long mantissas and large exponents
+    char* end;
+    *value = strtod(start, &end);
+    if (end == start)
+      return NULL;
+    return end;
+  }
+
+  double theValue = (double)mant;
+  if (exp10 < 0)
+    theValue /= iPlotPow10[-exp10];
+  else
+    theValue *= iPlotPow10[exp10];
+
+  *value = negative ? -theValue : theValue;
+  return str;
+}
+
+// Parses the values of a line, returns 0 if a value is invalid.
+// A missing value at the end of the line repeats the previous value.
+static int iPlotParseLine(const char* line_buffer, int ds_count, double* values)
+{
+  double value = 0;
+
+  for (int ds = 0; ds < ds_count; ds++)
+  {
+    if (*line_buffer != 0)
+    {
+      if (!iPlotParseDouble(line_buffer, &value))
+        return 0;
+
+      line_buffer = iPlotSkipValue(line_buffer);
+    }
+
+    values[ds] = value;
+  }
+
   return 1;
 }
 
+static const char* iPlotSkipSpaces(const char* line_buffer)
+{
+  while (*line_buffer == ' ' || *line_buffer == '\t')
+    line_buffer++;
+  return line_buffer;
+}
+
 static int iPlotAddToDataSetsStrX(Ihandle* ih, const char* line_buffer, int ds_start, int ds_count)
 {
   char x[100] = "";
@@ -2489,14 +2614,17 @@ static int iPlotAddToDataSetsStrX(Ihandle* ih, const char* line_buffer, int ds_s
   {
     if (ds == 0)
     {
-      int ret = sscanf(line_buffer, "%s", x);
-      if (!ret)
-        return 0;
+      int i = 0;
+      while (!iPlotIsValueEnd(line_buffer[i]) && i < (int)sizeof(x) - 1)
+      {
+        x[i] = line_buffer[i];
+        i++;
+      }
+      x[i] = 0;
     }
-    else
+    else if (*line_buffer != 0)
     {
-      int ret = sscanf(line_buffer, "%lf", &value);
-      if (!ret)
+      if (!iPlotParseDouble(line_buffer, &value))
         return 0;
     }
 
@@ -2514,11 +2642,20 @@ static int iPlotAddToDataSetsStrX(Ihandle* ih, const char* line_buffer, int ds_s
   return 1;
 }
 
-static int iPlotLoadDataFile(Ihandle* ih, IlineFile* line_file, int strXdata)
+static void iPlotCreateDataSets(Ihandle* ih, int ds_count, bool strXdata)
+{
+  for (int ds = 0; ds < ds_count - 1; ds++)
+  {
+    iupPlotDataSet* theDataSet = new iupPlotDataSet(strXdata);
+    ih->data->current_plot->AddDataSet(theDataSet);
+  }
+}
+
+static int iPlotLoadDataFileStrX(Ihandle* ih, IlineFile* line_file)
 {
   int first_line = 1;
   int ds_count = 0;
-  int ds, ds_start = ih->data->current_plot->mDataSetListCount;
+  int ds_start = ih->data->current_plot->mDataSetListCount;
 
   do
   {
@@ -2526,16 +2663,12 @@ static int iPlotLoadDataFile(Ihandle* ih, IlineFile* line_file, int strXdata)
     if (line_len == -1)
       return 0;
 
-    const char* line_buffer = iupLineFileGetBuffer(line_file);
+    const char* line_buffer = iPlotSkipSpaces(iupLineFileGetBuffer(line_file));
 
-    int i = 0;
-    while (line_buffer[i] == ' ') /* ignore spaces at start */
-      i++;
-
-    if (line_buffer[i] == 0) /* skip empty line */
+    if (*line_buffer == 0) /* skip empty line */
       continue;
 
-    if (line_buffer[i] == '#') /* "#" signifies a comment line when used as the first non-space character on a line */
+    if (*line_buffer == '#') /* "#" signifies a comment line when used as the first non-space character on a line */
       continue;
 
     if (first_line)
@@ -2544,29 +2677,374 @@ static int iPlotLoadDataFile(Ihandle* ih, IlineFile* line_file, int strXdata)
       if (ds_count < 2) // must have at least X and Y1, could have Y2, Y3, ...
         return 0;
 
-      for (ds = 0; ds < ds_count - 1; ds++)
+      iPlotCreateDataSets(ih, ds_count, true);
+      first_line = 0;
+    }
+
+    if (!iPlotAddToDataSetsStrX(ih, line_buffer, ds_start, ds_count))
+      return 0;
+
+  } while (!iupLineFileEOF(line_file));
+
+  return 1;
+}
+
+#define IPLOT_LOAD_BLOCK (16 * 1024 * 1024)
+#define IPLOT_LOAD_MIN_BYTES (1024 * 1024)
+
+// Complete lines of a block of the file, parsed by one thread.
+struct iPlotLoadJob
+{
+  char* start;
+  char* end;
+  int ds_count;
+  double* values;   // ds_count values for each row
+  int count, capacity;
+  int error;
+};
+
+static void iPlotLoadRunJob(void* inJob)
+{
+  iPlotLoadJob* job = (iPlotLoadJob*)inJob;
+  char* line = job->start;
+
+  while (line < job->end)
+  {
+    // lines end with '\n', except the last line of the file that ends with the terminator of the block
+    char* line_end = (char*)memchr(line, '\n', job->end - line);
+    if (!line_end)
+      line_end = job->end;
+
+    *line_end = 0;
+    if (line_end > line && line_end[-1] == '\r')
+      line_end[-1] = 0;
+
+    const char* line_buffer = iPlotSkipSpaces(line);
+    line = line_end + 1;
+
+    if (*line_buffer == 0 || *line_buffer == '#')  /* empty or comment line */
+      continue;
+
+    if (job->count == job->capacity)
+    {
+      int theCapacity = job->capacity ? 2 * job->capacity : 1024;
+      double* theValues = (double*)realloc(job->values, (size_t)theCapacity * job->ds_count * sizeof(double));
+      if (!theValues)
       {
-        iupPlotDataSet* theDataSet = new iupPlotDataSet(strXdata ? true : false);
-        ih->data->current_plot->AddDataSet(theDataSet);
+        job->error = 1;
+        return;
       }
+      job->values = theValues;
+      job->capacity = theCapacity;
+    }
 
-      first_line = 0;
+    if (!iPlotParseLine(line_buffer, job->ds_count, job->values + (size_t)job->count * job->ds_count))
+    {
+      job->error = 1;
+      return;
     }
 
-    if (strXdata)
+    job->count++;
+  }
+}
+
+// Adds the rows to the datasets, one column at a time.
+static void iPlotAddRowsToDataSets(Ihandle* ih, const double* values, int count, int ds_start, int ds_count, double* x, double* y)
+{
+  for (int i = 0; i < count; i++)
+    x[i] = values[(size_t)i * ds_count];
+
+  for (int ds = 1; ds < ds_count; ds++)
+  {
+    for (int i = 0; i < count; i++)
+      y[i] = values[(size_t)i * ds_count + ds];
+
+    iupPlotDataSet* theDataSet = ih->data->current_plot->mDataSetList[ds_start + ds - 1];
+    theDataSet->AddSamples(x, y, count);
+  }
+}
+
+// Parses the lines of a block in parallel, returns 0 if a line is invalid.
+// The lines before the invalid line are still added.
+static int iPlotLoadDataBlock(Ihandle* ih, char* block, size_t size, int ds_start, int ds_count)
+{
+  iPlotLoadJob jobs[IUP_PLOT_THREAD_MAX];
+  int theThreadCount = iupPlotGetThreadCount((int)size, IPLOT_LOAD_MIN_BYTES);
+  char* theStart = block;
+  int i, ret = 1;
+
+  for (i = 0; i < theThreadCount; i++)
+  {
+    // split at line boundaries
+    char* theEnd = block + (size * (i + 1)) / theThreadCount;
+    if (theEnd < theStart)
+      theEnd = theStart;
+
+    if (i < theThreadCount - 1)
     {
-      if (!iPlotAddToDataSetsStrX(ih, line_buffer + i, ds_start, ds_count))
-        return 0;
+      char* theNewLine = (char*)memchr(theEnd, '\n', block + size - theEnd);
+      theEnd = theNewLine ? theNewLine + 1 : block + size;
     }
     else
+      theEnd = block + size;
+
+    jobs[i].start = theStart;
+    jobs[i].end = theEnd;
+    jobs[i].ds_count = ds_count;
+    jobs[i].values = NULL;
+    jobs[i].count = 0;
+    jobs[i].capacity = 0;
+    jobs[i].error = 0;
+
+    theStart = theEnd;
+  }
+
+  iupPlotRunJobs(iPlotLoadRunJob, jobs, sizeof(iPlotLoadJob), theThreadCount);
+
+  int theMaxCount = 0;
+  for (i = 0; i < theThreadCount; i++)
+  {
+    if (jobs[i].count > theMaxCount)
+      theMaxCount = jobs[i].count;
+  }
+
+  double* x = (double*)malloc((size_t)theMaxCount * sizeof(double) + 1);
+  double* y = (double*)malloc((size_t)theMaxCount * sizeof(double) + 1);
+
+  for (i = 0; i < theThreadCount; i++)
+  {
+    if (ret && x && y)
+      iPlotAddRowsToDataSets(ih, jobs[i].values, jobs[i].count, ds_start, ds_count, x, y);
+
+    if (jobs[i].error || !x || !y)
+      ret = 0;
+
+    free(jobs[i].values);
+  }
+
+  free(x);
+  free(y);
+  return ret;
+}
+
+static int iPlotLoadDataFileNumeric(Ihandle* ih, FILE* file)
+{
+  int ds_count = 0;
+  int ds_start = ih->data->current_plot->mDataSetListCount;
+  size_t theBufferSize = IPLOT_LOAD_BLOCK, theDataSize = 0;
+  int ret = 1;
+
+  char* theBuffer = (char*)malloc(theBufferSize + 1);
+  if (!theBuffer)
+    return 0;
+
+  for (;;)
+  {
+    if (theDataSize == theBufferSize)
     {
-      if (!iPlotAddToDataSets(ih, line_buffer + i, ds_start, ds_count))
-        return 0;
+      // a line longer than the buffer
+      char* theNewBuffer = (char*)realloc(theBuffer, 2 * theBufferSize + 1);
+      if (!theNewBuffer)
+      {
+        ret = 0;
+        break;
+      }
+      theBuffer = theNewBuffer;
+      theBufferSize *= 2;
     }
 
-  } while (!iupLineFileEOF(line_file));
+    theDataSize += fread(theBuffer + theDataSize, 1, theBufferSize - theDataSize, file);
+    if (ferror(file))
+    {
+      ret = 0;
+      break;
+    }
 
-  return 1;
+    int theEOF = feof(file);
+    theBuffer[theDataSize] = 0;
+
+    // the last line is incomplete and is parsed with the next block
+    size_t theComplete = theDataSize;
+    if (!theEOF)
+    {
+      while (theComplete > 0 && theBuffer[theComplete - 1] != '\n')
+        theComplete--;
+
+      if (theComplete == 0)
+        continue;
+    }
+
+    char* theBlock = theBuffer;
+    size_t theBlockSize = theComplete;
+
+    if (ds_count == 0)
+    {
+      // find the first line with data to count the datasets
+      char* line = theBlock;
+      while (line < theBlock + theBlockSize)
+      {
+        char* line_end = (char*)memchr(line, '\n', theBlock + theBlockSize - line);
+        if (!line_end)
+          line_end = theBlock + theBlockSize;
+
+        const char* line_buffer = iPlotSkipSpaces(line);
+        if (line_buffer != line_end && *line_buffer != '\r' && *line_buffer != '#')
+        {
+          char* theEnd = line_end;
+          if (theEnd > line && theEnd[-1] == '\r')
+            theEnd--;
+
+          char theEndChar = *theEnd;
+          *theEnd = 0;
+          ds_count = iPlotCountDataSets(line_buffer);
+          *theEnd = theEndChar;
+          break;
+        }
+
+        line = line_end + 1;
+      }
+
+      if (ds_count == 0)  // only empty and comment lines
+        theBlockSize = 0;
+      else if (ds_count < 2) // must have at least X and Y1, could have Y2, Y3, ...
+      {
+        ret = 0;
+        break;
+      }
+      else
+      {
+        iPlotCreateDataSets(ih, ds_count, false);
+
+        // skip the empty and comment lines before the first line with data
+        theBlockSize -= line - theBlock;
+        theBlock = line;
+      }
+    }
+
+    if (ds_count != 0 && theBlockSize > 0)
+    {
+      if (!iPlotLoadDataBlock(ih, theBlock, theBlockSize, ds_start, ds_count))
+      {
+        ret = 0;
+        break;
+      }
+    }
+
+    if (theEOF)
+      break;
+
+    theDataSize -= theComplete;
+    memmove(theBuffer, theBuffer + theComplete, theDataSize);
+  }
+
+  free(theBuffer);
+  return ret;
+}
+
+#define IPLOT_BINARY_SIGNATURE "IUPPLOTB"
+#define IPLOT_BINARY_BYTEORDER 0x01020304
+#define IPLOT_SAVE_BLOCK 65536
+
+// Binary data file:
+//   "IUPPLOTB"  8 bytes signature
+//   uint32      0x01020304 in the byte order of the file
+//   uint32      number of columns, X followed by Y1, Y2, ...
+//   int64       number of samples
+//   double      the samples of each column, one column after the other
+static void iPlotSwapBytes(void* data, size_t size, size_t count)
+{
+  unsigned char* theBytes = (unsigned char*)data;
+  for (size_t i = 0; i < count; i++, theBytes += size)
+  {
+    for (size_t j = 0; j < size / 2; j++)
+    {
+      unsigned char theByte = theBytes[j];
+      theBytes[j] = theBytes[size - 1 - j];
+      theBytes[size - 1 - j] = theByte;
+    }
+  }
+}
+
+static int iPlotLoadDataFileBinary(Ihandle* ih, FILE* file)
+{
+  uint32_t theByteOrder, theColumnCount;
+  int64_t theSampleCount;
+
+  // the signature was already read
+  if (fread(&theByteOrder, sizeof(uint32_t), 1, file) != 1 ||
+      fread(&theColumnCount, sizeof(uint32_t), 1, file) != 1 ||
+      fread(&theSampleCount, sizeof(int64_t), 1, file) != 1)
+    return 0;
+
+  bool theSwap = false;
+  if (theByteOrder != IPLOT_BINARY_BYTEORDER)
+  {
+    iPlotSwapBytes(&theByteOrder, sizeof(uint32_t), 1);
+    if (theByteOrder != IPLOT_BINARY_BYTEORDER)
+      return 0;
+
+    iPlotSwapBytes(&theColumnCount, sizeof(uint32_t), 1);
+    iPlotSwapBytes(&theSampleCount, sizeof(int64_t), 1);
+    theSwap = true;
+  }
+
+  if (theColumnCount < 2 || theColumnCount > 0x10000 || theSampleCount < 0 || theSampleCount > 0x7FFFFFFF ||
+      (uint64_t)theSampleCount > (uint64_t)(SIZE_MAX / sizeof(double) - 1))
+    return 0;
+
+  int ds_count = (int)theColumnCount;
+  int count = (int)theSampleCount;
+  size_t theColumnSize = (size_t)count * sizeof(double);
+
+  // column 0 is X, the other columns are Y of each dataset
+  double** theColumns = (double**)calloc(ds_count, sizeof(double*));
+  if (!theColumns)
+    return 0;
+
+  int ret = 1;
+  for (int ds = 0; ds < ds_count && ret; ds++)
+  {
+    theColumns[ds] = (double*)malloc(theColumnSize + 1);
+    if (!theColumns[ds] || fread(theColumns[ds], sizeof(double), count, file) != (size_t)count)
+      ret = 0;
+    else if (theSwap)
+      iPlotSwapBytes(theColumns[ds], sizeof(double), count);
+  }
+
+  if (!ret)
+  {
+    for (int ds = 0; ds < ds_count; ds++)
+      free(theColumns[ds]);
+    free(theColumns);
+    return 0;
+  }
+
+  // the first dataset adopts the X column, the others share it
+  iupPlotDataSet* theFirstDataSet = new iupPlotDataSet(false);
+  theFirstDataSet->SetSamplesBuffer(theColumns[0], theColumns[1], count, true);
+  ih->data->current_plot->AddDataSet(theFirstDataSet);
+
+  for (int ds = 2; ds < ds_count; ds++)
+  {
+    if (!ret)
+    {
+      free(theColumns[ds]);
+      continue;
+    }
+
+    // fails only when out of memory, the Y column is released
+    iupPlotDataSet* theDataSet = new iupPlotDataSet(false);
+    if (theDataSet->SetSamplesBuffer(theFirstDataSet, theColumns[ds], true))
+      ih->data->current_plot->AddDataSet(theDataSet);
+    else
+    {
+      delete theDataSet;
+      ret = 0;
+    }
+  }
+
+  free(theColumns);
+  return ret;
 }
 
 IUPPLOT_API int IupPlotLoadData(Ihandle* ih, const char* filename, int strXdata)
@@ -2582,15 +3060,136 @@ IUPPLOT_API int IupPlotLoadData(Ihandle* ih, const char* filename, int strXdata)
   if (!filename)
     return 0;
 
-  IlineFile* line_file = iupLineFileOpen(filename);
-  if (!line_file)
+  FILE* file = fopen(filename, "rb");
+  if (!file)
     return 0;
 
-  int error = iPlotLoadDataFile(ih, line_file, strXdata);
+  char theSignature[8];
+  if (fread(theSignature, 1, 8, file) == 8 && memcmp(theSignature, IPLOT_BINARY_SIGNATURE, 8) == 0)
+  {
+    int ret = iPlotLoadDataFileBinary(ih, file);
+    fclose(file);
+    return ret;
+  }
+
+  if (strXdata)
+  {
+    fclose(file);
+
+    IlineFile* line_file = iupLineFileOpen(filename);
+    if (!line_file)
+      return 0;
+
+    int ret = iPlotLoadDataFileStrX(ih, line_file);
+
+    iupLineFileClose(line_file);
+    return ret;
+  }
+
+  rewind(file);
+  int ret = iPlotLoadDataFileNumeric(ih, file);
+  fclose(file);
+  return ret;
+}
+
+static int iPlotSaveDataFileText(iupPlot* plot, FILE* file, int count)
+{
+  const iupPlotData* theXData = plot->mDataSetList[0]->GetDataX();
+
+  for (int i = 0; i < count; i++)
+  {
+    if (theXData->IsString())
+      fputs(((const iupPlotDataString*)theXData)->GetSampleString(i), file);
+    else
+      fprintf(file, "%.17g", theXData->GetSample(i));
+
+    for (int ds = 0; ds < plot->mDataSetListCount; ds++)
+      fprintf(file, " %.17g", plot->mDataSetList[ds]->GetDataY()->GetSample(i));
+
+    fputc('\n', file);
+  }
+
+  return !ferror(file);
+}
+
+static int iPlotSaveColumn(const iupPlotData* inData, FILE* file, int count, double* values)
+{
+  for (int i = 0; i < count; i += IPLOT_SAVE_BLOCK)
+  {
+    int theCount = count - i < IPLOT_SAVE_BLOCK ? count - i : IPLOT_SAVE_BLOCK;
+    inData->GetSamples(i, theCount, values);
+    if (fwrite(values, sizeof(double), theCount, file) != (size_t)theCount)
+      return 0;
+  }
+  return 1;
+}
+
+static int iPlotSaveDataFileBinary(iupPlot* plot, FILE* file, int count)
+{
+  uint32_t theByteOrder = IPLOT_BINARY_BYTEORDER;
+  uint32_t theColumnCount = plot->mDataSetListCount + 1;
+  int64_t theSampleCount = count;
+
+  if (plot->mDataSetList[0]->GetDataX()->IsString())
+    return 0;
+
+  if (fwrite(IPLOT_BINARY_SIGNATURE, 1, 8, file) != 8 ||
+      fwrite(&theByteOrder, sizeof(uint32_t), 1, file) != 1 ||
+      fwrite(&theColumnCount, sizeof(uint32_t), 1, file) != 1 ||
+      fwrite(&theSampleCount, sizeof(int64_t), 1, file) != 1)
+    return 0;
+
+  double* theValues = (double*)malloc(IPLOT_SAVE_BLOCK * sizeof(double));
+  if (!theValues)
+    return 0;
+
+  int ret = iPlotSaveColumn(plot->mDataSetList[0]->GetDataX(), file, count, theValues);
+  for (int ds = 0; ds < plot->mDataSetListCount && ret; ds++)
+    ret = iPlotSaveColumn(plot->mDataSetList[ds]->GetDataY(), file, count, theValues);
+
+  free(theValues);
+  return ret;
+}
+
+IUPPLOT_API int IupPlotSaveData(Ihandle* ih, const char* filename, int binary)
+{
+  iupASSERT(iupObjectCheck(ih));
+  if (!iupObjectCheck(ih))
+    return 0;
+
+  if (ih->iclass->nativetype != IUP_TYPECANVAS ||
+      !IupClassMatch(ih, "plot"))
+      return 0;
+
+  if (!filename)
+    return 0;
+
+  iupPlot* plot = ih->data->current_plot;
+  if (plot->mDataSetListCount == 0)
+    return 0;
+
+  // all datasets share the X values of the first dataset
+  int count = plot->mDataSetList[0]->GetCount();
+  for (int ds = 1; ds < plot->mDataSetListCount; ds++)
+  {
+    if (plot->mDataSetList[ds]->GetCount() != count)
+      return 0;
+  }
+
+  FILE* file = fopen(filename, binary ? "wb" : "w");
+  if (!file)
+    return 0;
+
+  int ret;
+  if (binary)
+    ret = iPlotSaveDataFileBinary(plot, file, count);
+  else
+    ret = iPlotSaveDataFileText(plot, file, count);
 
-  iupLineFileClose(line_file);
+  if (fclose(file) != 0)
+    ret = 0;
 
-  return error;
+  return ret;
 }
 
 IUPPLOT_API int IupPlotFindSample(Ihandle* ih, double cnv_x, double cnv_y, int *ds_index, int *sample_index)
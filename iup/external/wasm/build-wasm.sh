@@ -127,7 +127,7 @@ PLOT_EXPORTS=""
 if has_tag plot; then
   CFLAGS="$CFLAGS -I$EXTERNAL/srcplot"
   CORE="$CORE $EXTERNAL/srcplot/*.cpp"
-  PLOT_EXPORTS=",_IupPlotOpen,_IupPlot,_IupPlotBegin,_IupPlotAdd,_IupPlotAddStr,_IupPlotAddSamples,_IupPlotAddStrSamples,_IupPlotInsert,_IupPlotInsertStr,_IupPlotInsertSamples,_IupPlotInsertStrSamples,_IupPlotAddSegment,_IupPlotInsertSegment,_IupPlotEnd,_IupPlotLoadData,_IupPlotSetSample,_IupPlotSetSampleStr,_IupPlotSetSampleSelection,_IupPlotSetSampleExtra,_IupPlotGetSample,_IupPlotGetSampleStr,_IupPlotGetSampleSelection,_IupPlotGetSampleExtra,_IupPlotTransform,_IupPlotTransformTo,_IupPlotFindSample,_IupPlotFindSegment"
+  PLOT_EXPORTS=",_IupPlotOpen,_IupPlot,_IupPlotBegin,_IupPlotAdd,_IupPlotAddStr,_IupPlotAddSamples,_IupPlotAddStrSamples,_IupPlotSetSamplesBuffer,_IupPlotInsert,_IupPlotInsertStr,_IupPlotInsertSamples,_IupPlotInsertStrSamples,_IupPlotAddSegment,_IupPlotInsertSegment,_IupPlotEnd,_IupPlotLoadData,_IupPlotSaveData,_IupPlotSetSample,_IupPlotSetSampleStr,_IupPlotSetSampleSelection,_IupPlotSetSampleExtra,_IupPlotGetSample,_IupPlotGetSampleStr,_IupPlotGetSampleSelection,_IupPlotGetSampleExtra,_IupPlotTransform,_IupPlotTransformTo,_IupPlotFindSample,_IupPlotFindSegment"
 fi
 
 if [ "$FORCE" = 1 ] || [ ! -f "$BUILD/iup.js" ]; then MODULE_FRESH=1; else MODULE_FRESH=0; fi
@@ -151,7 +151,7 @@ case "$APP" in
     cp "$HERE/web/index.html" "$BUILD/index.html"
     ;;
   *)
-    EXPORTS="_IupOpen,_IupClose,_IupMainLoop,_IupShow,_IupShowXY,_IupPopup,_IupLabel,_IupButton,_IupToggle,_IupText,_IupMultiLine,_IupList,_IupTabs,_IupVal,_IupProgressBar,_IupTimer,_IupCanvas,_IupCalendar,_IupTable,_IupScrollbar,_IupPopover,_IupTree,_IupSetAttributeId,_IupSetStrAttributeId,_IupGetAttributeId,_IupSetAttributeId2,_IupSetStrAttributeId2,_IupGetAttributeId2,_IupRadio,_IupDestroy,_IupGetGlobal,_IupGetChild,_IupGetFloat,_IupImage,_IupImageRGB,_IupImageRGBA,_IupImageFromHandle,_IupDialog,_IupFrame,_IupFill,_iupwasmTabs0,_IupAppend,_IupGetParent,_IupGetChildPos,_IupGetHandle,_IupGetName,_IupGetInt,_IupSetAttribute,_IupSetStrAttribute,_IupSetAttributeHandle,_IupGetAttribute,_IupSetHandle,_IupSetAttributes,_IupSetGlobal,_IupSetStrGlobal,_IupMessage,_IupMessageError,_IupMessageAlarm,_IupAlarm,_IupNotify,_IupClipboard,_IupHelp,_IupFontDlg,_IupSubmenu,_IupMenuItem,_IupSeparator,_IupMenuSeparator,_iupwasmMenu0,_IupDrawBegin,_IupDrawEnd,_IupDrawGetSize,_IupDrawParentBackground,_IupDrawLine,_IupDrawRectangle,_IupDrawArc,_IupDrawEllipse,_IupDrawPolygon,_IupDrawPixel,_IupDrawRoundedRectangle,_IupDrawBezier,_IupDrawQuadraticBezier,_IupDrawText,_IupDrawImage,_IupDrawSelectRect,_IupDrawFocusRect,_IupDrawSetClipRect,_IupDrawSetClipRoundedRect,_IupDrawResetClip,_IupDrawLinearGradient,_IupDrawRadialGradient,_IupDrawLinearGradientStops,_IupDrawRadialGradientStops,_IupDrawGetTextSize,_IupDrawGetTextMetrics,_iupwasmVbox0,_iupwasmHbox0,_IupSetCallback,_iupwasmGoSetCallback,_iupwasmGoSetIdle,_iupwasmListReorder,_iupwasmDndTransfer,_iupwasmGetParamv,_iupwasmThemeChanged,_IupFileDlg,_IupMessageDlg,_IupColorDlg,_IupColorBrowser,_IupProgressDlg,_IupGetFile,_IupGetColor,_IupGetText,_IupListDialog,_malloc,_free$GL_EXPORTS$WEB_EXPORTS"
+    EXPORTS="_IupOpen,_IupClose,_IupMainLoop,_IupShow,_IupShowXY,_IupPopup,_IupLabel,_IupButton,_IupToggle,_IupText,_IupMultiLine,_IupList,_IupTabs,_IupVal,_IupProgressBar,_IupTimer,_IupCanvas,_IupCalendar,_IupTable,_IupScrollbar,_IupPopover,_IupTree,_IupSetAttributeId,_IupSetStrAttributeId,_IupGetAttributeId,_IupSetAttributeId2,_IupSetStrAttributeId2,_IupGetAttributeId2,_IupRadio,_IupDestroy,_IupGetGlobal,_IupGetChild,_IupGetFloat,_IupImage,_IupImageRGB,_IupImageRGBA,_IupImageFromHandle,_IupDialog,_IupFrame,_IupFill,_iupwasmTabs0,_IupAppend,_IupGetParent,_IupGetChildPos,_IupGetHandle,_IupGetName,_IupGetInt,_IupSetAttribute,_IupSetStrAttribute,_IupSetAttributeHandle,_IupGetAttribute,_IupSetHandle,_IupSetAttributes,_IupSetGlobal,_IupSetStrGlobal,_IupMessage,_IupMessageError,_IupMessageAlarm,_IupAlarm,_IupNotify,_IupClipboard,_IupHelp,_IupFontDlg,_IupSubmenu,_IupMenuItem,_IupSeparator,_IupMenuSeparator,_iupwasmMenu0,_IupDrawBegin,_IupDrawEnd,_IupDrawGetSize,_IupDrawParentBackground,_IupDrawLine,_IupDrawRectangle,_IupDrawArc,_IupDrawEllipse,_IupDrawPolygon,_IupDrawPolyline,_IupDrawPixel,_IupDrawRoundedRectangle,_IupDrawBezier,_IupDrawQuadraticBezier,_IupDrawText,_IupDrawImage,_IupDrawSelectRect,_IupDrawFocusRect,_IupDrawSetClipRect,_IupDrawSetClipRoundedRect,_IupDrawResetClip,_IupDrawLinearGradient,_IupDrawRadialGradient,_IupDrawLinearGradientStops,_IupDrawRadialGradientStops,_IupDrawGetTextSize,_IupDrawGetTextMetrics,_iupwasmVbox0,_iupwasmHbox0,_IupSetCallback,_iupwasmGoSetCallback,_iupwasmGoSetIdle,_iupwasmListReorder,_iupwasmDndTransfer,_iupwasmGetParamv,_iupwasmThemeChanged,_IupFileDlg,_IupMessageDlg,_IupColorDlg,_IupColorBrowser,_IupProgressDlg,_IupGetFile,_IupGetColor,_IupGetText,_IupListDialog,_malloc,_free$GL_EXPORTS$WEB_EXPORTS"
     EXPORTS="$EXPORTS,_IupAnimatedLabel,_IupBackgroundBox,_IupClassMatch,_IupConfig,_IupConfigDialogClosed,_IupConfigDialogShow,_IupConfigGetVariableDouble,_IupConfigGetVariableDoubleDef,_IupConfigGetVariableDoubleId,_IupConfigGetVariableDoubleIdDef,_IupConfigGetVariableInt,_IupConfigGetVariableIntDef,_IupConfigGetVariableIntId,_IupConfigGetVariableIntIdDef,_IupConfigGetVariableStr,_IupConfigGetVariableStrDef,_IupConfigGetVariableStrId,_IupConfigGetVariableStrIdDef,_IupConfigLoad,_IupConfigRecentInit,_IupConfigRecentUpdate,_IupConfigSave,_IupConfigSetListVariable,_IupConfigSetVariableDouble,_IupConfigSetVariableDoubleId,_IupConfigSetVariableInt,_IupConfigSetVariableIntId,_IupConfigSetVariableStr,_IupConfigSetVariableStrId,_IupConvertXYToPos,_IupCopyClassAttributes,_IupCreate,_IupDatePick,_IupDetach,_IupDetachBox,_IupDrawGetClipRect,_IupDrawGetImage,_IupDrawGetImageInfo,_IupDrawGetSvg,_IupExecute,_IupExecuteWait,_IupExitLoop,_IupExpander,_IupFlush,_IupGetAllAttributes,_IupGetAllClasses,_IupGetAllDialogs,_IupGetAllFunctions,_IupGetAllGlobals,_IupGetAllNames,_IupGetAttributeHandle,_IupGetAttributeHandleId,_IupGetAttributeHandleId2,_IupGetAttributes,_IupGetBrother,_IupGetCallback,_IupGetChildCount,_IupGetClassAttributeInfo,_IupGetClassAttributes,_IupGetClassCallbackFormat,_IupGetClassCallbacks,_IupGetClassConstructor,_IupGetClassInfo,_IupGetClassName,_IupGetClassType,_IupGetDialog,_IupGetDialogChild,_IupGetDouble,_IupGetDoubleId,_IupGetDoubleId2,_IupGetFloatId,_IupGetFloatId2,_IupGetFocus,_IupGetFunction,_IupGetGlobalInfo,_IupGetIntId,_IupGetIntId2,_IupGetIntInt,_IupGetLanguage,_IupGetLanguageString,_IupGetNextChild,_IupGetRGB,_IupGetRGBA,_IupGetRGBId,_IupGetRGBId2,_IupHide,_IupImageGetHandle,_IupImageSave,_IupImageSaveToBuffer,_IupInsert,_IupLink,_IupLog,_IupLoopStep,_IupLoopStepWait,_IupMainLoopLevel,_IupMap,_IupNextField,_IupParam,_IupPlayInput,_IupPostMessage,_IupPreviousField,_IupRecordInput,_IupRedraw,_IupRefresh,_IupRefreshChildren,_IupReparent,_IupResetAttribute,_IupSaveClassAttributes,_IupSbox,_IupScrollBox,_IupSetAttributeHandleId,_IupSetAttributeHandleId2,_IupSetClassDefaultAttribute,_IupSetFocus,_IupSetLanguage,_IupSetLanguagePack,_IupSetRGB,_IupSetRGBA,_IupSetRGBId,_IupSetRGBId2,_IupSpace,_IupSpin,_IupSpinbox,_IupSplit,_IupStringCompare,_IupTextConvertLinColToPos,_IupTextConvertPosToLinCol,_IupThread,_IupTray,_IupTreeGetId,_IupTreeGetUserId,_IupTreeSetAttributeHandle,_IupTreeSetUserId,_IupUnmap,_IupUpdate,_IupUpdateChildren,_IupUser,_IupVersion,_IupVersionDate,_IupVersionNumber,_IupVersionShow,_IupCbox,_IupZbox,_IupGridBox,_IupMultiBox,_IupNormalizer,_IupParamBox,_IupDial,_IupColorbar,_IupElementPropertiesDialog,_IupClassInfoDialog,_IupGlobalsDialog$CTRL_EXPORTS$PLOT_EXPORTS"
     RUNTIME="ccall,cwrap,UTF8ToString,stringToUTF8,lengthBytesUTF8,setValue,getValue,HEAPU8"
     if [ "$MODULE_FRESH" = 1 ]; then
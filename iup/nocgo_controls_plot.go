@@ -18,6 +18,7 @@ var (
 	iupPlotAddSegment         func(ih uintptr, x, y float64)
 	iupPlotEnd                func(ih uintptr) int32
 	iupPlotLoadData           func(ih uintptr, filename string, strXdata int32) int32
+	iupPlotSaveData           func(ih uintptr, filename string, binary int32) int32
 	iupPlotInsert             func(ih uintptr, ds, sample int32, x, y float64)
 	iupPlotInsertStr          func(ih uintptr, ds, sample int32, x string, y float64)
 	iupPlotInsertSegment      func(ih uintptr, ds, sample int32, x, y float64)
@@ -37,6 +38,10 @@ var (
 	iupPlotTransformTo        func(ih uintptr, cnvX, cnvY float64, x, y *float64)
 	iupPlotFindSample         func(ih uintptr, cnvX, cnvY float64, ds, sample *int32) int32
 	iupPlotFindSegment        func(ih uintptr, cnvX, cnvY float64, ds, sample1, sample2 *int32) int32
+
+	// Optional: older libraries lack it, and the buffer needs the malloc the library frees with.
+	iupPlotSetSamplesBuffer func(ih uintptr, ds int32, x, y unsafe.Pointer, count, ownBuffer int32) int32
+	plotMalloc              func(size uintptr) unsafe.Pointer
 )
 
 func init() {
@@ -54,6 +59,7 @@ func init() {
 	reg(&iupPlotAddSegment, "IupPlotAddSegment")
 	reg(&iupPlotEnd, "IupPlotEnd")
 	reg(&iupPlotLoadData, "IupPlotLoadData")
+	reg(&iupPlotSaveData, "IupPlotSaveData")
 	reg(&iupPlotInsert, "IupPlotInsert")
 	reg(&iupPlotInsertStr, "IupPlotInsertStr")
 	reg(&iupPlotInsertSegment, "IupPlotInsertSegment")
@@ -73,6 +79,10 @@ func init() {
 	reg(&iupPlotTransformTo, "IupPlotTransformTo")
 	reg(&iupPlotFindSample, "IupPlotFindSample")
 	reg(&iupPlotFindSegment, "IupPlotFindSegment")
+	if fn, malloc := dlsymRaw(lib, "IupPlotSetSamplesBuffer"), dlsymRaw(lib, "malloc"); fn != 0 && malloc != 0 {
+		purego.RegisterFunc(&iupPlotSetSamplesBuffer, fn)
+		purego.RegisterFunc(&plotMalloc, malloc)
+	}
 }
 
 // cStrArray builds a char* array (as []uintptr into Go buffers) plus the keep
@@ -105,6 +115,10 @@ func PlotLoadData(ih Ihandle, filename string, strXdata int) int {
 	return int(iupPlotLoadData(uintptr(ih), filename, int32(strXdata)))
 }
 
+func PlotSaveData(ih Ihandle, filename string, binary int) int {
+	return int(iupPlotSaveData(uintptr(ih), filename, int32(binary)))
+}
+
 func PlotInsert(ih Ihandle, dsIndex, sampleIndex int, x, y float64) {
 	iupPlotInsert(uintptr(ih), int32(dsIndex), int32(sampleIndex), x, y)
 }
@@ -131,6 +145,21 @@ func PlotAddSamples(ih Ihandle, dsIndex int, x, y []float64) {
 	iupPlotAddSamples(uintptr(ih), int32(dsIndex), x, y, int32(len(x)))
 }
 
+func PlotSetSamplesBuffer(ih Ihandle, dsIndex int, x, y []float64) int {
+	count := len(x)
+	if len(y) != count || iupPlotSetSamplesBuffer == nil {
+		return 0
+	}
+	var pX, pY unsafe.Pointer
+	if count > 0 {
+		size := uintptr(count) * unsafe.Sizeof(float64(0))
+		pX, pY = plotMalloc(size), plotMalloc(size)
+		copy(unsafe.Slice((*float64)(pX), count), x)
+		copy(unsafe.Slice((*float64)(pY), count), y)
+	}
+	return int(iupPlotSetSamplesBuffer(uintptr(ih), int32(dsIndex), pX, pY, int32(count), 1))
+}
+
 func PlotAddStrSamples(ih Ihandle, dsIndex int, x []string, y []float64) {
 	arr, keep := cStrArray(x)
 	iupPlotAddStrSamples(uintptr(ih), int32(dsIndex), &arr[0], y, int32(len(x)))
@@ -50,6 +50,14 @@ func DrawPolygon(ih Ihandle, points []int, count int) {
 	iupDrawPolygon(uintptr(ih), cp, int32(count))
 }
 
+func DrawPolyline(ih Ihandle, points []int, count int) {
+	cp := make([]int32, len(points))
+	for i, v := range points {
+		cp[i] = int32(v)
+	}
+	iupDrawPolyline(uintptr(ih), cp, int32(count))
+}
+
 func DrawLinearGradientStops(ih Ihandle, x1, y1, x2, y2 int, angle float32, colors []string, offsets []float32) {
 	n := len(colors)
 	if n < 2 {
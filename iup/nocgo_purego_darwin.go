@@ -16,6 +16,14 @@ func dlopenRaw(nameOrPath string) uintptr {
 	return h
 }
 
+func dlsymRaw(h uintptr, name string) uintptr {
+	sym, err := purego.Dlsym(h, name)
+	if err != nil {
+		return 0
+	}
+	return sym
+}
+
 func sysLibNames(base string) []string {
 	return []string{"lib" + base + ".dylib", "lib" + base + ".4.dylib"}
 }
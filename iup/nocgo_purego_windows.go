@@ -15,6 +15,15 @@ func dlopenRaw(nameOrPath string) uintptr {
 	return uintptr(h)
 }
 
+// dlsymRaw only finds symbols exported by the DLL itself, not by its imports.
+func dlsymRaw(h uintptr, name string) uintptr {
+	sym, err := syscall.GetProcAddress(syscall.Handle(h), name)
+	if err != nil {
+		return 0
+	}
+	return sym
+}
+
 func sysLibNames(base string) []string { return []string{base + ".dll", "lib" + base + ".dll"} }
 
 // canonicalLibName matches the DLL import name recorded in dependent libs, so
@@ -244,6 +244,7 @@ var (
 	iupDrawArc                func(ih uintptr, x1, y1, x2, y2 int32, a1, a2 float64)
 	iupDrawEllipse            func(ih uintptr, x1, y1, x2, y2 int32)
 	iupDrawPolygon            func(ih uintptr, points []int32, count int32)
+	iupDrawPolyline           func(ih uintptr, points []int32, count int32)
 	iupDrawPixel              func(ih uintptr, x, y int32)
 	iupDrawRoundedRectangle   func(ih uintptr, x1, y1, x2, y2, corner int32)
 	iupDrawText               func(ih uintptr, str string, length, x, y, w, h int32)
@@ -553,6 +554,7 @@ func ensureBase() {
 		reg(&iupDrawArc, "IupDrawArc")
 		reg(&iupDrawEllipse, "IupDrawEllipse")
 		reg(&iupDrawPolygon, "IupDrawPolygon")
+		reg(&iupDrawPolyline, "IupDrawPolyline")
 		reg(&iupDrawPixel, "IupDrawPixel")
 		reg(&iupDrawRoundedRectangle, "IupDrawRoundedRectangle")
 		reg(&iupDrawText, "IupDrawText")
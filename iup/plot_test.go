@@ -0,0 +1,56 @@
+//go:build plot && cgo && !js
+
+package iup
+
+import (
+	"testing"
+)
+
+// PlotSetSamplesBuffer replaces the samples of numeric datasets only, and
+// reports failures instead of silently keeping the old samples. cgo only: the
+// libraries embedded for nocgo may predate the function.
+func TestPlotSetSamplesBuffer(t *testing.T) {
+	PlotOpen()
+	plot := Plot()
+	defer plot.Destroy()
+
+	PlotBegin(plot, 0)
+	PlotAdd(plot, 0, 0)
+	ds := PlotEnd(plot)
+
+	if r := PlotSetSamplesBuffer(plot, ds, []float64{1, 2, 3}, []float64{10, 20, 30}); r != 1 {
+		t.Fatalf("PlotSetSamplesBuffer = %d, want 1", r)
+	}
+	plot.SetAttribute("CURRENT", ds)
+	if n := plot.GetInt("DS_COUNT"); n != 3 {
+		t.Fatalf("DS_COUNT = %d, want 3", n)
+	}
+	if x, y := PlotGetSample(plot, ds, 2); x != 3 || y != 30 {
+		t.Fatalf("sample 2 = (%g, %g), want (3, 30)", x, y)
+	}
+
+	if r := PlotSetSamplesBuffer(plot, ds+1, []float64{1}, []float64{1}); r != 0 {
+		t.Fatalf("invalid dataset: PlotSetSamplesBuffer = %d, want 0", r)
+	}
+	if r := PlotSetSamplesBuffer(plot, ds, []float64{1, 2}, []float64{1}); r != 0 {
+		t.Fatalf("length mismatch: PlotSetSamplesBuffer = %d, want 0", r)
+	}
+	if n := plot.GetInt("DS_COUNT"); n != 3 {
+		t.Fatalf("failed calls changed DS_COUNT to %d", n)
+	}
+
+	PlotBegin(plot, 1)
+	PlotAddStr(plot, "a", 1)
+	strDs := PlotEnd(plot)
+	if r := PlotSetSamplesBuffer(plot, strDs, []float64{1}, []float64{1}); r != 0 {
+		t.Fatalf("string X: PlotSetSamplesBuffer = %d, want 0", r)
+	}
+
+	if r := PlotSetSamplesBuffer(plot, ds, nil, nil); r != 1 {
+		t.Fatalf("empty: PlotSetSamplesBuffer = %d, want 1", r)
+	}
+	plot.SetAttribute("CURRENT", ds)
+	if n := plot.GetInt("DS_COUNT"); n != 0 {
+		t.Fatalf("empty: DS_COUNT = %d, want 0", n)
+	}
+}
@@ -3,7 +3,10 @@
 package iup
 
 import (
+	"bytes"
+	"image"
 	"os"
+	"strconv"
 	"testing"
 	"time"
 	"unsafe"
@@ -396,3 +399,199 @@ func TestMapCallback(t *testing.T) {
 		t.Fatal("MAP_CB did not fire on Show")
 	}
 }
+
+// Numbered attributes set by id are found by name and the reverse, including ids too long to be parsed.
+func TestAttributeIds(t *testing.T) {
+	e := Label("x")
+	for _, id := range []int{0, 12, 999999999, 1000000000, 2147483647} {
+		SetAttributeId(e, "SMOKEID", id, "v")
+		name := "SMOKEID" + strconv.Itoa(id)
+		if got := e.GetAttribute(name); got != "v" {
+			t.Fatalf("id %d set by id, %s = %q", id, name, got)
+		}
+		e.SetAttribute(name, "w")
+		if got := GetAttributeId(e, "SMOKEID", id); got != "w" {
+			t.Fatalf("id %d set by name, GetAttributeId = %q", id, got)
+		}
+	}
+	SetAttributeId2(e, "SMOKEID", 3, 1000000000, "c")
+	if got := e.GetAttribute("SMOKEID3:1000000000"); got != "c" {
+		t.Fatalf("SMOKEID3:1000000000 = %q", got)
+	}
+	Destroy(e)
+}
+
+// IupRefresh computes the natural size again for the element given and for the whole dialog.
+func TestRefreshLayout(t *testing.T) {
+	a := Label("a")
+	box := Vbox(a, Label("b"))
+	dlg := Dialog(box)
+	Refresh(dlg)
+	_, w0, _ := GetInt2(box, "NATURALSIZE")
+
+	a.SetAttribute("TITLE", "a much longer title than before")
+	Refresh(a)
+	_, w1, _ := GetInt2(box, "NATURALSIZE")
+	if w1 <= w0 {
+		t.Fatalf("IupRefresh(label) did not grow the box: %d -> %d", w0, w1)
+	}
+
+	a.SetAttribute("TITLE", "a")
+	Refresh(dlg)
+	_, w2, _ := GetInt2(box, "NATURALSIZE")
+	if w2 != w0 {
+		t.Fatalf("IupRefresh(dialog) box width = %d, want %d", w2, w0)
+	}
+	Destroy(dlg)
+}
+
+// With NORMALIZESIZE the children get the size of the largest one again when it shrinks.
+func TestRefreshNormalizeSize(t *testing.T) {
+	a := Label("a much longer title than the other")
+	b := Label("b")
+	box := Vbox(a, b).SetAttribute("NORMALIZESIZE", "HORIZONTAL")
+	dlg := Dialog(box)
+	Refresh(dlg)
+	_, w0, _ := GetInt2(b, "NATURALSIZE")
+
+	a.SetAttribute("TITLE", "a")
+	Refresh(a)
+	_, w1, _ := GetInt2(b, "NATURALSIZE")
+	if w1 >= w0 {
+		t.Fatalf("IupRefresh(label) did not shrink the normalized width: %d -> %d", w0, w1)
+	}
+	Destroy(dlg)
+}
+
+// A recorded frame is drawn again when the pixels of an image change, even if the image name is the same.
+func TestDrawListImageChange(t *testing.T) {
+	img := Image(2, 2, []byte{1, 1, 1, 1})
+	img.SetAttribute("1", "255 0 0")
+	SetHandle("SMOKE_DRAWIMAGE", img)
+
+	cnv := Canvas()
+	cnv.SetAttributes("RASTERSIZE=4x4, DRAWHEADLESS=YES, DRAWLIST=YES")
+	draw := func() (string, uint8, uint8) {
+		DrawBegin(cnv)
+		DrawImage(cnv, "SMOKE_DRAWIMAGE", 0, 0, -1, -1)
+		DrawEnd(cnv)
+		out := DrawGetImage(cnv)
+		pix := ImageToImage(out)
+		Destroy(out)
+		if pix == nil {
+			t.Fatal("DrawGetImage returned no pixels")
+		}
+		return cnv.GetAttribute("DRAWLISTHASH"), pix.Pix[0], pix.Pix[1]
+	}
+
+	h1, r, _ := draw()
+	if r != 255 {
+		t.Fatalf("first frame red = %d, want 255", r)
+	}
+	if h2, _, _ := draw(); h2 != h1 {
+		t.Fatalf("same frame changed the hash: %s -> %s", h1, h2)
+	}
+
+	img.SetAttribute("1", "0 255 0")
+	img.SetAttribute("CLEARCACHE", "1")
+	h3, r, g := draw()
+	if h3 == h1 {
+		t.Fatal("CLEARCACHE did not change the frame hash")
+	}
+	if r != 0 || g != 255 {
+		t.Fatalf("changed image drawn as %d %d, want 0 255", r, g)
+	}
+
+	Destroy(cnv)
+	Destroy(img)
+}
+
+// Draws in a white headless canvas and returns its pixels.
+func drawHeadless(t *testing.T, w, h int, draw func(cnv Ihandle)) *image.RGBA {
+	t.Helper()
+	cnv := Canvas()
+	cnv.SetAttribute("RASTERSIZE", strconv.Itoa(w)+"x"+strconv.Itoa(h))
+	cnv.SetAttribute("DRAWHEADLESS", "YES")
+	DrawBegin(cnv)
+	cnv.SetAttributes("DRAWCOLOR=\"255 255 255\", DRAWSTYLE=FILL")
+	DrawRectangle(cnv, 0, 0, w-1, h-1)
+	cnv.SetAttributes("DRAWCOLOR=\"0 0 0\", DRAWSTYLE=STROKE, DRAWLINEWIDTH=1")
+	draw(cnv)
+	DrawEnd(cnv)
+	out := DrawGetImage(cnv)
+	pix := ImageToImage(out)
+	Destroy(out)
+	Destroy(cnv)
+	if pix == nil {
+		t.Fatal("DrawGetImage returned no pixels")
+	}
+	return pix
+}
+
+// Lines with coordinates far outside the canvas are clipped before they are rasterized,
+// and produce the same pixels as the visible part.
+func TestDrawHeadlessClip(t *testing.T) {
+	const huge = 1000000000
+	black := func(pix *image.RGBA, x, y int) bool {
+		c := pix.RGBAAt(x, y)
+		return c.R == 0 && c.G == 0 && c.B == 0
+	}
+
+	diag := drawHeadless(t, 16, 16, func(cnv Ihandle) { DrawLine(cnv, 0, 0, 15, 15) })
+	for i := 0; i < 16; i++ {
+		if !black(diag, i, i) {
+			t.Fatalf("diagonal pixel %d,%d is not drawn", i, i)
+		}
+		if i < 15 && black(diag, i+1, i) {
+			t.Fatalf("pixel %d,%d is drawn outside the diagonal", i+1, i)
+		}
+	}
+	hugeDiag := drawHeadless(t, 16, 16, func(cnv Ihandle) { DrawLine(cnv, -huge, -huge, huge, huge) })
+	if !bytes.Equal(diag.Pix, hugeDiag.Pix) {
+		t.Fatal("huge diagonal differs from the visible diagonal")
+	}
+
+	thick := drawHeadless(t, 32, 16, func(cnv Ihandle) {
+		cnv.SetAttribute("DRAWLINEWIDTH", 3)
+		DrawLine(cnv, -10, 8, 40, 8)
+	})
+	hugeThick := drawHeadless(t, 32, 16, func(cnv Ihandle) {
+		cnv.SetAttribute("DRAWLINEWIDTH", 3)
+		DrawLine(cnv, -huge, 8, huge, 8)
+	})
+	if !bytes.Equal(thick.Pix, hugeThick.Pix) {
+		t.Fatal("huge thick line differs from the visible thick line")
+	}
+
+	// dashing a line this long without clipping would take minutes and gigabytes
+	dashed := drawHeadless(t, 32, 16, func(cnv Ihandle) {
+		cnv.SetAttributes("DRAWLINEWIDTH=3, DRAWSTYLE=STROKE_DASH")
+		DrawLine(cnv, -huge, 8, huge, 8)
+	})
+	on, off := 0, 0
+	for x := 0; x < 32; x++ {
+		if black(dashed, x, 8) {
+			on++
+		} else {
+			off++
+		}
+		if black(dashed, x, 4) {
+			t.Fatalf("dashed line drawn at %d,4", x)
+		}
+	}
+	if on == 0 || off == 0 {
+		t.Fatalf("dashed line has %d drawn and %d empty pixels", on, off)
+	}
+
+	fill := drawHeadless(t, 8, 8, func(cnv Ihandle) {
+		cnv.SetAttribute("DRAWSTYLE", "FILL")
+		DrawRectangle(cnv, -2*huge, -2*huge, 2*huge, 2*huge)
+	})
+	for y := 0; y < 8; y++ {
+		for x := 0; x < 8; x++ {
+			if !black(fill, x, y) {
+				t.Fatalf("huge rectangle did not fill %d,%d", x, y)
+			}
+		}
+	}
+}
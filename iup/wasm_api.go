@@ -849,6 +849,21 @@ func DrawPolygon(ih Ihandle, points []int, count int) {
 	wasmFree(ptr)
 }
 
+// DrawPolyline draws a sequence of connected lines, as a single stroke. Coordinates are x1, y1, x2, y2, ...
+//
+// https://github.com/gen2brain/iup-go/blob/main/docs/func/iup_draw.md
+func DrawPolyline(ih Ihandle, points []int, count int) {
+	if len(points) == 0 {
+		return
+	}
+	ptr := wasmMalloc(len(points) * 4)
+	for i, v := range points {
+		wasmSetI32(ptr+i*4, v)
+	}
+	ccall("IupDrawPolyline", "", []interface{}{"number", "number", "number"}, []interface{}{int(ih), ptr, count})
+	wasmFree(ptr)
+}
+
 // DrawPixel draws a single pixel.
 //
 // https://github.com/gen2brain/iup-go/blob/main/docs/func/iup_draw.md
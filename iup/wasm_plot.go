@@ -20,6 +20,18 @@ func PlotAddSamples(ih Ihandle, dsIndex int, x, y []float64) {
 	ccall("IupPlotAddSamples", "", []interface{}{"number", "number", "number", "number", "number"}, []interface{}{int(ih), dsIndex, px, py, len(x)})
 }
 
+func PlotSetSamplesBuffer(ih Ihandle, dsIndex int, x, y []float64) int {
+	if len(y) != len(x) {
+		return 0
+	}
+	px, py := 0, 0
+	if len(x) > 0 {
+		// the plot frees the arrays, also on failure
+		px, py = wasmF64Array(x), wasmF64Array(y)
+	}
+	return ccall("IupPlotSetSamplesBuffer", "number", []interface{}{"number", "number", "number", "number", "number", "number"}, []interface{}{int(ih), dsIndex, px, py, len(x), 1}).Int()
+}
+
 func PlotAddSegment(ih Ihandle, x, y float64) {
 	ccall("IupPlotAddSegment", "", []interface{}{"number", "number", "number"}, []interface{}{int(ih), float64(x), float64(y)})
 }
@@ -125,6 +137,10 @@ func PlotLoadData(ih Ihandle, filename string, strXdata int) int {
 	return ccall("IupPlotLoadData", "number", []interface{}{"number", "string", "number"}, []interface{}{int(ih), filename, strXdata}).Int()
 }
 
+func PlotSaveData(ih Ihandle, filename string, binary int) int {
+	return ccall("IupPlotSaveData", "number", []interface{}{"number", "string", "number"}, []interface{}{int(ih), filename, binary}).Int()
+}
+
 func PlotOpen() {
 	ccall("IupPlotOpen", "", nil, nil)
 }